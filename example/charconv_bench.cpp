@@ -0,0 +1,119 @@
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ShivLib/charconv.hpp>
+
+// Parsing 100k numeric fields of the kinds a text feed carries, in nanoseconds per field:
+// shiv::from_chars against std::from_chars and strtoll or strtod. Quantities are 1 to 7 digit
+// integers, ids 16 to 19 digits, prices have 1 to 5 digits then 2 to 4 decimals, measurements
+// are 15 significant digits with an exponent, and shortest is the shortest round trip text of
+// random doubles. Prices are also parsed by from_chars_fixed into 4 decimal integer units.
+// Each timing repeats until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+// keeps the results alive so they are not optimised away
+volatile double sink{0};
+
+template <typename Shiv, typename Std, typename C>
+void row(const std::string& name, const std::vector<std::string>& fields, Shiv&& shiv_parse,
+         Std&& std_parse, C&& c_parse) {
+    const auto time{[&](auto&& parse) {
+        return seconds_per_call([&] {
+                   double total{0};
+                   for (const auto& field : fields) {
+                       total += static_cast<double>(parse(field));
+                   }
+                   sink = total;
+               }) /
+               static_cast<double>(fields.size()) * 1e9;
+    }};
+    const double shiv_time{time(shiv_parse)};
+    const double std_time{time(std_parse)};
+    const double c_time{time(c_parse)};
+    std::cout << name << "\t" << shiv_time << "\t" << std_time << "\t" << c_time << "\t"
+              << std_time / shiv_time << "x\n";
+}
+
+template <typename T>
+T shiv_value(const std::string& field) {
+    T value{};
+    (void)shiv::from_chars(shiv::StringView<char>{field}, value);
+    return value;
+}
+template <typename T>
+T std_value(const std::string& field) {
+    T value{};
+    (void)std::from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+int main() {
+    constexpr size_t count{100'000};
+    std::mt19937_64 generator{42};
+    const auto digits{[&](size_t length) {
+        std::string text(length, '0');
+        for (auto& c : text) {
+            c = static_cast<char>('0' + generator() % 10);
+        }
+        text[0] = static_cast<char>('1' + generator() % 9);
+        return text;
+    }};
+    std::vector<std::string> quantities{};
+    std::vector<std::string> ids{};
+    std::vector<std::string> prices{};
+    std::vector<std::string> measurements{};
+    std::vector<std::string> shortest{};
+    for (size_t i{0}; i < count; ++i) {
+        quantities.push_back(digits(1 + generator() % 7));
+        ids.push_back(digits(16 + generator() % 4));
+        std::string fraction{digits(2 + generator() % 3)};
+        fraction[0] = static_cast<char>('0' + generator() % 10);
+        prices.push_back(digits(1 + generator() % 5) + "." + fraction);
+        const std::string mantissa{digits(15)};
+        measurements.push_back(mantissa.substr(0, 1) + "." + mantissa.substr(1) + "e" +
+                               std::to_string(static_cast<int>(generator() % 40) - 20));
+        char buffer[32];
+        const double value{std::uniform_real_distribution<double>{-1e6, 1e6}(generator)};
+        shortest.emplace_back(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+    }
+
+    const auto strtoll_value{[](const std::string& field) {
+        return std::strtoll(field.c_str(), nullptr, 10);
+    }};
+    const auto strtod_value{[](const std::string& field) {
+        return std::strtod(field.c_str(), nullptr);
+    }};
+    std::cout << "field\tshiv ns\tstd ns\tstrto ns\tspeedup over std\n";
+    row("quantity", quantities, shiv_value<int64_t>, std_value<int64_t>, strtoll_value);
+    row("id", ids, shiv_value<int64_t>, std_value<int64_t>, strtoll_value);
+    row("price", prices, shiv_value<double>, std_value<double>, strtod_value);
+    row(
+        "price fixed", prices,
+        [](const std::string& field) {
+            int64_t units{0};
+            (void)shiv::from_chars_fixed(shiv::StringView<char>{field}, units, 4);
+            return units;
+        },
+        std_value<double>, strtod_value);
+    row("measurement", measurements, shiv_value<double>, std_value<double>, strtod_value);
+    row("shortest", shortest, shiv_value<double>, std_value<double>, strtod_value);
+    return 0;
+}
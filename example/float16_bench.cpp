@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/float16.hpp>
+
+// The same data stored as float, float16 and bfloat16. The first table is bulk conversion
+// throughput over 4M elements. The second is a factor model's exposure matrix, assets x 256
+// factors, times a float vector of factor returns through dot, which widens in registers: the
+// matrix size in MB, time per product, bandwidth over the matrix and error against a double
+// product of the original float values, largest absolute difference over largest result. The
+// third is a square matrix product through gemm, accumulated in float for every storage type.
+// Each measurement repeats until roughly a quarter of a second has passed.
+
+constexpr size_t factors{256};
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+double relative_error(const std::vector<double>& expected, const std::vector<float>& actual) {
+    double error{0};
+    double scale{0};
+    for (size_t i{0}; i < expected.size(); ++i) {
+        error = std::max(error, std::abs(expected[i] - static_cast<double>(actual[i])));
+        scale = std::max(scale, std::abs(expected[i]));
+    }
+    return error / scale;
+}
+
+template <typename From, typename To>
+void conversion(const std::string& name, size_t count, std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution{-1, 1};
+    std::vector<float> values(count);
+    std::generate(values.begin(), values.end(), [&] { return distribution(generator); });
+    std::vector<From> source(count);
+    std::transform(values.begin(), values.end(), source.begin(),
+                   [](float value) { return From{value}; });
+    std::vector<To> target(count);
+    const double time{
+        seconds_per_call([&] { shiv::convert(source.data(), target.data(), count); })};
+    const double bytes{static_cast<double>(count * (sizeof(From) + sizeof(To)))};
+    std::cout << name << "\t" << time * 1e3 << "\t" << bytes / time / 1e9 << "\n";
+}
+
+template <typename T>
+void exposures(const std::string& type, const shiv::DynMatrix<float>& original,
+               const std::vector<float>& returns, const std::vector<double>& expected) {
+    const auto stored{original.cast<T>()};
+    std::vector<float> result(original.rows());
+    const double time{seconds_per_call([&] {
+        for (size_t i{0}; i < stored.rows(); ++i) {
+            result[i] = shiv::dot(stored[i], returns.data(), factors);
+        }
+    })};
+    const double bytes{static_cast<double>(original.rows() * factors * sizeof(T))};
+    std::cout << type << "\t" << original.rows() << "\t" << bytes / 1e6 << "\t" << time * 1e6
+              << "\t" << bytes / time / 1e9 << "\t" << relative_error(expected, result) << "\n";
+}
+
+void factor_model(size_t assets, std::mt19937& generator) {
+    std::normal_distribution<float> distribution{0, 1};
+    shiv::DynMatrix<float> loadings{assets, factors};
+    for (size_t i{0}; i < assets; ++i) {
+        std::generate(loadings[i], loadings[i] + factors, [&] { return distribution(generator); });
+    }
+    std::vector<float> returns(factors);
+    std::generate(returns.begin(), returns.end(), [&] { return 0.01F * distribution(generator); });
+    std::vector<double> expected(assets);
+    for (size_t i{0}; i < assets; ++i) {
+        for (size_t j{0}; j < factors; ++j) {
+            expected[i] += static_cast<double>(loadings[i][j]) * static_cast<double>(returns[j]);
+        }
+    }
+    exposures<float>("float", loadings, returns, expected);
+    exposures<shiv::float16>("float16", loadings, returns, expected);
+    exposures<shiv::bfloat16>("bfloat16", loadings, returns, expected);
+}
+
+template <typename T>
+void product(const std::string& type, const shiv::DynMatrix<float>& a,
+             const shiv::DynMatrix<float>& b, const std::vector<double>& expected) {
+    const auto lhs{a.cast<T>()};
+    const auto rhs{b.cast<T>()};
+    shiv::DynMatrix<T> result{};
+    const double time{seconds_per_call([&] { result = lhs * rhs; })};
+    const auto wide{result.template cast<float>()};
+    std::vector<float> flat{};
+    for (size_t i{0}; i < wide.rows(); ++i) {
+        flat.insert(flat.end(), wide[i], wide[i] + wide.cols());
+    }
+    const auto n{static_cast<double>(a.rows())};
+    std::cout << type << "\t" << a.rows() << "\t" << time * 1e3 << "\t"
+              << 2 * n * n * n / time / 1e9 << "\t" << relative_error(expected, flat) << "\n";
+}
+
+void square(size_t n, std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution{-1, 1};
+    shiv::DynMatrix<float> a{n, n};
+    shiv::DynMatrix<float> b{n, n};
+    for (size_t i{0}; i < n; ++i) {
+        std::generate(a[i], a[i] + n, [&] { return distribution(generator); });
+        std::generate(b[i], b[i] + n, [&] { return distribution(generator); });
+    }
+    const auto reference{a.cast<double>() * b.cast<double>()};
+    std::vector<double> expected{};
+    for (size_t i{0}; i < n; ++i) {
+        expected.insert(expected.end(), reference[i], reference[i] + n);
+    }
+    product<float>("float", a, b, expected);
+    product<shiv::float16>("float16", a, b, expected);
+    product<shiv::bfloat16>("bfloat16", a, b, expected);
+}
+
+int main() {
+    std::mt19937 generator{42};
+    constexpr size_t count{1 << 22};
+    std::cout << "conversion\tms\tGB/s\n";
+    conversion<float, shiv::float16>("float -> float16", count, generator);
+    conversion<shiv::float16, float>("float16 -> float", count, generator);
+    conversion<float, shiv::bfloat16>("float -> bfloat16", count, generator);
+    conversion<shiv::bfloat16, float>("bfloat16 -> float", count, generator);
+
+    std::cout << "\ntype\tassets\tMB\tus\tGB/s\trelative error\n";
+    for (size_t assets{512}; assets <= 32768; assets *= 4) {
+        factor_model(assets, generator);
+    }
+
+    std::cout << "\ntype\tn\tms\tGFLOP/s\trelative error\n";
+    for (size_t n{256}; n <= 1024; n *= 2) {
+        square(n, generator);
+    }
+    return 0;
+}
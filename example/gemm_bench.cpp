@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <ShivLib/dataStructures/matrix.hpp>
+
+// Square Matrix products from 4x4 to 1024x1024, operator* against a copy of the i j k loop it
+// used to be, both returning by value. Each size repeats until roughly a quarter of a second has
+// passed. Double stops at 512 as a 1024 x 1024 double result no longer fits on the stack.
+
+template <typename T, size_t n>
+shiv::Matrix<T, n, n> naive_multiply(const shiv::Matrix<T, n, n>& lhs,
+                                     const shiv::Matrix<T, n, n>& rhs) {
+    shiv::Matrix<T, n, n> result{};
+    for (size_t i{0}; i < n; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            for (size_t k{0}; k < n; ++k) {
+                result[i][j] += lhs[i][k] * rhs[k][j];
+            }
+        }
+    }
+    return result;
+}
+
+template <typename Func>
+double gflops(size_t n, Func&& func) {
+    const double flops{2.0 * static_cast<double>(n) * static_cast<double>(n) *
+                       static_cast<double>(n)};
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return flops * static_cast<double>(iterations) /
+           std::chrono::duration<double>(end - start).count() / 1e9;
+}
+
+template <typename T, size_t n>
+void run(const std::string& type) {
+    using matrix = shiv::Matrix<T, n, n>;
+    auto lhs{std::make_unique<matrix>()};
+    auto rhs{std::make_unique<matrix>()};
+    auto naive{std::make_unique<matrix>()};
+    auto blocked{std::make_unique<matrix>()};
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<T> distribution{-1, 1};
+    std::generate(lhs->begin(), lhs->end(), [&] { return distribution(generator); });
+    std::generate(rhs->begin(), rhs->end(), [&] { return distribution(generator); });
+
+    const double old_rate{gflops(n, [&] { *naive = naive_multiply(*lhs, *rhs); })};
+    const double new_rate{gflops(n, [&] { *blocked = *lhs * *rhs; })};
+    T error{0};
+    for (size_t i{0}; i < n * n; ++i) {
+        error = std::max(error, std::abs(naive->begin()[i] - blocked->begin()[i]));
+    }
+    std::cout << type << "\t" << n << "\t" << old_rate << "\t" << new_rate << "\t"
+              << new_rate / old_rate << "x\t" << error << "\n";
+}
+
+template <typename T, size_t... sizes>
+void run_all(const std::string& type, std::index_sequence<sizes...>) {
+    (run<T, (size_t{4} << sizes)>(type), ...);
+}
+
+int main() {
+    std::cout << "type\tn\tnaive GFLOP/s\tblocked GFLOP/s\tspeedup\tmax abs diff\n";
+    run_all<float>("float", std::make_index_sequence<9>{});
+    run_all<double>("double", std::make_index_sequence<8>{});
+    return 0;
+}
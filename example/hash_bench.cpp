@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <x86intrin.h>
+
+#include <ShivLib/hash.hpp>
+
+// shiv::hash_bytes against std::hash<std::string_view> over keys of 4 bytes to 1MB, taken from
+// staggered offsets of a buffer so successive hashes cannot be folded together. The keys of each
+// size fit in 256KB, so they are hashed from cache like the keys of a table lookup. The table is
+// nanoseconds per key, GB/s and bytes per cycle of the time stamp counter, which ticks at the
+// nominal clock rate. Each timing repeats until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+// keeps the results alive so they are not optimised away
+volatile size_t sink{0};
+
+// time stamp counter ticks per second, measured against the steady clock
+double ticks_per_second() {
+    const auto start{std::chrono::steady_clock::now()};
+    const uint64_t first{__rdtsc()};
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds{100}) {
+    }
+    const uint64_t last{__rdtsc()};
+    const auto end{std::chrono::steady_clock::now()};
+    return static_cast<double>(last - first) / std::chrono::duration<double>(end - start).count();
+}
+
+int main() {
+    constexpr size_t buffer_size{2 << 20};
+    constexpr size_t window{256 << 10};
+    std::mt19937_64 generator{42};
+    std::vector<char> buffer(buffer_size + 64);
+    for (auto& c : buffer) {
+        c = static_cast<char>(generator());
+    }
+    const double ticks{ticks_per_second()};
+
+    std::cout << "size\tshiv ns\tstd ns\tshiv GB/s\tstd GB/s\tshiv B/cycle\tstd B/cycle\n";
+    for (const size_t size : {4, 8, 16, 32, 64, 128, 256, 1024, 4096, 65536, 1 << 20}) {
+        // up to 4096 keys, starting a byte further into their cache line each time
+        const size_t stride{size + 64};
+        const size_t key_count{std::clamp<size_t>(window / stride, 1, 4096)};
+        const double shiv_time{seconds_per_call([&] {
+                                   uint64_t total{0};
+                                   for (size_t i{0}; i < key_count; ++i) {
+                                       total ^= shiv::hash_bytes(buffer.data() + i * stride +
+                                                                     (i & 63),
+                                                                 size);
+                                   }
+                                   sink = total;
+                               }) /
+                               static_cast<double>(key_count)};
+        const double std_time{seconds_per_call([&] {
+                                  size_t total{0};
+                                  for (size_t i{0}; i < key_count; ++i) {
+                                      total ^= std::hash<std::string_view>{}(std::string_view{
+                                          buffer.data() + i * stride + (i & 63), size});
+                                  }
+                                  sink = total;
+                              }) /
+                              static_cast<double>(key_count)};
+        const auto gigabytes{[&](double seconds) {
+            return static_cast<double>(size) / seconds / 1e9;
+        }};
+        const auto per_cycle{[&](double seconds) {
+            return static_cast<double>(size) / (seconds * ticks);
+        }};
+        std::cout << size << "\t" << shiv_time * 1e9 << "\t" << std_time * 1e9 << "\t"
+                  << gigabytes(shiv_time) << "\t" << gigabytes(std_time) << "\t"
+                  << per_cycle(shiv_time) << "\t" << per_cycle(std_time) << "\n";
+    }
+    return 0;
+}
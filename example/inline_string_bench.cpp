@@ -0,0 +1,141 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ShivLib/dataStructures/inline_string.hpp>
+
+// A new order message with a symbol, a client order id and an account, held once in
+// shiv::InlineString fields and once in std::string fields. The table is the size of the
+// message and nanoseconds per message to copy 100k of them, to write them into a network
+// buffer, to compare each one's id with its neighbour's, the same length and differing only
+// in the last character, and to look its symbol up in a map of 500. The inline message is
+// written with one memcpy, the std one a length and the characters of each field. Each timing
+// repeats until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+// keeps the results alive so they are not optimised away
+volatile size_t sink{0};
+
+struct InlineOrder {
+    shiv::InlineString<15> symbol;
+    shiv::InlineString<31> client_order_id;
+    shiv::InlineString<15> account;
+    uint32_t quantity;
+    int64_t price;
+};
+
+struct StdOrder {
+    std::string symbol;
+    std::string client_order_id;
+    std::string account;
+    uint32_t quantity;
+    int64_t price;
+};
+
+std::string random_string(size_t length, std::mt19937& generator) {
+    std::uniform_int_distribution<int> letter{'A', 'Z'};
+    std::string result(length, ' ');
+    for (auto& c : result) {
+        c = static_cast<char>(letter(generator));
+    }
+    return result;
+}
+
+char* write_field(char* out, const std::string& field) {
+    *out++ = static_cast<char>(field.size());
+    std::memcpy(out, field.data(), field.size());
+    return out + field.size();
+}
+
+template <typename Order, typename Write>
+void run(const std::string& name, const std::vector<Order>& orders, Write&& write) {
+    std::vector<Order> copies{};
+    const double copy{seconds_per_call([&] {
+        copies = orders;
+        sink = copies.size();
+    })};
+    std::vector<char> buffer(orders.size() * (sizeof(InlineOrder) + 8));
+    const double serialise{seconds_per_call([&] {
+        char* out{buffer.data()};
+        for (const auto& order : orders) {
+            out = write(out, order);
+        }
+        sink = static_cast<size_t>(out - buffer.data());
+    })};
+    const double compare{seconds_per_call([&] {
+        size_t equal{0};
+        for (size_t i{1}; i < orders.size(); ++i) {
+            equal += orders[i].client_order_id == orders[i - 1].client_order_id ? 1 : 0;
+        }
+        sink = equal;
+    })};
+    std::unordered_map<decltype(Order::symbol), size_t> symbols{};
+    for (size_t i{0}; i < 500; ++i) {
+        symbols.emplace(orders[i].symbol, i);
+    }
+    const double lookup{seconds_per_call([&] {
+        size_t found{0};
+        for (const auto& order : orders) {
+            found += symbols.count(order.symbol);
+        }
+        sink = found;
+    })};
+    const auto per_message{[&](double seconds) {
+        return seconds / static_cast<double>(orders.size()) * 1e9;
+    }};
+    std::cout << name << "\t" << sizeof(Order) << "\t" << per_message(copy) << "\t"
+              << per_message(serialise) << "\t" << per_message(compare) << "\t"
+              << per_message(lookup) << "\n";
+}
+
+int main() {
+    std::mt19937 generator{42};
+    std::vector<std::string> symbols(500);
+    for (auto& symbol : symbols) {
+        symbol = random_string(3, generator) + ".L";
+    }
+    const std::string id_prefix{random_string(22, generator)};
+    std::vector<InlineOrder> inline_orders{};
+    std::vector<StdOrder> std_orders{};
+    std::uniform_int_distribution<size_t> pick{0, symbols.size() - 1};
+    for (size_t i{0}; i < 100'000; ++i) {
+        const std::string& symbol{i < symbols.size() ? symbols[i] : symbols[pick(generator)]};
+        const std::string id{id_prefix + std::to_string(1'000'000 + i)};
+        const std::string account{"ACC" + std::to_string(i % 97)};
+        inline_orders.push_back({shiv::StringView<char>{symbol}, shiv::StringView<char>{id},
+                                 shiv::StringView<char>{account}, 100, 12345});
+        std_orders.push_back({symbol, id, account, 100, 12345});
+    }
+
+    std::cout << "fields\tbytes\tcopy ns\twrite ns\tcompare ns\tlookup ns\n";
+    run("inline", inline_orders, [](char* out, const InlineOrder& order) {
+        std::memcpy(out, &order, sizeof(order));
+        return out + sizeof(order);
+    });
+    run("std", std_orders, [](char* out, const StdOrder& order) {
+        out = write_field(out, order.symbol);
+        out = write_field(out, order.client_order_id);
+        out = write_field(out, order.account);
+        std::memcpy(out, &order.quantity, sizeof(order.quantity));
+        std::memcpy(out + sizeof(order.quantity), &order.price, sizeof(order.price));
+        return out + sizeof(order.quantity) + sizeof(order.price);
+    });
+    return 0;
+}
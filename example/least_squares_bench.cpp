@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ShivLib/dataStructures/cholesky.hpp>
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/matrix_view.hpp>
+#include <ShivLib/dataStructures/qr.hpp>
+
+// The first table fits 10000 regressions of 500 observations on 10 regressors, cycling over 64
+// generated problems, as fixed size Matrix and as DynMatrix. Each is solved three ways: normal
+// equations through an explicit inverse, normal equations through Cholesky and QR on the
+// design matrix. The second fits a degree 9 polynomial on [0, 1], where A^T * A squares the
+// condition number of an already badly conditioned design, and reports the largest error in
+// the coefficients. The third times single large factorizations, Cholesky against LU on the
+// same positive definite matrix and QR of a 2n x n matrix. Each timing repeats until roughly a
+// quarter of a second has passed.
+
+constexpr size_t observations{500};
+constexpr size_t regressors{10};
+constexpr size_t problems{64};
+constexpr size_t fits{10000};
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+template <typename Design, typename Response>
+struct Problem {
+    Design design{};
+    Response response{};
+};
+
+template <typename Design, typename Response>
+std::vector<Problem<Design, Response>> make_problems(std::mt19937& generator) {
+    std::normal_distribution<double> distribution{0, 1};
+    std::vector<Problem<Design, Response>> result(problems);
+    for (auto& problem : result) {
+        if constexpr (!shiv::detail::is_matrix_v<Design>) {
+            problem.design = Design{observations, regressors};
+            problem.response = Response{observations, 1};
+        }
+        for (size_t i{0}; i < observations; ++i) {
+            double value{0};
+            for (size_t j{0}; j < regressors; ++j) {
+                problem.design[i][j] = j == 0 ? 1 : distribution(generator);
+                value += static_cast<double>(j) * problem.design[i][j];
+            }
+            problem.response[i][0] = value + distribution(generator);
+        }
+    }
+    return result;
+}
+
+template <typename Design, typename Response>
+void regressions(const std::string& type, std::mt19937& generator) {
+    const auto data{make_problems<Design, Response>(generator)};
+    double checksum{0};
+    const auto time{[&](auto&& fit) {
+        return seconds_per_call([&] {
+                   for (size_t k{0}; k < fits; ++k) {
+                       const auto& problem{data[k % problems]};
+                       checksum += fit(problem)[1][0];
+                   }
+               }) /
+               fits;
+    }};
+    const double inverse_time{time([](const auto& problem) {
+        const auto transposed{problem.design.get_transpose()};
+        return (transposed * problem.design).get_inverse() * (transposed * problem.response);
+    })};
+    const double cholesky_time{time([](const auto& problem) {
+        const auto transposed{problem.design.get_transpose()};
+        return shiv::Cholesky{transposed * problem.design}.solve(transposed * problem.response);
+    })};
+    const double qr_time{
+        time([](const auto& problem) { return shiv::QR{problem.design}.solve(problem.response); })};
+    std::cout << type << "\t" << inverse_time * fits * 1e3 << "\t" << cholesky_time * fits * 1e3
+              << "\t" << qr_time * fits * 1e3 << "\t" << inverse_time * 1e6 << "\t"
+              << cholesky_time * 1e6 << "\t" << qr_time * 1e6 << "\t" << inverse_time / qr_time
+              << "x\t" << inverse_time / cholesky_time << "x\n";
+    if (std::isnan(checksum)) {
+        std::cout << "nan in the fits\n";
+    }
+}
+
+void accuracy() {
+    constexpr size_t points{200};
+    constexpr size_t degree{9};
+    shiv::DynMatrix<double> design{points, degree + 1};
+    shiv::DynMatrix<double> response{points, 1};
+    for (size_t i{0}; i < points; ++i) {
+        const double t{static_cast<double>(i) / (points - 1)};
+        double power{1};
+        for (size_t j{0}; j <= degree; ++j) {
+            design[i][j] = power;
+            // every coefficient is one, so the response is exact
+            response[i][0] += power;
+            power *= t;
+        }
+    }
+    const auto error{[](const shiv::DynMatrix<double>& fit) {
+        double largest{0};
+        for (size_t j{0}; j <= degree; ++j) {
+            largest = std::max(largest, std::abs(fit[j][0] - 1));
+        }
+        return largest;
+    }};
+    const auto transposed{design.get_transpose()};
+    const auto normal{transposed * design};
+    const auto right{transposed * response};
+    std::cout << "inverse\t" << error(normal.get_inverse() * right) << "\n";
+    const shiv::Cholesky cholesky{normal};
+    if (cholesky.is_positive_definite()) {
+        std::cout << "cholesky\t" << error(cholesky.solve(right)) << "\n";
+    } else {
+        std::cout << "cholesky\tnot positive definite in floating point\n";
+    }
+    std::cout << "qr\t" << error(shiv::QR{design}.solve(response)) << "\n";
+}
+
+void large(size_t n, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    shiv::DynMatrix<double> tall{2 * n, n};
+    for (size_t i{0}; i < 2 * n; ++i) {
+        std::generate(tall[i], tall[i] + n, [&] { return distribution(generator); });
+    }
+    const auto spd{shiv::MatrixView<const double>{tall}.transposed() * tall};
+    const double size{static_cast<double>(n)};
+    const double cholesky_time{seconds_per_call([&] { (void)shiv::Cholesky{spd}.determinant(); })};
+    const double lu_time{seconds_per_call([&] { (void)shiv::LU{spd}.determinant(); })};
+    const double qr_time{seconds_per_call([&] { (void)shiv::QR{tall}.is_rank_deficient(); })};
+    const double cube{size * size * size};
+    std::cout << n << "\t" << cholesky_time * 1e3 << "\t" << cube / 3 / cholesky_time / 1e9 << "\t"
+              << lu_time * 1e3 << "\t" << 2 * cube / 3 / lu_time / 1e9 << "\t" << qr_time * 1e3
+              << "\t" << (4 * cube - 2 * cube / 3) / qr_time / 1e9 << "\n";
+}
+
+int main() {
+    std::mt19937 generator{42};
+    std::cout << "threads = " << shiv::matrix_threads() << "\n\n";
+    std::cout << "type\tinverse ms\tcholesky ms\tqr ms\tinverse us/fit\tcholesky us/fit"
+                 "\tqr us/fit\tqr speedup\tcholesky speedup\n";
+    regressions<shiv::Matrix<double, observations, regressors>,
+                shiv::Matrix<double, observations, 1>>("Matrix", generator);
+    regressions<shiv::DynMatrix<double>, shiv::DynMatrix<double>>("DynMatrix", generator);
+
+    std::cout << "\nmethod\tlargest coefficient error, degree 9 polynomial\n";
+    accuracy();
+
+    std::cout << "\nn\tcholesky ms\tGFLOP/s\tlu ms\tGFLOP/s\tqr 2n x n ms\tGFLOP/s\n";
+    for (size_t n{256}; n <= 2048; n *= 2) {
+        large(n, generator);
+    }
+    return 0;
+}
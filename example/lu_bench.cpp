@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/lu.hpp>
+
+// Square DynMatrix<double> systems from 64 to 1024. The first table is factorization throughput
+// and the cost of an inverse, LU against the unpivoted Gauss-Jordan inverse get_inverse used to
+// run. The second is repeated single column solves against one matrix, inverting it for every
+// solve as operator/ does against factoring once and reusing the factors. Each measurement
+// repeats until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+shiv::DynMatrix<double> random_matrix(size_t rows, size_t cols, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    shiv::DynMatrix<double> matrix{rows, cols};
+    for (size_t i{0}; i < rows; ++i) {
+        std::generate(matrix[i], matrix[i] + cols, [&] { return distribution(generator); });
+    }
+    return matrix;
+}
+
+shiv::DynMatrix<double> gauss_jordan_inverse(const shiv::DynMatrix<double>& matrix) {
+    shiv::DynMatrix<double> work{matrix};
+    shiv::DynMatrix<double> inverse{matrix.rows(), matrix.cols()};
+    shiv::detail::invert(work, inverse, matrix.rows());
+    return inverse;
+}
+
+double max_residual(const shiv::DynMatrix<double>& matrix, const shiv::DynMatrix<double>& inverse) {
+    const auto product{matrix * inverse};
+    double residual{0};
+    for (size_t i{0}; i < matrix.rows(); ++i) {
+        for (size_t j{0}; j < matrix.cols(); ++j) {
+            residual = std::max(residual, std::abs(product[i][j] - (i == j ? 1.0 : 0.0)));
+        }
+    }
+    return residual;
+}
+
+void factor(size_t n, std::mt19937& generator) {
+    const auto matrix{random_matrix(n, n, generator)};
+    const double dn{static_cast<double>(n)};
+    const double factor_time{seconds_per_call([&] { shiv::LU lu{matrix}; })};
+    shiv::DynMatrix<double> old_inverse{};
+    shiv::DynMatrix<double> new_inverse{};
+    const double old_time{seconds_per_call([&] { old_inverse = gauss_jordan_inverse(matrix); })};
+    const double new_time{seconds_per_call([&] { new_inverse = shiv::LU{matrix}.inverse(); })};
+    std::cout << n << "\t" << 2.0 * dn * dn * dn / 3.0 / factor_time / 1e9 << "\t"
+              << old_time * 1e3 << "\t" << new_time * 1e3 << "\t" << old_time / new_time << "x\t"
+              << max_residual(matrix, old_inverse) << "\t" << max_residual(matrix, new_inverse)
+              << "\n";
+}
+
+void repeated_solves(size_t n, std::mt19937& generator) {
+    const auto matrix{random_matrix(n, n, generator)};
+    const auto rhs{random_matrix(n, 1, generator)};
+    shiv::DynMatrix<double> solution{};
+    const double invert_time{seconds_per_call([&] { solution = matrix.get_inverse() * rhs; })};
+    const shiv::LU lu{matrix};
+    const double solve_time{seconds_per_call([&] { solution = lu.solve(rhs); })};
+    std::cout << n << "\t" << 1.0 / invert_time << "\t" << 1.0 / solve_time << "\t"
+              << invert_time / solve_time << "x\n";
+}
+
+int main() {
+    std::mt19937 generator{42};
+    std::cout << "n\tfactor GFLOP/s\tgauss-jordan inverse ms\tlu inverse ms\tspeedup"
+                 "\tgauss-jordan residual\tlu residual\n";
+    for (size_t n{64}; n <= 1024; n *= 2) {
+        factor(n, generator);
+    }
+    std::cout << "\nn\tinvert per solve/s\tfactored solve/s\tspeedup\n";
+    for (size_t n{64}; n <= 1024; n *= 2) {
+        repeated_solves(n, generator);
+    }
+    return 0;
+}
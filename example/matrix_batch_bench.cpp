@@ -0,0 +1,116 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <ShivLib/dataStructures/matrix_batch.hpp>
+
+// Batches of 2x2 to 4x4 float and double matrices, each operation run over a MatrixBatch and
+// over a Vector of the same matrices one at a time through the specialised small Matrix
+// kernels, both writing into storage allocated up front. Each repeats until roughly a tenth of
+// a second has passed, reported in millions of matrices per second. Conversion is one batch
+// built from the Vector and turned back into one.
+
+constexpr size_t count{4096};
+
+template <typename Func>
+double million_per_second(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{100});
+    return static_cast<double>(iterations * count) /
+           std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+template <typename T, size_t n, typename Loop, typename Batched>
+void compare(const std::string& type, const std::string& operation, Loop&& loop,
+             Batched&& batched) {
+    const double loop_rate{million_per_second(loop)};
+    const double batch_rate{million_per_second(batched)};
+    std::cout << type << "\t" << n << "x" << n << "\t" << operation << "\t" << loop_rate << "\t"
+              << batch_rate << "\t" << batch_rate / loop_rate << "x\n";
+}
+
+template <typename T, size_t n>
+void run(const std::string& type) {
+    using matrix = shiv::Matrix<T, n, n>;
+    using batch = shiv::MatrixBatch<T, n, n>;
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<T> distribution{-2, 2};
+    shiv::Vector<matrix> lhs(count);
+    shiv::Vector<matrix> rhs(count);
+    for (size_t i{0}; i < count; ++i) {
+        matrix a{};
+        matrix b{};
+        for (size_t j{0}; j < n * n; ++j) {
+            a.begin()[j] = distribution(generator);
+            b.begin()[j] = distribution(generator);
+        }
+        // diagonally dominant so none of them are singular
+        for (size_t j{0}; j < n; ++j) {
+            a[j][j] += 2 * n;
+        }
+        lhs.push_back(a);
+        rhs.push_back(b);
+    }
+    const batch lhs_batch{lhs};
+    const batch rhs_batch{rhs};
+    shiv::Vector<matrix> out(count);
+    shiv::Vector<T> determinants(count);
+    for (size_t i{0}; i < count; ++i) {
+        out.push_back(matrix{});
+        determinants.push_back(T{});
+    }
+    batch out_batch{count};
+
+    compare<T, n>(
+        type, "multiply",
+        [&] {
+            for (size_t i{0}; i < count; ++i) {
+                out[i] = lhs[i] * rhs[i];
+            }
+        },
+        [&] { shiv::batch_multiply(lhs_batch, rhs_batch, out_batch); });
+    compare<T, n>(
+        type, "add",
+        [&] {
+            for (size_t i{0}; i < count; ++i) {
+                out[i] = lhs[i] + rhs[i];
+            }
+        },
+        [&] { shiv::batch_add(lhs_batch, rhs_batch, out_batch); });
+    compare<T, n>(
+        type, "inverse",
+        [&] {
+            for (size_t i{0}; i < count; ++i) {
+                out[i] = lhs[i].get_inverse();
+            }
+        },
+        [&] { shiv::batch_inverse(lhs_batch, out_batch); });
+    compare<T, n>(
+        type, "determinant",
+        [&] {
+            for (size_t i{0}; i < count; ++i) {
+                determinants[i] = lhs[i].get_determinant();
+            }
+        },
+        [&] { shiv::batch_determinant(lhs_batch, determinants.begin()); });
+    compare<T, n>(
+        type, "convert", [&] { out = lhs; }, [&] { out_batch.assign(lhs); });
+}
+
+int main() {
+    std::cout << "type\tsize\toperation\tone at a time M/s\tbatched M/s\tspeedup\n";
+    run<float, 2>("float");
+    run<float, 3>("float");
+    run<float, 4>("float");
+    run<double, 2>("double");
+    run<double, 3>("double");
+    run<double, 4>("double");
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <ShivLib/dataStructures/matrix.hpp>
+
+// Chains of 2 to 6 element wise Matrix operations, evaluated once as a single fused expression
+// and once with every intermediate result stored to a Matrix, which is what the operators did
+// before they returned expressions. Each chain repeats until roughly a quarter of a second has
+// passed and reports nanoseconds per output element.
+
+constexpr size_t operand_count{6};
+
+template <typename T, size_t n>
+using operands = std::array<std::unique_ptr<shiv::Matrix<T, n, n>>, operand_count>;
+
+// alternates adding the next operand and scaling, so both kinds of node appear in the chain
+template <size_t ops, bool fused, typename E, typename T, size_t n>
+auto chain(const E& expression, const operands<T, n>& inputs) {
+    if constexpr (ops == 0) {
+        return expression;
+    } else {
+        const auto step{[&] {
+            if constexpr (ops % 2 == 0) {
+                return expression + *inputs[ops / 2];
+            } else {
+                return expression * T{0.5};
+            }
+        }()};
+        if constexpr (fused) {
+            return chain<ops - 1, fused>(step, inputs);
+        } else {
+            return chain<ops - 1, fused>(step.eval(), inputs);
+        }
+    }
+}
+
+template <typename Func>
+double ns_per_element(size_t elements, Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           static_cast<double>(iterations * elements);
+}
+
+template <typename T, size_t n, size_t ops>
+void run(const operands<T, n>& inputs) {
+    using matrix = shiv::Matrix<T, n, n>;
+    auto unfused{std::make_unique<matrix>()};
+    auto fused{std::make_unique<matrix>()};
+    const double unfused_ns{ns_per_element(n * n, [&] {
+        *unfused = chain<ops, false>(*inputs[0], inputs);
+    })};
+    const double fused_ns{ns_per_element(n * n, [&] {
+        *fused = chain<ops, true>(*inputs[0], inputs);
+    })};
+    T error{0};
+    for (size_t i{0}; i < n * n; ++i) {
+        error = std::max(error, std::abs(unfused->begin()[i] - fused->begin()[i]));
+    }
+    std::cout << n << "\t" << ops << "\t" << unfused_ns << "\t" << fused_ns << "\t"
+              << unfused_ns / fused_ns << "x\t" << error << "\n";
+}
+
+template <typename T, size_t n, size_t... ops>
+void run_all(std::index_sequence<ops...>) {
+    operands<T, n> inputs{};
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<T> distribution{-1, 1};
+    for (auto& input : inputs) {
+        input = std::make_unique<shiv::Matrix<T, n, n>>();
+        std::generate(input->begin(), input->end(), [&] { return distribution(generator); });
+    }
+    (run<T, n, ops + 2>(inputs), ...);
+}
+
+int main() {
+    std::cout << "n\tops\tunfused ns/elem\tfused ns/elem\tspeedup\tmax abs diff\n";
+    run_all<float, 32>(std::make_index_sequence<5>{});
+    run_all<float, 256>(std::make_index_sequence<5>{});
+    return 0;
+}
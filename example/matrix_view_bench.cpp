@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <ShivLib/dataStructures/matrix_view.hpp>
+
+// Square DynMatrix<double> operands from 256 to 2048, working on parts of them the way blocked
+// algorithms do. Each row is the copying way, the block copied out to its own DynMatrix before
+// and written back after, against the same work through MatrixView. Each measurement repeats
+// until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+shiv::DynMatrix<double> random_matrix(size_t n, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    shiv::DynMatrix<double> matrix{n, n};
+    for (size_t i{0}; i < n; ++i) {
+        std::generate(matrix[i], matrix[i] + n, [&] { return distribution(generator); });
+    }
+    return matrix;
+}
+
+shiv::DynMatrix<double> copy_block(const shiv::DynMatrix<double>& matrix, size_t row, size_t col,
+                                   size_t rows, size_t cols) {
+    shiv::DynMatrix<double> block{rows, cols};
+    for (size_t i{0}; i < rows; ++i) {
+        std::copy(matrix[row + i] + col, matrix[row + i] + col + cols, block[i]);
+    }
+    return block;
+}
+
+void report(const std::string& operation, size_t n, double copy_time, double view_time) {
+    std::cout << operation << "\t" << n << "\t" << copy_time * 1e3 << "\t" << view_time * 1e3
+              << "\t" << copy_time / view_time << "x\n";
+}
+
+void run(size_t n, std::mt19937& generator) {
+    const auto a{random_matrix(n, generator)};
+    const auto b{random_matrix(n, generator)};
+    auto c{random_matrix(n, generator)};
+    const size_t half{n / 2};
+
+    // the trailing update of a blocked factorization, C22 -= A21 * B12
+    const double update_copy{seconds_per_call([&] {
+        const auto product{copy_block(a, half, 0, half, half) * copy_block(b, 0, half, half, half)};
+        for (size_t i{0}; i < half; ++i) {
+            for (size_t j{0}; j < half; ++j) {
+                c[half + i][half + j] -= product[i][j];
+            }
+        }
+    })};
+    const shiv::MatrixView<const double> a_view{a};
+    const shiv::MatrixView<const double> b_view{b};
+    const shiv::MatrixView<double> c_view{c};
+    const double update_view{seconds_per_call([&] {
+        shiv::gemm(-1.0, a_view.submatrix(half, 0, half, half),
+                   b_view.submatrix(0, half, half, half), 1.0,
+                   c_view.submatrix(half, half, half, half));
+    })};
+    report("block update", n, update_copy, update_view);
+
+    // A^T * B
+    shiv::DynMatrix<double> result{};
+    const double transpose_copy{seconds_per_call([&] { result = a.get_transpose() * b; })};
+    const double transpose_view{seconds_per_call([&] { result = a_view.transposed() * b; })};
+    report("transpose product", n, transpose_copy, transpose_view);
+
+    // scaling one column in place, the copy goes through the transpose to get a row
+    const double column_copy{seconds_per_call([&] {
+        auto transposed{c.get_transpose()};
+        for (size_t j{0}; j < n; ++j) {
+            transposed[half][j] *= 1.0000001;
+        }
+        for (size_t i{0}; i < n; ++i) {
+            c[i][half] = transposed[half][i];
+        }
+    })};
+    const double column_view{seconds_per_call([&] { c_view.col(half) *= 1.0000001; })};
+    report("scale column", n, column_copy, column_view);
+}
+
+int main() {
+    std::mt19937 generator{42};
+    std::cout << "operation\tn\tcopying ms\tview ms\tspeedup\n";
+    for (size_t n{256}; n <= 2048; n *= 2) {
+        run(n, generator);
+    }
+    return 0;
+}
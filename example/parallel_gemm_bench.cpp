@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/lu.hpp>
+
+// Strong scaling of DynMatrix<double> products and LU factorizations at fixed sizes, from one
+// thread up to one per hardware thread, or up to the count given as the first argument. Each
+// measurement repeats until roughly half a second has passed. Efficiency is the speedup over one
+// thread divided by the thread count.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{500});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+shiv::DynMatrix<double> random_matrix(size_t n, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    shiv::DynMatrix<double> matrix{n, n};
+    for (size_t i{0}; i < n; ++i) {
+        std::generate(matrix[i], matrix[i] + n, [&] { return distribution(generator); });
+    }
+    return matrix;
+}
+
+template <typename Func>
+void scale(const std::string& name, size_t n, double flops, size_t max_threads, Func&& func) {
+    double single{0};
+    for (size_t threads{1}; threads <= max_threads; threads = threads < 4 ? threads + 1
+                                                                          : threads * 2) {
+        shiv::set_matrix_threads(threads);
+        const double rate{flops / seconds_per_call(func) / 1e9};
+        if (threads == 1) {
+            single = rate;
+        }
+        std::cout << name << "\t" << n << "\t" << threads << "\t" << rate << "\t"
+                  << rate / single << "x\t" << rate / single / static_cast<double>(threads)
+                  << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t max_threads{argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                                      : std::thread::hardware_concurrency()};
+    std::mt19937 generator{42};
+    std::cout << "kernel\tn\tthreads\tGFLOP/s\tspeedup\tefficiency\n";
+    for (size_t n : {512U, 1024U, 2048U}) {
+        const auto lhs{random_matrix(n, generator)};
+        const auto rhs{random_matrix(n, generator)};
+        const double dn{static_cast<double>(n)};
+        shiv::DynMatrix<double> product{};
+        scale("gemm", n, 2 * dn * dn * dn, max_threads, [&] { product = lhs * rhs; });
+        scale("lu", n, 2 * dn * dn * dn / 3, max_threads, [&] { shiv::LU lu{lhs}; });
+    }
+    shiv::set_matrix_threads(0);
+    return 0;
+}
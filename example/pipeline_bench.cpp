@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ShivLib/multithreading/pipeline.hpp>
+
+// A feed handler shaped pipeline, parse -> normalize -> enrich -> publish, over synthetic wire
+// messages. Runs it with single stages, then with enrich spread over replicas in both merge
+// modes, and with batching turned off to show what batching the ring traffic buys.
+
+struct Wire {
+    uint64_t sequence;
+    char text[24];
+};
+
+struct Quote {
+    uint64_t sequence;
+    int64_t price;
+    int64_t quantity;
+    double notional;
+};
+
+Wire make_wire(uint64_t sequence) {
+    Wire wire{sequence, {}};
+    const std::string text{std::to_string(10000 + sequence % 5000) + " " +
+                           std::to_string(1 + sequence % 100)};
+    text.copy(wire.text, sizeof(wire.text) - 1);
+    return wire;
+}
+
+Quote parse(const Wire& wire) {
+    Quote quote{wire.sequence, 0, 0, 0.0};
+    const char* ptr{wire.text};
+    for (; *ptr != ' '; ++ptr) {
+        quote.price = quote.price * 10 + (*ptr - '0');
+    }
+    for (++ptr; *ptr != '\0'; ++ptr) {
+        quote.quantity = quote.quantity * 10 + (*ptr - '0');
+    }
+    return quote;
+}
+
+// stands in for a reference data lookup, enough work to make enrich the slowest stage
+double enrich_notional(const Quote& quote) {
+    double value{static_cast<double>(quote.price) / 100.0};
+    for (int i{0}; i < 200; ++i) {
+        value = value * 1.0000001 + 1e-9;
+    }
+    return value * static_cast<double>(quote.quantity);
+}
+
+void run(const std::string& label, uint64_t count, size_t replicas, shiv::Merge merge,
+         shiv::PipelineOptions options) {
+    std::vector<Wire> input{};
+    input.reserve(count);
+    for (uint64_t i{0}; i < count; ++i) {
+        input.push_back(make_wire(i));
+    }
+    uint64_t published{0};
+    uint64_t out_of_order{0};
+    uint64_t last{0};
+    auto pipeline{shiv::Pipeline<Wire>::builder(options)
+                      .stage("parse", [](Wire wire) { return parse(wire); })
+                      .stage("normalize",
+                             [](Quote quote) {
+                                 quote.price = quote.price * 100;
+                                 return quote;
+                             })
+                      .parallel_stage("enrich", replicas,
+                                      [](Quote quote) {
+                                          quote.notional = enrich_notional(quote);
+                                          return quote;
+                                      },
+                                      merge)
+                      .sink("publish", [&](Quote quote) {
+                          out_of_order += published != 0 && quote.sequence < last;
+                          last = quote.sequence;
+                          ++published;
+                      })};
+
+    const auto start{std::chrono::steady_clock::now()};
+    pipeline.start();
+    pipeline.push_batch(input.begin(), input.end());
+    pipeline.finish();
+    const auto end{std::chrono::steady_clock::now()};
+
+    const double seconds{std::chrono::duration<double>(end - start).count()};
+    std::cout << label << ": " << static_cast<double>(published) / seconds / 1e6
+              << " M msg/s, out of order " << out_of_order << "\n";
+    for (auto&& stage : pipeline.stats()) {
+        std::cout << "    " << stage.name << " x" << stage.replicas << "\t" << stage.processed
+                  << " msgs\t" << stage.throughput / 1e6 << " M msg/s\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    const uint64_t count{argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000};
+    const size_t max_replicas{std::max(2U, std::thread::hardware_concurrency()) / 2};
+
+    run("single stages, batch 32", count, 1, shiv::Merge::ordered, {1024, 32});
+    run("single stages, batch 1", count, 1, shiv::Merge::ordered, {1024, 1});
+    for (size_t replicas{2}; replicas <= max_replicas; replicas *= 2) {
+        run("enrich x" + std::to_string(replicas) + " ordered", count, replicas,
+            shiv::Merge::ordered, {1024, 32});
+        run("enrich x" + std::to_string(replicas) + " unordered", count, replicas,
+            shiv::Merge::unordered, {1024, 32});
+    }
+    return 0;
+}
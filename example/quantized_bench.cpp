@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/quantized.hpp>
+
+// The first table is raw throughput of square products, float gemm against the int8 kernel
+// for int8 * int8 and uint8 * int8, in multiply adds counted as two operations. The second is
+// a scoring step, a batch of float activations times a float weight matrix quantized once by
+// column: the time to quantize the batch by row and multiply, the weight matrix size in MB and
+// the largest error against the float product over its largest element. Each timing repeats
+// until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+template <typename T>
+shiv::DynMatrix<T> random_matrix(size_t rows, size_t cols, std::mt19937& generator) {
+    std::uniform_int_distribution<int> distribution{std::is_signed_v<T> ? -128 : 0,
+                                                    std::is_signed_v<T> ? 127 : 255};
+    shiv::DynMatrix<T> result{rows, cols};
+    for (size_t i{0}; i < rows; ++i) {
+        std::generate(result[i], result[i] + cols,
+                      [&] { return static_cast<T>(distribution(generator)); });
+    }
+    return result;
+}
+
+void square(size_t n, std::mt19937& generator) {
+    const auto a{random_matrix<int8_t>(n, n, generator)};
+    const auto u{random_matrix<uint8_t>(n, n, generator)};
+    const auto b{random_matrix<int8_t>(n, n, generator)};
+    const auto a_float{a.cast<float>()};
+    const auto b_float{b.cast<float>()};
+    shiv::DynMatrix<float> float_result{};
+    shiv::DynMatrix<int32_t> int_result{};
+    const double float_time{seconds_per_call([&] { float_result = a_float * b_float; })};
+    const double signed_time{seconds_per_call([&] { int_result = widening_product(a, b); })};
+    const double unsigned_time{seconds_per_call([&] { int_result = widening_product(u, b); })};
+    const double operations{2 * static_cast<double>(n) * static_cast<double>(n) *
+                            static_cast<double>(n)};
+    std::cout << n << "\t" << operations / float_time / 1e9 << "\t"
+              << operations / signed_time / 1e9 << "\t" << operations / unsigned_time / 1e9
+              << "\t" << float_time / signed_time << "x\n";
+}
+
+shiv::DynMatrix<float> random_floats(size_t rows, size_t cols, float low, float high,
+                                     std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution{low, high};
+    shiv::DynMatrix<float> result{rows, cols};
+    for (size_t i{0}; i < rows; ++i) {
+        std::generate(result[i], result[i] + cols, [&] { return distribution(generator); });
+    }
+    return result;
+}
+
+template <typename T>
+void scoring(const std::string& type, const shiv::DynMatrix<float>& activations,
+             const shiv::DynMatrix<float>& weights, const shiv::DynMatrix<float>& expected) {
+    const auto weights_q{shiv::quantize<int8_t>(weights, shiv::QuantizeAxis::cols)};
+    shiv::DynMatrix<float> result{};
+    const double time{seconds_per_call([&] {
+        result = shiv::quantize<T>(activations, shiv::QuantizeAxis::rows) * weights_q;
+    })};
+    double error{0};
+    double largest{0};
+    for (size_t i{0}; i < expected.rows(); ++i) {
+        for (size_t j{0}; j < expected.cols(); ++j) {
+            error = std::max(error, static_cast<double>(std::abs(result[i][j] - expected[i][j])));
+            largest = std::max(largest, static_cast<double>(std::abs(expected[i][j])));
+        }
+    }
+    const double megabytes{static_cast<double>(weights.rows() * weights.cols()) / 1e6};
+    std::cout << type << "\t" << time * 1e3 << "\t" << megabytes << "\t" << error / largest
+              << "\n";
+}
+
+void scoring_step(size_t batch, size_t features, size_t outputs, std::mt19937& generator) {
+    const auto activations{random_floats(batch, features, 0, 6, generator)};
+    const auto weights{random_floats(features, outputs, -0.1F, 0.1F, generator)};
+    shiv::DynMatrix<float> expected{};
+    const double float_time{seconds_per_call([&] { expected = activations * weights; })};
+    std::cout << batch << " x " << features << " x " << outputs << "\n";
+    std::cout << "float\t" << float_time * 1e3 << "\t"
+              << static_cast<double>(features * outputs * sizeof(float)) / 1e6 << "\t0\n";
+    scoring<int8_t>("int8", activations, weights, expected);
+    scoring<uint8_t>("uint8", activations, weights, expected);
+}
+
+int main() {
+    std::mt19937 generator{42};
+    std::cout << "threads = " << shiv::matrix_threads() << "\n\n";
+    std::cout << "n\tfloat GOP/s\tint8 GOP/s\tuint8 GOP/s\tint8 speedup\n";
+    for (size_t n{256}; n <= 2048; n *= 2) {
+        square(n, generator);
+    }
+
+    std::cout << "\ntype\tms\tweights MB\trelative error\n";
+    scoring_step(64, 1024, 1024, generator);
+    scoring_step(512, 4096, 1024, generator);
+    return 0;
+}
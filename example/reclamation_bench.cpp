@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <ShivLib/memory.hpp>
+#include <ShivLib/utility.hpp>
+
+// Treiber stack push/pop pairs under each reclamation scheme. Reports the cost per pop and the
+// highest number of retired but unfreed nodes seen by any thread.
+
+struct Node {
+    long value;
+    Node* next;
+};
+
+struct Result {
+    double ns_per_op;
+    size_t peak_unreclaimed;
+};
+
+template <typename Work>
+Result run(int threads, int iterations, Work&& work) {
+    std::atomic<Node*> head{nullptr};
+    std::atomic<size_t> peak{0};
+    std::vector<std::thread> workers{};
+    auto start{std::chrono::steady_clock::now()};
+    for (int t{0}; t < threads; ++t) {
+        workers.emplace_back([&] {
+            size_t local_peak{work(head, iterations)};
+            size_t current{peak.load()};
+            while (current < local_peak && !peak.compare_exchange_weak(current, local_peak)) {
+            }
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    auto end{std::chrono::steady_clock::now()};
+    while (Node* node{head.load()}) {
+        head = node->next;
+        delete node;
+    }
+    auto ns{std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()};
+    return {static_cast<double>(ns) / (static_cast<double>(threads) * iterations), peak.load()};
+}
+
+void push(std::atomic<Node*>& head, long value) {
+    auto* node{new Node{value, head.load(std::memory_order_relaxed)}};
+    while (!head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+    }
+}
+
+int main(int argc, char** argv) {
+    const int iterations{argc > 1 ? std::atoi(argv[1]) : 1'000'000};
+    const int max_threads{static_cast<int>(std::max(2U, std::thread::hardware_concurrency()))};
+
+    std::cout << "threads\tscheme\tns/op\tpeak unreclaimed\n";
+    for (int threads{1}; threads <= max_threads; threads *= 2) {
+        if (threads == 1) {
+            // with one thread nodes can be deleted straight away, the lower bound on cost
+            auto direct{run(threads, iterations, [&](std::atomic<Node*>& head, int count) {
+                for (int i{0}; i < count; ++i) {
+                    push(head, i);
+                    Node* node{head.load(std::memory_order_acquire)};
+                    head.store(node->next, std::memory_order_relaxed);
+                    delete node;
+                }
+                return size_t{0};
+            })};
+            std::cout << threads << "\tdirect\t" << direct.ns_per_op << "\t0\n";
+        }
+
+        shiv::EpochDomain epoch_domain{};
+        auto epoch{run(threads, iterations, [&](std::atomic<Node*>& head, int count) {
+            auto handle{epoch_domain.register_thread()};
+            size_t peak{0};
+            for (int i{0}; i < count; ++i) {
+                push(head, i);
+                auto guard{handle.pin()};
+                Node* node{head.load(std::memory_order_acquire)};
+                while (node != nullptr && !head.compare_exchange_weak(node, node->next)) {
+                }
+                if (node != nullptr) {
+                    handle.retire(node);
+                }
+                if ((i & 1023) == 0) {
+                    peak = std::max(peak, epoch_domain.unreclaimed());
+                }
+            }
+            return peak;
+        })};
+        std::cout << threads << "\tepoch\t" << epoch.ns_per_op << "\t" << epoch.peak_unreclaimed
+                  << "\n";
+
+        shiv::HazardDomain hazard_domain{};
+        auto hazard{run(threads, iterations, [&](std::atomic<Node*>& head, int count) {
+            shiv::HazardDomain::Guard guard{hazard_domain};
+            size_t peak{0};
+            for (int i{0}; i < count; ++i) {
+                push(head, i);
+                Node* node{guard.protect(head)};
+                while (node != nullptr && !head.compare_exchange_weak(node, node->next)) {
+                    node = guard.protect(head);
+                }
+                guard.reset();
+                if (node != nullptr) {
+                    hazard_domain.retire(node);
+                }
+                if ((i & 1023) == 0) {
+                    peak = std::max(peak, hazard_domain.unreclaimed());
+                }
+            }
+            return peak;
+        })};
+        std::cout << threads << "\thazard\t" << hazard.ns_per_op << "\t"
+                  << hazard.peak_unreclaimed << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ShivLib/dataStructures/rope.hpp>
+
+// shiv::Rope against editing one std::string, on a 4MB document. The table is nanoseconds per
+// operation: building the document from 100k appends of 40 characters, inserting and erasing
+// 40 characters at 1000 random positions, taking a 1MB substring and then writing it out, the
+// rope chunk by chunk into a buffer as writev would, and flattening it into a single view. Each
+// timing repeats until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+// keeps the results alive so they are not optimised away
+volatile size_t sink{0};
+
+int main() {
+    constexpr size_t piece_count{100'000};
+    constexpr size_t edit_count{1000};
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+    std::string piece(40, ' ');
+    for (auto& c : piece) {
+        c = static_cast<char>(letter(generator));
+    }
+    const shiv::StringView<char> view{piece};
+    const size_t document_size{piece_count * piece.size()};
+    std::vector<size_t> positions(edit_count);
+    // within the first half, so erasing never runs past the shrinking end
+    std::uniform_int_distribution<size_t> position_distribution{0, document_size / 2};
+    for (auto& position : positions) {
+        position = position_distribution(generator);
+    }
+
+    const double rope_build{seconds_per_call([&] {
+        shiv::Rope rope{};
+        for (size_t i{0}; i < piece_count; ++i) {
+            rope.append(view);
+        }
+        sink = rope.size();
+    })};
+    const double std_build{seconds_per_call([&] {
+        std::string text{};
+        for (size_t i{0}; i < piece_count; ++i) {
+            text.append(piece);
+        }
+        sink = text.size();
+    })};
+
+    shiv::Rope document{};
+    std::string text{};
+    for (size_t i{0}; i < piece_count; ++i) {
+        document.append(view);
+        text.append(piece);
+    }
+    const double rope_insert{seconds_per_call([&] {
+        shiv::Rope edited{document};
+        for (const size_t position : positions) {
+            edited.insert(position, view);
+        }
+        sink = edited.size();
+    })};
+    const double std_insert{seconds_per_call([&] {
+        std::string edited{text};
+        for (const size_t position : positions) {
+            edited.insert(position, piece);
+        }
+        sink = edited.size();
+    })};
+    const double rope_erase{seconds_per_call([&] {
+        shiv::Rope edited{document};
+        for (const size_t position : positions) {
+            edited.erase(position, piece.size());
+        }
+        sink = edited.size();
+    })};
+    const double std_erase{seconds_per_call([&] {
+        std::string edited{text};
+        for (const size_t position : positions) {
+            edited.erase(position, piece.size());
+        }
+        sink = edited.size();
+    })};
+    const double rope_substr{seconds_per_call([&] {
+        sink = document.substr(document_size / 3, 1 << 20).size();
+    })};
+    const double std_substr{seconds_per_call([&] {
+        sink = text.substr(document_size / 3, 1 << 20).size();
+    })};
+    std::vector<char> out(document_size);
+    const double rope_write{seconds_per_call([&] {
+        document.copy(out.data());
+        sink = static_cast<size_t>(out[document_size / 2]);
+    })};
+    const double std_write{seconds_per_call([&] {
+        std::memcpy(out.data(), text.data(), text.size());
+        sink = static_cast<size_t>(out[document_size / 2]);
+    })};
+    const double rope_flatten{seconds_per_call([&] {
+        shiv::Rope copy{document};
+        sink = copy.flatten().size();
+    })};
+
+    const auto row{[](const std::string& name, double rope, double std, size_t count) {
+        const double scale{1e9 / static_cast<double>(count)};
+        std::cout << name << "\t" << rope * scale << "\t" << std * scale << "\t" << std / rope
+                  << "x\n";
+    }};
+    std::cout << "operation\trope ns\tstd ns\tspeedup\n";
+    row("append", rope_build, std_build, piece_count);
+    row("insert", rope_insert, std_insert, edit_count);
+    row("erase", rope_erase, std_erase, edit_count);
+    row("substr", rope_substr, std_substr, 1);
+    row("write", rope_write, std_write, 1);
+    std::cout << "flatten\t" << rope_flatten * 1e9 << "\t-\t-\n";
+    return 0;
+}
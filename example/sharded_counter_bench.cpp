@@ -0,0 +1,57 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <ShivLib/multithreading/sharded_counter.hpp>
+
+// Every thread hammers the same counter, compares a single shared atomic with the sharded
+// counters at 1 to 64 threads.
+
+template <typename Increment>
+double run(int threads, long iterations, Increment&& increment) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers{};
+    for (int t{0}; t < threads; ++t) {
+        workers.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (long i{0}; i < iterations; ++i) {
+                increment();
+            }
+        });
+    }
+    auto start{std::chrono::steady_clock::now()};
+    go.store(true, std::memory_order_release);
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    auto end{std::chrono::steady_clock::now()};
+    auto ns{std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()};
+    return static_cast<double>(ns) / (static_cast<double>(threads) * iterations);
+}
+
+int main(int argc, char** argv) {
+    const long iterations{argc > 1 ? std::atol(argv[1]) : 10'000'000};
+
+    std::cout << "threads\tatomic ns/op\tper-thread ns/op\tper-cpu ns/op\n";
+    for (int threads{1}; threads <= 64; threads *= 2) {
+        alignas(shiv::cache_line_size) std::atomic<long> shared{0};
+        shiv::ShardedCounter<shiv::ShardBy::thread> per_thread{};
+        shiv::ShardedCounter<shiv::ShardBy::cpu> per_cpu{};
+
+        const double atomic_ns{
+            run(threads, iterations, [&] { shared.fetch_add(1, std::memory_order_relaxed); })};
+        const double thread_ns{run(threads, iterations, [&] { per_thread.increment(); })};
+        const double cpu_ns{run(threads, iterations, [&] { per_cpu.increment(); })};
+
+        if (shared.load() != per_thread.value() || shared.load() != per_cpu.value()) {
+            std::cerr << "count mismatch\n";
+            return 1;
+        }
+        std::cout << threads << "\t" << atomic_ns << "\t" << thread_ns << "\t" << cpu_ns << "\n";
+    }
+    return 0;
+}
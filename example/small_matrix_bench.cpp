@@ -0,0 +1,117 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ShivLib/dataStructures/matrix.hpp>
+
+// 2x2, 3x3 and 4x4 float and double matrices, each operation run over a batch of 1024 random
+// matrices with the closed form and SIMD kernels Matrix now dispatches to, and with the generic
+// paths every other size takes: the dot product loop, LU inverse and determinant and the tiled
+// transpose. Each repeats until roughly a tenth of a second has passed, reported in nanoseconds
+// per matrix.
+
+constexpr size_t batch{1024};
+
+template <typename Func>
+double ns_per_matrix(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{100});
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           static_cast<double>(iterations * batch);
+}
+
+template <typename T, size_t n>
+shiv::Matrix<T, n, n> generic_multiply(const shiv::Matrix<T, n, n>& lhs,
+                                       const shiv::Matrix<T, n, n>& rhs) {
+    shiv::Matrix<T, n, n> result{};
+    for (size_t i{0}; i < n; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            T sum{};
+            for (size_t k{0}; k < n; ++k) {
+                sum += lhs[i][k] * rhs[k][j];
+            }
+            result[i][j] = sum;
+        }
+    }
+    return result;
+}
+
+template <typename T, size_t n>
+shiv::Matrix<T, n, n> generic_transpose(const shiv::Matrix<T, n, n>& matrix) {
+    shiv::Matrix<T, n, n> result{};
+    shiv::detail::transpose(matrix, result, n, n);
+    return result;
+}
+
+template <typename T, size_t n, typename Generic, typename Special>
+void compare(const std::string& type, const std::string& operation,
+             const std::vector<shiv::Matrix<T, n, n>>& inputs, Generic&& generic,
+             Special&& special) {
+    using Result = decltype(special(inputs[0], inputs[0]));
+    std::vector<Result> generic_out(batch);
+    std::vector<Result> special_out(batch);
+    const double generic_ns{ns_per_matrix([&] {
+        for (size_t i{0}; i < batch; ++i) {
+            generic_out[i] = generic(inputs[i], inputs[batch - 1 - i]);
+        }
+    })};
+    const double special_ns{ns_per_matrix([&] {
+        for (size_t i{0}; i < batch; ++i) {
+            special_out[i] = special(inputs[i], inputs[batch - 1 - i]);
+        }
+    })};
+    std::cout << type << "\t" << n << "x" << n << "\t" << operation << "\t" << generic_ns << "\t"
+              << special_ns << "\t" << generic_ns / special_ns << "x\n";
+}
+
+template <typename T, size_t n>
+void run(const std::string& type) {
+    using matrix = shiv::Matrix<T, n, n>;
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<T> distribution{-2, 2};
+    std::vector<matrix> inputs(batch);
+    for (auto&& input : inputs) {
+        for (auto&& value : input) {
+            value = distribution(generator);
+        }
+    }
+    compare<T, n>(
+        type, "multiply", inputs, [](const matrix& a, const matrix& b) {
+            return generic_multiply(a, b);
+        },
+        [](const matrix& a, const matrix& b) { return a * b; });
+    compare<T, n>(
+        type, "inverse", inputs, [](const matrix& a, const matrix&) {
+            return shiv::LU{a}.inverse();
+        },
+        [](const matrix& a, const matrix&) { return a.get_inverse(); });
+    compare<T, n>(
+        type, "determinant", inputs, [](const matrix& a, const matrix&) {
+            return shiv::LU{a}.determinant();
+        },
+        [](const matrix& a, const matrix&) { return a.get_determinant(); });
+    compare<T, n>(
+        type, "transpose", inputs, [](const matrix& a, const matrix&) {
+            return generic_transpose(a);
+        },
+        [](const matrix& a, const matrix&) { return a.get_transpose(); });
+}
+
+int main() {
+    std::cout << "type\tsize\toperation\tgeneric ns\tspecialised ns\tspeedup\n";
+    run<float, 2>("float");
+    run<float, 3>("float");
+    run<float, 4>("float");
+    run<double, 2>("double");
+    run<double, 3>("double");
+    run<double, 4>("double");
+    return 0;
+}
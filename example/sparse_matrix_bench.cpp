@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <ShivLib/dataStructures/sparse_matrix.hpp>
+
+// Square power-law matrices, like a graph adjacency matrix: row lengths follow a Pareto
+// distribution with exponent 2.1 and columns are drawn towards the low indices, so a few hubs
+// hold most of the nonzeros. The first table is y = A * x, a plain CSR loop against the gather
+// kernel on one thread and on every thread, or on the count given as the first argument, for
+// each value and index width, with memory and effective bandwidth over the matrix, x and y.
+// The second is a product with a dense n x 8 matrix, the third building, converting and
+// transposing. Each measurement repeats until roughly a quarter of a second has passed.
+
+constexpr size_t size{1 << 19};
+constexpr double mean_degree{16};
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+template <typename T, typename Index>
+shiv::CooMatrix<T, Index> power_law(std::mt19937& generator) {
+    constexpr double alpha{2.1};
+    // a Pareto with this minimum has mean_degree as its mean
+    constexpr double minimum{mean_degree * (alpha - 2) / (alpha - 1)};
+    std::uniform_real_distribution<double> uniform{0, 1};
+    shiv::CooMatrix<T, Index> coo{size, size, static_cast<size_t>(size * mean_degree * 1.5)};
+    for (size_t row{0}; row < size; ++row) {
+        const double degree{minimum * std::pow(1 - uniform(generator), -1 / (alpha - 1))};
+        const size_t count{std::min(static_cast<size_t>(degree) + 1, size / 4)};
+        for (size_t k{0}; k < count; ++k) {
+            const auto col{static_cast<size_t>(static_cast<double>(size) *
+                                               std::pow(uniform(generator), 3.0))};
+            coo.add(row, std::min(col, size - 1), static_cast<T>(uniform(generator)));
+        }
+    }
+    return coo;
+}
+
+template <typename T, typename Index>
+void naive_multiply(const shiv::CsrMatrix<T, Index>& matrix, const T* x, T* y) {
+    for (size_t i{0}; i < matrix.rows(); ++i) {
+        T sum{};
+        for (size_t k{matrix.offsets()[i]}; k < matrix.offsets()[i + 1]; ++k) {
+            sum += matrix.values()[k] * x[matrix.indices()[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+template <typename T, typename Index>
+void spmv(const std::string& type, size_t threads, std::mt19937& generator) {
+    const shiv::CsrMatrix<T, Index> csr{power_law<T, Index>(generator)};
+    const auto csc{csr.to_csc()};
+    shiv::Vector<T> x(size);
+    std::uniform_real_distribution<T> uniform{-1, 1};
+    for (size_t i{0}; i < size; ++i) {
+        x.push_back(uniform(generator));
+    }
+    shiv::Vector<T> y{shiv::detail::filled_vector(size, T{})};
+    shiv::Vector<T> expected{shiv::detail::filled_vector(size, T{})};
+    const double naive_time{
+        seconds_per_call([&] { naive_multiply(csr, x.begin(), expected.begin()); })};
+    shiv::set_matrix_threads(1);
+    const double one_time{seconds_per_call([&] { csr.multiply(x.begin(), y.begin()); })};
+    shiv::set_matrix_threads(threads);
+    const double all_time{seconds_per_call([&] { csr.multiply(x.begin(), y.begin()); })};
+    double error{0};
+    for (size_t i{0}; i < size; ++i) {
+        error = std::max(error, static_cast<double>(std::abs(y[i] - expected[i])));
+    }
+    const double csc_time{seconds_per_call([&] { csc.multiply(x.begin(), y.begin()); })};
+    const double bytes{static_cast<double>(csr.storage_bytes() + 2 * size * sizeof(T))};
+    std::cout << type << "\t" << sizeof(Index) * 8 << "\t" << csr.nonzeros() << "\t"
+              << static_cast<double>(csr.storage_bytes()) / 1e6 << "\t" << naive_time * 1e3
+              << "\t" << one_time * 1e3 << "\t" << all_time * 1e3 << "\t" << csc_time * 1e3
+              << "\t" << naive_time / all_time << "x\t" << bytes / all_time / 1e9 << "\t"
+              << error << "\n";
+}
+
+void sparse_dense(std::mt19937& generator) {
+    const shiv::CsrMatrix<double> csr{power_law<double, uint32_t>(generator)};
+    constexpr size_t cols{8};
+    shiv::DynMatrix<double> rhs{size, cols, 1.0};
+    shiv::DynMatrix<double> result{};
+    const double naive_time{seconds_per_call([&] {
+        result = shiv::DynMatrix<double>{size, cols};
+        for (size_t i{0}; i < size; ++i) {
+            for (size_t k{csr.offsets()[i]}; k < csr.offsets()[i + 1]; ++k) {
+                for (size_t j{0}; j < cols; ++j) {
+                    result[i][j] += csr.values()[k] * rhs[csr.indices()[k]][j];
+                }
+            }
+        }
+    })};
+    const double time{seconds_per_call([&] { result = csr * rhs; })};
+    std::cout << "double\t" << cols << "\t" << naive_time * 1e3 << "\t" << time * 1e3 << "\t"
+              << naive_time / time << "x\n";
+}
+
+void build(std::mt19937& generator) {
+    const auto coo{power_law<double, uint32_t>(generator)};
+    shiv::CsrMatrix<double> csr{};
+    shiv::CscMatrix<double> csc{};
+    const double build_time{seconds_per_call([&] { csr = shiv::CsrMatrix<double>{coo}; })};
+    const double convert_time{seconds_per_call([&] { csc = csr.to_csc(); })};
+    const double transpose_time{seconds_per_call([&] { csr = csr.get_transpose(); })};
+    std::cout << coo.size() << "\t" << build_time * 1e3 << "\t" << convert_time * 1e3 << "\t"
+              << transpose_time * 1e3 << "\n";
+}
+
+int main(int argc, char** argv) {
+    const size_t threads{argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                                  : std::thread::hardware_concurrency()};
+    std::mt19937 generator{42};
+    shiv::set_matrix_threads(threads);
+    std::cout << "n = " << size << ", threads = " << shiv::matrix_threads() << "\n\n";
+    std::cout << "type\tindex bits\tnonzeros\tMB\tnaive ms\tcsr 1 thread ms\tcsr ms\tcsc ms"
+                 "\tspeedup\tGB/s\tmax error\n";
+    spmv<float, uint32_t>("float", threads, generator);
+    spmv<double, uint32_t>("double", threads, generator);
+    spmv<double, uint64_t>("double", threads, generator);
+    std::cout << "\ntype\tdense cols\tnaive ms\tcsr * dense ms\tspeedup\n";
+    sparse_dense(generator);
+    std::cout << "\ncoo entries\tbuild csr ms\tto csc ms\ttranspose ms\n";
+    build(generator);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ShivLib/dataStructures/split.hpp>
+
+// Splitting 16MB of log lines into fields, in GB/s of text, shiv::split against a loop of
+// std::string_view find calls, the usual allocation free way, and for a single character
+// against collecting each line's fields into a std::vector<std::string>. Fields are 1 to 15
+// characters, the delimiters are a comma, ", " and any of ",;|". Each timing repeats until
+// roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+// keeps the results alive so they are not optimised away
+volatile size_t sink{0};
+
+template <typename Shiv, typename Std>
+void row(const std::string& name, size_t bytes, Shiv&& shiv_split, Std&& std_split) {
+    const double shiv_time{seconds_per_call([&] { sink = shiv_split(); })};
+    const double std_time{seconds_per_call([&] { sink = std_split(); })};
+    const double gigabytes{static_cast<double>(bytes) / 1e9};
+    std::cout << name << "\t" << gigabytes / shiv_time << "\t" << gigabytes / std_time << "\t"
+              << std_time / shiv_time << "x\n";
+}
+
+// the text with every comma replaced by each delimiter in turn
+std::string with_delimiters(const std::string& text, const std::vector<std::string>& delimiters) {
+    std::string result{};
+    size_t next{0};
+    for (const char c : text) {
+        if (c == ',') {
+            result += delimiters[next++ % delimiters.size()];
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+int main() {
+    constexpr size_t size{16 << 20};
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+    std::uniform_int_distribution<size_t> field_length{1, 15};
+    std::string text{};
+    while (text.size() < size) {
+        const size_t length{field_length(generator)};
+        for (size_t i{0}; i < length; ++i) {
+            text += static_cast<char>(letter(generator));
+        }
+        text += ',';
+    }
+    const std::string spaced{with_delimiters(text, {", "})};
+    const std::string mixed{with_delimiters(text, {",", ";", "|"})};
+
+    std::cout << "delimiter\tshiv GB/s\tstd GB/s\tspeedup\n";
+    row("char", text.size(),
+        [&] {
+            size_t total{0};
+            for (const auto field : shiv::split(text, ',')) {
+                total += field.size();
+            }
+            return total;
+        },
+        [&] {
+            const std::string_view view{text};
+            size_t total{0};
+            for (size_t begin{0}; begin < view.size();) {
+                const size_t end{std::min(view.find(',', begin), view.size())};
+                total += end - begin;
+                begin = end + 1;
+            }
+            return total;
+        });
+    row("char vector", text.size(),
+        [&] {
+            size_t total{0};
+            for (const auto field : shiv::split(text, ',')) {
+                total += field.size();
+            }
+            return total;
+        },
+        [&] {
+            // a line of 8 fields at a time, as a log parser keeping each line's fields would
+            const std::string_view view{text};
+            std::vector<std::string> fields{};
+            size_t total{0};
+            for (size_t begin{0}; begin < view.size();) {
+                const size_t end{std::min(view.find(',', begin), view.size())};
+                fields.emplace_back(view.substr(begin, end - begin));
+                if (fields.size() == 8) {
+                    total += fields.back().size();
+                    fields = {};
+                }
+                begin = end + 1;
+            }
+            return total;
+        });
+    row("string", spaced.size(),
+        [&] {
+            size_t total{0};
+            for (const auto field : shiv::split(spaced, ", ")) {
+                total += field.size();
+            }
+            return total;
+        },
+        [&] {
+            const std::string_view view{spaced};
+            size_t total{0};
+            for (size_t begin{0}; begin < view.size();) {
+                const size_t end{std::min(view.find(", ", begin), view.size())};
+                total += end - begin;
+                begin = end + 2;
+            }
+            return total;
+        });
+    const shiv::CharSet delimiters{",;|"};
+    row("set", mixed.size(),
+        [&] {
+            size_t total{0};
+            for (const auto field : shiv::split(mixed, delimiters)) {
+                total += field.size();
+            }
+            return total;
+        },
+        [&] {
+            const std::string_view view{mixed};
+            size_t total{0};
+            for (size_t begin{0}; begin < view.size();) {
+                const size_t end{std::min(view.find_first_of(",;|", begin), view.size())};
+                total += end - begin;
+                begin = end + 1;
+            }
+            return total;
+        });
+    return 0;
+}
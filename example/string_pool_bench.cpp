@@ -0,0 +1,136 @@
+#include <chrono>
+#include <iostream>
+#include <malloc.h>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <ShivLib/dataStructures/string_pool.hpp>
+
+// shiv::StringPool against a std::unordered_set<std::string> holding 300k distinct symbols of
+// 6 to 24 characters. The table is nanoseconds per string to intern every symbol into an empty
+// container, to look up 1M symbols that are already there, and to compare 1M pairs for equality,
+// as Symbols and as std::strings, and the bytes the heap gained for the container as reported by
+// mallinfo2. Each timing repeats until roughly a quarter of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+// keeps the results alive so they are not optimised away
+volatile size_t sink{0};
+
+size_t heap_in_use() {
+    return mallinfo2().uordblks;
+}
+
+int main() {
+    constexpr size_t unique_count{300'000};
+    constexpr size_t lookup_count{1'000'000};
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> letter{'A', 'Z'};
+    std::uniform_int_distribution<size_t> length{6, 24};
+    std::unordered_set<std::string> seen{};
+    std::vector<std::string> keys{};
+    while (keys.size() < unique_count) {
+        std::string key(length(generator), ' ');
+        for (auto& c : key) {
+            c = static_cast<char>(letter(generator));
+        }
+        if (seen.insert(key).second) {
+            keys.push_back(std::move(key));
+        }
+    }
+    seen.clear();
+    std::uniform_int_distribution<size_t> pick{0, unique_count - 1};
+    std::vector<size_t> lookups(lookup_count);
+    for (auto& lookup : lookups) {
+        lookup = pick(generator);
+    }
+
+    const double pool_build{seconds_per_call([&] {
+        shiv::StringPool pool{};
+        for (const auto& key : keys) {
+            sink = pool.intern(shiv::StringView<char>{key}).id();
+        }
+    })};
+    const double std_build{seconds_per_call([&] {
+        std::unordered_set<std::string> set{};
+        for (const auto& key : keys) {
+            sink = set.insert(key).second;
+        }
+    })};
+
+    size_t before{heap_in_use()};
+    shiv::StringPool pool{};
+    std::vector<shiv::Symbol> symbols{};
+    for (const auto& key : keys) {
+        symbols.push_back(pool.intern(shiv::StringView<char>{key}));
+    }
+    const size_t pool_bytes{heap_in_use() - before - symbols.capacity() * sizeof(shiv::Symbol)};
+    before = heap_in_use();
+    std::unordered_set<std::string> set{};
+    for (const auto& key : keys) {
+        set.insert(key);
+    }
+    const size_t std_bytes{heap_in_use() - before};
+
+    const double pool_lookup{seconds_per_call([&] {
+        size_t total{0};
+        for (const size_t index : lookups) {
+            total += pool.intern(shiv::StringView<char>{keys[index]}).id();
+        }
+        sink = total;
+    })};
+    const double std_lookup{seconds_per_call([&] {
+        size_t total{0};
+        for (const size_t index : lookups) {
+            total += set.find(keys[index])->size();
+        }
+        sink = total;
+    })};
+    // neighbouring lookups compared, equal about one time in three
+    for (size_t i{1}; i < lookups.size(); i += 3) {
+        lookups[i] = lookups[i - 1];
+    }
+    std::vector<std::string> copies{};
+    for (const auto& key : keys) {
+        copies.push_back(key);
+    }
+    const double pool_compare{seconds_per_call([&] {
+        size_t equal{0};
+        for (size_t i{1}; i < lookups.size(); ++i) {
+            equal += symbols[lookups[i]] == symbols[lookups[i - 1]] ? 1 : 0;
+        }
+        sink = equal;
+    })};
+    const double std_compare{seconds_per_call([&] {
+        size_t equal{0};
+        for (size_t i{1}; i < lookups.size(); ++i) {
+            equal += keys[lookups[i]] == copies[lookups[i - 1]] ? 1 : 0;
+        }
+        sink = equal;
+    })};
+
+    const auto per_string{[](double seconds, size_t count) {
+        return seconds / static_cast<double>(count) * 1e9;
+    }};
+    std::cout << "container\tintern ns\tlookup ns\tcompare ns\tbytes\n";
+    std::cout << "pool\t" << per_string(pool_build, unique_count) << "\t"
+              << per_string(pool_lookup, lookup_count) << "\t"
+              << per_string(pool_compare, lookup_count) << "\t" << pool_bytes << "\n";
+    std::cout << "std\t" << per_string(std_build, unique_count) << "\t"
+              << per_string(std_lookup, lookup_count) << "\t"
+              << per_string(std_compare, lookup_count) << "\t" << std_bytes << "\n";
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <ShivLib/dataStructures/string_view.hpp>
+
+// Searches of a megabyte of random lowercase text, in GB/s of text scanned, shiv::StringView
+// against std::string_view. Each search is set up to scan the whole text: the character or
+// needle sits at the far end and needles start with a character the text does not hold, the
+// best case for std, apart from find(common) whose needle starts and ends with a common letter.
+// The character set only matches the final byte. find_first_of is given a CharSet built once,
+// std::string_view the same characters as a string. Each timing repeats until roughly a quarter
+// of a second has passed.
+
+template <typename Func>
+double seconds_per_call(Func&& func) {
+    size_t iterations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    auto end{start};
+    do {
+        func();
+        ++iterations;
+        end = std::chrono::steady_clock::now();
+    } while (end - start < std::chrono::milliseconds{250});
+    return std::chrono::duration<double>(end - start).count() / static_cast<double>(iterations);
+}
+
+// keeps the result of a search alive so it is not optimised away
+volatile size_t sink{0};
+
+template <typename Shiv, typename Std>
+void row(const std::string& name, size_t bytes, Shiv&& shiv_search, Std&& std_search) {
+    const double shiv_time{seconds_per_call([&] { sink = shiv_search(); })};
+    const double std_time{seconds_per_call([&] { sink = std_search(); })};
+    const double gigabytes{static_cast<double>(bytes) / 1e9};
+    std::cout << name << "\t" << gigabytes / shiv_time << "\t" << gigabytes / std_time << "\t"
+              << std_time / shiv_time << "x\n";
+}
+
+int main() {
+    constexpr size_t size{1 << 20};
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution{'a', 'z'};
+    std::string text(size, ' ');
+    for (auto& c : text) {
+        c = static_cast<char>(distribution(generator));
+    }
+    const std::string needle_16{"0123456789ABCDEF"};
+    const std::string needle_64{needle_16 + needle_16 + needle_16 + needle_16};
+    // a needle whose first and last characters are common in the text, where std's search
+    // stops at every occurrence of the first
+    const std::string common{"e" + needle_16 + "e"};
+    std::string tail{text};
+    tail.replace(size - needle_64.size(), needle_64.size(), needle_64);
+    tail.replace(size - needle_64.size() - common.size(), common.size(), common);
+    std::string head{text};
+    head.replace(0, needle_64.size(), needle_64);
+    // only the last byte is a delimiter or anything other than a letter
+    std::string fields{text};
+    fields.back() = ',';
+
+    const shiv::StringView<char> shiv_tail{tail};
+    const std::string_view std_tail{tail};
+    const shiv::StringView<char> shiv_head{head};
+    const std::string_view std_head{head};
+    const shiv::StringView<char> shiv_fields{fields};
+    const std::string_view std_fields{fields};
+    const shiv::StringView<char> shiv_copy{text};
+    const std::string copy{text};
+    const std::string_view std_copy{copy};
+
+    std::cout << "search\tshiv GB/s\tstd GB/s\tspeedup\n";
+    row("find(char)", size, [&] { return shiv_tail.find('0'); },
+        [&] { return std_tail.find('0'); });
+    row("rfind(char)", size, [&] { return shiv_head.rfind('0'); },
+        [&] { return std_head.rfind('0'); });
+    for (const size_t length : {size_t{4}, size_t{16}, size_t{64}}) {
+        const std::string needle{needle_64.substr(needle_64.size() - length)};
+        row("find(" + std::to_string(length) + ")", size,
+            [&] { return shiv_tail.find(shiv::StringView<char>{needle}); },
+            [&] { return std_tail.find(needle); });
+        const std::string prefix{needle_64.substr(0, length)};
+        row("rfind(" + std::to_string(length) + ")", size,
+            [&] { return shiv_head.rfind(shiv::StringView<char>{prefix}); },
+            [&] { return std_head.rfind(prefix); });
+    }
+    row("find(common)", size, [&] { return shiv_tail.find(shiv::StringView<char>{common}); },
+        [&] { return std_tail.find(common); });
+    const shiv::CharSet delimiters{",;|\n"};
+    row("find_first_of", size, [&] { return shiv_fields.find_first_of(delimiters); },
+        [&] { return std_fields.find_first_of(",;|\n"); });
+    const shiv::CharSet letters{"abcdefghijklmnopqrstuvwxyz"};
+    row("find_first_not_of", size, [&] { return shiv_fields.find_first_not_of(letters); },
+        [&] { return std_fields.find_first_not_of("abcdefghijklmnopqrstuvwxyz"); });
+    row("operator==", size, [&] { return static_cast<size_t>(shiv_copy == copy); },
+        [&] { return static_cast<size_t>(std_copy == text); });
+    row("compare", size, [&] { return static_cast<size_t>(shiv_copy.compare(copy)); },
+        [&] { return static_cast<size_t>(std_copy.compare(text)); });
+    return 0;
+}
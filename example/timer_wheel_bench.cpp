@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include <ShivLib/dataStructures/timer_wheel.hpp>
+
+// 1M live session timeouts. Every tick a batch of sessions sees traffic and pushes its timeout
+// back, which is a cancel and reschedule. The priority queue can not cancel, so like most
+// hand rolled versions it tags entries with a generation and skips stale ones when they pop.
+
+struct Session : shiv::TimerNode {
+    uint32_t generation{0};
+    uint64_t expiry{0};
+};
+
+struct Entry {
+    uint64_t expiry;
+    uint32_t generation;
+    uint32_t session;
+    bool operator>(const Entry& other) const {
+        return expiry > other.expiry;
+    }
+};
+
+int main(int argc, char** argv) {
+    const size_t timers{argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000};
+    const size_t touches_per_tick{argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000};
+    const uint64_t ticks{10'000};
+    const uint64_t timeout{4'000};
+
+    std::vector<Session> sessions(timers);
+    std::mt19937_64 rng{1};
+    // each touch pushes a session's deadline between timeout / 2 and timeout ticks out
+    std::vector<uint32_t> touches(ticks * touches_per_tick);
+    std::vector<uint32_t> delays(ticks * touches_per_tick);
+    for (size_t i{0}; i < touches.size(); ++i) {
+        touches[i] = static_cast<uint32_t>(rng() % timers);
+        delays[i] = static_cast<uint32_t>(timeout / 2 + rng() % (timeout / 2));
+    }
+
+    size_t wheel_fired{0};
+    auto start{std::chrono::steady_clock::now()};
+    {
+        shiv::TimerWheel wheel{};
+        rng.seed(2);
+        for (auto&& session : sessions) {
+            session.callback = [](shiv::TimerNode&) {};
+            wheel.schedule(session, rng() % (timeout * 4));
+        }
+        for (uint64_t tick{0}; tick < ticks; ++tick) {
+            for (size_t i{0}; i < touches_per_tick; ++i) {
+                const size_t touch{tick * touches_per_tick + i};
+                wheel.schedule(sessions[touches[touch]], tick + delays[touch]);
+            }
+            wheel_fired += wheel.advance_to(tick);
+        }
+        wheel.clear();
+    }
+    auto end{std::chrono::steady_clock::now()};
+    auto wheel_ns{std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()};
+
+    rng.seed(2);
+    size_t heap_fired{0};
+    start = std::chrono::steady_clock::now();
+    {
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap{};
+        for (uint32_t i{0}; i < timers; ++i) {
+            sessions[i].expiry = rng() % (timeout * 4);
+            heap.push({sessions[i].expiry, sessions[i].generation, i});
+        }
+        for (uint64_t tick{0}; tick < ticks; ++tick) {
+            for (size_t i{0}; i < touches_per_tick; ++i) {
+                const size_t touch{tick * touches_per_tick + i};
+                const uint32_t index{touches[touch]};
+                auto& session{sessions[index]};
+                session.expiry = tick + delays[touch];
+                heap.push({session.expiry, ++session.generation, index});
+            }
+            while (!heap.empty() && heap.top().expiry <= tick) {
+                if (heap.top().generation == sessions[heap.top().session].generation) {
+                    ++heap_fired;
+                }
+                heap.pop();
+            }
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    auto heap_ns{std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()};
+
+    const double operations{static_cast<double>(ticks * touches_per_tick)};
+    std::cout << "live timers: " << timers << ", reschedules per tick: " << touches_per_tick
+              << "\n";
+    std::cout << "timer wheel:    " << wheel_ns / operations << " ns/reschedule, fired "
+              << wheel_fired << "\n";
+    std::cout << "priority queue: " << heap_ns / operations << " ns/reschedule, fired "
+              << heap_fired << "\n";
+    return 0;
+}
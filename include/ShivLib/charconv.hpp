@@ -0,0 +1,503 @@
+#ifndef SHIVLIB_CHARCONV_HPP
+#define SHIVLIB_CHARCONV_HPP
+
+#include "charconv_tables.hpp"
+#include "concepts.hpp"
+#include "cstddef.hpp"
+#include "dataStructures/string_view.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+// Number parsing from a StringView, in the manner of std::from_chars: no leading whitespace or
+// plus sign, decimal only, and the result says how much of the text was the number. Digits are
+// taken 8 at a time as a SWAR word whose bytes are checked and combined in three multiplies, and
+// the last few are found and parsed in one more word, so a short field costs no loop over its
+// characters. Floating point text of up to 19 significant digits is converted with
+// Clinger's exact fast path when the digits and power of ten fit a double, otherwise with the
+// Eisel-Lemire algorithm on a 128 bit power of five, which is always correctly rounded for
+// them. Longer mantissas, rare outside of test suites, go to std::from_chars.
+
+namespace shiv {
+/// How a parse went. consumed is the length of the number read from the start of the text, 0
+/// along with invalid_argument if there was none. result_out_of_range means the text was a
+/// number but its value does not fit, and consumed covers it all.
+struct FromCharsResult {
+    size_t consumed;
+    std::errc error;
+
+    [[nodiscard]] constexpr explicit operator bool() const noexcept {
+        return error == std::errc{};
+    }
+    [[nodiscard]] friend constexpr bool operator==(const FromCharsResult& lhs,
+                                                   const FromCharsResult& rhs) noexcept = default;
+};
+
+namespace detail {
+[[nodiscard]] constexpr bool is_digit(char c) noexcept {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// eight characters as a little endian word, only read when there are eight to read
+[[nodiscard]] inline uint64_t read_eight(const char* text) noexcept {
+    uint64_t word;
+    std::memcpy(&word, text, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+        word = __builtin_bswap64(word);
+    }
+    return word;
+}
+[[nodiscard]] constexpr bool is_eight_digits(uint64_t word) noexcept {
+    // a byte under '0' borrows into its top bit, one over '9' carries into it
+    const uint64_t out_of_range{(word + 0x4646464646464646) | (word - 0x3030303030303030)};
+    return (out_of_range & 0x8080808080808080) == 0;
+}
+/// the value of eight digit characters, the first the most significant
+[[nodiscard]] constexpr uint32_t parse_eight_digits(uint64_t word) noexcept {
+    constexpr uint64_t mask{0x000000FF000000FF};
+    constexpr uint64_t mul1{100 + (uint64_t{1000000} << 32)};
+    constexpr uint64_t mul2{1 + (uint64_t{10000} << 32)};
+    word -= 0x3030303030303030;
+    // pairs of digits, then fours, then the eight
+    word = word * 10 + (word >> 8);
+    return static_cast<uint32_t>(((word & mask) * mul1 + ((word >> 16) & mask) * mul2) >> 32);
+}
+
+// 10^0 to 10^19, all that fit in 64 bits
+inline constexpr std::array<uint64_t, 20> powers_of_ten{[] {
+    std::array<uint64_t, 20> powers{};
+    uint64_t power{1};
+    for (auto& entry : powers) {
+        entry = power;
+        power *= 10;
+    }
+    return powers;
+}()};
+
+// Up to eight characters as a little endian word, zero past the end of the text. Four or more
+// are two overlapping four byte loads and fewer are single bytes, so the only branch is on
+// which of those it is.
+[[nodiscard]] inline uint64_t read_up_to_eight(const char* text, size_t size) noexcept {
+    if (size >= 8) {
+        return read_eight(text);
+    }
+    uint64_t word{0};
+    if (size >= 4) {
+        uint32_t low;
+        uint32_t high;
+        std::memcpy(&low, text, sizeof(low));
+        std::memcpy(&high, text + size - 4, sizeof(high));
+        word = uint64_t{low} | uint64_t{high} << (8 * (size - 4));
+    } else if (size > 0) {
+        word = uint64_t{static_cast<unsigned char>(text[0])} |
+               uint64_t{static_cast<unsigned char>(text[size / 2])} << (8 * (size / 2)) |
+               uint64_t{static_cast<unsigned char>(text[size - 1])} << (8 * (size - 1));
+    }
+    if constexpr (std::endian::native == std::endian::big) {
+        word = __builtin_bswap64(word) >> (8 * (8 - std::min<size_t>(size, 8)));
+    }
+    return word;
+}
+
+/// Reads the digits at cursor into value, wrapping rather than overflowing, and returns how
+/// many there were. Whole words of eight digits are taken first, then the digits left, fewer
+/// than eight, are found in one more word by the lowest byte that is not a digit, moved to the
+/// top of it over a run of '0's, and parsed as eight.
+constexpr size_t parse_digits(const char*& cursor, const char* end, uint64_t& value) noexcept {
+    const char* const begin{cursor};
+    if (std::is_constant_evaluated()) {
+        while (cursor != end && is_digit(*cursor)) {
+            value = value * 10 + static_cast<uint64_t>(*cursor - '0');
+            ++cursor;
+        }
+        return static_cast<size_t>(cursor - begin);
+    }
+    uint64_t word{0};
+    while (true) {
+        word = read_up_to_eight(cursor, static_cast<size_t>(end - cursor));
+        if (end - cursor < 8 || !is_eight_digits(word)) {
+            break;
+        }
+        value = value * 100000000 + parse_eight_digits(word);
+        cursor += 8;
+    }
+    // bytes below the first that is not a digit neither borrow nor carry, so it is found exactly
+    const uint64_t not_digits{((word + 0x4646464646464646) | (word - 0x3030303030303030)) &
+                              0x8080808080808080};
+    const auto count{static_cast<size_t>(std::countr_zero(not_digits | 0x8000000000000000) / 8)};
+    if (count > 0) {
+        const size_t padding{8 * (8 - count)};
+        word = word << padding | 0x3030303030303030 >> (64 - padding);
+        value = value * powers_of_ten[count] + parse_eight_digits(word);
+        cursor += count;
+    }
+    return static_cast<size_t>(cursor - begin);
+}
+
+/// Reads an unsigned decimal integer at cursor into magnitude, returning false if it does not
+/// fit in 64 bits. Leading zeros are skipped, then 20 digits only fit when they start with a 1
+/// and did not wrap below 10^19.
+constexpr bool parse_magnitude(const char*& cursor, const char* end,
+                               uint64_t& magnitude) noexcept {
+    while (cursor != end && *cursor == '0') {
+        ++cursor;
+    }
+    const char* const significant{cursor};
+    const size_t digit_count{parse_digits(cursor, end, magnitude)};
+    return digit_count < 20 ||
+           (digit_count == 20 && *significant == '1' && magnitude >= powers_of_ten[19]);
+}
+
+/// value as T, negated if need be, or false if it does not fit
+template <Integral T>
+[[nodiscard]] constexpr bool to_integer(uint64_t magnitude, bool negative, T& value) noexcept {
+    using Unsigned = std::make_unsigned_t<T>;
+    const auto max{static_cast<uint64_t>(std::numeric_limits<T>::max())};
+    if (magnitude > max + (negative ? 1 : 0)) {
+        return false;
+    }
+    value = static_cast<T>(negative ? Unsigned(0) - static_cast<Unsigned>(magnitude)
+                                    : static_cast<Unsigned>(magnitude));
+    return true;
+}
+
+[[nodiscard]] constexpr bool starts_with_ignoring_case(const char* text, const char* end,
+                                                       const char* lower) noexcept {
+    for (; *lower != '\0'; ++text, ++lower) {
+        if (text == end || (*text | 0x20) != *lower) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+struct BinaryFormat;
+template <>
+struct BinaryFormat<double> {
+    using bits_type = uint64_t;
+    static constexpr int mantissa_bits{52};
+    static constexpr int minimum_exponent{-1023};
+    static constexpr int infinite_power{0x7FF};
+    static constexpr int smallest_power_of_ten{-342};
+    static constexpr int largest_power_of_ten{308};
+    static constexpr int min_exponent_round_to_even{-4};
+    static constexpr int max_exponent_round_to_even{23};
+    static constexpr int max_exact_power{22};
+    static constexpr double exact_powers[max_exact_power + 1]{
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+template <>
+struct BinaryFormat<float> {
+    using bits_type = uint32_t;
+    static constexpr int mantissa_bits{23};
+    static constexpr int minimum_exponent{-127};
+    static constexpr int infinite_power{0xFF};
+    static constexpr int smallest_power_of_ten{-65};
+    static constexpr int largest_power_of_ten{38};
+    static constexpr int min_exponent_round_to_even{-17};
+    static constexpr int max_exponent_round_to_even{10};
+    static constexpr int max_exact_power{10};
+    static constexpr float exact_powers[max_exact_power + 1]{1e0F, 1e1F, 1e2F, 1e3F, 1e4F, 1e5F,
+                                                              1e6F, 1e7F, 1e8F, 1e9F, 1e10F};
+};
+
+/// A binary floating point value as its biased exponent and mantissa without the implicit bit.
+struct AdjustedMantissa {
+    uint64_t mantissa;
+    int power2;
+};
+
+/// Eisel-Lemire: the correctly rounded binary value of digits * 10^power, digits nonzero and
+/// exact. The digits are multiplied by the truncated 128 bit 5^power, only reading the second
+/// word of it when the bits below the mantissa are all ones and a carry from it could matter.
+/// Noble Mushtak and Daniel Lemire showed that product is always enough for 19 digits.
+template <typename T>
+[[nodiscard]] constexpr AdjustedMantissa eisel_lemire(int64_t power, uint64_t digits) noexcept {
+    using Format = BinaryFormat<T>;
+    if (power < Format::smallest_power_of_ten) {
+        return {0, 0};
+    }
+    if (power > Format::largest_power_of_ten) {
+        return {0, Format::infinite_power};
+    }
+    const int leading_zeros{std::countl_zero(digits)};
+    digits <<= leading_zeros;
+
+    __extension__ using uint128 = unsigned __int128;
+    const size_t index{2 * static_cast<size_t>(power - smallest_power_of_five)};
+    const uint128 product{static_cast<uint128>(digits) * power_of_five_128[index]};
+    uint64_t low{static_cast<uint64_t>(product)};
+    uint64_t high{static_cast<uint64_t>(product >> 64)};
+    constexpr uint64_t precision_mask{~uint64_t{0} >> (Format::mantissa_bits + 3)};
+    if ((high & precision_mask) == precision_mask) {
+        const auto second{static_cast<uint64_t>(
+            (static_cast<uint128>(digits) * power_of_five_128[index + 1]) >> 64)};
+        low += second;
+        if (second > low) {
+            ++high;
+        }
+    }
+
+    const int upper_bit{static_cast<int>(high >> 63)};
+    const int shift{upper_bit + 64 - Format::mantissa_bits - 3};
+    AdjustedMantissa answer{high >> shift, 0};
+    // floor(log2(10^power)) + 63, exact over the table's range
+    const auto power_of_two{static_cast<int>(((152170 + 65536) * power) >> 16) + 63};
+    answer.power2 = power_of_two + upper_bit - leading_zeros - Format::minimum_exponent;
+    if (answer.power2 <= 0) {
+        // subnormal, or rounding up to the smallest normal
+        if (-answer.power2 + 1 >= 64) {
+            return {0, 0};
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < (uint64_t{1} << Format::mantissa_bits) ? 0 : 1;
+        return answer;
+    }
+    // exactly halfway between two values is only possible for small powers, where 5^power is
+    // exact in the table, and then rounds to even rather than up
+    if (low <= 1 && power >= Format::min_exponent_round_to_even &&
+        power <= Format::max_exponent_round_to_even && (answer.mantissa & 3) == 1 &&
+        answer.mantissa << shift == high) {
+        answer.mantissa &= ~uint64_t{1};
+    }
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= uint64_t{2} << Format::mantissa_bits) {
+        answer.mantissa = uint64_t{1} << Format::mantissa_bits;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(uint64_t{1} << Format::mantissa_bits);
+    if (answer.power2 >= Format::infinite_power) {
+        return {0, Format::infinite_power};
+    }
+    return answer;
+}
+
+template <typename T>
+[[nodiscard]] constexpr T to_float(bool negative, AdjustedMantissa value) noexcept {
+    using Format = BinaryFormat<T>;
+    using Bits = typename Format::bits_type;
+    Bits bits{static_cast<Bits>(value.mantissa | uint64_t(value.power2) << Format::mantissa_bits)};
+    if (negative) {
+        bits |= Bits{1} << (sizeof(Bits) * 8 - 1);
+    }
+    return std::bit_cast<T>(bits);
+}
+
+// inf, infinity, nan and nan(chars) in any case, after the sign
+template <typename T>
+[[nodiscard]] constexpr size_t parse_special(const char* begin, const char* end, bool negative,
+                                             T& value) noexcept {
+    if (starts_with_ignoring_case(begin, end, "inf")) {
+        value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return starts_with_ignoring_case(begin, end, "infinity") ? 8 : 3;
+    }
+    if (starts_with_ignoring_case(begin, end, "nan")) {
+        value = negative ? -std::numeric_limits<T>::quiet_NaN()
+                         : std::numeric_limits<T>::quiet_NaN();
+        const char* cursor{begin + 3};
+        if (cursor != end && *cursor == '(') {
+            const char* close{cursor + 1};
+            while (close != end && (is_digit(*close) || *close == '_' ||
+                                    static_cast<unsigned char>((*close | 0x20) - 'a') < 26)) {
+                ++close;
+            }
+            if (close != end && *close == ')') {
+                cursor = close + 1;
+            }
+        }
+        return static_cast<size_t>(cursor - begin);
+    }
+    return 0;
+}
+
+template <typename T>
+[[nodiscard]] FromCharsResult parse_float(StringView<char> text, T& value) noexcept {
+    using Format = BinaryFormat<T>;
+    const char* const begin{text.data()};
+    const char* const end{begin + text.size()};
+    const char* cursor{begin};
+    const bool negative{cursor != end && *cursor == '-'};
+    cursor += negative ? 1 : 0;
+    if (cursor != end && !is_digit(*cursor) && *cursor != '.') {
+        const size_t special{parse_special(cursor, end, negative, value)};
+        if (special == 0) {
+            return {0, std::errc::invalid_argument};
+        }
+        return {static_cast<size_t>(cursor - begin) + special, std::errc{}};
+    }
+
+    const char* const digits_begin{cursor};
+    uint64_t digits{0};
+    size_t digit_count{parse_digits(cursor, end, digits)};
+    int64_t power{0};
+    if (cursor != end && *cursor == '.') {
+        ++cursor;
+        const size_t fraction{parse_digits(cursor, end, digits)};
+        digit_count += fraction;
+        power = -static_cast<int64_t>(fraction);
+    }
+    if (digit_count == 0) {
+        return {0, std::errc::invalid_argument};
+    }
+    if (cursor != end && (*cursor | 0x20) == 'e') {
+        // an exponent without digits is not part of the number
+        const char* exponent_cursor{cursor + 1};
+        const bool negative_exponent{exponent_cursor != end && *exponent_cursor == '-'};
+        if (exponent_cursor != end && (*exponent_cursor == '-' || *exponent_cursor == '+')) {
+            ++exponent_cursor;
+        }
+        int64_t exponent{0};
+        const char* exponent_digits{exponent_cursor};
+        while (exponent_cursor != end && is_digit(*exponent_cursor)) {
+            // past any representable power it only needs to stay large
+            if (exponent < 0x10000000) {
+                exponent = exponent * 10 + (*exponent_cursor - '0');
+            }
+            ++exponent_cursor;
+        }
+        if (exponent_cursor != exponent_digits) {
+            power += negative_exponent ? -exponent : exponent;
+            cursor = exponent_cursor;
+        }
+    }
+    const auto consumed{static_cast<size_t>(cursor - begin)};
+
+    if (digit_count > 19) {
+        // leading zeros are not significant, past them more than 19 digits need the exact
+        // arbitrary precision conversion
+        for (const char* lead{digits_begin}; lead != cursor && (*lead == '0' || *lead == '.');
+             ++lead) {
+            digit_count -= *lead == '0' ? 1 : 0;
+        }
+        if (digit_count > 19) {
+            T result{};
+            const auto [ptr, error]{std::from_chars(begin, cursor, result)};
+            if (error == std::errc{}) {
+                value = result;
+            }
+            return {static_cast<size_t>(ptr - begin), error};
+        }
+    }
+
+    if (power >= -Format::max_exact_power && power <= Format::max_exact_power &&
+        digits <= uint64_t{1} << (Format::mantissa_bits + 1)) {
+        // both the digits and the power of ten are exact, so one rounding gives the answer
+        T result{static_cast<T>(digits)};
+        if (power < 0) {
+            result /= Format::exact_powers[-power];
+        } else {
+            result *= Format::exact_powers[power];
+        }
+        value = negative ? -result : result;
+        return {consumed, std::errc{}};
+    }
+    if (digits == 0) {
+        value = negative ? -T{0} : T{0};
+        return {consumed, std::errc{}};
+    }
+    const AdjustedMantissa result{eisel_lemire<T>(power, digits)};
+    if (result.power2 == Format::infinite_power || (result.mantissa == 0 && result.power2 == 0)) {
+        return {consumed, std::errc::result_out_of_range};
+    }
+    value = to_float<T>(negative, result);
+    return {consumed, std::errc{}};
+}
+} // namespace detail
+
+/// Parses a decimal integer, with a leading minus for signed types.
+template <Integral T>
+constexpr FromCharsResult from_chars(StringView<char> text, T& value) noexcept {
+    const char* const begin{text.data()};
+    const char* const end{begin + text.size()};
+    const char* cursor{begin};
+    bool negative{false};
+    if constexpr (std::is_signed_v<T>) {
+        negative = cursor != end && *cursor == '-';
+        cursor += negative ? 1 : 0;
+    }
+    const char* const digits_begin{cursor};
+    uint64_t magnitude{0};
+    const bool fits{detail::parse_magnitude(cursor, end, magnitude)};
+    if (cursor == digits_begin) {
+        return {0, std::errc::invalid_argument};
+    }
+    const auto consumed{static_cast<size_t>(cursor - begin)};
+    if (!fits || !detail::to_integer(magnitude, negative, value)) {
+        return {consumed, std::errc::result_out_of_range};
+    }
+    return {consumed, std::errc{}};
+}
+
+/// Parses decimal floating point text, fixed or scientific, and inf or nan, correctly rounded.
+inline FromCharsResult from_chars(StringView<char> text, double& value) noexcept {
+    return detail::parse_float(text, value);
+}
+inline FromCharsResult from_chars(StringView<char> text, float& value) noexcept {
+    return detail::parse_float(text, value);
+}
+
+/// Parses a decimal such as a price, "123.45", into an integer count of 10^-decimals units, so
+/// with 4 decimals it gives 1234500, with no rounding anywhere. Fraction digits past decimals
+/// are read but must be zeros, as anything else cannot be held exactly and gives
+/// result_out_of_range. There is no exponent. decimals is at most 19.
+template <Integral T>
+constexpr FromCharsResult from_chars_fixed(StringView<char> text, T& value,
+                                           unsigned decimals) noexcept {
+    assert(decimals < 20 && "Too many decimals for 64 bits");
+    const char* const begin{text.data()};
+    const char* const end{begin + text.size()};
+    const char* cursor{begin};
+    bool negative{false};
+    if constexpr (std::is_signed_v<T>) {
+        negative = cursor != end && *cursor == '-';
+        cursor += negative ? 1 : 0;
+    }
+    const char* const digits_begin{cursor};
+    uint64_t integer{0};
+    bool fits{detail::parse_magnitude(cursor, end, integer)};
+    bool has_digits{cursor != digits_begin};
+
+    uint64_t fraction{0};
+    if (cursor != end && *cursor == '.') {
+        ++cursor;
+        const char* const fraction_begin{cursor};
+        // the digits decimals holds, then any more, which must be zeros
+        const char* const held_end{
+            static_cast<size_t>(end - cursor) > decimals ? cursor + decimals : end};
+        const size_t held{detail::parse_digits(cursor, held_end, fraction)};
+        fraction *= detail::powers_of_ten[decimals - held];
+        if (held == decimals) {
+            while (cursor != end && detail::is_digit(*cursor)) {
+                fits = fits && *cursor == '0';
+                ++cursor;
+            }
+        }
+        has_digits = has_digits || cursor != fraction_begin;
+    }
+    if (!has_digits) {
+        return {0, std::errc::invalid_argument};
+    }
+    const auto consumed{static_cast<size_t>(cursor - begin)};
+    uint64_t magnitude{0};
+    if (!fits || __builtin_mul_overflow(integer, detail::powers_of_ten[decimals], &magnitude) ||
+        __builtin_add_overflow(magnitude, fraction, &magnitude) ||
+        !detail::to_integer(magnitude, negative, value)) {
+        return {consumed, std::errc::result_out_of_range};
+    }
+    return {consumed, std::errc{}};
+}
+} // namespace shiv
+
+#endif //SHIVLIB_CHARCONV_HPP
@@ -0,0 +1,161 @@
+#ifndef SHIVLIB_DATASTRUCTURE_CHOLESKY_HPP
+#define SHIVLIB_DATASTRUCTURE_CHOLESKY_HPP
+
+#include "../concepts.hpp"
+#include "lu.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace shiv {
+/// Cholesky factorization A = L * L^T of a symmetric positive definite matrix, half the work of
+/// LU and stable without pivoting. Only the lower triangle of A is read. Works on Matrix,
+/// including at compile time, on DynMatrix and in place on a MatrixView. Like LU, panels of
+/// columns are factored one at a time and the lower triangle of the rest of the matrix is
+/// updated through the blocked gemm kernel.
+template <typename M>
+requires(shiv::FloatingPoint<detail::matrix_element_t<M>> &&
+         !detail::is_half_precision_v<detail::matrix_element_t<M>>)
+class Cholesky {
+  public:
+    using value_type = detail::matrix_element_t<M>;
+    using matrix_type = M;
+
+  private:
+    using T = value_type;
+    using traits = detail::lu_traits<M>;
+
+    M m_factor{};
+    size_t m_size{0};
+    bool m_positive_definite{true};
+
+    // columns [first, last) of L, rows first onwards, false if a pivot is not positive. The
+    // diagonal block is factored right looking, copying each new column of L into the row
+    // above the diagonal as it goes, then the rows below solve against it a row at a time,
+    // L21 = A21 * L11^-T, so each row stays in cache for the whole panel.
+    constexpr bool factor_panel(size_t first, size_t last) {
+        T reciprocals[detail::lu_block_size]{};
+        for (size_t j{first}; j < last; ++j) {
+            const T diagonal{m_factor[j][j]};
+            // written this way round so a nan fails too
+            if (!(diagonal > T{})) {
+                return false;
+            }
+            const T root{detail::constexpr_sqrt(diagonal)};
+            m_factor[j][j] = root;
+            reciprocals[j - first] = T{1} / root;
+            for (size_t i{j + 1}; i < last; ++i) {
+                m_factor[i][j] *= reciprocals[j - first];
+                const T scalar{m_factor[i][j]};
+                m_factor[j][i] = scalar;
+                for (size_t col{j + 1}; col <= i; ++col) {
+                    m_factor[i][col] -= scalar * m_factor[j][col];
+                }
+            }
+        }
+        for (size_t i{last}; i < m_size; ++i) {
+            for (size_t j{first}; j < last; ++j) {
+                m_factor[i][j] *= reciprocals[j - first];
+                const T scalar{m_factor[i][j]};
+                for (size_t col{j + 1}; col < last; ++col) {
+                    m_factor[i][col] -= scalar * m_factor[j][col];
+                }
+            }
+        }
+        return true;
+    }
+
+    constexpr void factor() {
+        for (size_t first{0}; first < m_size; first += detail::lu_block_size) {
+            const size_t last{shiv::min(first + detail::lu_block_size, m_size)};
+            if (!factor_panel(first, last)) {
+                m_positive_definite = false;
+                return;
+            }
+            // the rest of L^T goes above the diagonal, the trailing update and back substitution
+            // read it
+            for (size_t j{last}; j < m_size; ++j) {
+                for (size_t i{first}; i < last; ++i) {
+                    m_factor[i][j] = m_factor[j][i];
+                }
+            }
+            // A22 -= L21 * L21^T, a block of columns at a time from the diagonal down so little
+            // of the upper triangle, which is never read, is computed
+            constexpr size_t width{detail::lu_block_size * 4};
+            for (size_t col{last}; col < m_size; col += width) {
+                detail::subtract_product(m_factor, col, first, m_factor, first, col, m_factor,
+                                         col, col, m_size - col,
+                                         shiv::min(width, m_size - col), last - first);
+            }
+        }
+    }
+
+  public:
+    /// throws std::invalid_argument if a runtime sized matrix is not square
+    explicit constexpr Cholesky(const M& matrix)
+    : m_factor{matrix}
+    , m_size{traits::rows(matrix)} {
+        if constexpr (detail::is_matrix_v<M>) {
+            static_assert(M::row_count == M::col_count, "Must be a square matrix");
+        } else {
+            if (traits::rows(matrix) != traits::cols(matrix)) {
+                throw std::invalid_argument{"Must be a square matrix"};
+            }
+        }
+        factor();
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return m_size;
+    }
+    /// false if a pivot came out zero, negative or nan, solve and inverse will throw
+    [[nodiscard]] constexpr bool is_positive_definite() const noexcept {
+        return m_positive_definite;
+    }
+    /// L on and below the diagonal and L^T above it
+    [[nodiscard]] constexpr const M& packed() const noexcept {
+        return m_factor;
+    }
+
+    [[nodiscard]] constexpr T determinant() const noexcept {
+        T result{1};
+        for (size_t i{0}; i < m_size; ++i) {
+            result *= m_factor[i][i];
+        }
+        return result * result;
+    }
+
+    /// overwrites every column of rhs with the solution x of A * x = rhs
+    template <typename B>
+    constexpr void solve_in_place(B& rhs) const {
+        static_assert(std::is_same_v<detail::matrix_element_t<B>, T>,
+                      "Right hand side must have the same element type");
+        using rhs_traits = detail::lu_traits<std::remove_const_t<B>>;
+        if (rhs_traits::rows(rhs) != m_size) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        if (!m_positive_definite) {
+            throw std::domain_error{"Matrix is not positive definite"};
+        }
+        const size_t cols{rhs_traits::cols(rhs)};
+        detail::forward_substitute<false>(m_factor, m_size, rhs, cols);
+        detail::back_substitute(m_factor, m_size, rhs, cols);
+    }
+    /// the solution x of A * x = rhs, rhs may have any number of columns
+    template <typename B>
+    [[nodiscard]] constexpr B solve(B rhs) const {
+        solve_in_place(rhs);
+        return rhs;
+    }
+    [[nodiscard]] constexpr M inverse() const {
+        M result{traits::make(m_size, m_size)};
+        for (size_t i{0}; i < m_size; ++i) {
+            result[i][i] = T{1};
+        }
+        solve_in_place(result);
+        return result;
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_CHOLESKY_HPP
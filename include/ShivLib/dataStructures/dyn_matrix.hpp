@@ -0,0 +1,386 @@
+#ifndef SHIVLIB_DATASTRUCTURE_DYN_MATRIX_HPP
+#define SHIVLIB_DATASTRUCTURE_DYN_MATRIX_HPP
+
+#include "../concepts.hpp"
+#include "../float16.hpp"
+#include "../memory.hpp"
+#include "gemm.hpp"
+#include "lu.hpp"
+#include "matrix.hpp"
+#include "matrix_kernels.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace shiv {
+/// Runtime sized matrix on the heap. Rows are stored contiguously, each one padded out to a whole
+/// number of cache lines so every row starts 64 byte aligned, stride() is the distance between
+/// rows in elements. Moves only hand the buffer over.
+template <shiv::Arithmetic T>
+class DynMatrix {
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using allocator_type = AlignedAllocator<T>;
+
+  private:
+    static constexpr size_t row_alignment{shiv::max(cache_line_size / sizeof(T), size_t{1})};
+
+    size_t m_rows{0};
+    size_t m_cols{0};
+    size_t m_stride{0};
+    T* m_data{nullptr};
+    [[no_unique_address]] allocator_type m_allocator{};
+
+    [[nodiscard]] static constexpr size_t padded(size_t cols) noexcept {
+        return (cols + row_alignment - 1) / row_alignment * row_alignment;
+    }
+
+    // padding is zeroed along with everything else so kernels may read whole cache lines
+    void allocate(size_t rows, size_t cols) {
+        m_rows = rows;
+        m_cols = cols;
+        m_stride = padded(cols);
+        const size_t count{rows * m_stride};
+        if (count != 0) {
+            m_data = m_allocator.allocate(count);
+            std::fill(m_data, m_data + count, T{});
+        }
+    }
+    void release() noexcept {
+        if (m_data != nullptr) {
+            m_allocator.deallocate(m_data, m_rows * m_stride);
+            m_data = nullptr;
+        }
+    }
+
+    void check_same_shape(const DynMatrix& other) const {
+        if (m_rows != other.m_rows || m_cols != other.m_cols) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+    }
+    void check_square() const {
+        if (m_rows != m_cols) {
+            throw std::invalid_argument{"Must be a square matrix"};
+        }
+    }
+
+    template <typename Func>
+    [[nodiscard]] DynMatrix transform(Func&& func) const {
+        DynMatrix result_matrix{m_rows, m_cols};
+        for (size_t i{0}; i < m_rows; ++i) {
+            const T* row{(*this)[i]};
+            T* result_row{result_matrix[i]};
+            for (size_t j{0}; j < m_cols; ++j) {
+                result_row[j] = func(row[j]);
+            }
+        }
+        return result_matrix;
+    }
+    template <typename Func>
+    [[nodiscard]] DynMatrix transform(const DynMatrix& other, Func&& func) const {
+        check_same_shape(other);
+        DynMatrix result_matrix{m_rows, m_cols};
+        for (size_t i{0}; i < m_rows; ++i) {
+            const T* lhs_row{(*this)[i]};
+            const T* rhs_row{other[i]};
+            T* result_row{result_matrix[i]};
+            for (size_t j{0}; j < m_cols; ++j) {
+                result_row[j] = func(lhs_row[j], rhs_row[j]);
+            }
+        }
+        return result_matrix;
+    }
+
+  public:
+    DynMatrix() = default;
+    /// zero initialised
+    DynMatrix(size_t rows, size_t cols) {
+        allocate(rows, cols);
+    }
+    DynMatrix(size_t rows, size_t cols, const T& value) {
+        allocate(rows, cols);
+        fill(value);
+    }
+    /// one inner list per row, every row must be the same length
+    DynMatrix(std::initializer_list<std::initializer_list<T>> values) {
+        allocate(values.size(), values.size() == 0 ? 0 : values.begin()->size());
+        for (size_t i{0}; auto&& row : values) {
+            if (row.size() != m_cols) {
+                release();
+                throw std::invalid_argument{"Matrix rows must all be the same length"};
+            }
+            std::copy(row.begin(), row.end(), (*this)[i++]);
+        }
+    }
+    template <size_t rows, size_t cols>
+    explicit DynMatrix(const Matrix<T, rows, cols>& matrix) {
+        allocate(rows, cols);
+        for (size_t i{0}; i < rows; ++i) {
+            std::copy(matrix[i].begin(), matrix[i].end(), (*this)[i]);
+        }
+    }
+
+    DynMatrix(const DynMatrix& other) {
+        allocate(other.m_rows, other.m_cols);
+        std::copy(other.m_data, other.m_data + m_rows * m_stride, m_data);
+    }
+    DynMatrix& operator=(const DynMatrix& other) {
+        if (this != &other) {
+            DynMatrix copy{other};
+            swap(copy);
+        }
+        return *this;
+    }
+    DynMatrix(DynMatrix&& other) noexcept
+    : m_rows{std::exchange(other.m_rows, 0)}
+    , m_cols{std::exchange(other.m_cols, 0)}
+    , m_stride{std::exchange(other.m_stride, 0)}
+    , m_data{std::exchange(other.m_data, nullptr)} {
+    }
+    DynMatrix& operator=(DynMatrix&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_rows = std::exchange(other.m_rows, 0);
+            m_cols = std::exchange(other.m_cols, 0);
+            m_stride = std::exchange(other.m_stride, 0);
+            m_data = std::exchange(other.m_data, nullptr);
+        }
+        return *this;
+    }
+    ~DynMatrix() {
+        release();
+    }
+
+    [[nodiscard]] static DynMatrix identity(size_t size) {
+        DynMatrix identity_matrix{size, size};
+        for (size_t i{0}; i < size; ++i) {
+            identity_matrix[i][i] = 1;
+        }
+        return identity_matrix;
+    }
+
+    [[nodiscard]] size_t rows() const noexcept {
+        return m_rows;
+    }
+    [[nodiscard]] size_t cols() const noexcept {
+        return m_cols;
+    }
+    /// elements from the start of one row to the start of the next
+    [[nodiscard]] size_t stride() const noexcept {
+        return m_stride;
+    }
+    [[nodiscard]] size_t size() const noexcept {
+        return m_rows * m_cols;
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    void fill(const T& value) {
+        for (size_t i{0}; i < m_rows; ++i) {
+            std::fill((*this)[i], (*this)[i] + m_cols, value);
+        }
+    }
+    void swap(DynMatrix& other) noexcept {
+        std::swap(m_rows, other.m_rows);
+        std::swap(m_cols, other.m_cols);
+        std::swap(m_stride, other.m_stride);
+        std::swap(m_data, other.m_data);
+    }
+
+    [[nodiscard]] DynMatrix get_augment(const DynMatrix& other) const {
+        if (m_rows != other.m_rows) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        DynMatrix result_matrix{m_rows, m_cols + other.m_cols};
+        for (size_t i{0}; i < m_rows; ++i) {
+            std::copy((*this)[i], (*this)[i] + m_cols, result_matrix[i]);
+            std::copy(other[i], other[i] + other.m_cols, result_matrix[i] + m_cols);
+        }
+        return result_matrix;
+    }
+    /// 16 bit matrices are factored in float
+    [[nodiscard]] T get_determinant() const {
+        check_square();
+        if constexpr (detail::is_half_precision_v<T>) {
+            return T{cast<float>().get_determinant()};
+        } else if constexpr (shiv::FloatingPoint<T>) {
+            return LU{*this}.determinant();
+        }
+        DynMatrix scratch{*this};
+        return detail::determinant(scratch, m_rows);
+    }
+    [[nodiscard]] DynMatrix get_identity() const {
+        check_square();
+        return identity(m_rows);
+    }
+    /// throws std::domain_error for a singular floating point matrix
+    [[nodiscard]] DynMatrix get_inverse() const {
+        check_square();
+        if constexpr (detail::is_half_precision_v<T>) {
+            return cast<float>().get_inverse().template cast<T>();
+        } else if constexpr (shiv::FloatingPoint<T>) {
+            return LU{*this}.inverse();
+        }
+        DynMatrix work{*this};
+        DynMatrix inverted_matrix{m_rows, m_cols};
+        detail::invert(work, inverted_matrix, m_rows);
+        return inverted_matrix;
+    }
+    /// element wise static_cast, float16 and bfloat16 to and from float convert in bulk
+    template <shiv::Arithmetic U>
+    [[nodiscard]] DynMatrix<U> cast() const {
+        DynMatrix<U> result_matrix{m_rows, m_cols};
+        for (size_t i{0}; i < m_rows; ++i) {
+            if constexpr (requires(const T* source, U* target) {
+                              shiv::convert(source, target, size_t{});
+                          }) {
+                shiv::convert((*this)[i], result_matrix[i], m_cols);
+            } else {
+                std::transform((*this)[i], (*this)[i] + m_cols, result_matrix[i],
+                               [](const T& value) { return static_cast<U>(value); });
+            }
+        }
+        return result_matrix;
+    }
+    [[nodiscard]] std::tuple<DynMatrix, bool> get_row_echelon() const {
+        DynMatrix result_matrix{*this};
+        const bool is_inverted{detail::row_echelon(result_matrix, m_rows, m_cols)};
+        return std::make_tuple(std::move(result_matrix), is_inverted);
+    }
+    [[nodiscard]] DynMatrix get_transpose() const {
+        DynMatrix transposed_matrix{m_cols, m_rows};
+        detail::transpose(*this, transposed_matrix, m_rows, m_cols);
+        return transposed_matrix;
+    }
+    [[nodiscard]] bool is_orthogonal() const {
+        return get_transpose() == get_inverse();
+    }
+
+    // Arithmetic operators
+    [[nodiscard]] friend DynMatrix operator+(const DynMatrix& lhs, const DynMatrix& rhs) {
+        return lhs.transform(rhs, [](const T& a, const T& b) { return a + b; });
+    }
+    [[nodiscard]] DynMatrix operator+(const T& scalar) const {
+        return transform([&scalar](const T& value) { return value + scalar; });
+    }
+    [[nodiscard]] friend DynMatrix operator-(const DynMatrix& lhs, const DynMatrix& rhs) {
+        return lhs.transform(rhs, [](const T& a, const T& b) { return a - b; });
+    }
+    [[nodiscard]] DynMatrix operator-(const T& scalar) const {
+        return transform([&scalar](const T& value) { return value - scalar; });
+    }
+    /// shares the blocked kernel with Matrix for floating point types
+    [[nodiscard]] friend DynMatrix operator*(const DynMatrix& lhs, const DynMatrix& rhs) {
+        if (lhs.m_cols != rhs.m_rows) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        DynMatrix result_matrix{lhs.m_rows, rhs.m_cols};
+        if constexpr (shiv::FloatingPoint<T>) {
+            shiv::gemm(lhs.m_rows, rhs.m_cols, lhs.m_cols, T{1}, lhs.m_data,
+                       static_cast<ptrdiff_t>(lhs.m_stride), 1, rhs.m_data,
+                       static_cast<ptrdiff_t>(rhs.m_stride), 1, T{}, result_matrix.m_data,
+                       static_cast<ptrdiff_t>(result_matrix.m_stride), 1);
+        } else {
+            for (size_t i{0}; i < lhs.m_rows; ++i) {
+                T* result_row{result_matrix[i]};
+                for (size_t k{0}; k < lhs.m_cols; ++k) {
+                    const T scalar{lhs[i][k]};
+                    const T* rhs_row{rhs[k]};
+                    for (size_t j{0}; j < rhs.m_cols; ++j) {
+                        result_row[j] += scalar * rhs_row[j];
+                    }
+                }
+            }
+        }
+        return result_matrix;
+    }
+    [[nodiscard]] DynMatrix operator*(const T& scalar) const {
+        return transform([&scalar](const T& value) { return value * scalar; });
+    }
+    [[nodiscard]] friend DynMatrix operator/(const DynMatrix& lhs, const DynMatrix& rhs) {
+        return lhs * rhs.get_inverse();
+    }
+    [[nodiscard]] DynMatrix operator/(const T& scalar) const {
+        return transform([&scalar](const T& value) { return value / scalar; });
+    }
+    [[nodiscard]] DynMatrix operator-() const {
+        return transform([](const T& value) { return -value; });
+    }
+
+    // Arithmetic assignment operators
+    DynMatrix& operator+=(const DynMatrix& other) {
+        return *this = *this + other;
+    }
+    DynMatrix& operator+=(const T& scalar) {
+        return *this = *this + scalar;
+    }
+    DynMatrix& operator-=(const DynMatrix& other) {
+        return *this = *this - other;
+    }
+    DynMatrix& operator-=(const T& scalar) {
+        return *this = *this - scalar;
+    }
+    DynMatrix& operator*=(const DynMatrix& other) {
+        return *this = *this * other;
+    }
+    DynMatrix& operator*=(const T& scalar) {
+        return *this = *this * scalar;
+    }
+    DynMatrix& operator/=(const DynMatrix& other) {
+        return *this = *this / other;
+    }
+    DynMatrix& operator/=(const T& scalar) {
+        return *this = *this / scalar;
+    }
+
+    // Element access
+    /// pointer to the start of a row, so matrix[i][j] works as it does for Matrix
+    [[nodiscard]] T* operator[](size_t row) noexcept {
+        return m_data + row * m_stride;
+    }
+    [[nodiscard]] const T* operator[](size_t row) const noexcept {
+        return m_data + row * m_stride;
+    }
+    [[nodiscard]] reference at(size_t row_index, size_t col_index) {
+        if (row_index >= m_rows || col_index >= m_cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return (*this)[row_index][col_index];
+    }
+    [[nodiscard]] const_reference at(size_t row_index, size_t col_index) const {
+        if (row_index >= m_rows || col_index >= m_cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return (*this)[row_index][col_index];
+    }
+    [[nodiscard]] T* data() noexcept {
+        return m_data;
+    }
+    [[nodiscard]] const T* data() const noexcept {
+        return m_data;
+    }
+
+    // Comparison
+    [[nodiscard]] friend bool operator==(const DynMatrix& lhs, const DynMatrix& rhs) noexcept {
+        if (lhs.m_rows != rhs.m_rows || lhs.m_cols != rhs.m_cols) {
+            return false;
+        }
+        for (size_t i{0}; i < lhs.m_rows; ++i) {
+            if (!std::equal(lhs[i], lhs[i] + lhs.m_cols, rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    [[nodiscard]] friend bool operator!=(const DynMatrix& lhs, const DynMatrix& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_DYN_MATRIX_HPP
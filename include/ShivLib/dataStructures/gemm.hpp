@@ -0,0 +1,902 @@
+#ifndef SHIVLIB_DATASTRUCTURE_GEMM_HPP
+#define SHIVLIB_DATASTRUCTURE_GEMM_HPP
+
+#include "../float16.hpp"
+#include "../memory.hpp"
+#include "../multithreading/thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace shiv {
+namespace detail {
+/// One SIMD register's worth of T. The primary template is the portable scalar fallback, the
+/// micro-kernel is written against this so every instruction set shares it.
+template <typename T>
+struct SimdVec {
+    using reg = T;
+    static constexpr size_t width{1};
+    static constexpr size_t register_count{16};
+
+    static reg zero() noexcept {
+        return T{};
+    }
+    static reg load(const T* ptr) noexcept {
+        return *ptr;
+    }
+    static void store(T* ptr, reg value) noexcept {
+        *ptr = value;
+    }
+    static reg broadcast(T value) noexcept {
+        return value;
+    }
+    /// a * b + c
+    static reg fmadd(reg a, reg b, reg c) noexcept {
+        return a * b + c;
+    }
+};
+
+#if defined(__AVX512F__)
+template <>
+struct SimdVec<float> {
+    using reg = __m512;
+    static constexpr size_t width{16};
+    static constexpr size_t register_count{32};
+
+    static reg zero() noexcept {
+        return _mm512_setzero_ps();
+    }
+    static reg load(const float* ptr) noexcept {
+        return _mm512_loadu_ps(ptr);
+    }
+    static void store(float* ptr, reg value) noexcept {
+        _mm512_storeu_ps(ptr, value);
+    }
+    static reg broadcast(float value) noexcept {
+        return _mm512_set1_ps(value);
+    }
+    static reg fmadd(reg a, reg b, reg c) noexcept {
+        return _mm512_fmadd_ps(a, b, c);
+    }
+};
+template <>
+struct SimdVec<double> {
+    using reg = __m512d;
+    static constexpr size_t width{8};
+    static constexpr size_t register_count{32};
+
+    static reg zero() noexcept {
+        return _mm512_setzero_pd();
+    }
+    static reg load(const double* ptr) noexcept {
+        return _mm512_loadu_pd(ptr);
+    }
+    static void store(double* ptr, reg value) noexcept {
+        _mm512_storeu_pd(ptr, value);
+    }
+    static reg broadcast(double value) noexcept {
+        return _mm512_set1_pd(value);
+    }
+    static reg fmadd(reg a, reg b, reg c) noexcept {
+        return _mm512_fmadd_pd(a, b, c);
+    }
+};
+#elif defined(__AVX2__)
+template <>
+struct SimdVec<float> {
+    using reg = __m256;
+    static constexpr size_t width{8};
+    static constexpr size_t register_count{16};
+
+    static reg zero() noexcept {
+        return _mm256_setzero_ps();
+    }
+    static reg load(const float* ptr) noexcept {
+        return _mm256_loadu_ps(ptr);
+    }
+    static void store(float* ptr, reg value) noexcept {
+        _mm256_storeu_ps(ptr, value);
+    }
+    static reg broadcast(float value) noexcept {
+        return _mm256_set1_ps(value);
+    }
+    static reg fmadd(reg a, reg b, reg c) noexcept {
+#if defined(__FMA__)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+};
+template <>
+struct SimdVec<double> {
+    using reg = __m256d;
+    static constexpr size_t width{4};
+    static constexpr size_t register_count{16};
+
+    static reg zero() noexcept {
+        return _mm256_setzero_pd();
+    }
+    static reg load(const double* ptr) noexcept {
+        return _mm256_loadu_pd(ptr);
+    }
+    static void store(double* ptr, reg value) noexcept {
+        _mm256_storeu_pd(ptr, value);
+    }
+    static reg broadcast(double value) noexcept {
+        return _mm256_set1_pd(value);
+    }
+    static reg fmadd(reg a, reg b, reg c) noexcept {
+#if defined(__FMA__)
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+    }
+};
+#endif
+
+/// Register tile and cache block sizes. The mr x nr tile of C lives in registers for a whole
+/// kc deep pass, a kc x nr panel of B stays in L1 while mr x kc panels of A stream past it from
+/// an mc x kc block held in L2.
+template <typename T>
+struct GemmBlocking {
+    static constexpr size_t width{SimdVec<T>::width};
+    static constexpr size_t vectors{width == 1 ? 4 : 2}; // per row of the register tile
+    static constexpr size_t nr{vectors * width};
+    // leave registers for the B row and the broadcast of A
+    static constexpr size_t mr{width == 1 ? 4 : (SimdVec<T>::register_count - 4) / vectors};
+    static constexpr size_t kc{shiv::min(size_t{512}, 24 * 1024 / (nr * sizeof(T))) / 8 * 8};
+    static constexpr size_t mc{shiv::max(mr, 192 * 1024 / (kc * sizeof(T)) / mr * mr)};
+    static constexpr size_t nc{4096 / nr * nr};
+};
+
+// reused between calls so small and medium products do not pay for an allocation each time
+template <typename T, int which>
+[[nodiscard]] T* gemm_scratch(size_t count) {
+    thread_local std::vector<T, AlignedAllocator<T>> buffer{};
+    if (buffer.size() < count) {
+        buffer.resize(count);
+    }
+    return buffer.data();
+}
+
+/// copies an m x k block of A into mr row panels, column by column, scaled by alpha, padding
+/// the last panel with zeros so the kernel never needs an edge case on the inside
+template <typename T>
+void pack_a(size_t m, size_t k, T alpha, const T* a, ptrdiff_t row_stride, ptrdiff_t col_stride,
+            T* packed) noexcept {
+    constexpr size_t mr{GemmBlocking<T>::mr};
+    for (size_t i0{0}; i0 < m; i0 += mr) {
+        const size_t rows{shiv::min(mr, m - i0)};
+        const T* panel{a + static_cast<ptrdiff_t>(i0) * row_stride};
+        for (size_t p{0}; p < k; ++p) {
+            const T* column{panel + static_cast<ptrdiff_t>(p) * col_stride};
+            for (size_t i{0}; i < rows; ++i) {
+                packed[i] = alpha * column[static_cast<ptrdiff_t>(i) * row_stride];
+            }
+            for (size_t i{rows}; i < mr; ++i) {
+                packed[i] = T{};
+            }
+            packed += mr;
+        }
+    }
+}
+
+/// copies a k x n block of B into nr column panels, row by row, zero padded
+template <typename T>
+void pack_b(size_t k, size_t n, const T* b, ptrdiff_t row_stride, ptrdiff_t col_stride,
+            T* packed) noexcept {
+    constexpr size_t nr{GemmBlocking<T>::nr};
+    for (size_t j0{0}; j0 < n; j0 += nr) {
+        const size_t cols{shiv::min(nr, n - j0)};
+        const T* panel{b + static_cast<ptrdiff_t>(j0) * col_stride};
+        for (size_t p{0}; p < k; ++p) {
+            const T* row{panel + static_cast<ptrdiff_t>(p) * row_stride};
+            if (col_stride == 1) {
+                for (size_t j{0}; j < cols; ++j) {
+                    packed[j] = row[j];
+                }
+            } else {
+                for (size_t j{0}; j < cols; ++j) {
+                    packed[j] = row[static_cast<ptrdiff_t>(j) * col_stride];
+                }
+            }
+            for (size_t j{cols}; j < nr; ++j) {
+                packed[j] = T{};
+            }
+            packed += nr;
+        }
+    }
+}
+
+/// C[rows x cols] = beta * C + A_panel * B_panel, rows <= mr and cols <= nr. Beta 0 never
+/// reads C, so C may start out uninitialised.
+template <typename T>
+void micro_kernel(size_t k, const T* a, const T* b, T beta, T* c, ptrdiff_t row_stride,
+                  ptrdiff_t col_stride, size_t rows, size_t cols) noexcept {
+    using V = SimdVec<T>;
+    constexpr size_t mr{GemmBlocking<T>::mr};
+    constexpr size_t nr{GemmBlocking<T>::nr};
+    constexpr size_t vectors{GemmBlocking<T>::vectors};
+    constexpr size_t width{V::width};
+
+    typename V::reg acc[mr][vectors];
+#pragma GCC unroll 16
+    for (size_t i{0}; i < mr; ++i) {
+#pragma GCC unroll 4
+        for (size_t v{0}; v < vectors; ++v) {
+            acc[i][v] = V::zero();
+        }
+    }
+    for (size_t p{0}; p < k; ++p) {
+        typename V::reg b_row[vectors];
+#pragma GCC unroll 4
+        for (size_t v{0}; v < vectors; ++v) {
+            b_row[v] = V::load(b + v * width);
+        }
+#pragma GCC unroll 16
+        for (size_t i{0}; i < mr; ++i) {
+            const auto a_value{V::broadcast(a[i])};
+#pragma GCC unroll 4
+            for (size_t v{0}; v < vectors; ++v) {
+                acc[i][v] = V::fmadd(a_value, b_row[v], acc[i][v]);
+            }
+        }
+        a += mr;
+        b += nr;
+    }
+
+    if (rows == mr && cols == nr && col_stride == 1) {
+        const auto beta_value{V::broadcast(beta)};
+#pragma GCC unroll 16
+        for (size_t i{0}; i < mr; ++i) {
+            T* c_row{c + static_cast<ptrdiff_t>(i) * row_stride};
+#pragma GCC unroll 4
+            for (size_t v{0}; v < vectors; ++v) {
+                if (beta == T{}) {
+                    V::store(c_row + v * width, acc[i][v]);
+                } else {
+                    V::store(c_row + v * width,
+                             V::fmadd(beta_value, V::load(c_row + v * width), acc[i][v]));
+                }
+            }
+        }
+        return;
+    }
+    // edge tile or strided C, go through a buffer
+    alignas(cache_line_size) T tile[mr * nr];
+    for (size_t i{0}; i < mr; ++i) {
+        for (size_t v{0}; v < vectors; ++v) {
+            V::store(tile + i * nr + v * width, acc[i][v]);
+        }
+    }
+    for (size_t i{0}; i < rows; ++i) {
+        for (size_t j{0}; j < cols; ++j) {
+            T& out{
+                c[static_cast<ptrdiff_t>(i) * row_stride + static_cast<ptrdiff_t>(j) * col_stride]};
+            out = beta == T{} ? tile[i * nr + j] : beta * out + tile[i * nr + j];
+        }
+    }
+}
+
+template <typename T>
+void scale(size_t m, size_t n, T beta, T* c, ptrdiff_t row_stride, ptrdiff_t col_stride) noexcept {
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            T& out{
+                c[static_cast<ptrdiff_t>(i) * row_stride + static_cast<ptrdiff_t>(j) * col_stride]};
+            out = beta == T{} ? T{} : beta * out;
+        }
+    }
+}
+} // namespace detail
+
+namespace detail {
+// products with fewer multiply adds than this stay on the calling thread
+inline constexpr size_t parallel_gemm_threshold{128 * 128 * 128};
+
+struct MatrixPool {
+    std::mutex mutex{};
+    std::shared_ptr<ThreadPool> pool{std::make_shared<ThreadPool>()};
+};
+[[nodiscard]] inline MatrixPool& matrix_pool_state() {
+    static MatrixPool state{};
+    return state;
+}
+
+/// the pool large products share out over. Callers keep their copy for the whole product, so
+/// set_matrix_threads can swap the pool while products are running on the old one.
+[[nodiscard]] inline std::shared_ptr<ThreadPool> matrix_pool() {
+    auto& state{matrix_pool_state()};
+    const std::lock_guard lock{state.mutex};
+    return state.pool;
+}
+
+template <typename Func>
+void gemm_for(ThreadPool* pool, size_t count, Func&& body) {
+    if (pool != nullptr) {
+        pool->parallel_for(count, body);
+    } else {
+        for (size_t index{0}; index < count; ++index) {
+            body(index);
+        }
+    }
+}
+} // namespace detail
+
+/// Threads gemm, and the LU built on it, may use, counting the calling thread. 0 means one per
+/// hardware thread, which is also the default. Safe to call while products are running, they
+/// finish on the pool they started with and only later ones use the new one.
+inline void set_matrix_threads(size_t threads) {
+    auto pool{std::make_shared<ThreadPool>(threads == 0 ? std::thread::hardware_concurrency()
+                                                         : threads)};
+    auto& state{detail::matrix_pool_state()};
+    {
+        const std::lock_guard lock{state.mutex};
+        state.pool.swap(pool);
+    }
+    // the old pool stops here, or when the last product still using it finishes
+}
+[[nodiscard]] inline size_t matrix_threads() {
+    return detail::matrix_pool()->size();
+}
+
+/// C = alpha * A * B + beta * C, where A is m x k, B is k x n and C is m x n. Each operand is
+/// addressed by its row and column stride, so row major, column major and transposed views all
+/// go through the same kernel. C must not alias A or B. Blocked for cache and register reuse
+/// with packed panels, the inner kernel uses AVX-512 or AVX2 when compiled for them. Large
+/// products are shared out over matrix_threads(), every thread packs part of each B panel and
+/// then works through its own macro tiles of C against the shared panel.
+template <typename T>
+void gemm(size_t m, size_t n, size_t k, T alpha, const T* a, ptrdiff_t a_row_stride,
+          ptrdiff_t a_col_stride, const T* b, ptrdiff_t b_row_stride, ptrdiff_t b_col_stride,
+          T beta, T* c, ptrdiff_t c_row_stride, ptrdiff_t c_col_stride) {
+    using blocking = detail::GemmBlocking<T>;
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (k == 0 || alpha == T{}) {
+        detail::scale(m, n, beta, c, c_row_stride, c_col_stride);
+        return;
+    }
+    std::shared_ptr<ThreadPool> pool{};
+    size_t threads{1};
+    if (m * n * k >= detail::parallel_gemm_threshold) {
+        pool = detail::matrix_pool();
+        threads = pool->size();
+        if (threads == 1) {
+            pool.reset();
+        }
+    }
+    // shrink the macro tiles until there are enough of them to go round
+    const size_t per_thread{(m + threads - 1) / threads};
+    const size_t mc{shiv::min(blocking::mc,
+                              shiv::max(blocking::mr, (per_thread + blocking::mr - 1) /
+                                                          blocking::mr * blocking::mr))};
+    T* packed_b{detail::gemm_scratch<T, 1>(blocking::kc * blocking::nc)};
+
+    for (size_t jc{0}; jc < n; jc += blocking::nc) {
+        const size_t nc{shiv::min(blocking::nc, n - jc)};
+        const size_t panels{(nc + blocking::nr - 1) / blocking::nr};
+        const size_t parts{shiv::min(threads, panels)};
+        for (size_t pc{0}; pc < k; pc += blocking::kc) {
+            const size_t kc{shiv::min(blocking::kc, k - pc)};
+            detail::gemm_for(pool.get(), parts, [&](size_t part) {
+                const size_t first{part * panels / parts * blocking::nr};
+                const size_t last{shiv::min((part + 1) * panels / parts * blocking::nr, nc)};
+                detail::pack_b(kc, last - first,
+                               b + static_cast<ptrdiff_t>(pc) * b_row_stride +
+                                   static_cast<ptrdiff_t>(jc + first) * b_col_stride,
+                               b_row_stride, b_col_stride, packed_b + first * kc);
+            });
+            // only the first pass over k applies beta, later ones accumulate
+            const T pass_beta{pc == 0 ? beta : T{1}};
+
+            detail::gemm_for(pool.get(), (m + mc - 1) / mc, [&](size_t block) {
+                const size_t ic{block * mc};
+                const size_t rows{shiv::min(mc, m - ic)};
+                T* packed_a{detail::gemm_scratch<T, 0>(blocking::mc * blocking::kc)};
+                detail::pack_a(rows, kc, alpha,
+                               a + static_cast<ptrdiff_t>(ic) * a_row_stride +
+                                   static_cast<ptrdiff_t>(pc) * a_col_stride,
+                               a_row_stride, a_col_stride, packed_a);
+
+                for (size_t jr{0}; jr < nc; jr += blocking::nr) {
+                    for (size_t ir{0}; ir < rows; ir += blocking::mr) {
+                        detail::micro_kernel(
+                            kc, packed_a + ir * kc, packed_b + jr * kc, pass_beta,
+                            c + static_cast<ptrdiff_t>(ic + ir) * c_row_stride +
+                                static_cast<ptrdiff_t>(jc + jr) * c_col_stride,
+                            c_row_stride, c_col_stride, shiv::min(blocking::mr, rows - ir),
+                            shiv::min(blocking::nr, nc - jr));
+                    }
+                }
+            });
+        }
+    }
+}
+
+namespace detail {
+// an m x n block of 16 bit values, copied out as floats into rows of n
+template <typename T>
+void widen_block(size_t m, size_t n, const T* source, ptrdiff_t row_stride,
+                 ptrdiff_t col_stride, float* target) noexcept {
+    for (size_t i{0}; i < m; ++i) {
+        const T* row{source + static_cast<ptrdiff_t>(i) * row_stride};
+        if (col_stride == 1) {
+            shiv::convert(row, target + i * n, n);
+            continue;
+        }
+        for (size_t j{0}; j < n; ++j) {
+            target[i * n + j] = static_cast<float>(row[static_cast<ptrdiff_t>(j) * col_stride]);
+        }
+    }
+}
+} // namespace detail
+
+/// float16 and bfloat16 operands are widened a k slice at a time into float scratch and go
+/// through the float kernel, accumulating into a float copy of C that is rounded back once at
+/// the end, so the result carries one rounding rather than one per k step.
+template <typename T>
+requires detail::is_half_precision_v<T>
+void gemm(size_t m, size_t n, size_t k, T alpha, const T* a, ptrdiff_t a_row_stride,
+          ptrdiff_t a_col_stride, const T* b, ptrdiff_t b_row_stride, ptrdiff_t b_col_stride,
+          T beta, T* c, ptrdiff_t c_row_stride, ptrdiff_t c_col_stride) {
+    constexpr size_t depth{256};
+    if (m == 0 || n == 0) {
+        return;
+    }
+    float* accumulator{detail::gemm_scratch<float, 2>(m * n)};
+    if (beta == T{}) {
+        std::fill(accumulator, accumulator + m * n, 0.0F);
+    } else {
+        detail::widen_block(m, n, c, c_row_stride, c_col_stride, accumulator);
+        detail::scale(m, n, static_cast<float>(beta), accumulator, static_cast<ptrdiff_t>(n), 1);
+    }
+    float* wide_a{detail::gemm_scratch<float, 3>(m * shiv::min(depth, k))};
+    float* wide_b{detail::gemm_scratch<float, 4>(shiv::min(depth, k) * n)};
+    for (size_t pc{0}; pc < k; pc += depth) {
+        const size_t kc{shiv::min(depth, k - pc)};
+        detail::widen_block(m, kc, a + static_cast<ptrdiff_t>(pc) * a_col_stride, a_row_stride,
+                            a_col_stride, wide_a);
+        detail::widen_block(kc, n, b + static_cast<ptrdiff_t>(pc) * b_row_stride, b_row_stride,
+                            b_col_stride, wide_b);
+        shiv::gemm(m, n, kc, static_cast<float>(alpha), wide_a, static_cast<ptrdiff_t>(kc), 1,
+                   wide_b, static_cast<ptrdiff_t>(n), 1, 1.0F, accumulator,
+                   static_cast<ptrdiff_t>(n), 1);
+    }
+    for (size_t i{0}; i < m; ++i) {
+        T* row{c + static_cast<ptrdiff_t>(i) * c_row_stride};
+        if (c_col_stride == 1) {
+            shiv::convert(accumulator + i * n, row, n);
+            continue;
+        }
+        for (size_t j{0}; j < n; ++j) {
+            row[static_cast<ptrdiff_t>(j) * c_col_stride] = T{accumulator[i * n + j]};
+        }
+    }
+}
+namespace detail {
+template <typename T>
+inline constexpr bool is_int8_v{std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t>};
+
+/// One register of int32 accumulators for the int8 kernel, and how A and B are packed for it.
+/// With AVX-512 VNNI, vpdpbusd multiplies 4 unsigned bytes of A by 4 signed bytes of B and adds
+/// them into each lane, so k is packed in groups of 4 and the operands are offset into those
+/// ranges, see int8_offset. AVX2 widens both to int16 for vpmaddwd on pairs, which unlike
+/// vpmaddubsw cannot saturate on 255 * -128 + 255 * -128.
+struct Int8Simd {
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__)
+    using reg = __m512i;
+    using packed_a = uint8_t;
+    using packed_b = int8_t;
+    static constexpr size_t group{4};
+    static constexpr size_t width{16};
+    static constexpr size_t register_count{32};
+
+    static reg zero() noexcept {
+        return _mm512_setzero_si512();
+    }
+    static reg load(const packed_b* ptr) noexcept {
+        return _mm512_loadu_si512(ptr);
+    }
+    static reg load(const int32_t* ptr) noexcept {
+        return _mm512_loadu_si512(ptr);
+    }
+    static void store(int32_t* ptr, reg value) noexcept {
+        _mm512_storeu_si512(ptr, value);
+    }
+    static reg add(reg a, reg b) noexcept {
+        return _mm512_add_epi32(a, b);
+    }
+    /// c plus the sum of each group of a times the matching group of b
+    static reg multiply_add(reg a, reg b, reg c) noexcept {
+        return _mm512_dpbusd_epi32(c, a, b);
+    }
+    /// one group of A in every lane
+    static reg broadcast(const packed_a* ptr) noexcept {
+        int32_t bits{};
+        std::memcpy(&bits, ptr, sizeof(bits));
+        return _mm512_set1_epi32(bits);
+    }
+#elif defined(__AVX2__)
+    using reg = __m256i;
+    using packed_a = int16_t;
+    using packed_b = int16_t;
+    static constexpr size_t group{2};
+    static constexpr size_t width{8};
+    static constexpr size_t register_count{16};
+
+    static reg zero() noexcept {
+        return _mm256_setzero_si256();
+    }
+    static reg load(const packed_b* ptr) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    static reg load(const int32_t* ptr) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    static void store(int32_t* ptr, reg value) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value);
+    }
+    static reg add(reg a, reg b) noexcept {
+        return _mm256_add_epi32(a, b);
+    }
+    static reg multiply_add(reg a, reg b, reg c) noexcept {
+        return _mm256_add_epi32(c, _mm256_madd_epi16(a, b));
+    }
+    static reg broadcast(const packed_a* ptr) noexcept {
+        int32_t bits{};
+        std::memcpy(&bits, ptr, sizeof(bits));
+        return _mm256_set1_epi32(bits);
+    }
+#else
+    using reg = int32_t;
+    using packed_a = int16_t;
+    using packed_b = int16_t;
+    static constexpr size_t group{1};
+    static constexpr size_t width{1};
+    static constexpr size_t register_count{16};
+
+    static reg zero() noexcept {
+        return 0;
+    }
+    static reg load(const packed_b* ptr) noexcept {
+        return *ptr;
+    }
+    static reg load(const int32_t* ptr) noexcept {
+        return *ptr;
+    }
+    static void store(int32_t* ptr, reg value) noexcept {
+        *ptr = value;
+    }
+    static reg add(reg a, reg b) noexcept {
+        return a + b;
+    }
+    static reg multiply_add(reg a, reg b, reg c) noexcept {
+        return a * b + c;
+    }
+    static reg broadcast(const packed_a* ptr) noexcept {
+        return *ptr;
+    }
+#endif
+};
+
+struct Int8Blocking {
+    static constexpr size_t width{Int8Simd::width};
+    static constexpr size_t group{Int8Simd::group};
+    static constexpr size_t vectors{width == 1 ? 4 : 2};
+    static constexpr size_t nr{vectors * width};
+    static constexpr size_t mr{width == 1 ? 4 : (Int8Simd::register_count - 4) / vectors};
+    static constexpr size_t kc{512};
+    static constexpr size_t mc{
+        shiv::max(mr, 192 * 1024 / (kc * sizeof(Int8Simd::packed_a)) / mr * mr)};
+    static constexpr size_t nc{4096 / nr * nr};
+};
+
+/// added to an operand as it is packed to bring it into the range the kernel multiplies,
+/// int8 A into uint8 and uint8 B into int8 for VNNI, nothing when widening to int16
+template <typename T, typename Packed>
+inline constexpr int32_t int8_offset{
+    sizeof(Packed) == 1 && std::is_signed_v<T> != std::is_signed_v<Packed>
+        ? (std::is_signed_v<T> ? 128 : -128)
+        : 0};
+
+/// copies an m x k block of A into mr row panels a group of k at a time, zero padded in both
+template <typename A>
+void pack_int8_a(size_t m, size_t k, const A* a, ptrdiff_t row_stride, ptrdiff_t col_stride,
+                 Int8Simd::packed_a* packed) noexcept {
+    using packed_a = Int8Simd::packed_a;
+    constexpr size_t mr{Int8Blocking::mr};
+    constexpr size_t group{Int8Blocking::group};
+    constexpr int32_t offset{int8_offset<A, packed_a>};
+    for (size_t i0{0}; i0 < m; i0 += mr) {
+        const size_t rows{shiv::min(mr, m - i0)};
+        const A* panel{a + static_cast<ptrdiff_t>(i0) * row_stride};
+        for (size_t p0{0}; p0 < k; p0 += group) {
+            if (rows == mr && p0 + group <= k) {
+                for (size_t i{0}; i < mr; ++i) {
+                    const A* first{panel + static_cast<ptrdiff_t>(i) * row_stride +
+                                   static_cast<ptrdiff_t>(p0) * col_stride};
+                    for (size_t g{0}; g < group; ++g) {
+                        packed[i * group + g] = static_cast<packed_a>(
+                            first[static_cast<ptrdiff_t>(g) * col_stride] + offset);
+                    }
+                }
+            } else {
+                // edge of the block, padded
+                for (size_t i{0}; i < mr; ++i) {
+                    for (size_t g{0}; g < group; ++g) {
+                        const size_t p{p0 + g};
+                        packed[i * group + g] =
+                            i < rows && p < k
+                                ? static_cast<packed_a>(
+                                      panel[static_cast<ptrdiff_t>(i) * row_stride +
+                                            static_cast<ptrdiff_t>(p) * col_stride] +
+                                      offset)
+                                : packed_a{};
+                    }
+                }
+            }
+            packed += mr * group;
+        }
+    }
+}
+
+/// copies a k x n block of B into nr column panels, each row of a panel holding a group of k
+/// for every column so one load fills a register
+template <typename B>
+void pack_int8_b(size_t k, size_t n, const B* b, ptrdiff_t row_stride, ptrdiff_t col_stride,
+                 Int8Simd::packed_b* packed) noexcept {
+    using packed_b = Int8Simd::packed_b;
+    constexpr size_t nr{Int8Blocking::nr};
+    constexpr size_t group{Int8Blocking::group};
+    constexpr int32_t offset{int8_offset<B, packed_b>};
+    for (size_t j0{0}; j0 < n; j0 += nr) {
+        const size_t cols{shiv::min(nr, n - j0)};
+        const B* panel{b + static_cast<ptrdiff_t>(j0) * col_stride};
+        for (size_t p0{0}; p0 < k; p0 += group) {
+            const bool full{cols == nr && p0 + group <= k};
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__)
+            if (full && col_stride == 1) {
+                // four rows of 16 bytes interleaved into 16 groups of 4 with two rounds of
+                // unpacks, the offset of -128 is a flip of the top bit
+                const __m128i flip{_mm_set1_epi8(offset == 0 ? 0 : -128)};
+                for (size_t j{0}; j < nr; j += 16) {
+                    __m128i rows[group];
+                    for (size_t g{0}; g < group; ++g) {
+                        rows[g] = _mm_xor_si128(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                panel + static_cast<ptrdiff_t>(p0 + g) * row_stride + j)),
+                            flip);
+                    }
+                    const __m128i low01{_mm_unpacklo_epi8(rows[0], rows[1])};
+                    const __m128i high01{_mm_unpackhi_epi8(rows[0], rows[1])};
+                    const __m128i low23{_mm_unpacklo_epi8(rows[2], rows[3])};
+                    const __m128i high23{_mm_unpackhi_epi8(rows[2], rows[3])};
+                    auto* target{reinterpret_cast<__m128i*>(packed + j * group)};
+                    _mm_storeu_si128(target, _mm_unpacklo_epi16(low01, low23));
+                    _mm_storeu_si128(target + 1, _mm_unpackhi_epi16(low01, low23));
+                    _mm_storeu_si128(target + 2, _mm_unpacklo_epi16(high01, high23));
+                    _mm_storeu_si128(target + 3, _mm_unpackhi_epi16(high01, high23));
+                }
+                packed += nr * group;
+                continue;
+            }
+#endif
+            for (size_t g{0}; g < group; ++g) {
+                const size_t p{p0 + g};
+                if (p >= k) {
+                    for (size_t j{0}; j < nr; ++j) {
+                        packed[j * group + g] = packed_b{};
+                    }
+                    continue;
+                }
+                const B* row{panel + static_cast<ptrdiff_t>(p) * row_stride};
+                if (full && col_stride == 1) {
+                    for (size_t j{0}; j < nr; ++j) {
+                        packed[j * group + g] = static_cast<packed_b>(row[j] + offset);
+                    }
+                    continue;
+                }
+                for (size_t j{0}; j < nr; ++j) {
+                    packed[j * group + g] =
+                        j < cols
+                            ? static_cast<packed_b>(row[static_cast<ptrdiff_t>(j) * col_stride] +
+                                                    offset)
+                            : packed_b{};
+                }
+            }
+            packed += nr * group;
+        }
+    }
+}
+
+/// C[rows x cols] = beta * C + A_panel * B_panel in int32 over groups of k
+inline void int8_micro_kernel(size_t groups, const Int8Simd::packed_a* a,
+                              const Int8Simd::packed_b* b, int32_t beta, int32_t* c,
+                              ptrdiff_t row_stride, ptrdiff_t col_stride, size_t rows,
+                              size_t cols) noexcept {
+    using V = Int8Simd;
+    constexpr size_t mr{Int8Blocking::mr};
+    constexpr size_t nr{Int8Blocking::nr};
+    constexpr size_t vectors{Int8Blocking::vectors};
+    constexpr size_t width{V::width};
+    constexpr size_t group{V::group};
+
+    typename V::reg acc[mr][vectors];
+#pragma GCC unroll 16
+    for (size_t i{0}; i < mr; ++i) {
+#pragma GCC unroll 4
+        for (size_t v{0}; v < vectors; ++v) {
+            acc[i][v] = V::zero();
+        }
+    }
+    for (size_t p{0}; p < groups; ++p) {
+        typename V::reg b_row[vectors];
+#pragma GCC unroll 4
+        for (size_t v{0}; v < vectors; ++v) {
+            b_row[v] = V::load(b + v * width * group);
+        }
+#pragma GCC unroll 16
+        for (size_t i{0}; i < mr; ++i) {
+            const auto a_value{V::broadcast(a + i * group)};
+#pragma GCC unroll 4
+            for (size_t v{0}; v < vectors; ++v) {
+                acc[i][v] = V::multiply_add(a_value, b_row[v], acc[i][v]);
+            }
+        }
+        a += mr * group;
+        b += nr * group;
+    }
+
+    // later passes over k add to C, beta 1, so that has a fast path too
+    if (rows == mr && cols == nr && col_stride == 1 && (beta == 0 || beta == 1)) {
+#pragma GCC unroll 16
+        for (size_t i{0}; i < mr; ++i) {
+            int32_t* c_row{c + static_cast<ptrdiff_t>(i) * row_stride};
+#pragma GCC unroll 4
+            for (size_t v{0}; v < vectors; ++v) {
+                V::store(c_row + v * width,
+                         beta == 0 ? acc[i][v] : V::add(V::load(c_row + v * width), acc[i][v]));
+            }
+        }
+        return;
+    }
+    alignas(cache_line_size) int32_t tile[mr * nr];
+    for (size_t i{0}; i < mr; ++i) {
+        for (size_t v{0}; v < vectors; ++v) {
+            V::store(tile + i * nr + v * width, acc[i][v]);
+        }
+    }
+    for (size_t i{0}; i < rows; ++i) {
+        for (size_t j{0}; j < cols; ++j) {
+            int32_t& out{c[static_cast<ptrdiff_t>(i) * row_stride +
+                           static_cast<ptrdiff_t>(j) * col_stride]};
+            out = beta == 0 ? tile[i * nr + j] : beta * out + tile[i * nr + j];
+        }
+    }
+}
+} // namespace detail
+
+/// C = A * B + beta * C for int8 and uint8 operands, in any mix, accumulated exactly in int32.
+/// The same blocking and threading as the floating point kernel, over vpdpbusd with AVX-512
+/// VNNI, vpmaddwd with AVX2 and scalar otherwise. When VNNI needs an operand offset into its
+/// range the offset's contribution, a multiple of the row sums of A or column sums of B, is
+/// subtracted from C at the end. Exact while k * 255 * 128 fits in an int32, k up to 65793.
+template <typename A, typename B>
+requires(detail::is_int8_v<A> && detail::is_int8_v<B>)
+void gemm(size_t m, size_t n, size_t k, const A* a, ptrdiff_t a_row_stride,
+          ptrdiff_t a_col_stride, const B* b, ptrdiff_t b_row_stride, ptrdiff_t b_col_stride,
+          int32_t beta, int32_t* c, ptrdiff_t c_row_stride, ptrdiff_t c_col_stride) {
+    using blocking = detail::Int8Blocking;
+    using packed_a = detail::Int8Simd::packed_a;
+    using packed_b = detail::Int8Simd::packed_b;
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (k == 0) {
+        detail::scale(m, n, beta, c, c_row_stride, c_col_stride);
+        return;
+    }
+    std::shared_ptr<ThreadPool> pool{};
+    size_t threads{1};
+    if (m * n * k >= detail::parallel_gemm_threshold) {
+        pool = detail::matrix_pool();
+        threads = pool->size();
+        if (threads == 1) {
+            pool.reset();
+        }
+    }
+    const size_t per_thread{(m + threads - 1) / threads};
+    const size_t mc{shiv::min(blocking::mc,
+                              shiv::max(blocking::mr, (per_thread + blocking::mr - 1) /
+                                                          blocking::mr * blocking::mr))};
+    packed_b* packed{detail::gemm_scratch<packed_b, 1>(blocking::kc * blocking::nc)};
+
+    for (size_t jc{0}; jc < n; jc += blocking::nc) {
+        const size_t nc{shiv::min(blocking::nc, n - jc)};
+        const size_t panels{(nc + blocking::nr - 1) / blocking::nr};
+        const size_t parts{shiv::min(threads, panels)};
+        for (size_t pc{0}; pc < k; pc += blocking::kc) {
+            const size_t kc{shiv::min(blocking::kc, k - pc)};
+            const size_t groups{(kc + blocking::group - 1) / blocking::group};
+            detail::gemm_for(pool.get(), parts, [&](size_t part) {
+                const size_t first{part * panels / parts * blocking::nr};
+                const size_t last{shiv::min((part + 1) * panels / parts * blocking::nr, nc)};
+                detail::pack_int8_b(kc, last - first,
+                                    b + static_cast<ptrdiff_t>(pc) * b_row_stride +
+                                        static_cast<ptrdiff_t>(jc + first) * b_col_stride,
+                                    b_row_stride, b_col_stride,
+                                    packed + first * groups * blocking::group);
+            });
+            const int32_t pass_beta{pc == 0 ? beta : 1};
+
+            detail::gemm_for(pool.get(), (m + mc - 1) / mc, [&](size_t block) {
+                const size_t ic{block * mc};
+                const size_t rows{shiv::min(mc, m - ic)};
+                packed_a* packed_block{
+                    detail::gemm_scratch<packed_a, 0>(blocking::mc * blocking::kc)};
+                detail::pack_int8_a(rows, kc,
+                                    a + static_cast<ptrdiff_t>(ic) * a_row_stride +
+                                        static_cast<ptrdiff_t>(pc) * a_col_stride,
+                                    a_row_stride, a_col_stride, packed_block);
+
+                for (size_t jr{0}; jr < nc; jr += blocking::nr) {
+                    for (size_t ir{0}; ir < rows; ir += blocking::mr) {
+                        detail::int8_micro_kernel(
+                            groups, packed_block + ir * groups * blocking::group,
+                            packed + jr * groups * blocking::group, pass_beta,
+                            c + static_cast<ptrdiff_t>(ic + ir) * c_row_stride +
+                                static_cast<ptrdiff_t>(jc + jr) * c_col_stride,
+                            c_row_stride, c_col_stride, shiv::min(blocking::mr, rows - ir),
+                            shiv::min(blocking::nr, nc - jr));
+                    }
+                }
+            });
+        }
+    }
+
+    // sum (a + oa) * (b + ob) = sum a * b + ob * sum a + oa * sum b + k * oa * ob
+    constexpr int32_t a_offset{detail::int8_offset<A, packed_a>};
+    constexpr int32_t b_offset{detail::int8_offset<B, packed_b>};
+    if constexpr (a_offset != 0 || b_offset != 0) {
+        int32_t* row_sums{detail::gemm_scratch<int32_t, 0>(m)};
+        int32_t* col_sums{detail::gemm_scratch<int32_t, 1>(n)};
+        for (size_t i{0}; i < m; ++i) {
+            const A* row{a + static_cast<ptrdiff_t>(i) * a_row_stride};
+            int32_t sum{0};
+            for (size_t p{0}; p < k; ++p) {
+                sum += row[static_cast<ptrdiff_t>(p) * a_col_stride];
+            }
+            row_sums[i] = b_offset * sum + a_offset * b_offset * static_cast<int32_t>(k);
+        }
+        std::fill(col_sums, col_sums + n, 0);
+        for (size_t p{0}; p < k; ++p) {
+            const B* row{b + static_cast<ptrdiff_t>(p) * b_row_stride};
+            for (size_t j{0}; j < n; ++j) {
+                col_sums[j] += row[static_cast<ptrdiff_t>(j) * b_col_stride];
+            }
+        }
+        for (size_t i{0}; i < m; ++i) {
+            int32_t* row{c + static_cast<ptrdiff_t>(i) * c_row_stride};
+            for (size_t j{0}; j < n; ++j) {
+                row[static_cast<ptrdiff_t>(j) * c_col_stride] -=
+                    row_sums[i] + a_offset * col_sums[j];
+            }
+        }
+    }
+}
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_GEMM_HPP
@@ -0,0 +1,232 @@
+#ifndef SHIVLIB_DATASTRUCTURE_INLINE_STRING_HPP
+#define SHIVLIB_DATASTRUCTURE_INLINE_STRING_HPP
+
+#include "../cstddef.hpp"
+#include "../hash.hpp"
+#include "string_kernels.hpp"
+#include "string_view.hpp"
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace shiv {
+/// A string of at most N chars stored in place, N + 1 bytes with a length byte after the
+/// characters, for the symbols, ids and tags of wire messages. Trivially copyable, so a struct
+/// of them can be memcpy'd into a network buffer, and constexpr throughout. The bytes past the
+/// length are kept zero, so equal strings are equal byte for byte and == is a few whole
+/// register compares. Not null terminated when full. Throws std::length_error rather than
+/// truncate.
+template <size_t N>
+class InlineString {
+    static_assert(N > 0 && N < 256, "InlineString holds 1 to 255 characters");
+
+    char m_data[N]{};
+    uint8_t m_size{0};
+
+    constexpr void check_fits(size_t new_size) const {
+        if (new_size > N) {
+            throw std::length_error{"String does not fit"};
+        }
+    }
+
+  public:
+    using value_type = char;
+    using pointer = char*;
+    using iterator = char*;
+    using const_iterator = const char*;
+    using reverse_iterator = std::reverse_iterator<char*>;
+    using const_reverse_iterator = const std::reverse_iterator<const char*>;
+    using reference = char&;
+    using const_reference = const char&;
+
+    static constexpr size_t npos = size_t{static_cast<size_t>(-1)};
+
+    constexpr InlineString() noexcept = default;
+    constexpr InlineString(StringView<char> view) {
+        assign(view);
+    }
+    constexpr InlineString(const char* str)
+    : InlineString(StringView<char>{str}) {
+    }
+    constexpr InlineString(const char* str, size_t count)
+    : InlineString(StringView<char>{str, count}) {
+    }
+
+    constexpr InlineString& operator=(StringView<char> view) {
+        assign(view);
+        return *this;
+    }
+    constexpr void assign(StringView<char> view) {
+        check_fits(view.size());
+        for (size_t i{0}; i < view.size(); ++i) {
+            m_data[i] = view[i];
+        }
+        for (size_t i{view.size()}; i < m_size; ++i) {
+            m_data[i] = '\0';
+        }
+        m_size = static_cast<uint8_t>(view.size());
+    }
+
+    // adding characters
+    constexpr InlineString& append(StringView<char> view) {
+        check_fits(size() + view.size());
+        for (size_t i{0}; i < view.size(); ++i) {
+            m_data[m_size + i] = view[i];
+        }
+        m_size = static_cast<uint8_t>(m_size + view.size());
+        return *this;
+    }
+    constexpr InlineString& operator+=(StringView<char> view) {
+        return append(view);
+    }
+    constexpr void push_back(char c) {
+        check_fits(size() + 1);
+        m_data[m_size++] = c;
+    }
+    constexpr void resize(size_t new_size, char c = '\0') {
+        check_fits(new_size);
+        for (size_t i{m_size}; i < new_size; ++i) {
+            m_data[i] = c;
+        }
+        for (size_t i{new_size}; i < m_size; ++i) {
+            m_data[i] = '\0';
+        }
+        m_size = static_cast<uint8_t>(new_size);
+    }
+
+    // removing characters
+    constexpr void pop_back() noexcept {
+        m_data[--m_size] = '\0';
+    }
+    constexpr void clear() noexcept {
+        resize(0);
+    }
+
+    // Element Access. Writing past size() through data() breaks ==.
+    [[nodiscard]] constexpr char* data() noexcept {
+        return m_data;
+    }
+    [[nodiscard]] constexpr const char* data() const noexcept {
+        return m_data;
+    }
+    [[nodiscard]] constexpr reference operator[](size_t index) noexcept {
+        return m_data[index];
+    }
+    [[nodiscard]] constexpr const_reference operator[](size_t index) const noexcept {
+        return m_data[index];
+    }
+    [[nodiscard]] constexpr reference at(size_t index) {
+        if (index >= m_size) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return m_data[index];
+    }
+    [[nodiscard]] constexpr const_reference at(size_t index) const {
+        if (index >= m_size) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return m_data[index];
+    }
+    [[nodiscard]] constexpr reference front() noexcept {
+        return m_data[0];
+    }
+    [[nodiscard]] constexpr const_reference front() const noexcept {
+        return m_data[0];
+    }
+    [[nodiscard]] constexpr reference back() noexcept {
+        return m_data[m_size - 1];
+    }
+    [[nodiscard]] constexpr const_reference back() const noexcept {
+        return m_data[m_size - 1];
+    }
+
+    [[nodiscard]] constexpr StringView<char> view() const noexcept {
+        return StringView<char>{m_data, m_size};
+    }
+    constexpr operator StringView<char>() const noexcept {
+        return view();
+    }
+
+    // Iterators
+    [[nodiscard]] constexpr auto begin() noexcept {
+        return iterator{m_data};
+    }
+    [[nodiscard]] constexpr auto begin() const noexcept {
+        return const_iterator{m_data};
+    }
+    [[nodiscard]] constexpr auto cbegin() const noexcept {
+        return const_iterator{m_data};
+    }
+    [[nodiscard]] constexpr auto rbegin() noexcept {
+        return reverse_iterator{end()};
+    }
+    [[nodiscard]] constexpr auto rbegin() const noexcept {
+        return const_reverse_iterator{end()};
+    }
+    [[nodiscard]] constexpr auto end() noexcept {
+        return iterator{m_data + m_size};
+    }
+    [[nodiscard]] constexpr auto end() const noexcept {
+        return const_iterator{m_data + m_size};
+    }
+    [[nodiscard]] constexpr auto cend() const noexcept {
+        return const_iterator{m_data + m_size};
+    }
+    [[nodiscard]] constexpr auto rend() noexcept {
+        return reverse_iterator{begin()};
+    }
+    [[nodiscard]] constexpr auto rend() const noexcept {
+        return const_reverse_iterator{begin()};
+    }
+
+    // Capacity
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return m_size;
+    }
+    [[nodiscard]] constexpr size_t length() const noexcept {
+        return m_size;
+    }
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return N;
+    }
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    // comparison
+    [[nodiscard]] friend constexpr bool operator==(const InlineString& lhs,
+                                                   const InlineString& rhs) noexcept {
+        if (std::is_constant_evaluated()) {
+            return lhs.view() == rhs.view();
+        }
+        // the characters and the length byte at once, the zero tail makes that exact
+        return detail::equal_bytes<sizeof(InlineString)>(reinterpret_cast<const char*>(&lhs),
+                                                         reinterpret_cast<const char*>(&rhs));
+    }
+    [[nodiscard]] friend constexpr bool operator==(const InlineString& lhs,
+                                                   StringView<char> rhs) noexcept {
+        return lhs.view() == rhs;
+    }
+    [[nodiscard]] friend constexpr bool operator==(const InlineString& lhs,
+                                                   const char* rhs) noexcept {
+        return lhs.view() == StringView<char>{rhs};
+    }
+    [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const InlineString& lhs,
+                                                                    StringView<char> rhs) noexcept {
+        return lhs.view().compare(rhs) <=> 0;
+    }
+};
+} // namespace shiv
+
+/// so InlineString can key the standard unordered containers
+template <size_t N>
+struct std::hash<shiv::InlineString<N>> {
+    [[nodiscard]] size_t operator()(const shiv::InlineString<N>& str) const noexcept {
+        return shiv::hash_bytes(str.data(), str.size());
+    }
+};
+
+#endif //SHIVLIB_DATASTRUCTURE_INLINE_STRING_HPP
@@ -0,0 +1,350 @@
+#ifndef SHIVLIB_DATASTRUCTURE_LU_HPP
+#define SHIVLIB_DATASTRUCTURE_LU_HPP
+
+#include "../concepts.hpp"
+#include "array.hpp"
+#include "gemm.hpp"
+#include "matrix_expression.hpp"
+#include "matrix_kernels.hpp"
+#include "vector.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace shiv {
+namespace detail {
+// std::abs and std::sqrt only become constexpr in C++23 and C++26, so the factorizations use
+// these, which do the sums by hand during constant evaluation
+template <typename T>
+[[nodiscard]] constexpr T constexpr_abs(T value) noexcept {
+    if (std::is_constant_evaluated()) {
+        return value < T{} ? -value : value;
+    }
+    return std::abs(value);
+}
+/// Newton's method from above the root falls until it stops changing, within an ulp of std::sqrt
+template <typename T>
+[[nodiscard]] constexpr T constexpr_sqrt(T value) noexcept {
+    if (!std::is_constant_evaluated()) {
+        return std::sqrt(value);
+    }
+    if (!(value > T{}) || value == std::numeric_limits<T>::infinity()) {
+        return value < T{} ? std::numeric_limits<T>::quiet_NaN() : value;
+    }
+    T root{value > T{1} ? value : T{1}};
+    while (true) {
+        const T next{(root + value / root) / 2};
+        if (!(next < root)) {
+            return root;
+        }
+        root = next;
+    }
+}
+
+// what LU needs to know about the matrices it factors and solves against, Matrix knows its
+// shape at compile time, MatrixView specialises this in matrix_view.hpp and anything else is
+// expected to look like DynMatrix
+template <typename M>
+struct lu_traits {
+    template <typename U>
+    using vector = shiv::Vector<U>;
+    using pivots = vector<size_t>;
+
+    [[nodiscard]] static M make(size_t rows, size_t cols) {
+        return M{rows, cols};
+    }
+    [[nodiscard]] static size_t rows(const M& matrix) noexcept {
+        return matrix.rows();
+    }
+    [[nodiscard]] static size_t cols(const M& matrix) noexcept {
+        return matrix.cols();
+    }
+    [[nodiscard]] static ptrdiff_t stride(const M& matrix) noexcept {
+        return static_cast<ptrdiff_t>(matrix.stride());
+    }
+    [[nodiscard]] static constexpr ptrdiff_t col_stride(const M&) noexcept {
+        return 1;
+    }
+};
+template <typename T, size_t rows_, size_t cols_>
+struct lu_traits<Matrix<T, rows_, cols_>> {
+    template <typename U>
+    using vector = shiv::Array<U, rows_>;
+    using pivots = vector<size_t>;
+
+    [[nodiscard]] static constexpr Matrix<T, rows_, cols_> make(size_t, size_t) noexcept {
+        return {};
+    }
+    [[nodiscard]] static constexpr size_t rows(const Matrix<T, rows_, cols_>&) noexcept {
+        return rows_;
+    }
+    [[nodiscard]] static constexpr size_t cols(const Matrix<T, rows_, cols_>&) noexcept {
+        return cols_;
+    }
+    [[nodiscard]] static constexpr ptrdiff_t stride(const Matrix<T, rows_, cols_>&) noexcept {
+        return static_cast<ptrdiff_t>(cols_);
+    }
+    [[nodiscard]] static constexpr ptrdiff_t col_stride(const Matrix<T, rows_, cols_>&) noexcept {
+        return 1;
+    }
+};
+
+// columns per panel, the trailing update for each one is a rank lu_block_size gemm
+inline constexpr size_t lu_block_size{64};
+
+/// c[ci + i][cj + j] -= sum over p of a[ai + i][aj + p] * b[bi + p][bj + j] for an m x n block
+/// with inner dimension k. a and c may be the same matrix as long as the blocks do not overlap.
+template <typename A, typename B, typename C>
+constexpr void subtract_product(const A& a, size_t ai, size_t aj, const B& b, size_t bi,
+                                size_t bj, C& c, size_t ci, size_t cj, size_t m, size_t n,
+                                size_t k) {
+    using T = matrix_element_t<C>;
+    if (m == 0 || n == 0 || k == 0) {
+        return;
+    }
+    if constexpr (shiv::FloatingPoint<T>) {
+        if (!std::is_constant_evaluated() && m * n * k > 16 * 16 * 16) {
+            shiv::gemm(m, n, k, T{-1}, &a[ai][aj], lu_traits<A>::stride(a),
+                       lu_traits<A>::col_stride(a), &b[bi][bj], lu_traits<B>::stride(b),
+                       lu_traits<B>::col_stride(b), T{1}, &c[ci][cj],
+                       lu_traits<std::remove_const_t<C>>::stride(c),
+                       lu_traits<std::remove_const_t<C>>::col_stride(c));
+            return;
+        }
+    }
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t p{0}; p < k; ++p) {
+            const T scalar{a[ai + i][aj + p]};
+            for (size_t j{0}; j < n; ++j) {
+                c[ci + i][cj + j] -= scalar * b[bi + p][bj + j];
+            }
+        }
+    }
+}
+
+/// solves L * X = B in place, a block of rows at a time, where L is the lower triangle of the
+/// first n rows and columns of factors and B the first n rows of rhs. L's diagonal is taken
+/// as ones when unit is set.
+template <bool unit, typename F, typename B>
+constexpr void forward_substitute(const F& factors, size_t n, B& rhs, size_t cols) {
+    using T = matrix_element_t<F>;
+    for (size_t first{0}; first < n; first += lu_block_size) {
+        const size_t last{shiv::min(first + lu_block_size, n)};
+        subtract_product(factors, first, 0, rhs, 0, 0, rhs, first, 0, last - first, cols, first);
+        for (size_t i{first}; i < last; ++i) {
+            for (size_t p{first}; p < i; ++p) {
+                const T scalar{factors[i][p]};
+                for (size_t j{0}; j < cols; ++j) {
+                    rhs[i][j] -= scalar * rhs[p][j];
+                }
+            }
+            if constexpr (!unit) {
+                const T reciprocal{T{1} / factors[i][i]};
+                for (size_t j{0}; j < cols; ++j) {
+                    rhs[i][j] *= reciprocal;
+                }
+            }
+        }
+    }
+}
+/// solves U * X = B in place, from the last block of rows up, where U is the upper triangle,
+/// diagonal included, of the first n rows and columns of factors
+template <typename F, typename B>
+constexpr void back_substitute(const F& factors, size_t n, B& rhs, size_t cols) {
+    using T = matrix_element_t<F>;
+    for (size_t last{n}; last > 0;) {
+        const size_t first{last > lu_block_size ? last - lu_block_size : 0};
+        // rows below the block are already solved, the first time round there are none
+        if (last < n) {
+            subtract_product(factors, first, last, rhs, last, 0, rhs, first, 0, last - first,
+                             cols, n - last);
+        }
+        for (size_t i{last}; i-- > first;) {
+            for (size_t p{i + 1}; p < last; ++p) {
+                const T scalar{factors[i][p]};
+                for (size_t j{0}; j < cols; ++j) {
+                    rhs[i][j] -= scalar * rhs[p][j];
+                }
+            }
+            const T reciprocal{T{1} / factors[i][i]};
+            for (size_t j{0}; j < cols; ++j) {
+                rhs[i][j] *= reciprocal;
+            }
+        }
+        last = first;
+    }
+}
+} // namespace detail
+
+/// LU factorization with partial pivoting, P * A = L * U with a unit lower triangular L. The
+/// factors are computed once, after which solves against any number of right hand sides, the
+/// determinant and the inverse all reuse them. Works on Matrix, including at compile time, and
+/// on DynMatrix. A MatrixView is factored in place, in the elements it views. Panels of
+/// columns are factored one at a time and the rest of the matrix is updated through the
+/// blocked gemm kernel, so large matrices stay cache friendly and use matrix_threads().
+template <typename M>
+requires(shiv::FloatingPoint<detail::matrix_element_t<M>> &&
+         !detail::is_half_precision_v<detail::matrix_element_t<M>>)
+class LU {
+  public:
+    using value_type = detail::matrix_element_t<M>;
+    using matrix_type = M;
+
+  private:
+    using T = value_type;
+    using traits = detail::lu_traits<M>;
+
+    M m_lu{};
+    typename traits::pivots m_pivots{};
+    size_t m_size{0};
+    bool m_negative{false};
+    bool m_singular{false};
+
+    // unblocked right looking factorization of columns [first, last), rows first onwards
+    constexpr void factor_panel(size_t first, size_t last) {
+        for (size_t j{first}; j < last; ++j) {
+            size_t pivot{j};
+            T largest{detail::constexpr_abs(m_lu[j][j])};
+            for (size_t i{j + 1}; i < m_size; ++i) {
+                if (detail::constexpr_abs(m_lu[i][j]) > largest) {
+                    largest = detail::constexpr_abs(m_lu[i][j]);
+                    pivot = i;
+                }
+            }
+            if constexpr (detail::is_matrix_v<M>) {
+                m_pivots[j] = pivot;
+            } else {
+                m_pivots.push_back(pivot);
+            }
+            if (largest == T{}) {
+                // the column is already zero below the diagonal, there is nothing to eliminate
+                m_singular = true;
+                continue;
+            }
+            if (pivot != j) {
+                detail::swap_rows(m_lu, pivot, j, m_size);
+                m_negative = !m_negative;
+            }
+            const T reciprocal{T{1} / m_lu[j][j]};
+            for (size_t i{j + 1}; i < m_size; ++i) {
+                m_lu[i][j] *= reciprocal;
+                const T scalar{m_lu[i][j]};
+                for (size_t col{j + 1}; col < last; ++col) {
+                    m_lu[i][col] -= scalar * m_lu[j][col];
+                }
+            }
+        }
+    }
+
+    constexpr void factor() {
+        for (size_t first{0}; first < m_size; first += detail::lu_block_size) {
+            const size_t last{shiv::min(first + detail::lu_block_size, m_size)};
+            factor_panel(first, last);
+            // U12 = L11^-1 * A12, columns are independent so wide ones are shared out
+            const auto solve_columns{[&](size_t col_first, size_t col_last) {
+                for (size_t i{first + 1}; i < last; ++i) {
+                    for (size_t p{first}; p < i; ++p) {
+                        const T scalar{m_lu[i][p]};
+                        for (size_t col{col_first}; col < col_last; ++col) {
+                            m_lu[i][col] -= scalar * m_lu[p][col];
+                        }
+                    }
+                }
+            }};
+            constexpr size_t chunk{detail::lu_block_size * 4};
+            if (!std::is_constant_evaluated() && m_size - last > chunk) {
+                const size_t chunks{(m_size - last + chunk - 1) / chunk};
+                detail::matrix_pool()->parallel_for(chunks, [&](size_t index) {
+                    const size_t col_first{last + index * chunk};
+                    solve_columns(col_first, shiv::min(col_first + chunk, m_size));
+                });
+            } else {
+                solve_columns(last, m_size);
+            }
+            // A22 -= L21 * U12
+            detail::subtract_product(m_lu, last, first, m_lu, first, last, m_lu, last, last,
+                                     m_size - last, m_size - last, last - first);
+        }
+    }
+
+  public:
+    /// throws std::invalid_argument if a runtime sized matrix is not square
+    explicit constexpr LU(const M& matrix)
+    : m_lu{matrix}
+    , m_size{traits::rows(matrix)} {
+        if constexpr (detail::is_matrix_v<M>) {
+            static_assert(M::row_count == M::col_count, "Must be a square matrix");
+        } else {
+            if (traits::rows(matrix) != traits::cols(matrix)) {
+                throw std::invalid_argument{"Must be a square matrix"};
+            }
+            m_pivots.reserve(m_size);
+        }
+        factor();
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return m_size;
+    }
+    /// true if U has a zero on its diagonal, solve and inverse will throw
+    [[nodiscard]] constexpr bool is_singular() const noexcept {
+        return m_singular;
+    }
+    /// L below the diagonal, without its unit diagonal, and U on and above it
+    [[nodiscard]] constexpr const M& packed() const noexcept {
+        return m_lu;
+    }
+    /// the row that was swapped with row at that step of the elimination
+    [[nodiscard]] constexpr size_t pivot(size_t row) const noexcept {
+        return m_pivots[row];
+    }
+
+    [[nodiscard]] constexpr T determinant() const noexcept {
+        T result{1};
+        for (size_t i{0}; i < m_size; ++i) {
+            result *= m_lu[i][i];
+        }
+        return m_negative ? -result : result;
+    }
+
+    /// overwrites every column of rhs with the solution x of A * x = rhs
+    template <typename B>
+    constexpr void solve_in_place(B& rhs) const {
+        static_assert(std::is_same_v<detail::matrix_element_t<B>, T>,
+                      "Right hand side must have the same element type");
+        // a view passed as const still writes through to what it views
+        using rhs_traits = detail::lu_traits<std::remove_const_t<B>>;
+        if (rhs_traits::rows(rhs) != m_size) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        if (m_singular) {
+            throw std::domain_error{"Matrix is singular"};
+        }
+        const size_t cols{rhs_traits::cols(rhs)};
+        for (size_t i{0}; i < m_size; ++i) {
+            if (m_pivots[i] != i) {
+                detail::swap_rows(rhs, i, m_pivots[i], cols);
+            }
+        }
+        detail::forward_substitute<true>(m_lu, m_size, rhs, cols);
+        detail::back_substitute(m_lu, m_size, rhs, cols);
+    }
+    /// the solution x of A * x = rhs, rhs may have any number of columns
+    template <typename B>
+    [[nodiscard]] constexpr B solve(B rhs) const {
+        solve_in_place(rhs);
+        return rhs;
+    }
+    [[nodiscard]] constexpr M inverse() const {
+        M result{traits::make(m_size, m_size)};
+        for (size_t i{0}; i < m_size; ++i) {
+            result[i][i] = T{1};
+        }
+        solve_in_place(result);
+        return result;
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_LU_HPP
@@ -2,9 +2,16 @@
 #define SHIVLIB_DATASTRUCTURE_MATRIX_HPP
 
 #include "../concepts.hpp"
+#include "../float16.hpp"
 #include "array.hpp"
+#include "gemm.hpp"
+#include "lu.hpp"
+#include "matrix_expression.hpp"
+#include "matrix_kernels.hpp"
+#include "small_matrix.hpp"
 #include <cmath>
 #include <tuple>
+#include <type_traits>
 
 namespace shiv {
 template <shiv::Arithmetic T, size_t rows, size_t cols>
@@ -17,9 +24,14 @@ class Matrix {
     using const_reverse_iterator = const std::reverse_iterator<const T*>;
     using reference = T&;
     using const_reference = const T&;
+    static constexpr size_t row_count{rows};
+    static constexpr size_t col_count{cols};
 
     // No explicit constructor/ destructor etc. for aggregate all members must also be public
 
+    // multiply adds up to which the plain loop beats packing for the blocked kernel
+    static constexpr size_t gemm_threshold{16 * 16 * 16};
+
     shiv::Array<shiv::Array<T, cols>, rows> m_data{};
 
     [[nodiscard]] constexpr bool empty() const noexcept {
@@ -46,24 +58,20 @@ class Matrix {
         return result_matrix;
     }
 
+    /// floating point matrices go through a pivoted LU, see LU for repeated use of one matrix.
+    /// 16 bit matrices are factored in float and integers exactly by fraction free elimination.
+    /// Every path also runs at compile time, so fixed matrices can be folded into constants.
     [[nodiscard]] constexpr T get_determinant() const {
         static_assert(rows == cols, "Must be a square matrix");
-        T determinant{1};
-        if (rows == 1) {
-            return m_data[0][0];
-        }
-        if (rows == 2) {
-            return (m_data[0][0] * m_data[1][1]) - (m_data[1][0] * m_data[0][1]);
-        }
-        // row echelon is calculated first to reduce the complexity down closer to O(N^2)
-        const auto [row_echelon_form, is_negative] = get_row_echelon();
-        for (size_t i{0}; i < rows; ++i) {
-            determinant *= row_echelon_form[i][i];
-        }
-        if (is_negative) {
-            determinant = -determinant;
+        if constexpr (detail::is_half_precision_v<T>) {
+            return T{cast<float>().get_determinant()};
+        } else if constexpr (detail::is_small_square_v<T, rows>) {
+            return detail::small_determinant<rows>(*this);
+        } else if constexpr (shiv::FloatingPoint<T>) {
+            return LU{*this}.determinant();
         }
-        return determinant;
+        Matrix scratch{*this};
+        return detail::determinant(scratch, rows);
     }
     [[nodiscard]] constexpr Matrix get_identity() const noexcept {
         Matrix identity_matrix{};
@@ -78,82 +86,45 @@ class Matrix {
         }
         return identity_matrix;
     }
+    /// throws std::domain_error for a singular floating point matrix
     [[nodiscard]] constexpr Matrix get_inverse() const {
-        Matrix<T, rows, cols * 2> aug_ident_matrix{get_augment(get_identity())};
-        constexpr size_t AUG_ID_COLS{aug_ident_matrix[0].size()};
-
-        // replace elements based on a constant scalar from ANOTHER row
-        for (size_t i{0}; i < cols; ++i) {
-            for (size_t j{0}; j < rows; ++j) {
-                if (i != j) {
-                    T scalar{aug_ident_matrix[j][i] / aug_ident_matrix[i][i]};
-                    for (size_t k{0}; k < AUG_ID_COLS; ++k) {
-                        aug_ident_matrix[j][k] -= aug_ident_matrix[i][k] * scalar;
-                    }
-                }
-            }
-        }
-        // divide each row element by the diagonal elements that were skipped previously
-        for (size_t i{0}; i < rows; i++) {
-            T scalar{aug_ident_matrix[i][i]};
-            for (size_t j{0}; j < AUG_ID_COLS; j++) {
-                aug_ident_matrix[i][j] = aug_ident_matrix[i][j] / scalar;
-            }
+        static_assert(rows == cols, "Must be a square matrix");
+        if constexpr (detail::is_half_precision_v<T>) {
+            return cast<float>().get_inverse().template cast<T>();
+        } else if constexpr (detail::is_small_square_v<T, rows>) {
+            return detail::small_inverse(*this);
+        } else if constexpr (shiv::FloatingPoint<T>) {
+            return LU{*this}.inverse();
         }
-        // add the inverted half of the augmented matrix to it's own matrix
+        Matrix work{*this};
         Matrix inverted_matrix{};
+        detail::invert(work, inverted_matrix, rows);
+        return inverted_matrix;
+    }
+    /// element wise static_cast, such as widening 16 bit storage to float
+    template <shiv::Arithmetic U>
+    [[nodiscard]] constexpr Matrix<U, rows, cols> cast() const noexcept {
+        Matrix<U, rows, cols> result_matrix{};
         for (size_t i{0}; i < rows; ++i) {
             for (size_t j{0}; j < cols; ++j) {
-                inverted_matrix[i][j] = aug_ident_matrix[i][j + cols];
+                result_matrix[i][j] = static_cast<U>(m_data[i][j]);
             }
         }
-        return inverted_matrix;
+        return result_matrix;
     }
-    [[nodiscard]] std::tuple<Matrix, bool> get_row_echelon() const {
+    /// the row echelon form and whether an odd number of rows were swapped to reach it
+    [[nodiscard]] constexpr std::tuple<Matrix, bool> get_row_echelon() const {
         Matrix result_matrix{*this};
-        bool is_inverted{false};
-
-        for (size_t pivot_row{0}; (rows < cols ? pivot_row < rows - 1 : pivot_row < cols - 1);
-             ++pivot_row) {
-            if (result_matrix[pivot_row][pivot_row] == 0) {
-
-                // swap pivot element with another non 0 element
-                size_t swap_row{pivot_row};
-                for (size_t i{pivot_row + 1}; i < rows; i++) {
-                    if (result_matrix[i][pivot_row] != 0) {
-                        swap_row = i;
-                        break;
-                    }
-                }
-                if (swap_row == pivot_row) {
-                    continue;
-                }
-                is_inverted = !is_inverted;
-                // swaps the swap_row and pivot_row
-                result_matrix[swap_row].swap(result_matrix[pivot_row]);
-            }
-            // eliminate elements in x col under x col
-            for (size_t target_row{pivot_row + 1}; target_row < rows; ++target_row) {
-                T scale{result_matrix[target_row][pivot_row] / result_matrix[pivot_row][pivot_row]};
-
-                for (size_t target_col{0}; target_col < cols; ++target_col) {
-                    result_matrix[target_row][target_col] -=
-                        scale * result_matrix[pivot_row][target_col];
-                }
-            }
-        }
+        const bool is_inverted{detail::row_echelon(result_matrix, rows, cols)};
         return std::make_tuple(result_matrix, is_inverted);
     }
 
-    [[nodiscard]] constexpr Matrix get_transpose() const {
-        Matrix<T, rows, cols>
-            transposed_matrix{}; // rows and cols are in opposite order for transposed matrix
-
-        for (size_t i{0}; i < rows; ++i) {
-            for (size_t j{0}; j < cols; ++j) {
-                transposed_matrix[i][j] = m_data[j][i];
-            }
+    [[nodiscard]] constexpr Matrix<T, cols, rows> get_transpose() const {
+        if constexpr (rows == cols && detail::is_small_square_v<T, rows>) {
+            return detail::small_transpose(*this);
         }
+        Matrix<T, cols, rows> transposed_matrix{};
+        detail::transpose(*this, transposed_matrix, rows, cols);
         return transposed_matrix;
     }
     [[nodiscard]] constexpr bool is_orthogonal() const {
@@ -168,118 +139,109 @@ class Matrix {
         }
     }
     // Arithmetic operators
-    [[nodiscard]] friend constexpr Matrix operator+(const Matrix& lhs, const Matrix& rhs) noexcept {
-        Matrix result_matrix{};
-        for (size_t i{0}; i < rows; ++i) {
-            for (size_t j{0}; j < cols; ++j) {
-                result_matrix[i][j] = lhs[i][j] + rhs[i][j];
-            }
+    // element wise +, -, scalar * and / and negation build expressions, see matrix_expression.hpp
+    /// blocked SIMD kernel for large floating point products, unrolled SIMD for 4x4 float and
+    /// double, a plain loop otherwise and at compile time
+    template <size_t other_cols>
+    [[nodiscard]] constexpr Matrix<T, rows, other_cols>
+    operator*(const Matrix<T, cols, other_cols>& other) const {
+        if constexpr (rows == cols && cols == other_cols && detail::is_small_square_v<T, rows>) {
+            return detail::small_multiply(*this, other);
         }
-        return result_matrix;
-    }
-    [[nodiscard]] constexpr Matrix operator+(const T& scalar) const noexcept {
-        Matrix<T, cols, rows> result_matrix = {};
-        for (size_t i{0}; i < rows; ++i) {
-            for (size_t j{0}; j < cols; ++j) {
-                result_matrix[i][j] = m_data[i][j] + scalar;
+        Matrix<T, rows, other_cols> result_matrix{};
+        if constexpr (shiv::FloatingPoint<T> && rows * cols * other_cols > gemm_threshold) {
+            if (!std::is_constant_evaluated()) {
+                shiv::gemm(rows, other_cols, cols, T{1}, m_data[0].data(), cols, 1,
+                           other[0].data(), other_cols, 1, T{}, result_matrix[0].data(),
+                           other_cols, 1);
+                return result_matrix;
             }
         }
-        return result_matrix;
-    }
-    [[nodiscard]] friend constexpr Matrix operator-(const Matrix& lhs, const Matrix& rhs) noexcept {
-        Matrix result_matrix{};
+        // dot product form, for small fixed sizes the compiler unrolls and vectorises it well.
+        // 16 bit types sum in float
+        using accumulator = detail::accumulator_t<T>;
         for (size_t i{0}; i < rows; ++i) {
-            for (size_t j{0}; j < cols; ++j) { // m_data[x] will all have same .size()
-                result_matrix[i][j] = lhs[i][j] - rhs[i][j];
-            }
-        }
-        return result_matrix;
-    }
-    [[nodiscard]] constexpr Matrix operator-(const T& scalar) const noexcept {
-        Matrix result_matrix{};
-        for (size_t i{0}; i < rows; ++i) {
-            for (size_t j{0}; j < cols; ++j) {
-                result_matrix[i][j] = m_data[i][j] - scalar;
+            for (size_t j{0}; j < other_cols; ++j) {
+                accumulator sum{};
+                for (size_t k{0}; k < cols; ++k) {
+                    sum += static_cast<accumulator>(m_data[i][k]) *
+                           static_cast<accumulator>(other[k][j]);
+                }
+                result_matrix[i][j] = static_cast<T>(sum);
             }
         }
         return result_matrix;
     }
     template <size_t otherRows, size_t otherCols>
-    [[nodiscard]] constexpr Matrix<T, cols, otherRows>
-    operator*(const Matrix<T, otherCols, otherRows>& other) const noexcept {
-        Matrix<T, cols, otherRows> result_matrix{};
-        for (size_t i{0}; i < otherRows; ++i) {
+    [[nodiscard]] constexpr auto operator/(const Matrix<T, otherCols, otherRows>& other) const {
+        Matrix inverted_matrix{other.get_inverse()};
+        return (*this * inverted_matrix);
+    }
+
+    /// evaluates an element wise expression in one pass, it may refer to this matrix
+    template <MatrixExpression E>
+    requires(!detail::is_matrix_v<E> && SameShapeExpressions<Matrix, E>)
+    constexpr Matrix& operator=(const E& expression) noexcept {
+        for (size_t i{0}; i < rows; ++i) {
             for (size_t j{0}; j < cols; ++j) {
-                for (size_t k{0}; k < rows; ++k) {
-                    result_matrix[i][j] += m_data[i][k] * other[k][j];
-                }
+                m_data[i][j] = expression(i, j);
             }
         }
-        return result_matrix;
+        return *this;
     }
-    [[nodiscard]] constexpr Matrix operator*(const T& scalar) const noexcept {
-        Matrix result_matrix{};
+
+    // Arithmetic assignment operators, element wise ones update in place
+    template <MatrixExpression E>
+    requires SameShapeExpressions<Matrix, E>
+    constexpr Matrix& operator+=(const E& expression) noexcept {
         for (size_t i{0}; i < rows; ++i) {
             for (size_t j{0}; j < cols; ++j) {
-                result_matrix[i][j] = m_data[i][j] * scalar;
+                m_data[i][j] += expression(i, j);
             }
         }
-        return result_matrix;
+        return *this;
     }
-    template <size_t otherRows, size_t otherCols>
-    [[nodiscard]] constexpr auto operator/(Matrix<T, otherCols, otherRows>& other) const noexcept {
-        Matrix inverted_matrix{other.get_inverse()};
-        return (*this * inverted_matrix);
+    constexpr Matrix& operator+=(const T& scalar) noexcept {
+        for (auto&& value : *this) {
+            value += scalar;
+        }
+        return *this;
     }
-    [[nodiscard]] constexpr Matrix operator/(const T& scalar) const noexcept {
-        Matrix result_matrix{};
+    template <MatrixExpression E>
+    requires SameShapeExpressions<Matrix, E>
+    constexpr Matrix& operator-=(const E& expression) noexcept {
         for (size_t i{0}; i < rows; ++i) {
             for (size_t j{0}; j < cols; ++j) {
-                result_matrix[i][j] = m_data[i][j] / scalar;
+                m_data[i][j] -= expression(i, j);
             }
         }
-        return result_matrix;
-    }
-    [[nodiscard]] friend constexpr Matrix operator-(Matrix& matrix) noexcept {
-        for (auto&& i : matrix) {
-            i = -i;
-        }
-        return matrix;
-    }
-
-    // Arithmetic assignment operators
-    friend constexpr Matrix& operator+=(Matrix& lhs, const Matrix& rhs) noexcept {
-        lhs = lhs + rhs;
-        return lhs;
-    }
-    constexpr Matrix& operator+=(const T& scalar) noexcept {
-        *this = *this + scalar;
         return *this;
     }
-    friend constexpr Matrix& operator-=(Matrix& lhs, const Matrix& rhs) noexcept {
-        lhs = lhs - rhs;
-        return lhs;
-    }
     constexpr Matrix& operator-=(const T& scalar) noexcept {
-        *this = *this - scalar;
+        for (auto&& value : *this) {
+            value -= scalar;
+        }
         return *this;
     }
-    template <size_t other_rows, size_t other_cols>
-    constexpr auto& operator*=(const Matrix<T, other_cols, other_rows>& other) noexcept {
+    constexpr Matrix& operator*=(const Matrix<T, cols, cols>& other) {
         *this = *this * other;
         return *this;
     }
     constexpr Matrix& operator*=(const T& scalar) noexcept {
-        *this = *this * scalar;
+        for (auto&& value : *this) {
+            value *= scalar;
+        }
         return *this;
     }
     template <size_t other_rows, size_t other_cols>
-    constexpr auto& operator/=(const Matrix<T, other_cols, other_rows>& other) noexcept {
+    constexpr auto& operator/=(const Matrix<T, other_cols, other_rows>& other) {
         *this = *this / other;
         return *this;
     }
     constexpr Matrix& operator/=(const T& scalar) noexcept {
-        *this = *this / scalar;
+        for (auto&& value : *this) {
+            value /= scalar;
+        }
         return *this;
     }
 
@@ -290,6 +252,14 @@ class Matrix {
     [[nodiscard]] constexpr const shiv::Array<T, cols>& operator[](size_t index) const noexcept {
         return m_data[index];
     }
+    /// unchecked, the same access expressions use
+    [[nodiscard]] constexpr reference operator()(size_t row_index, size_t col_index) noexcept {
+        return m_data[row_index][col_index];
+    }
+    [[nodiscard]] constexpr const_reference operator()(size_t row_index,
+                                                       size_t col_index) const noexcept {
+        return m_data[row_index][col_index];
+    }
     [[nodiscard]] constexpr reference at(size_t row_index, size_t col_index) {
         if (row_index >= rows || col_index >= cols) {
             throw std::out_of_range{"Element out of range"};
@@ -0,0 +1,460 @@
+#ifndef SHIVLIB_DATASTRUCTURE_MATRIX_BATCH_HPP
+#define SHIVLIB_DATASTRUCTURE_MATRIX_BATCH_HPP
+
+#include "../concepts.hpp"
+#include "../memory.hpp"
+#include "gemm.hpp"
+#include "matrix.hpp"
+#include "small_matrix.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace shiv {
+namespace detail {
+// One register of lanes of the same element, from consecutive matrices of a block, with the
+// arithmetic the closed form kernels in small_matrix.hpp use, so they run a register of
+// matrices at a time.
+template <typename T>
+struct BatchVec {
+    using simd = SimdVec<T>;
+    typename simd::reg value{simd::zero()};
+
+    BatchVec() = default;
+    // implicit so T{1} and T{} in the kernels broadcast
+    BatchVec(T scalar) noexcept
+    : value{simd::broadcast(scalar)} {
+    }
+    [[nodiscard]] static BatchVec of(typename simd::reg reg) noexcept {
+        BatchVec result{};
+        result.value = reg;
+        return result;
+    }
+    [[nodiscard]] static BatchVec load(const T* ptr) noexcept {
+        return of(simd::load(ptr));
+    }
+    void store(T* ptr) const noexcept {
+        simd::store(ptr, value);
+    }
+
+    [[nodiscard]] friend BatchVec operator+(BatchVec lhs, BatchVec rhs) noexcept {
+        return of(lhs.value + rhs.value);
+    }
+    [[nodiscard]] friend BatchVec operator-(BatchVec lhs, BatchVec rhs) noexcept {
+        return of(lhs.value - rhs.value);
+    }
+    [[nodiscard]] friend BatchVec operator*(BatchVec lhs, BatchVec rhs) noexcept {
+        return of(lhs.value * rhs.value);
+    }
+    [[nodiscard]] friend BatchVec operator/(BatchVec lhs, BatchVec rhs) noexcept {
+        return of(lhs.value / rhs.value);
+    }
+    [[nodiscard]] BatchVec operator-() const noexcept {
+        return of(-value);
+    }
+};
+
+// a register of matrices starting at first in a block, indexable as matrix[i][j], reading an
+// element loads those lanes of it
+template <typename T, size_t cols, size_t lanes>
+class BatchVecIn {
+    const T* m_first;
+
+    class Row {
+        const T* m_first;
+
+      public:
+        explicit Row(const T* first) noexcept
+        : m_first{first} {
+        }
+        [[nodiscard]] BatchVec<T> operator[](size_t col) const noexcept {
+            return BatchVec<T>::load(m_first + col * lanes);
+        }
+    };
+
+  public:
+    explicit BatchVecIn(const T* first) noexcept
+    : m_first{first} {
+    }
+    [[nodiscard]] Row operator[](size_t row) const noexcept {
+        return Row{m_first + row * cols * lanes};
+    }
+};
+// as BatchVecIn, assigning to an element stores those lanes of it
+template <typename T, size_t cols, size_t lanes>
+class BatchVecOut {
+    T* m_first;
+
+    class Element {
+        T* m_ptr;
+
+      public:
+        explicit Element(T* ptr) noexcept
+        : m_ptr{ptr} {
+        }
+        const Element& operator=(const BatchVec<T>& value) const noexcept {
+            value.store(m_ptr);
+            return *this;
+        }
+    };
+    class Row {
+        T* m_first;
+
+      public:
+        explicit Row(T* first) noexcept
+        : m_first{first} {
+        }
+        [[nodiscard]] Element operator[](size_t col) const noexcept {
+            return Element{m_first + col * lanes};
+        }
+    };
+
+  public:
+    explicit BatchVecOut(T* first) noexcept
+    : m_first{first} {
+    }
+    [[nodiscard]] Row operator[](size_t row) const noexcept {
+        return Row{m_first + row * cols * lanes};
+    }
+};
+
+inline void check_batch_sizes(size_t lhs, size_t rhs) {
+    if (lhs != rhs) {
+        throw std::invalid_argument{"Batch sizes do not match"};
+    }
+}
+} // namespace detail
+
+template <shiv::Arithmetic T, size_t rows, size_t cols>
+class MatrixBatch;
+
+template <typename T, size_t rows, size_t inner, size_t cols>
+void batch_multiply(const MatrixBatch<T, rows, inner>& lhs, const MatrixBatch<T, inner, cols>& rhs,
+                    MatrixBatch<T, rows, cols>& out);
+template <typename T, size_t rows, size_t cols>
+void batch_add(const MatrixBatch<T, rows, cols>& lhs, const MatrixBatch<T, rows, cols>& rhs,
+               MatrixBatch<T, rows, cols>& out);
+template <typename T, size_t rows, size_t cols>
+void batch_subtract(const MatrixBatch<T, rows, cols>& lhs, const MatrixBatch<T, rows, cols>& rhs,
+                    MatrixBatch<T, rows, cols>& out);
+template <typename T, size_t n>
+void batch_inverse(const MatrixBatch<T, n, n>& in, MatrixBatch<T, n, n>& out);
+template <typename T, size_t n>
+void batch_determinant(const MatrixBatch<T, n, n>& in, T* out);
+
+/// A batch of same sized matrices stored interleaved by element. Matrices are grouped into
+/// blocks of lanes, a block holds element (0, 0) of each of its matrices in one cache line,
+/// then element (0, 1) and so on, so every operation is a loop over whole cache lines that
+/// works on a full SIMD register of matrices at a time. The last block is padded with zeros.
+template <shiv::Arithmetic T, size_t rows, size_t cols>
+class MatrixBatch {
+  public:
+    using value_type = T;
+    using matrix_type = Matrix<T, rows, cols>;
+    static constexpr size_t row_count{rows};
+    static constexpr size_t col_count{cols};
+    /// matrices per block
+    static constexpr size_t lanes{shiv::max(cache_line_size / sizeof(T), size_t{1})};
+    /// elements per block
+    static constexpr size_t block_size{rows * cols * lanes};
+
+  private:
+    std::vector<T, AlignedAllocator<T>> m_data{};
+    size_t m_size{0};
+
+    [[nodiscard]] static constexpr size_t offset(size_t index, size_t row, size_t col) noexcept {
+        return index / lanes * block_size + (row * cols + col) * lanes + index % lanes;
+    }
+
+    void check_same_size(size_t other_size) const {
+        detail::check_batch_sizes(m_size, other_size);
+    }
+
+  public:
+    MatrixBatch() = default;
+    /// count zero matrices
+    explicit MatrixBatch(size_t count)
+    : m_data((count + lanes - 1) / lanes * block_size)
+    , m_size{count} {
+    }
+    explicit MatrixBatch(const shiv::Vector<matrix_type>& matrices) {
+        assign(matrices);
+    }
+
+    /// replaces the batch with matrices, storage is reused when it fits
+    void assign(const shiv::Vector<matrix_type>& matrices) {
+        resize(matrices.size());
+        for (size_t index{0}; index < m_size; ++index) {
+            T* first{block(index / lanes) + index % lanes};
+            const T* elements{&matrices[index][0][0]};
+            for (size_t element{0}; element < rows * cols; ++element) {
+                first[element * lanes] = elements[element];
+            }
+        }
+    }
+    /// existing matrices keep their values, new ones are zero, storage is reused when it fits
+    void resize(size_t count) {
+        m_data.resize((count + lanes - 1) / lanes * block_size);
+        m_size = count;
+        clear_padding();
+    }
+    /// lanes past the end of the batch are kept at zero, kernels that write whole blocks call
+    /// this afterwards
+    void clear_padding() noexcept {
+        const size_t used{m_size % lanes};
+        if (used == 0) {
+            return;
+        }
+        T* last{block(blocks() - 1)};
+        for (size_t element{0}; element < rows * cols; ++element) {
+            for (size_t lane{used}; lane < lanes; ++lane) {
+                last[element * lanes + lane] = T{};
+            }
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return m_size;
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return m_size == 0;
+    }
+    [[nodiscard]] size_t blocks() const noexcept {
+        return m_data.size() / block_size;
+    }
+    [[nodiscard]] T* block(size_t index) noexcept {
+        return m_data.data() + index * block_size;
+    }
+    [[nodiscard]] const T* block(size_t index) const noexcept {
+        return m_data.data() + index * block_size;
+    }
+
+    // Element access
+    /// unchecked, element (row, col) of matrix index
+    [[nodiscard]] T& operator()(size_t index, size_t row, size_t col) noexcept {
+        return m_data[offset(index, row, col)];
+    }
+    [[nodiscard]] const T& operator()(size_t index, size_t row, size_t col) const noexcept {
+        return m_data[offset(index, row, col)];
+    }
+    [[nodiscard]] T& at(size_t index, size_t row, size_t col) {
+        if (index >= m_size || row >= rows || col >= cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return m_data[offset(index, row, col)];
+    }
+    [[nodiscard]] const T& at(size_t index, size_t row, size_t col) const {
+        if (index >= m_size || row >= rows || col >= cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return m_data[offset(index, row, col)];
+    }
+    /// gathers matrix index out of its block
+    [[nodiscard]] matrix_type get(size_t index) const noexcept {
+        matrix_type matrix{};
+        for (size_t i{0}; i < rows; ++i) {
+            for (size_t j{0}; j < cols; ++j) {
+                matrix[i][j] = (*this)(index, i, j);
+            }
+        }
+        return matrix;
+    }
+    void set(size_t index, const matrix_type& matrix) noexcept {
+        for (size_t i{0}; i < rows; ++i) {
+            for (size_t j{0}; j < cols; ++j) {
+                (*this)(index, i, j) = matrix[i][j];
+            }
+        }
+    }
+    [[nodiscard]] shiv::Vector<matrix_type> to_vector() const {
+        shiv::Vector<matrix_type> matrices(m_size);
+        for (size_t index{0}; index < m_size; ++index) {
+            const T* first{block(index / lanes) + index % lanes};
+            matrix_type matrix{};
+            T* elements{&matrix[0][0]};
+            for (size_t element{0}; element < rows * cols; ++element) {
+                elements[element] = first[element * lanes];
+            }
+            matrices.push_back(matrix);
+        }
+        return matrices;
+    }
+
+    /// determinant of every matrix, see batch_determinant
+    [[nodiscard]] shiv::Vector<T> get_determinant() const {
+        shiv::Vector<T> determinants(m_size);
+        for (size_t i{0}; i < m_size; ++i) {
+            determinants.push_back(T{});
+        }
+        batch_determinant(*this, determinants.begin());
+        return determinants;
+    }
+    /// inverse of every matrix, see batch_inverse
+    [[nodiscard]] MatrixBatch get_inverse() const {
+        MatrixBatch result_batch{};
+        batch_inverse(*this, result_batch);
+        return result_batch;
+    }
+
+    // Arithmetic operators, the batch_ functions below write into an existing batch instead
+    [[nodiscard]] friend MatrixBatch operator+(const MatrixBatch& lhs, const MatrixBatch& rhs) {
+        MatrixBatch result_batch{};
+        batch_add(lhs, rhs, result_batch);
+        return result_batch;
+    }
+    [[nodiscard]] friend MatrixBatch operator-(const MatrixBatch& lhs, const MatrixBatch& rhs) {
+        MatrixBatch result_batch{};
+        batch_subtract(lhs, rhs, result_batch);
+        return result_batch;
+    }
+    [[nodiscard]] MatrixBatch operator*(const T& scalar) const {
+        MatrixBatch result_batch{*this};
+        result_batch *= scalar;
+        return result_batch;
+    }
+    /// the product of each pair of matrices
+    template <size_t other_cols>
+    [[nodiscard]] MatrixBatch<T, rows, other_cols>
+    operator*(const MatrixBatch<T, cols, other_cols>& other) const {
+        MatrixBatch<T, rows, other_cols> result_batch{};
+        batch_multiply(*this, other, result_batch);
+        return result_batch;
+    }
+
+    // Arithmetic assignment operators
+    MatrixBatch& operator+=(const MatrixBatch& other) {
+        check_same_size(other.m_size);
+        for (size_t i{0}; i < m_data.size(); ++i) {
+            m_data[i] += other.m_data[i];
+        }
+        return *this;
+    }
+    MatrixBatch& operator-=(const MatrixBatch& other) {
+        check_same_size(other.m_size);
+        for (size_t i{0}; i < m_data.size(); ++i) {
+            m_data[i] -= other.m_data[i];
+        }
+        return *this;
+    }
+    MatrixBatch& operator*=(const T& scalar) noexcept {
+        for (auto&& value : m_data) {
+            value *= scalar;
+        }
+        return *this;
+    }
+
+    // Comparison
+    [[nodiscard]] friend bool operator==(const MatrixBatch& lhs, const MatrixBatch& rhs) noexcept {
+        return lhs.m_size == rhs.m_size && lhs.m_data == rhs.m_data;
+    }
+    [[nodiscard]] friend bool operator!=(const MatrixBatch& lhs, const MatrixBatch& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+};
+/// out = lhs * rhs for each pair of matrices, out is resized to match and must not be either
+/// operand
+template <typename T, size_t rows, size_t inner, size_t cols>
+void batch_multiply(const MatrixBatch<T, rows, inner>& lhs, const MatrixBatch<T, inner, cols>& rhs,
+                    MatrixBatch<T, rows, cols>& out) {
+    using simd = detail::SimdVec<T>;
+    constexpr size_t lanes{MatrixBatch<T, rows, cols>::lanes};
+    detail::check_batch_sizes(lhs.size(), rhs.size());
+    out.resize(lhs.size());
+    for (size_t b{0}; b < lhs.blocks(); ++b) {
+        for (size_t lane{0}; lane < lanes; lane += simd::width) {
+            const T* a_first{lhs.block(b) + lane};
+            const T* b_first{rhs.block(b) + lane};
+            T* out_first{out.block(b) + lane};
+            for (size_t i{0}; i < rows; ++i) {
+                for (size_t j{0}; j < cols; ++j) {
+                    typename simd::reg sum{simd::zero()};
+                    for (size_t k{0}; k < inner; ++k) {
+                        sum = simd::fmadd(simd::load(a_first + (i * inner + k) * lanes),
+                                          simd::load(b_first + (k * cols + j) * lanes), sum);
+                    }
+                    simd::store(out_first + (i * cols + j) * lanes, sum);
+                }
+            }
+        }
+    }
+}
+
+/// out = lhs + rhs, out is resized to match and may be either operand
+template <typename T, size_t rows, size_t cols>
+void batch_add(const MatrixBatch<T, rows, cols>& lhs, const MatrixBatch<T, rows, cols>& rhs,
+               MatrixBatch<T, rows, cols>& out) {
+    detail::check_batch_sizes(lhs.size(), rhs.size());
+    out.resize(lhs.size());
+    const size_t count{lhs.blocks() * MatrixBatch<T, rows, cols>::block_size};
+    const T* a{lhs.block(0)};
+    const T* b{rhs.block(0)};
+    T* c{out.block(0)};
+    for (size_t i{0}; i < count; ++i) {
+        c[i] = a[i] + b[i];
+    }
+}
+/// out = lhs - rhs, out is resized to match and may be either operand
+template <typename T, size_t rows, size_t cols>
+void batch_subtract(const MatrixBatch<T, rows, cols>& lhs, const MatrixBatch<T, rows, cols>& rhs,
+                    MatrixBatch<T, rows, cols>& out) {
+    detail::check_batch_sizes(lhs.size(), rhs.size());
+    out.resize(lhs.size());
+    const size_t count{lhs.blocks() * MatrixBatch<T, rows, cols>::block_size};
+    const T* a{lhs.block(0)};
+    const T* b{rhs.block(0)};
+    T* c{out.block(0)};
+    for (size_t i{0}; i < count; ++i) {
+        c[i] = a[i] - b[i];
+    }
+}
+
+/// Inverse of every matrix into out, closed form for 2x2 to 4x4 float and double. out is
+/// resized to match and must not be in. Throws std::domain_error if any matrix is singular.
+template <typename T, size_t n>
+void batch_inverse(const MatrixBatch<T, n, n>& in, MatrixBatch<T, n, n>& out) {
+    static_assert(detail::is_small_square_v<T, n>,
+                  "Batched inverses are for 2x2 to 4x4 float and double matrices");
+    constexpr size_t lanes{MatrixBatch<T, n, n>::lanes};
+    constexpr size_t width{detail::SimdVec<T>::width};
+    out.resize(in.size());
+    bool singular{false};
+    for (size_t b{0}; b < in.blocks(); ++b) {
+        T determinants[lanes];
+        for (size_t lane{0}; lane < lanes; lane += width) {
+            detail::BatchVecOut<T, n, lanes> inverse{out.block(b) + lane};
+            detail::small_inverse_into<n>(detail::BatchVecIn<T, n, lanes>{in.block(b) + lane},
+                                          inverse)
+                .store(determinants + lane);
+        }
+        for (size_t lane{0}; lane < lanes && b * lanes + lane < in.size(); ++lane) {
+            singular |= determinants[lane] == T{};
+        }
+    }
+    out.clear_padding();
+    if (singular) {
+        throw std::domain_error{"Matrix is singular"};
+    }
+}
+
+/// writes the determinant of every matrix to out[0, in.size()), closed form for 2x2 to 4x4
+/// float and double
+template <typename T, size_t n>
+void batch_determinant(const MatrixBatch<T, n, n>& in, T* out) {
+    static_assert(detail::is_small_square_v<T, n>,
+                  "Batched determinants are for 2x2 to 4x4 float and double matrices");
+    constexpr size_t lanes{MatrixBatch<T, n, n>::lanes};
+    constexpr size_t width{detail::SimdVec<T>::width};
+    for (size_t b{0}; b < in.blocks(); ++b) {
+        T determinants[lanes];
+        for (size_t lane{0}; lane < lanes; lane += width) {
+            detail::small_determinant<n>(detail::BatchVecIn<T, n, lanes>{in.block(b) + lane})
+                .store(determinants + lane);
+        }
+        std::copy(determinants, determinants + shiv::min(lanes, in.size() - b * lanes),
+                  out + b * lanes);
+    }
+}
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_MATRIX_BATCH_HPP
@@ -0,0 +1,176 @@
+#ifndef SHIVLIB_DATASTRUCTURE_MATRIX_EXPRESSION_HPP
+#define SHIVLIB_DATASTRUCTURE_MATRIX_EXPRESSION_HPP
+
+#include "../concepts.hpp"
+#include "array.hpp"
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Element wise Matrix arithmetic builds a tree of lightweight nodes instead of a matrix per
+// operator. Nothing is computed until the tree is assigned or converted to a Matrix, which then
+// runs one loop that evaluates the whole chain per element. Nodes refer to the named matrices
+// they were built from, so evaluate them before those matrices go out of scope. Temporary
+// matrices are moved into the node instead, so auto expression{make() + make()} is safe.
+
+namespace shiv {
+template <shiv::Arithmetic T, size_t rows, size_t cols>
+class Matrix;
+
+namespace detail {
+template <typename T>
+struct is_matrix : std::false_type {};
+template <typename T, size_t rows, size_t cols>
+struct is_matrix<Matrix<T, rows, cols>> : std::true_type {};
+template <typename T>
+inline constexpr bool is_matrix_v{is_matrix<std::remove_cvref_t<T>>::value};
+} // namespace detail
+
+/// a Matrix or an unevaluated element wise expression over matrices
+template <typename E>
+concept MatrixExpression = requires(const E& expression) {
+    typename E::value_type;
+    { E::row_count } -> std::convertible_to<size_t>;
+    { E::col_count } -> std::convertible_to<size_t>;
+    { expression(size_t{0}, size_t{0}) } -> std::convertible_to<typename E::value_type>;
+};
+
+template <typename L, typename R>
+concept SameShapeExpressions = MatrixExpression<L> && MatrixExpression<R> &&
+                               std::same_as<typename L::value_type, typename R::value_type> &&
+                               L::row_count == R::row_count && L::col_count == R::col_count;
+
+namespace detail {
+// E as an operator deduced it. Matrix lvalues are held by reference, Matrix rvalues and nodes,
+// which are small, by value.
+template <typename E>
+using expression_storage_t =
+    std::conditional_t<is_matrix_v<E> && std::is_lvalue_reference_v<E>,
+                       const std::remove_reference_t<E>&, const std::remove_cvref_t<E>>;
+template <typename E>
+using expression_t = std::remove_cvref_t<E>;
+
+template <typename Derived, typename T, size_t rows, size_t cols>
+class MatrixExpressionBase {
+  public:
+    using value_type = T;
+    static constexpr size_t row_count{rows};
+    static constexpr size_t col_count{cols};
+
+    [[nodiscard]] constexpr Matrix<T, rows, cols> eval() const noexcept {
+        Matrix<T, rows, cols> result_matrix{};
+        result_matrix = static_cast<const Derived&>(*this);
+        return result_matrix;
+    }
+    constexpr operator Matrix<T, rows, cols>() const noexcept {
+        return eval();
+    }
+    // lets Matrix<T, rows, cols> matrix{expression} aggregate initialise its storage
+    constexpr operator shiv::Array<shiv::Array<T, cols>, rows>() const noexcept {
+        return eval().m_data;
+    }
+};
+
+template <typename Op, typename L, typename R>
+class MatrixBinary
+: public MatrixExpressionBase<MatrixBinary<Op, L, R>, typename expression_t<L>::value_type,
+                              expression_t<L>::row_count, expression_t<L>::col_count> {
+    expression_storage_t<L> m_lhs;
+    expression_storage_t<R> m_rhs;
+
+  public:
+    constexpr MatrixBinary(L&& lhs, R&& rhs) noexcept
+    : m_lhs{std::forward<L>(lhs)}
+    , m_rhs{std::forward<R>(rhs)} {
+    }
+    [[nodiscard]] constexpr auto operator()(size_t row, size_t col) const noexcept {
+        return Op{}(m_lhs(row, col), m_rhs(row, col));
+    }
+};
+
+template <typename Op, typename E>
+class MatrixScalar
+: public MatrixExpressionBase<MatrixScalar<Op, E>, typename expression_t<E>::value_type,
+                              expression_t<E>::row_count, expression_t<E>::col_count> {
+    expression_storage_t<E> m_expression;
+    typename expression_t<E>::value_type m_scalar;
+
+  public:
+    constexpr MatrixScalar(E&& expression,
+                           const typename expression_t<E>::value_type& scalar) noexcept
+    : m_expression{std::forward<E>(expression)}
+    , m_scalar{scalar} {
+    }
+    [[nodiscard]] constexpr auto operator()(size_t row, size_t col) const noexcept {
+        return Op{}(m_expression(row, col), m_scalar);
+    }
+};
+
+template <typename Op, typename E>
+class MatrixUnary
+: public MatrixExpressionBase<MatrixUnary<Op, E>, typename expression_t<E>::value_type,
+                              expression_t<E>::row_count, expression_t<E>::col_count> {
+    expression_storage_t<E> m_expression;
+
+  public:
+    explicit constexpr MatrixUnary(E&& expression) noexcept
+    : m_expression{std::forward<E>(expression)} {
+    }
+    [[nodiscard]] constexpr auto operator()(size_t row, size_t col) const noexcept {
+        return Op{}(m_expression(row, col));
+    }
+};
+} // namespace detail
+
+template <typename L, typename R>
+requires SameShapeExpressions<detail::expression_t<L>, detail::expression_t<R>>
+[[nodiscard]] constexpr auto operator+(L&& lhs, R&& rhs) noexcept {
+    return detail::MatrixBinary<std::plus<>, L, R>{std::forward<L>(lhs), std::forward<R>(rhs)};
+}
+template <typename L, typename R>
+requires SameShapeExpressions<detail::expression_t<L>, detail::expression_t<R>>
+[[nodiscard]] constexpr auto operator-(L&& lhs, R&& rhs) noexcept {
+    return detail::MatrixBinary<std::minus<>, L, R>{std::forward<L>(lhs), std::forward<R>(rhs)};
+}
+template <typename E>
+requires MatrixExpression<detail::expression_t<E>>
+[[nodiscard]] constexpr auto
+operator+(E&& expression, const typename detail::expression_t<E>::value_type& scalar) noexcept {
+    return detail::MatrixScalar<std::plus<>, E>{std::forward<E>(expression), scalar};
+}
+template <typename E>
+requires MatrixExpression<detail::expression_t<E>>
+[[nodiscard]] constexpr auto
+operator-(E&& expression, const typename detail::expression_t<E>::value_type& scalar) noexcept {
+    return detail::MatrixScalar<std::minus<>, E>{std::forward<E>(expression), scalar};
+}
+template <typename E>
+requires MatrixExpression<detail::expression_t<E>>
+[[nodiscard]] constexpr auto
+operator*(E&& expression, const typename detail::expression_t<E>::value_type& scalar) noexcept {
+    return detail::MatrixScalar<std::multiplies<>, E>{std::forward<E>(expression), scalar};
+}
+template <typename E>
+requires MatrixExpression<detail::expression_t<E>>
+[[nodiscard]] constexpr auto
+operator/(E&& expression, const typename detail::expression_t<E>::value_type& scalar) noexcept {
+    return detail::MatrixScalar<std::divides<>, E>{std::forward<E>(expression), scalar};
+}
+template <typename E>
+requires MatrixExpression<detail::expression_t<E>>
+[[nodiscard]] constexpr auto operator-(E&& expression) noexcept {
+    return detail::MatrixUnary<std::negate<>, E>{std::forward<E>(expression)};
+}
+
+/// a matrix product is not element wise, so an expression operand is evaluated first
+template <MatrixExpression L, MatrixExpression R>
+requires(!(detail::is_matrix_v<L> && detail::is_matrix_v<R>) && L::col_count == R::row_count)
+[[nodiscard]] constexpr auto operator*(const L& lhs, const R& rhs) {
+    const Matrix<typename L::value_type, L::row_count, L::col_count> lhs_matrix{lhs};
+    const Matrix<typename R::value_type, R::row_count, R::col_count> rhs_matrix{rhs};
+    return lhs_matrix * rhs_matrix;
+}
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_MATRIX_EXPRESSION_HPP
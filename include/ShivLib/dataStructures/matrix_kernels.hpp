@@ -0,0 +1,164 @@
+#ifndef SHIVLIB_DATASTRUCTURE_MATRIX_KERNELS_HPP
+#define SHIVLIB_DATASTRUCTURE_MATRIX_KERNELS_HPP
+
+#include "../algorithm.hpp"
+#include "../cstddef.hpp"
+#include <type_traits>
+#include <utility>
+
+// Algorithms shared by Matrix and DynMatrix. They take anything indexable as matrix[i][j] so the
+// fixed size Matrix keeps working at compile time.
+
+namespace shiv::detail {
+template <typename Mat>
+using matrix_element_t = std::remove_cvref_t<decltype(std::declval<Mat&>()[0][0])>;
+
+template <typename Mat>
+constexpr void swap_rows(Mat& matrix, size_t first, size_t second, size_t cols) {
+    for (size_t j{0}; j < cols; ++j) {
+        std::swap(matrix[first][j], matrix[second][j]);
+    }
+}
+
+/// Forward elimination to row echelon form in place, a zero pivot is swapped with the first non
+/// zero row below it. Returns true if an odd number of rows were swapped.
+template <typename Mat>
+constexpr bool row_echelon(Mat& matrix, size_t rows, size_t cols) {
+    using T = matrix_element_t<Mat>;
+    bool is_inverted{false};
+    if (rows == 0 || cols == 0) {
+        return is_inverted;
+    }
+    for (size_t pivot_row{0}; (rows < cols ? pivot_row < rows - 1 : pivot_row < cols - 1);
+         ++pivot_row) {
+        if (matrix[pivot_row][pivot_row] == 0) {
+            size_t swap_row{pivot_row};
+            for (size_t i{pivot_row + 1}; i < rows; ++i) {
+                if (matrix[i][pivot_row] != 0) {
+                    swap_row = i;
+                    break;
+                }
+            }
+            if (swap_row == pivot_row) {
+                continue;
+            }
+            is_inverted = !is_inverted;
+            swap_rows(matrix, swap_row, pivot_row, cols);
+        }
+        // eliminate everything under the pivot
+        for (size_t target_row{pivot_row + 1}; target_row < rows; ++target_row) {
+            const T scale{matrix[target_row][pivot_row] / matrix[pivot_row][pivot_row]};
+            for (size_t target_col{0}; target_col < cols; ++target_col) {
+                matrix[target_row][target_col] -= scale * matrix[pivot_row][target_col];
+            }
+        }
+    }
+    return is_inverted;
+}
+
+/// determinant of an n x n matrix, scratch is overwritten with its row echelon form
+template <typename Mat>
+constexpr auto determinant(Mat& scratch, size_t n) {
+    using T = matrix_element_t<Mat>;
+    if (n == 0) {
+        return T{1};
+    }
+    if (n == 1) {
+        return scratch[0][0];
+    }
+    if (n == 2) {
+        return (scratch[0][0] * scratch[1][1]) - (scratch[1][0] * scratch[0][1]);
+    }
+    if constexpr (std::is_integral_v<T>) {
+        // Bareiss elimination, each step divides exactly by the previous pivot so integers stay
+        // exact where row_echelon's truncating division would not. The intermediates are minors
+        // of the matrix, so they overflow no sooner than the determinant itself might.
+        T previous{1};
+        bool is_negative{false};
+        for (size_t pivot{0}; pivot + 1 < n; ++pivot) {
+            if (scratch[pivot][pivot] == 0) {
+                size_t swap_row{pivot};
+                for (size_t i{pivot + 1}; i < n; ++i) {
+                    if (scratch[i][pivot] != 0) {
+                        swap_row = i;
+                        break;
+                    }
+                }
+                if (swap_row == pivot) {
+                    return T{0};
+                }
+                is_negative = !is_negative;
+                swap_rows(scratch, swap_row, pivot, n);
+            }
+            for (size_t i{pivot + 1}; i < n; ++i) {
+                for (size_t j{pivot + 1}; j < n; ++j) {
+                    scratch[i][j] = (scratch[i][j] * scratch[pivot][pivot] -
+                                     scratch[i][pivot] * scratch[pivot][j]) /
+                                    previous;
+                }
+            }
+            previous = scratch[pivot][pivot];
+        }
+        return is_negative ? T{0} - scratch[n - 1][n - 1] : scratch[n - 1][n - 1];
+    }
+    // row echelon is calculated first to reduce the complexity down closer to O(N^2)
+    const bool is_negative{row_echelon(scratch, n, n)};
+    T result{1};
+    for (size_t i{0}; i < n; ++i) {
+        result *= scratch[i][i];
+    }
+    return is_negative ? -result : result;
+}
+
+/// Gauss-Jordan inverse of an n x n matrix into out, work is reduced to the identity on the way
+template <typename Mat, typename Out>
+constexpr void invert(Mat& work, Out& out, size_t n) {
+    using T = matrix_element_t<Mat>;
+    for (size_t i{0}; i < n; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            out[i][j] = i == j ? T{1} : T{0};
+        }
+    }
+    // replace elements based on a constant scalar from ANOTHER row
+    for (size_t i{0}; i < n; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            if (i != j) {
+                const T scalar{work[j][i] / work[i][i]};
+                for (size_t k{0}; k < n; ++k) {
+                    work[j][k] -= work[i][k] * scalar;
+                }
+                for (size_t k{0}; k < n; ++k) {
+                    out[j][k] -= out[i][k] * scalar;
+                }
+            }
+        }
+    }
+    // divide each row by the diagonal element that was skipped above
+    for (size_t i{0}; i < n; ++i) {
+        const T scalar{work[i][i]};
+        for (size_t j{0}; j < n; ++j) {
+            out[i][j] = out[i][j] / scalar;
+        }
+        work[i][i] = T{1};
+    }
+}
+
+/// out[j][i] = in[i][j], in square tiles so both sides stay in cache for large matrices
+template <typename Mat, typename Out>
+constexpr void transpose(const Mat& in, Out& out, size_t rows, size_t cols) {
+    constexpr size_t tile{16};
+    for (size_t i0{0}; i0 < rows; i0 += tile) {
+        for (size_t j0{0}; j0 < cols; j0 += tile) {
+            const size_t i_end{shiv::min(i0 + tile, rows)};
+            const size_t j_end{shiv::min(j0 + tile, cols)};
+            for (size_t i{i0}; i < i_end; ++i) {
+                for (size_t j{j0}; j < j_end; ++j) {
+                    out[j][i] = in[i][j];
+                }
+            }
+        }
+    }
+}
+} // namespace shiv::detail
+
+#endif //SHIVLIB_DATASTRUCTURE_MATRIX_KERNELS_HPP
@@ -0,0 +1,360 @@
+#ifndef SHIVLIB_DATASTRUCTURE_MATRIX_VIEW_HPP
+#define SHIVLIB_DATASTRUCTURE_MATRIX_VIEW_HPP
+
+#include "../concepts.hpp"
+#include "dyn_matrix.hpp"
+#include "gemm.hpp"
+#include "lu.hpp"
+#include "matrix.hpp"
+#include <stdexcept>
+#include <type_traits>
+
+namespace shiv {
+/// Non owning view of a rows x cols matrix anywhere in memory, element (i, j) is at
+/// data[i * row_stride + j * col_stride]. Submatrices, transposes, single rows and columns are
+/// views over the same elements, so blocked algorithms can work on parts of a matrix without
+/// copying them out. MatrixView<const T> is read only. Like std::span the view does not own
+/// what it points at, it must not outlive the matrix or buffer it was made from, and copying a
+/// view copies the pointer rather than the elements.
+template <typename T>
+requires shiv::Arithmetic<std::remove_const_t<T>>
+class MatrixView {
+  public:
+    using value_type = std::remove_const_t<T>;
+    using element_type = T;
+    using reference = T&;
+
+  private:
+    T* m_data{nullptr};
+    size_t m_rows{0};
+    size_t m_cols{0};
+    ptrdiff_t m_row_stride{0};
+    ptrdiff_t m_col_stride{1};
+
+    class Row {
+        T* m_first;
+        ptrdiff_t m_col_stride;
+
+      public:
+        constexpr Row(T* first, ptrdiff_t col_stride) noexcept
+        : m_first{first}
+        , m_col_stride{col_stride} {
+        }
+        [[nodiscard]] constexpr T& operator[](size_t col) const noexcept {
+            return m_first[static_cast<ptrdiff_t>(col) * m_col_stride];
+        }
+    };
+
+    template <typename U>
+    void check_same_shape(const MatrixView<U>& other) const {
+        if (m_rows != other.rows() || m_cols != other.cols()) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+    }
+
+  public:
+    constexpr MatrixView() = default;
+    /// row major by default
+    constexpr MatrixView(T* data, size_t rows, size_t cols, ptrdiff_t row_stride,
+                         ptrdiff_t col_stride = 1) noexcept
+    : m_data{data}
+    , m_rows{rows}
+    , m_cols{cols}
+    , m_row_stride{row_stride}
+    , m_col_stride{col_stride} {
+    }
+    constexpr MatrixView(T* data, size_t rows, size_t cols) noexcept
+    : MatrixView(data, rows, cols, static_cast<ptrdiff_t>(cols)) {
+    }
+    // implicit, like std::span, so matrices can be passed wherever a view is expected
+    template <size_t rows_, size_t cols_>
+    constexpr MatrixView(Matrix<value_type, rows_, cols_>& matrix) noexcept
+    : MatrixView(rows_ * cols_ == 0 ? nullptr : &matrix[0][0], rows_, cols_) {
+    }
+    template <size_t rows_, size_t cols_>
+    requires std::is_const_v<T>
+    constexpr MatrixView(const Matrix<value_type, rows_, cols_>& matrix) noexcept
+    : MatrixView(rows_ * cols_ == 0 ? nullptr : &matrix[0][0], rows_, cols_) {
+    }
+    MatrixView(DynMatrix<value_type>& matrix) noexcept
+    : MatrixView(matrix.data(), matrix.rows(), matrix.cols(),
+                 static_cast<ptrdiff_t>(matrix.stride())) {
+    }
+    MatrixView(const DynMatrix<value_type>& matrix) noexcept requires std::is_const_v<T>
+    : MatrixView(matrix.data(), matrix.rows(), matrix.cols(),
+                 static_cast<ptrdiff_t>(matrix.stride())) {
+    }
+    /// a mutable view converts to a read only one
+    constexpr operator MatrixView<const value_type>() const noexcept
+    requires(!std::is_const_v<T>)
+    {
+        return {m_data, m_rows, m_cols, m_row_stride, m_col_stride};
+    }
+
+    [[nodiscard]] constexpr size_t rows() const noexcept {
+        return m_rows;
+    }
+    [[nodiscard]] constexpr size_t cols() const noexcept {
+        return m_cols;
+    }
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return m_rows * m_cols;
+    }
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return size() == 0;
+    }
+    [[nodiscard]] constexpr ptrdiff_t row_stride() const noexcept {
+        return m_row_stride;
+    }
+    [[nodiscard]] constexpr ptrdiff_t col_stride() const noexcept {
+        return m_col_stride;
+    }
+    /// element (0, 0)
+    [[nodiscard]] constexpr T* data() const noexcept {
+        return m_data;
+    }
+
+    // Element access
+    /// unchecked, view[i][j] like Matrix and DynMatrix so the shared kernels take views
+    [[nodiscard]] constexpr Row operator[](size_t row) const noexcept {
+        return Row{m_data + static_cast<ptrdiff_t>(row) * m_row_stride, m_col_stride};
+    }
+    [[nodiscard]] constexpr T& operator()(size_t row, size_t col) const noexcept {
+        return m_data[static_cast<ptrdiff_t>(row) * m_row_stride +
+                      static_cast<ptrdiff_t>(col) * m_col_stride];
+    }
+    [[nodiscard]] constexpr T& at(size_t row, size_t col) const {
+        if (row >= m_rows || col >= m_cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return (*this)(row, col);
+    }
+
+    // Slicing, every slice views the same elements
+    /// the rows x cols block starting at (first_row, first_col), throws std::out_of_range if it
+    /// does not fit
+    [[nodiscard]] constexpr MatrixView submatrix(size_t first_row, size_t first_col, size_t rows,
+                                                 size_t cols) const {
+        if (first_row + rows > m_rows || first_col + cols > m_cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return {rows * cols == 0 ? m_data : &(*this)(first_row, first_col), rows, cols,
+                m_row_stride, m_col_stride};
+    }
+    /// 1 x cols
+    [[nodiscard]] constexpr MatrixView row(size_t index) const {
+        return submatrix(index, 0, 1, m_cols);
+    }
+    /// rows x 1
+    [[nodiscard]] constexpr MatrixView col(size_t index) const {
+        return submatrix(0, index, m_rows, 1);
+    }
+    /// swaps the strides, no elements move
+    [[nodiscard]] constexpr MatrixView transposed() const noexcept {
+        return {m_data, m_cols, m_rows, m_col_stride, m_row_stride};
+    }
+    [[nodiscard]] DynMatrix<value_type> to_dyn_matrix() const {
+        DynMatrix<value_type> result_matrix{m_rows, m_cols};
+        for (size_t i{0}; i < m_rows; ++i) {
+            for (size_t j{0}; j < m_cols; ++j) {
+                result_matrix[i][j] = (*this)(i, j);
+            }
+        }
+        return result_matrix;
+    }
+
+    // Writing through the view
+    void fill(const value_type& value) const requires(!std::is_const_v<T>) {
+        for_each([&value](T& element) { element = value; });
+    }
+    /// copies other's elements into the viewed ones, throws std::invalid_argument if the shapes
+    /// differ. The two may only overlap if they view exactly the same elements.
+    void assign(MatrixView<const value_type> other) const requires(!std::is_const_v<T>) {
+        check_same_shape(other);
+        for (size_t i{0}; i < m_rows; ++i) {
+            for (size_t j{0}; j < m_cols; ++j) {
+                (*this)(i, j) = other(i, j);
+            }
+        }
+    }
+    const MatrixView& operator+=(MatrixView<const value_type> other) const
+    requires(!std::is_const_v<T>)
+    {
+        check_same_shape(other);
+        for (size_t i{0}; i < m_rows; ++i) {
+            for (size_t j{0}; j < m_cols; ++j) {
+                (*this)(i, j) += other(i, j);
+            }
+        }
+        return *this;
+    }
+    const MatrixView& operator-=(MatrixView<const value_type> other) const
+    requires(!std::is_const_v<T>)
+    {
+        check_same_shape(other);
+        for (size_t i{0}; i < m_rows; ++i) {
+            for (size_t j{0}; j < m_cols; ++j) {
+                (*this)(i, j) -= other(i, j);
+            }
+        }
+        return *this;
+    }
+    const MatrixView& operator*=(const value_type& scalar) const requires(!std::is_const_v<T>) {
+        for_each([&scalar](T& element) { element *= scalar; });
+        return *this;
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (size_t i{0}; i < m_rows; ++i) {
+            T* row_first{m_data + static_cast<ptrdiff_t>(i) * m_row_stride};
+            if (m_col_stride == 1) {
+                // contiguous rows are the common case, keep that loop simple enough to vectorise
+                for (size_t j{0}; j < m_cols; ++j) {
+                    func(row_first[j]);
+                }
+            } else {
+                for (size_t j{0}; j < m_cols; ++j) {
+                    func(row_first[static_cast<ptrdiff_t>(j) * m_col_stride]);
+                }
+            }
+        }
+    }
+};
+
+template <typename T, size_t rows, size_t cols>
+MatrixView(Matrix<T, rows, cols>&) -> MatrixView<T>;
+template <typename T, size_t rows, size_t cols>
+MatrixView(const Matrix<T, rows, cols>&) -> MatrixView<const T>;
+template <typename T>
+MatrixView(DynMatrix<T>&) -> MatrixView<T>;
+template <typename T>
+MatrixView(const DynMatrix<T>&) -> MatrixView<const T>;
+
+namespace detail {
+template <typename T>
+struct is_matrix_view : std::false_type {};
+template <typename T>
+struct is_matrix_view<MatrixView<T>> : std::true_type {};
+template <typename T>
+inline constexpr bool is_matrix_view_v{is_matrix_view<std::remove_cvref_t<T>>::value};
+
+/// anything a read only view can be made of
+template <typename M>
+concept Viewable = is_matrix_view_v<M> || is_matrix_v<M> ||
+                   std::is_same_v<std::remove_cvref_t<M>,
+                                  DynMatrix<typename std::remove_cvref_t<M>::value_type>>;
+
+template <typename M>
+[[nodiscard]] constexpr auto as_const_view(const M& matrix) noexcept {
+    using T = typename std::remove_cvref_t<M>::value_type;
+    return MatrixView<const T>{matrix};
+}
+
+// LU factors a view in place and solves into one, there is nothing to allocate so make is left
+// out and inverse() is unavailable
+template <typename T>
+struct lu_traits<MatrixView<T>> {
+    template <typename U>
+    using vector = shiv::Vector<U>;
+    using pivots = vector<size_t>;
+
+    [[nodiscard]] static size_t rows(const MatrixView<T>& matrix) noexcept {
+        return matrix.rows();
+    }
+    [[nodiscard]] static size_t cols(const MatrixView<T>& matrix) noexcept {
+        return matrix.cols();
+    }
+    [[nodiscard]] static ptrdiff_t stride(const MatrixView<T>& matrix) noexcept {
+        return matrix.row_stride();
+    }
+    [[nodiscard]] static ptrdiff_t col_stride(const MatrixView<T>& matrix) noexcept {
+        return matrix.col_stride();
+    }
+};
+} // namespace detail
+
+/// c = alpha * a * b + beta * c through the blocked kernel, any strides. c must not overlap a or
+/// b. Throws std::invalid_argument if the shapes do not line up.
+template <shiv::FloatingPoint T>
+void gemm(T alpha, MatrixView<const T> a, MatrixView<const T> b, T beta, MatrixView<T> c) {
+    if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+        throw std::invalid_argument{"Matrix dimensions do not match"};
+    }
+    shiv::gemm(a.rows(), b.cols(), a.cols(), alpha, a.data(), a.row_stride(), a.col_stride(),
+               b.data(), b.row_stride(), b.col_stride(), beta, c.data(), c.row_stride(),
+               c.col_stride());
+}
+
+// Arithmetic on views, or a view and a Matrix or DynMatrix, gives a new DynMatrix. Write into an
+// existing matrix through a view with assign, += and -=, or with gemm for products.
+template <typename L, typename R>
+requires detail::Viewable<L> && detail::Viewable<R> &&
+         (detail::is_matrix_view_v<L> || detail::is_matrix_view_v<R>)
+[[nodiscard]] auto operator+(const L& lhs, const R& rhs) {
+    auto result_matrix{detail::as_const_view(lhs).to_dyn_matrix()};
+    MatrixView{result_matrix} += detail::as_const_view(rhs);
+    return result_matrix;
+}
+template <typename L, typename R>
+requires detail::Viewable<L> && detail::Viewable<R> &&
+         (detail::is_matrix_view_v<L> || detail::is_matrix_view_v<R>)
+[[nodiscard]] auto operator-(const L& lhs, const R& rhs) {
+    auto result_matrix{detail::as_const_view(lhs).to_dyn_matrix()};
+    MatrixView{result_matrix} -= detail::as_const_view(rhs);
+    return result_matrix;
+}
+template <typename L, typename R>
+requires detail::Viewable<L> && detail::Viewable<R> &&
+         (detail::is_matrix_view_v<L> || detail::is_matrix_view_v<R>)
+[[nodiscard]] auto operator*(const L& lhs, const R& rhs) {
+    const auto a{detail::as_const_view(lhs)};
+    const auto b{detail::as_const_view(rhs)};
+    using T = typename decltype(a)::value_type;
+    if (a.cols() != b.rows()) {
+        throw std::invalid_argument{"Matrix dimensions do not match"};
+    }
+    DynMatrix<T> result_matrix{a.rows(), b.cols()};
+    if constexpr (shiv::FloatingPoint<T>) {
+        shiv::gemm(T{1}, a, b, T{}, MatrixView{result_matrix});
+    } else {
+        for (size_t i{0}; i < a.rows(); ++i) {
+            for (size_t k{0}; k < a.cols(); ++k) {
+                const T scalar{a(i, k)};
+                for (size_t j{0}; j < b.cols(); ++j) {
+                    result_matrix[i][j] += scalar * b(k, j);
+                }
+            }
+        }
+    }
+    return result_matrix;
+}
+template <typename T>
+[[nodiscard]] DynMatrix<std::remove_const_t<T>> operator*(MatrixView<T> view,
+                                                          const std::remove_const_t<T>& scalar) {
+    auto result_matrix{view.to_dyn_matrix()};
+    result_matrix *= scalar;
+    return result_matrix;
+}
+
+template <typename L, typename R>
+requires detail::Viewable<L> && detail::Viewable<R> &&
+         (detail::is_matrix_view_v<L> || detail::is_matrix_view_v<R>)
+[[nodiscard]] bool operator==(const L& lhs, const R& rhs) {
+    const auto a{detail::as_const_view(lhs)};
+    const auto b{detail::as_const_view(rhs)};
+    if (a.rows() != b.rows() || a.cols() != b.cols()) {
+        return false;
+    }
+    for (size_t i{0}; i < a.rows(); ++i) {
+        for (size_t j{0}; j < a.cols(); ++j) {
+            if (a(i, j) != b(i, j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_MATRIX_VIEW_HPP
@@ -0,0 +1,271 @@
+#ifndef SHIVLIB_DATASTRUCTURE_QR_HPP
+#define SHIVLIB_DATASTRUCTURE_QR_HPP
+
+#include "../concepts.hpp"
+#include "lu.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace shiv {
+/// Householder QR factorization A = Q * R of an m x n matrix with m >= n, for least squares.
+/// solve finds the x minimising |A * x - b| from R and Q^T * b without forming A^T * A, so it
+/// keeps the digits that normal equations lose on ill conditioned problems. Q is kept as the
+/// Householder vectors below R's diagonal. Works on Matrix, including at compile time, on
+/// DynMatrix and in place on a MatrixView. Panels of columns are factored one at a time and
+/// their reflectors applied to the rest of the matrix together, as I - V * T * V^T, through the
+/// blocked gemm kernel.
+template <typename M>
+requires(shiv::FloatingPoint<detail::matrix_element_t<M>> &&
+         !detail::is_half_precision_v<detail::matrix_element_t<M>>)
+class QR {
+  public:
+    using value_type = detail::matrix_element_t<M>;
+    using matrix_type = M;
+
+  private:
+    using T = value_type;
+    using traits = detail::lu_traits<M>;
+
+    M m_qr{};
+    typename traits::template vector<T> m_tau{};
+    size_t m_rows{0};
+    size_t m_cols{0};
+    bool m_rank_deficient{false};
+
+    // applies reflector j, I - tau * v * v^T, to columns [first, last) of target, rows j onwards.
+    // The sums for a chunk of columns are gathered a row at a time so row major storage is read
+    // in order.
+    template <typename B>
+    constexpr void reflect(size_t j, B& target, size_t first, size_t last) const {
+        constexpr size_t chunk{32};
+        const T tau{m_tau[j]};
+        if (tau == T{}) {
+            return;
+        }
+        for (size_t chunk_first{first}; chunk_first < last; chunk_first += chunk) {
+            const size_t count{shiv::min(chunk, last - chunk_first)};
+            T sums[chunk]{};
+            for (size_t c{0}; c < count; ++c) {
+                sums[c] = target[j][chunk_first + c];
+            }
+            for (size_t i{j + 1}; i < m_rows; ++i) {
+                const T v{m_qr[i][j]};
+                for (size_t c{0}; c < count; ++c) {
+                    sums[c] += v * target[i][chunk_first + c];
+                }
+            }
+            for (size_t c{0}; c < count; ++c) {
+                sums[c] *= tau;
+                target[j][chunk_first + c] -= sums[c];
+            }
+            for (size_t i{j + 1}; i < m_rows; ++i) {
+                const T v{m_qr[i][j]};
+                for (size_t c{0}; c < count; ++c) {
+                    target[i][chunk_first + c] -= v * sums[c];
+                }
+            }
+        }
+    }
+
+    // applies H_first ... H_last-1 transposed, so Q^T for the panel, to columns [col_first,
+    // col_last) of target. Wide targets go through gemm as A2 -= V * T^T * (V^T * A2)
+    template <typename B>
+    constexpr void reflect_panel(size_t first, size_t last, B& target, size_t col_first,
+                                 size_t col_last) const {
+        const size_t rows{m_rows - first};
+        const size_t width{col_last - col_first};
+        const size_t depth{last - first};
+        if (std::is_constant_evaluated() || width < detail::lu_block_size ||
+            rows * width * depth <= 16 * 16 * 16) {
+            for (size_t j{first}; j < last; ++j) {
+                reflect(j, target, col_first, col_last);
+            }
+            return;
+        }
+        using target_traits = detail::lu_traits<std::remove_const_t<B>>;
+        // V with its unit diagonal and zeros above written out, rows x depth
+        T* v{detail::gemm_scratch<T, 5>(rows * depth)};
+        T* t{detail::gemm_scratch<T, 6>(depth * depth)};
+        T* w{detail::gemm_scratch<T, 7>(depth * width)};
+        T* product{detail::gemm_scratch<T, 8>(depth * width)};
+        for (size_t i{0}; i < rows; ++i) {
+            for (size_t p{0}; p < depth; ++p) {
+                v[i * depth + p] = i > p ? m_qr[first + i][first + p] : i == p ? T{1} : T{};
+            }
+        }
+        // T is upper triangular with H_first ... H_last-1 = I - V * T * V^T, built a column at
+        // a time from the inner products of the Householder vectors, V^T * V
+        shiv::gemm(depth, depth, rows, T{1}, v, 1, static_cast<ptrdiff_t>(depth), v,
+                   static_cast<ptrdiff_t>(depth), 1, T{}, w, static_cast<ptrdiff_t>(depth), 1);
+        for (size_t j{0}; j < depth; ++j) {
+            const T tau{m_tau[first + j]};
+            for (size_t i{0}; i < j; ++i) {
+                T sum{};
+                for (size_t p{i}; p < j; ++p) {
+                    sum += t[i * depth + p] * w[p * depth + j];
+                }
+                t[i * depth + j] = -tau * sum;
+            }
+            t[j * depth + j] = tau;
+            for (size_t i{j + 1}; i < depth; ++i) {
+                t[i * depth + j] = T{};
+            }
+        }
+        T* block{&target[first][col_first]};
+        const ptrdiff_t row_stride{target_traits::stride(target)};
+        const ptrdiff_t col_stride{target_traits::col_stride(target)};
+        const auto wide{static_cast<ptrdiff_t>(width)};
+        shiv::gemm(depth, width, rows, T{1}, v, 1, static_cast<ptrdiff_t>(depth), block,
+                   row_stride, col_stride, T{}, w, wide, 1);
+        shiv::gemm(depth, width, depth, T{1}, t, 1, static_cast<ptrdiff_t>(depth), w, wide, 1,
+                   T{}, product, wide, 1);
+        shiv::gemm(rows, width, depth, T{-1}, v, static_cast<ptrdiff_t>(depth), 1, product, wide,
+                   1, T{1}, block, row_stride, col_stride);
+    }
+
+    // Householder vectors for columns [first, last), applied to the rest of the panel one at a
+    // time. v is scaled so its first element is an implicit 1 and R's diagonal takes its place.
+    constexpr void factor_panel(size_t first, size_t last) {
+        for (size_t j{first}; j < last; ++j) {
+            T below{};
+            for (size_t i{j + 1}; i < m_rows; ++i) {
+                below += m_qr[i][j] * m_qr[i][j];
+            }
+            const T alpha{m_qr[j][j]};
+            T tau{};
+            if (below != T{}) {
+                const T norm{detail::constexpr_sqrt(alpha * alpha + below)};
+                // the sign that avoids cancellation in alpha - beta
+                const T beta{alpha > T{} ? -norm : norm};
+                tau = (beta - alpha) / beta;
+                const T scale{T{1} / (alpha - beta)};
+                for (size_t i{j + 1}; i < m_rows; ++i) {
+                    m_qr[i][j] *= scale;
+                }
+                m_qr[j][j] = beta;
+            }
+            if constexpr (detail::is_matrix_v<M>) {
+                m_tau[j] = tau;
+            } else {
+                m_tau.push_back(tau);
+            }
+            reflect(j, m_qr, j + 1, last);
+        }
+    }
+
+    constexpr void factor() {
+        for (size_t first{0}; first < m_cols; first += detail::lu_block_size) {
+            const size_t last{shiv::min(first + detail::lu_block_size, m_cols)};
+            factor_panel(first, last);
+            reflect_panel(first, last, m_qr, last, m_cols);
+        }
+        // rounding leaves dependent columns with a tiny diagonal rather than an exact zero, so
+        // the test is relative to the largest, the usual max(m, n) * epsilon rank tolerance
+        T largest{};
+        for (size_t j{0}; j < m_cols; ++j) {
+            largest = shiv::max(largest, detail::constexpr_abs(m_qr[j][j]));
+        }
+        const T tolerance{largest * static_cast<T>(m_rows) * std::numeric_limits<T>::epsilon()};
+        for (size_t j{0}; j < m_cols; ++j) {
+            if (!(detail::constexpr_abs(m_qr[j][j]) > tolerance)) {
+                m_rank_deficient = true;
+            }
+        }
+    }
+
+  public:
+    /// throws std::invalid_argument if the matrix has fewer rows than columns
+    explicit constexpr QR(const M& matrix)
+    : m_qr{matrix}
+    , m_rows{traits::rows(matrix)}
+    , m_cols{traits::cols(matrix)} {
+        if constexpr (detail::is_matrix_v<M>) {
+            static_assert(M::row_count >= M::col_count,
+                          "Matrix must have at least as many rows as columns");
+        } else {
+            if (m_rows < m_cols) {
+                throw std::invalid_argument{"Matrix must have at least as many rows as columns"};
+            }
+            m_tau.reserve(m_cols);
+        }
+        factor();
+    }
+
+    [[nodiscard]] constexpr size_t rows() const noexcept {
+        return m_rows;
+    }
+    [[nodiscard]] constexpr size_t cols() const noexcept {
+        return m_cols;
+    }
+    /// true if R's diagonal has an element that is zero to working precision, the columns of A
+    /// are linearly dependent and solve will throw
+    [[nodiscard]] constexpr bool is_rank_deficient() const noexcept {
+        return m_rank_deficient;
+    }
+    /// R on and above the diagonal and the Householder vectors, without their leading 1, below
+    [[nodiscard]] constexpr const M& packed() const noexcept {
+        return m_qr;
+    }
+    /// the scale of the Householder reflector for that column, H = I - tau * v * v^T
+    [[nodiscard]] constexpr T tau(size_t col) const noexcept {
+        return m_tau[col];
+    }
+
+    /// overwrites rhs, which has rows() rows, with Q^T * rhs
+    template <typename B>
+    constexpr void multiply_qt_in_place(B& rhs) const {
+        static_assert(std::is_same_v<detail::matrix_element_t<B>, T>,
+                      "Right hand side must have the same element type");
+        using rhs_traits = detail::lu_traits<std::remove_const_t<B>>;
+        if (rhs_traits::rows(rhs) != m_rows) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        const size_t cols{rhs_traits::cols(rhs)};
+        for (size_t first{0}; first < m_cols; first += detail::lu_block_size) {
+            reflect_panel(first, shiv::min(first + detail::lu_block_size, m_cols), rhs, 0, cols);
+        }
+    }
+    /// least squares in place: the first cols() rows of rhs become the solution x of each
+    /// column, the remaining rows the residual rotated by Q^T, so their sum of squares is the
+    /// residual sum of squares
+    template <typename B>
+    constexpr void solve_in_place(B& rhs) const {
+        using rhs_traits = detail::lu_traits<std::remove_const_t<B>>;
+        if (rhs_traits::rows(rhs) != m_rows) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        // before rhs is touched, so a failed solve leaves it as it was
+        if (m_rank_deficient) {
+            throw std::domain_error{"Matrix is rank deficient"};
+        }
+        multiply_qt_in_place(rhs);
+        detail::back_substitute(m_qr, m_cols, rhs, rhs_traits::cols(rhs));
+    }
+    /// the x minimising |A * x - rhs| for each column of rhs, cols() rows. A Matrix right hand
+    /// side needs a Matrix A, so the shape is known at compile time.
+    template <typename B>
+    [[nodiscard]] constexpr auto solve(B rhs) const {
+        solve_in_place(rhs);
+        using rhs_traits = detail::lu_traits<B>;
+        const size_t cols{rhs_traits::cols(rhs)};
+        auto result{[&] {
+            if constexpr (detail::is_matrix_v<B>) {
+                static_assert(detail::is_matrix_v<M>, "A Matrix right hand side needs a Matrix");
+                return Matrix<T, M::col_count, B::col_count>{};
+            } else {
+                return rhs_traits::make(m_cols, cols);
+            }
+        }()};
+        for (size_t i{0}; i < m_cols; ++i) {
+            for (size_t j{0}; j < cols; ++j) {
+                result[i][j] = rhs[i][j];
+            }
+        }
+        return result;
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_QR_HPP
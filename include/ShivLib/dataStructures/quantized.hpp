@@ -0,0 +1,232 @@
+#ifndef SHIVLIB_DATASTRUCTURE_QUANTIZED_HPP
+#define SHIVLIB_DATASTRUCTURE_QUANTIZED_HPP
+
+#include "dyn_matrix.hpp"
+#include "gemm.hpp"
+#include "matrix.hpp"
+#include "matrix_view.hpp"
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace shiv {
+/// int32 product of int8 or uint8 matrices through the int8 gemm kernel, nothing is lost to
+/// overflow or rounding. Constant evaluation takes a plain triple loop instead.
+template <typename A, typename B, size_t rows, size_t inner, size_t cols>
+requires(detail::is_int8_v<A> && detail::is_int8_v<B>)
+[[nodiscard]] constexpr Matrix<int32_t, rows, cols>
+widening_product(const Matrix<A, rows, inner>& lhs, const Matrix<B, inner, cols>& rhs) {
+    Matrix<int32_t, rows, cols> result_matrix{};
+    if (!std::is_constant_evaluated() && rows * inner * cols != 0) {
+        shiv::gemm(rows, cols, inner, lhs[0].data(), inner, 1, rhs[0].data(), cols, 1, 0,
+                   result_matrix[0].data(), cols, 1);
+        return result_matrix;
+    }
+    for (size_t i{0}; i < rows; ++i) {
+        for (size_t k{0}; k < inner; ++k) {
+            for (size_t j{0}; j < cols; ++j) {
+                result_matrix[i][j] += int32_t{lhs[i][k]} * int32_t{rhs[k][j]};
+            }
+        }
+    }
+    return result_matrix;
+}
+/// throws std::invalid_argument if lhs has a different number of columns to rhs' rows
+template <typename A, typename B>
+requires(detail::is_int8_v<A> && detail::is_int8_v<B>)
+[[nodiscard]] DynMatrix<int32_t> widening_product(const DynMatrix<A>& lhs,
+                                                  const DynMatrix<B>& rhs) {
+    if (lhs.cols() != rhs.rows()) {
+        throw std::invalid_argument{"Matrix dimensions do not match"};
+    }
+    DynMatrix<int32_t> result_matrix{lhs.rows(), rhs.cols()};
+    shiv::gemm(lhs.rows(), rhs.cols(), lhs.cols(), lhs.data(),
+               static_cast<ptrdiff_t>(lhs.stride()), 1, rhs.data(),
+               static_cast<ptrdiff_t>(rhs.stride()), 1, 0, result_matrix.data(),
+               static_cast<ptrdiff_t>(result_matrix.stride()), 1);
+    return result_matrix;
+}
+
+/// which way a quantized matrix shares its scales: one per row suits the left hand side of a
+/// product, activations, and one per column the right, weights per output
+enum class QuantizeAxis { rows, cols };
+
+/// A float matrix stored in 8 bits with a scale and zero point per row or per column, the
+/// float is scale * (value - zero_point). int8 is symmetric, the zero point is 0 and the
+/// largest magnitude maps to 127. uint8 is affine, spanning the smallest to the largest value
+/// in 255 steps with the zero point placed so 0.0 is exact.
+template <typename T>
+requires detail::is_int8_v<T>
+struct QuantizedMatrix {
+    DynMatrix<T> values{};
+    std::vector<float> scales{};
+    std::vector<int32_t> zero_points{};
+    QuantizeAxis axis{QuantizeAxis::rows};
+
+    [[nodiscard]] size_t rows() const noexcept {
+        return values.rows();
+    }
+    [[nodiscard]] size_t cols() const noexcept {
+        return values.cols();
+    }
+    [[nodiscard]] DynMatrix<float> dequantize() const {
+        DynMatrix<float> result_matrix{rows(), cols()};
+        for (size_t i{0}; i < rows(); ++i) {
+            const T* row{values[i]};
+            float* result_row{result_matrix[i]};
+            if (axis == QuantizeAxis::rows) {
+                const float scale{scales[i]};
+                const int32_t zero_point{zero_points[i]};
+                for (size_t j{0}; j < cols(); ++j) {
+                    result_row[j] = scale * static_cast<float>(int32_t{row[j]} - zero_point);
+                }
+            } else {
+                for (size_t j{0}; j < cols(); ++j) {
+                    result_row[j] =
+                        scales[j] * static_cast<float>(int32_t{row[j]} - zero_points[j]);
+                }
+            }
+        }
+        return result_matrix;
+    }
+};
+
+namespace detail {
+// the scale and zero point that map [low, high] onto T's range
+template <typename T>
+void quantize_range(float low, float high, float& scale, int32_t& zero_point) {
+    if constexpr (std::is_signed_v<T>) {
+        const float largest{shiv::max(std::abs(low), std::abs(high))};
+        scale = largest > 0.0F ? largest / 127.0F : 1.0F;
+        zero_point = 0;
+    } else {
+        low = shiv::min(low, 0.0F);
+        high = shiv::max(high, 0.0F);
+        scale = high > low ? (high - low) / 255.0F : 1.0F;
+        zero_point = static_cast<int32_t>(std::nearbyint(-low / scale));
+        zero_point = shiv::min(shiv::max(zero_point, int32_t{0}), int32_t{255});
+    }
+}
+template <typename T>
+[[nodiscard]] T quantize_value(float value, float inverse_scale, int32_t zero_point) noexcept {
+    constexpr float lowest{std::is_signed_v<T> ? -127.0F : 0.0F};
+    constexpr float highest{std::is_signed_v<T> ? 127.0F : 255.0F};
+    // adding and taking away 1.5 * 2^23 rounds anything this small to nearest even, in a form
+    // that vectorises where nearbyint is a library call
+    constexpr float round{12582912.0F};
+    const float shifted{value * inverse_scale + static_cast<float>(zero_point)};
+    const float clamped{shiv::min(shiv::max(shifted, lowest), highest)};
+    return static_cast<T>(static_cast<int32_t>((clamped + round) - round));
+}
+} // namespace detail
+
+/// rounds to nearest, values outside the range of a row or column cannot occur, a nan is
+/// undefined
+template <typename T>
+requires detail::is_int8_v<T>
+[[nodiscard]] QuantizedMatrix<T> quantize(MatrixView<const float> matrix, QuantizeAxis axis) {
+    if (matrix.col_stride() != 1 && matrix.rows() * matrix.cols() != 0) {
+        // the loops below read whole rows, so a transposed view is copied out first
+        DynMatrix<float> rows_in_order{matrix.rows(), matrix.cols()};
+        for (size_t i{0}; i < matrix.rows(); ++i) {
+            for (size_t j{0}; j < matrix.cols(); ++j) {
+                rows_in_order[i][j] = matrix(i, j);
+            }
+        }
+        return quantize<T>(rows_in_order, axis);
+    }
+    const size_t count{axis == QuantizeAxis::rows ? matrix.rows() : matrix.cols()};
+    QuantizedMatrix<T> result{DynMatrix<T>{matrix.rows(), matrix.cols()},
+                              std::vector<float>(count), std::vector<int32_t>(count), axis};
+    if (axis == QuantizeAxis::rows) {
+        for (size_t i{0}; i < matrix.rows(); ++i) {
+            const float* source{&matrix(i, 0)};
+            float low{0};
+            float high{0};
+            for (size_t j{0}; j < matrix.cols(); ++j) {
+                low = shiv::min(low, source[j]);
+                high = shiv::max(high, source[j]);
+            }
+            detail::quantize_range<T>(low, high, result.scales[i], result.zero_points[i]);
+            const float inverse_scale{1.0F / result.scales[i]};
+            T* row{result.values[i]};
+            for (size_t j{0}; j < matrix.cols(); ++j) {
+                row[j] = detail::quantize_value<T>(source[j], inverse_scale,
+                                                   result.zero_points[i]);
+            }
+        }
+        return result;
+    }
+    // columns are scanned a row at a time so row major storage is read in order
+    std::vector<float> low(count);
+    std::vector<float> high(count);
+    for (size_t i{0}; i < matrix.rows(); ++i) {
+        const float* source{&matrix(i, 0)};
+        for (size_t j{0}; j < count; ++j) {
+            low[j] = shiv::min(low[j], source[j]);
+            high[j] = shiv::max(high[j], source[j]);
+        }
+    }
+    std::vector<float> inverse_scales(count);
+    for (size_t j{0}; j < count; ++j) {
+        detail::quantize_range<T>(low[j], high[j], result.scales[j], result.zero_points[j]);
+        inverse_scales[j] = 1.0F / result.scales[j];
+    }
+    for (size_t i{0}; i < matrix.rows(); ++i) {
+        const float* source{&matrix(i, 0)};
+        T* row{result.values[i]};
+        for (size_t j{0}; j < count; ++j) {
+            row[j] = detail::quantize_value<T>(source[j], inverse_scales[j],
+                                               result.zero_points[j]);
+        }
+    }
+    return result;
+}
+
+/// float approximation of lhs * rhs from the exact int32 product of the 8 bit values, lhs
+/// quantized by row and rhs by column so each element of the result has one scale,
+/// scale_i * scale_j * (sum a * b - zero_j * sum a - zero_i * sum b + k * zero_i * zero_j).
+/// Throws std::invalid_argument if the axes or dimensions do not fit.
+template <typename A, typename B>
+[[nodiscard]] DynMatrix<float> operator*(const QuantizedMatrix<A>& lhs,
+                                         const QuantizedMatrix<B>& rhs) {
+    if (lhs.axis != QuantizeAxis::rows || rhs.axis != QuantizeAxis::cols) {
+        throw std::invalid_argument{"Left hand side must be quantized by row, right by column"};
+    }
+    const DynMatrix<int32_t> product{widening_product(lhs.values, rhs.values)};
+    const size_t inner{lhs.cols()};
+    // the zero points of int8 are 0, so the sums they multiply are only needed for uint8
+    std::vector<int32_t> col_sums(rhs.cols());
+    if constexpr (std::is_unsigned_v<A>) {
+        for (size_t p{0}; p < inner; ++p) {
+            const B* row{rhs.values[p]};
+            for (size_t j{0}; j < rhs.cols(); ++j) {
+                col_sums[j] += row[j];
+            }
+        }
+    }
+    DynMatrix<float> result_matrix{lhs.rows(), rhs.cols()};
+    for (size_t i{0}; i < lhs.rows(); ++i) {
+        const int32_t zero_i{lhs.zero_points[i]};
+        int32_t row_sum{0};
+        if constexpr (std::is_unsigned_v<B>) {
+            for (size_t p{0}; p < inner; ++p) {
+                row_sum += lhs.values[i][p];
+            }
+        }
+        const int32_t* product_row{product[i]};
+        float* result_row{result_matrix[i]};
+        for (size_t j{0}; j < rhs.cols(); ++j) {
+            const int32_t zero_j{rhs.zero_points[j]};
+            const int32_t sum{product_row[j] - zero_j * row_sum - zero_i * col_sums[j] +
+                              static_cast<int32_t>(inner) * zero_i * zero_j};
+            result_row[j] = lhs.scales[i] * rhs.scales[j] * static_cast<float>(sum);
+        }
+    }
+    return result_matrix;
+}
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_QUANTIZED_HPP
@@ -0,0 +1,476 @@
+#ifndef SHIVLIB_DATASTRUCTURE_ROPE_HPP
+#define SHIVLIB_DATASTRUCTURE_ROPE_HPP
+
+#include "../cstddef.hpp"
+#include "string_view.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace shiv {
+/// A string held as a balanced tree of immutable chunks, for building and editing large text
+/// such as reports or protocol payloads without copying it on every change. Concatenation,
+/// insert, erase and substr are O(log n) and share chunks with the ropes they came from, so
+/// copying a Rope is a reference count. chunks() walks the text in order as StringViews, ready
+/// for writev, and flatten() rebuilds it as one chunk where contiguous text is needed.
+/// The tree is kept AVL balanced. Pieces up to merge_limit long are copied into their
+/// neighbour instead, so a run of small appends does not make a node per character, and an
+/// append to a rope that shares none of its end writes straight into the last chunk.
+class Rope {
+    struct Node {
+        std::shared_ptr<const Node> left{};
+        std::shared_ptr<const Node> right{};
+        // leaves only, a chunk may be a slice of a larger shared buffer
+        std::shared_ptr<const char[]> buffer{};
+        const char* data{nullptr};
+        size_t size{0};
+        // the bytes of buffer from data on, room to grow into while nothing else holds it
+        size_t capacity{0};
+        uint8_t height{0};
+
+        [[nodiscard]] bool is_leaf() const noexcept {
+            return height == 0;
+        }
+    };
+    using node_ptr = std::shared_ptr<const Node>;
+
+  public:
+    /// pieces up to this long are copied into a neighbouring chunk rather than given their own
+    static constexpr size_t merge_limit{512};
+    /// the room a chunk started by append has for the appends after it
+    static constexpr size_t append_capacity{4096};
+
+  private:
+    node_ptr m_root{};
+
+    explicit Rope(node_ptr root) noexcept
+    : m_root{std::move(root)} {
+    }
+
+    [[nodiscard]] static uint8_t height(const node_ptr& node) noexcept {
+        return node ? node->height : 0;
+    }
+    [[nodiscard]] static size_t size(const node_ptr& node) noexcept {
+        return node ? node->size : 0;
+    }
+
+    // Nodes are created mutable and only modified in place while a single rope owns them
+    [[nodiscard]] static node_ptr make_leaf(StringView<char> lhs, StringView<char> rhs = {"", 0},
+                                            size_t min_capacity = merge_limit) {
+        const size_t leaf_size{lhs.size() + rhs.size()};
+        // a short chunk gets room to take later appends without a new leaf
+        const size_t leaf_capacity{std::max(leaf_size, min_capacity)};
+        std::shared_ptr<char[]> buffer{new char[leaf_capacity]};
+        std::memcpy(buffer.get(), lhs.data(), lhs.size());
+        std::memcpy(buffer.get() + lhs.size(), rhs.data(), rhs.size());
+        const char* data{buffer.get()};
+        return std::make_shared<Node>(
+            Node{nullptr, nullptr, std::move(buffer), data, leaf_size, leaf_capacity, 0});
+    }
+    // count characters of leaf from index, sharing its buffer
+    [[nodiscard]] static node_ptr slice(const node_ptr& leaf, size_t index, size_t count) {
+        if (count == 0) {
+            return nullptr;
+        }
+        if (count == leaf->size) {
+            return leaf;
+        }
+        return std::make_shared<Node>(Node{nullptr, nullptr, leaf->buffer, leaf->data + index,
+                                           count, leaf->capacity - index, 0});
+    }
+    [[nodiscard]] static node_ptr make_node(node_ptr left, node_ptr right) {
+        const auto node_height{static_cast<uint8_t>(std::max(height(left), height(right)) + 1)};
+        const size_t node_size{left->size + right->size};
+        return std::make_shared<Node>(
+            Node{std::move(left), std::move(right), nullptr, nullptr, node_size, 0, node_height});
+    }
+
+    // make_node for subtrees whose heights differ by up to two, rotating back into balance
+    [[nodiscard]] static node_ptr balance(const node_ptr& left, const node_ptr& right) {
+        if (height(left) > height(right) + 1) {
+            if (height(left->left) >= height(left->right)) {
+                return make_node(left->left, make_node(left->right, right));
+            }
+            const auto& middle{left->right};
+            return make_node(make_node(left->left, middle->left),
+                             make_node(middle->right, right));
+        }
+        if (height(right) > height(left) + 1) {
+            if (height(right->right) >= height(right->left)) {
+                return make_node(make_node(left, right->left), right->right);
+            }
+            const auto& middle{right->left};
+            return make_node(make_node(left, middle->left),
+                             make_node(middle->right, right->right));
+        }
+        return make_node(left, right);
+    }
+    // descends the taller tree's inner spine to a subtree of matching height, O(height difference)
+    [[nodiscard]] static node_ptr join(const node_ptr& left, const node_ptr& right) {
+        if (!left) {
+            return right;
+        }
+        if (!right) {
+            return left;
+        }
+        if (height(left) > height(right) + 1) {
+            return balance(left->left, join(left->right, right));
+        }
+        if (height(right) > height(left) + 1) {
+            return balance(join(left, right->left), right->right);
+        }
+        return make_node(left, right);
+    }
+
+    // the tree with its last chunk extended by piece, or null if that chunk is too long
+    [[nodiscard]] static node_ptr merge_back(const node_ptr& node, StringView<char> piece) {
+        if (node->is_leaf()) {
+            if (node->size + piece.size() > merge_limit) {
+                return nullptr;
+            }
+            return make_leaf(StringView<char>{node->data, node->size}, piece);
+        }
+        auto right{merge_back(node->right, piece)};
+        // heights are unchanged, so no rebalancing
+        return right ? make_node(node->left, std::move(right)) : nullptr;
+    }
+    [[nodiscard]] static node_ptr merge_front(StringView<char> piece, const node_ptr& node) {
+        if (node->is_leaf()) {
+            if (piece.size() + node->size > merge_limit) {
+                return nullptr;
+            }
+            return make_leaf(piece, StringView<char>{node->data, node->size});
+        }
+        auto left{merge_front(piece, node->left)};
+        return left ? make_node(std::move(left), node->right) : nullptr;
+    }
+    // Appends into the spare room of the last chunk when this rope is the only owner of it and
+    // of every node above it, so no other rope can see the change. The bytes past a chunk are
+    // only written while its buffer has no other holder, a slice sharing it included.
+    bool append_in_place(StringView<char> piece) noexcept {
+        if (m_root.use_count() != 1) {
+            return false;
+        }
+        const Node* node{m_root.get()};
+        while (!node->is_leaf()) {
+            if (node->right.use_count() != 1) {
+                return false;
+            }
+            node = node->right.get();
+        }
+        if (node->buffer.use_count() != 1 || node->size + piece.size() > node->capacity) {
+            return false;
+        }
+        std::memcpy(const_cast<char*>(node->data) + node->size, piece.data(), piece.size());
+        for (node = m_root.get(); node; node = node->right.get()) {
+            const_cast<Node*>(node)->size += piece.size();
+        }
+        return true;
+    }
+
+    [[nodiscard]] static node_ptr concat(const node_ptr& left, const node_ptr& right) {
+        if (!left) {
+            return right;
+        }
+        if (!right) {
+            return left;
+        }
+        if (right->is_leaf() && right->size <= merge_limit) {
+            if (auto merged{merge_back(left, StringView<char>{right->data, right->size})}) {
+                return merged;
+            }
+        } else if (left->is_leaf() && left->size <= merge_limit) {
+            if (auto merged{merge_front(StringView<char>{left->data, left->size}, right)}) {
+                return merged;
+            }
+        }
+        return join(left, right);
+    }
+
+    // the first index characters and the rest
+    [[nodiscard]] static std::pair<node_ptr, node_ptr> split(const node_ptr& node, size_t index) {
+        if (index == 0) {
+            return {nullptr, node};
+        }
+        if (index >= size(node)) {
+            return {node, nullptr};
+        }
+        if (node->is_leaf()) {
+            return {slice(node, 0, index), slice(node, index, node->size - index)};
+        }
+        const size_t left_size{node->left->size};
+        if (index < left_size) {
+            auto [front, back]{split(node->left, index)};
+            return {std::move(front), join(back, node->right)};
+        }
+        auto [front, back]{split(node->right, index - left_size)};
+        return {join(node->left, front), std::move(back)};
+    }
+
+    void check_index(size_t index) const {
+        if (index > size()) {
+            throw std::out_of_range{"Element out of range"};
+        }
+    }
+
+  public:
+    /// Walks the chunks of a Rope in order. Holds a stack of the subtrees still to visit, so
+    /// the Rope must outlive it and stay unmodified.
+    class ChunkIterator {
+        std::vector<const Node*> m_pending{};
+
+        void descend(const Node* node) {
+            while (!node->is_leaf()) {
+                m_pending.push_back(node->right.get());
+                node = node->left.get();
+            }
+            m_pending.push_back(node);
+        }
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StringView<char>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const StringView<char>*;
+        using reference = StringView<char>;
+
+        ChunkIterator() noexcept = default;
+        explicit ChunkIterator(const Node* root) {
+            if (root) {
+                descend(root);
+            }
+        }
+
+        [[nodiscard]] StringView<char> operator*() const noexcept {
+            return StringView<char>{m_pending.back()->data, m_pending.back()->size};
+        }
+        ChunkIterator& operator++() {
+            m_pending.pop_back();
+            if (!m_pending.empty() && !m_pending.back()->is_leaf()) {
+                const Node* next{m_pending.back()};
+                m_pending.pop_back();
+                descend(next);
+            }
+            return *this;
+        }
+        ChunkIterator operator++(int) {
+            auto copy{*this};
+            ++*this;
+            return copy;
+        }
+        [[nodiscard]] friend bool operator==(const ChunkIterator& lhs,
+                                             const ChunkIterator& rhs) noexcept {
+            return lhs.m_pending == rhs.m_pending;
+        }
+    };
+
+    /// the chunks of a Rope, for range for
+    class Chunks {
+        const Node* m_root;
+
+      public:
+        explicit Chunks(const Node* root) noexcept
+        : m_root{root} {
+        }
+        [[nodiscard]] ChunkIterator begin() const {
+            return ChunkIterator{m_root};
+        }
+        [[nodiscard]] ChunkIterator end() const noexcept {
+            return ChunkIterator{};
+        }
+    };
+
+    static constexpr size_t npos = size_t{static_cast<size_t>(-1)};
+
+    Rope() noexcept = default;
+    Rope(StringView<char> view)
+    : m_root{view.empty() ? nullptr : make_leaf(view)} {
+    }
+    explicit Rope(const char* str)
+    : Rope(StringView<char>{str}) {
+    }
+
+    // adding characters
+    Rope& append(const Rope& other) {
+        m_root = concat(m_root, other.m_root);
+        return *this;
+    }
+    Rope& append(StringView<char> view) {
+        if (view.empty()) {
+            return *this;
+        }
+        if (m_root && append_in_place(view)) {
+            return *this;
+        }
+        // a short piece goes into a copy of the last chunk rather than a leaf of its own
+        if (m_root && view.size() <= merge_limit) {
+            if (auto merged{merge_back(m_root, view)}) {
+                m_root = std::move(merged);
+                return *this;
+            }
+        }
+        // the end is where the next append lands, so give it room for a run of them
+        m_root = join(m_root, make_leaf(view, {"", 0}, append_capacity));
+        return *this;
+    }
+    Rope& operator+=(const Rope& other) {
+        return append(other);
+    }
+    Rope& operator+=(StringView<char> view) {
+        return append(view);
+    }
+    Rope& prepend(const Rope& other) {
+        m_root = concat(other.m_root, m_root);
+        return *this;
+    }
+    /// inserts other before the character at index, index may be size()
+    Rope& insert(size_t index, const Rope& other) {
+        check_index(index);
+        auto [front, back]{split(m_root, index)};
+        m_root = concat(concat(front, other.m_root), back);
+        return *this;
+    }
+    Rope& insert(size_t index, StringView<char> view) {
+        return insert(index, Rope{view});
+    }
+    [[nodiscard]] friend Rope operator+(const Rope& lhs, const Rope& rhs) {
+        return Rope{concat(lhs.m_root, rhs.m_root)};
+    }
+
+    // removing characters
+    /// removes up to count characters from index
+    Rope& erase(size_t index, size_t count = npos) {
+        check_index(index);
+        count = std::min(count, size() - index);
+        auto [front, rest]{split(m_root, index)};
+        m_root = concat(front, split(rest, count).second);
+        return *this;
+    }
+    void clear() noexcept {
+        m_root = nullptr;
+    }
+
+    /// up to count characters from index, sharing this rope's chunks
+    [[nodiscard]] Rope substr(size_t index, size_t count = npos) const {
+        check_index(index);
+        count = std::min(count, size() - index);
+        return Rope{split(split(m_root, index).second, count).first};
+    }
+
+    // Element Access, O(log n)
+    [[nodiscard]] char operator[](size_t index) const noexcept {
+        assert((index < size()) && ("Index out of range"));
+        const Node* node{m_root.get()};
+        while (!node->is_leaf()) {
+            if (index < node->left->size) {
+                node = node->left.get();
+            } else {
+                index -= node->left->size;
+                node = node->right.get();
+            }
+        }
+        return node->data[index];
+    }
+    [[nodiscard]] char at(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return (*this)[index];
+    }
+
+    [[nodiscard]] Chunks chunks() const noexcept {
+        return Chunks{m_root.get()};
+    }
+    /// copies the text to out, which must have room for size() characters
+    void copy(char* out) const {
+        for (const auto chunk : chunks()) {
+            std::memcpy(out, chunk.data(), chunk.size());
+            out += chunk.size();
+        }
+    }
+    /// The text as one contiguous view, copying it into a single chunk that replaces the tree
+    /// unless it is one already. Valid until the rope is next modified, copies are unaffected.
+    [[nodiscard]] StringView<char> flatten() {
+        if (!m_root) {
+            return StringView<char>{"", 0};
+        }
+        if (!m_root->is_leaf()) {
+            std::shared_ptr<char[]> buffer{new char[m_root->size]};
+            copy(buffer.get());
+            const char* data{buffer.get()};
+            m_root = std::make_shared<Node>(
+                Node{nullptr, nullptr, std::move(buffer), data, m_root->size, m_root->size, 0});
+        }
+        return StringView<char>{m_root->data, m_root->size};
+    }
+
+    // Capacity
+    [[nodiscard]] size_t size() const noexcept {
+        return size(m_root);
+    }
+    [[nodiscard]] size_t length() const noexcept {
+        return size();
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return !m_root;
+    }
+    /// the height of the tree, 0 for a single chunk
+    [[nodiscard]] size_t depth() const noexcept {
+        return height(m_root);
+    }
+
+    // comparison
+    [[nodiscard]] friend bool operator==(const Rope& lhs, StringView<char> rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        size_t offset{0};
+        for (const auto chunk : lhs.chunks()) {
+            if (std::memcmp(chunk.data(), rhs.data() + offset, chunk.size()) != 0) {
+                return false;
+            }
+            offset += chunk.size();
+        }
+        return true;
+    }
+    [[nodiscard]] friend bool operator==(const Rope& lhs, const char* rhs) {
+        return lhs == StringView<char>{rhs};
+    }
+    [[nodiscard]] friend bool operator==(const Rope& lhs, const Rope& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        // walks both chunk sequences together, comparing the overlap of the current pair
+        auto left{lhs.chunks().begin()};
+        auto right{rhs.chunks().begin()};
+        const ChunkIterator end{};
+        StringView<char> left_chunk{"", 0};
+        StringView<char> right_chunk{"", 0};
+        while (true) {
+            if (left_chunk.empty()) {
+                if (left == end) {
+                    return true;
+                }
+                left_chunk = *left++;
+            }
+            if (right_chunk.empty()) {
+                right_chunk = *right++;
+            }
+            const size_t count{std::min(left_chunk.size(), right_chunk.size())};
+            if (std::memcmp(left_chunk.data(), right_chunk.data(), count) != 0) {
+                return false;
+            }
+            left_chunk = left_chunk.substr(count);
+            right_chunk = right_chunk.substr(count);
+        }
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_ROPE_HPP
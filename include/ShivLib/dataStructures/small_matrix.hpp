@@ -0,0 +1,260 @@
+#ifndef SHIVLIB_DATASTRUCTURE_SMALL_MATRIX_HPP
+#define SHIVLIB_DATASTRUCTURE_SMALL_MATRIX_HPP
+
+#include "../cstddef.hpp"
+#include "matrix_expression.hpp"
+#include "matrix_kernels.hpp"
+#include <stdexcept>
+#include <type_traits>
+#if defined(__SSE__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// Closed form kernels for 2x2, 3x3 and 4x4 float and double matrices, the sizes transforms use.
+// Everything here is constexpr, the 4x4 multiply and transpose switch to SSE or AVX registers
+// when they run at runtime and the target has them.
+
+namespace shiv::detail {
+template <typename T, size_t n>
+inline constexpr bool is_small_square_v{(std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+                                        n >= 2 && n <= 4};
+
+#ifdef __SSE__
+// a row of c is the rows of b weighted by the matching row of a
+inline void multiply_4x4(const float* a, const float* b, float* c) noexcept {
+    const __m128 b0{_mm_loadu_ps(b)};
+    const __m128 b1{_mm_loadu_ps(b + 4)};
+    const __m128 b2{_mm_loadu_ps(b + 8)};
+    const __m128 b3{_mm_loadu_ps(b + 12)};
+    for (size_t i{0}; i < 4; ++i) {
+        const float* row{a + i * 4};
+        __m128 sum{_mm_mul_ps(_mm_set1_ps(row[0]), b0)};
+#ifdef __FMA__
+        sum = _mm_fmadd_ps(_mm_set1_ps(row[1]), b1, sum);
+        sum = _mm_fmadd_ps(_mm_set1_ps(row[2]), b2, sum);
+        sum = _mm_fmadd_ps(_mm_set1_ps(row[3]), b3, sum);
+#else
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[1]), b1));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[2]), b2));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[3]), b3));
+#endif
+        _mm_storeu_ps(c + i * 4, sum);
+    }
+}
+inline void transpose_4x4(const float* in, float* out) noexcept {
+    __m128 r0{_mm_loadu_ps(in)};
+    __m128 r1{_mm_loadu_ps(in + 4)};
+    __m128 r2{_mm_loadu_ps(in + 8)};
+    __m128 r3{_mm_loadu_ps(in + 12)};
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(out, r0);
+    _mm_storeu_ps(out + 4, r1);
+    _mm_storeu_ps(out + 8, r2);
+    _mm_storeu_ps(out + 12, r3);
+}
+#endif
+#ifdef __AVX__
+inline void multiply_4x4(const double* a, const double* b, double* c) noexcept {
+    const __m256d b0{_mm256_loadu_pd(b)};
+    const __m256d b1{_mm256_loadu_pd(b + 4)};
+    const __m256d b2{_mm256_loadu_pd(b + 8)};
+    const __m256d b3{_mm256_loadu_pd(b + 12)};
+    for (size_t i{0}; i < 4; ++i) {
+        const double* row{a + i * 4};
+        __m256d sum{_mm256_mul_pd(_mm256_set1_pd(row[0]), b0)};
+#ifdef __FMA__
+        sum = _mm256_fmadd_pd(_mm256_set1_pd(row[1]), b1, sum);
+        sum = _mm256_fmadd_pd(_mm256_set1_pd(row[2]), b2, sum);
+        sum = _mm256_fmadd_pd(_mm256_set1_pd(row[3]), b3, sum);
+#else
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(row[1]), b1));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(row[2]), b2));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(row[3]), b3));
+#endif
+        _mm256_storeu_pd(c + i * 4, sum);
+    }
+}
+inline void transpose_4x4(const double* in, double* out) noexcept {
+    const __m256d r0{_mm256_loadu_pd(in)};
+    const __m256d r1{_mm256_loadu_pd(in + 4)};
+    const __m256d r2{_mm256_loadu_pd(in + 8)};
+    const __m256d r3{_mm256_loadu_pd(in + 12)};
+    // pairs of columns from pairs of rows, then swap the 128 bit halves into place
+    const __m256d even01{_mm256_unpacklo_pd(r0, r1)};
+    const __m256d odd01{_mm256_unpackhi_pd(r0, r1)};
+    const __m256d even23{_mm256_unpacklo_pd(r2, r3)};
+    const __m256d odd23{_mm256_unpackhi_pd(r2, r3)};
+    _mm256_storeu_pd(out, _mm256_permute2f128_pd(even01, even23, 0x20));
+    _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(odd01, odd23, 0x20));
+    _mm256_storeu_pd(out + 8, _mm256_permute2f128_pd(even01, even23, 0x31));
+    _mm256_storeu_pd(out + 12, _mm256_permute2f128_pd(odd01, odd23, 0x31));
+}
+#endif
+
+template <typename T>
+inline constexpr bool has_simd_4x4_v{
+#ifdef __SSE__
+    std::is_same_v<T, float> ||
+#endif
+#ifdef __AVX__
+    std::is_same_v<T, double> ||
+#endif
+    false};
+
+template <typename T, size_t n>
+[[nodiscard]] constexpr Matrix<T, n, n> small_multiply(const Matrix<T, n, n>& a,
+                                                       const Matrix<T, n, n>& b) noexcept {
+    Matrix<T, n, n> c{};
+    if constexpr (n == 4 && has_simd_4x4_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            multiply_4x4(a[0].data(), b[0].data(), c[0].data());
+            return c;
+        }
+    }
+    // constant trip counts, the compiler unrolls this completely
+    for (size_t i{0}; i < n; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            T sum{a[i][0] * b[0][j]};
+            for (size_t k{1}; k < n; ++k) {
+                sum += a[i][k] * b[k][j];
+            }
+            c[i][j] = sum;
+        }
+    }
+    return c;
+}
+
+template <typename T, size_t n>
+[[nodiscard]] constexpr Matrix<T, n, n> small_transpose(const Matrix<T, n, n>& in) noexcept {
+    Matrix<T, n, n> out{};
+    if constexpr (n == 4 && has_simd_4x4_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            transpose_4x4(in[0].data(), out[0].data());
+            return out;
+        }
+    }
+    for (size_t i{0}; i < n; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            out[j][i] = in[i][j];
+        }
+    }
+    return out;
+}
+
+// The determinant and inverse below take anything indexable as m[i][j], so MatrixBatch can run
+// them on a register of lanes from a block of interleaved matrices.
+
+// the 2x2 minors of the top two and bottom two rows, both 4x4 determinant and inverse use them
+template <typename T>
+struct Minors4x4 {
+    T top[6];
+    T bottom[6];
+
+    template <typename In>
+    explicit constexpr Minors4x4(const In& m) noexcept
+    : top{m[0][0] * m[1][1] - m[1][0] * m[0][1], m[0][0] * m[1][2] - m[1][0] * m[0][2],
+          m[0][0] * m[1][3] - m[1][0] * m[0][3], m[0][1] * m[1][2] - m[1][1] * m[0][2],
+          m[0][1] * m[1][3] - m[1][1] * m[0][3], m[0][2] * m[1][3] - m[1][2] * m[0][3]}
+    , bottom{m[2][0] * m[3][1] - m[3][0] * m[2][1], m[2][0] * m[3][2] - m[3][0] * m[2][2],
+             m[2][0] * m[3][3] - m[3][0] * m[2][3], m[2][1] * m[3][2] - m[3][1] * m[2][2],
+             m[2][1] * m[3][3] - m[3][1] * m[2][3], m[2][2] * m[3][3] - m[3][2] * m[2][3]} {
+    }
+    [[nodiscard]] constexpr T determinant() const noexcept {
+        return top[0] * bottom[5] - top[1] * bottom[4] + top[2] * bottom[3] +
+               top[3] * bottom[2] - top[4] * bottom[1] + top[5] * bottom[0];
+    }
+};
+
+template <size_t n, typename In>
+[[nodiscard]] constexpr auto small_determinant(const In& m) noexcept {
+    using T = matrix_element_t<const In>;
+    if constexpr (n == 2) {
+        return T{m[0][0] * m[1][1] - m[0][1] * m[1][0]};
+    } else if constexpr (n == 3) {
+        return T{m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+                 m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+                 m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])};
+    } else {
+        return Minors4x4<T>{m}.determinant();
+    }
+}
+
+/// adjugate over determinant into inverse, which must not alias m, returning the determinant.
+/// Nothing is checked, a singular matrix leaves infinities or NaNs behind.
+template <size_t n, typename In, typename Out>
+constexpr auto small_inverse_into(const In& m, Out& inverse) noexcept {
+    using T = matrix_element_t<const In>;
+    if constexpr (n == 2) {
+        const T det{small_determinant<2>(m)};
+        const T scale{T{1} / det};
+        inverse[0][0] = m[1][1] * scale;
+        inverse[0][1] = -m[0][1] * scale;
+        inverse[1][0] = -m[1][0] * scale;
+        inverse[1][1] = m[0][0] * scale;
+        return det;
+    } else if constexpr (n == 3) {
+        const T c00{m[1][1] * m[2][2] - m[1][2] * m[2][1]};
+        const T c01{m[1][2] * m[2][0] - m[1][0] * m[2][2]};
+        const T c02{m[1][0] * m[2][1] - m[1][1] * m[2][0]};
+        const T det{m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02};
+        const T scale{T{1} / det};
+        const T i01{(m[0][2] * m[2][1] - m[0][1] * m[2][2]) * scale};
+        const T i02{(m[0][1] * m[1][2] - m[0][2] * m[1][1]) * scale};
+        const T i11{(m[0][0] * m[2][2] - m[0][2] * m[2][0]) * scale};
+        const T i12{(m[0][2] * m[1][0] - m[0][0] * m[1][2]) * scale};
+        const T i21{(m[0][1] * m[2][0] - m[0][0] * m[2][1]) * scale};
+        const T i22{(m[0][0] * m[1][1] - m[0][1] * m[1][0]) * scale};
+        inverse[0][0] = c00 * scale;
+        inverse[0][1] = i01;
+        inverse[0][2] = i02;
+        inverse[1][0] = c01 * scale;
+        inverse[1][1] = i11;
+        inverse[1][2] = i12;
+        inverse[2][0] = c02 * scale;
+        inverse[2][1] = i21;
+        inverse[2][2] = i22;
+        return det;
+    } else {
+        const Minors4x4<T> minors{m};
+        const T det{minors.determinant()};
+        const T scale{T{1} / det};
+        const T* s{minors.top};
+        const T* c{minors.bottom};
+        T result[4][4]{
+            {m[1][1] * c[5] - m[1][2] * c[4] + m[1][3] * c[3],
+             -m[0][1] * c[5] + m[0][2] * c[4] - m[0][3] * c[3],
+             m[3][1] * s[5] - m[3][2] * s[4] + m[3][3] * s[3],
+             -m[2][1] * s[5] + m[2][2] * s[4] - m[2][3] * s[3]},
+            {-m[1][0] * c[5] + m[1][2] * c[2] - m[1][3] * c[1],
+             m[0][0] * c[5] - m[0][2] * c[2] + m[0][3] * c[1],
+             -m[3][0] * s[5] + m[3][2] * s[2] - m[3][3] * s[1],
+             m[2][0] * s[5] - m[2][2] * s[2] + m[2][3] * s[1]},
+            {m[1][0] * c[4] - m[1][1] * c[2] + m[1][3] * c[0],
+             -m[0][0] * c[4] + m[0][1] * c[2] - m[0][3] * c[0],
+             m[3][0] * s[4] - m[3][1] * s[2] + m[3][3] * s[0],
+             -m[2][0] * s[4] + m[2][1] * s[2] - m[2][3] * s[0]},
+            {-m[1][0] * c[3] + m[1][1] * c[1] - m[1][2] * c[0],
+             m[0][0] * c[3] - m[0][1] * c[1] + m[0][2] * c[0],
+             -m[3][0] * s[3] + m[3][1] * s[1] - m[3][2] * s[0],
+             m[2][0] * s[3] - m[2][1] * s[1] + m[2][2] * s[0]}};
+        for (size_t i{0}; i < 4; ++i) {
+            for (size_t j{0}; j < 4; ++j) {
+                inverse[i][j] = result[i][j] * scale;
+            }
+        }
+        return det;
+    }
+}
+
+/// throws std::domain_error for a singular matrix
+template <typename T, size_t n>
+[[nodiscard]] constexpr Matrix<T, n, n> small_inverse(const Matrix<T, n, n>& m) {
+    Matrix<T, n, n> inverse{};
+    if (small_inverse_into<n>(m, inverse) == T{}) {
+        throw std::domain_error{"Matrix is singular"};
+    }
+    return inverse;
+}
+} // namespace shiv::detail
+
+#endif //SHIVLIB_DATASTRUCTURE_SMALL_MATRIX_HPP
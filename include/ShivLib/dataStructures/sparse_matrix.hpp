@@ -0,0 +1,550 @@
+#ifndef SHIVLIB_DATASTRUCTURE_SPARSE_MATRIX_HPP
+#define SHIVLIB_DATASTRUCTURE_SPARSE_MATRIX_HPP
+
+#include "../concepts.hpp"
+#include "dyn_matrix.hpp"
+#include "gemm.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace shiv {
+/// which dimension a SparseMatrix is compressed along, rows for csr and columns for csc
+enum class SparseFormat { csr, csc };
+
+template <shiv::Arithmetic T, SparseFormat format, shiv::Integral Index>
+class SparseMatrix;
+
+namespace detail {
+// parallel kernels hand out roughly this many nonzeros to each task
+inline constexpr size_t sparse_chunk_nonzeros{size_t{1} << 15};
+
+template <typename T>
+[[nodiscard]] shiv::Vector<T> filled_vector(size_t count, const T& value) {
+    shiv::Vector<T> result(count);
+    for (size_t i{0}; i < count; ++i) {
+        result.push_back(value);
+    }
+    return result;
+}
+
+template <typename Index>
+void check_index_range(size_t value) {
+    if (value > std::numeric_limits<Index>::max()) {
+        throw std::length_error{"Too many elements for the index type"};
+    }
+}
+
+#if defined(__AVX512F__)
+// GCC 12 warns about the undefined registers behind the unmasked gathers, extracts and
+// _mm512_reduce_add, so the kernels use full masks and these instead
+[[nodiscard]] inline float reduce_add(__m512 value) noexcept {
+    const __m512d bits{_mm512_castps_pd(value)};
+    const __m256 half{_mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, bits, 0)),
+                                    _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, bits, 1)))};
+    __m128 quarter{_mm_add_ps(_mm256_castps256_ps128(half), _mm256_extractf128_ps(half, 1))};
+    quarter = _mm_add_ps(quarter, _mm_movehl_ps(quarter, quarter));
+    return _mm_cvtss_f32(_mm_add_ss(quarter, _mm_movehdup_ps(quarter)));
+}
+[[nodiscard]] inline double reduce_add(__m512d value) noexcept {
+    const __m256d half{_mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xF, value, 0),
+                                     _mm512_maskz_extractf64x4_pd(0xF, value, 1))};
+    const __m128d quarter{
+        _mm_add_pd(_mm256_castpd256_pd128(half), _mm256_extractf128_pd(half, 1))};
+    return _mm_cvtsd_f64(_mm_add_sd(quarter, _mm_unpackhi_pd(quarter, quarter)));
+}
+#endif
+
+// The dot product of one compressed row with x. Gathers x with AVX-512 or AVX2 for float and
+// double, gather takes signed indices so callers only use it while x is shorter than 2^31.
+template <typename T, typename Index>
+[[nodiscard]] T sparse_dot(const Index* indices, const T* values, size_t count,
+                           const T* x) noexcept {
+    size_t i{0};
+#if defined(__AVX512F__)
+    if (count < 8) {
+        // too short to fill a register, the scalar loop below is quicker
+    } else if constexpr (std::is_same_v<T, float> && sizeof(Index) == 4) {
+        __m512 sum{_mm512_setzero_ps()};
+        for (; i + 16 <= count; i += 16) {
+            const __m512i index{_mm512_loadu_si512(indices + i)};
+            sum = _mm512_fmadd_ps(
+                _mm512_loadu_ps(values + i),
+                _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, index, x, 4), sum);
+        }
+        if (i < count) {
+            const auto mask{static_cast<__mmask16>((1U << (count - i)) - 1)};
+            const __m512i index{_mm512_maskz_loadu_epi32(mask, indices + i)};
+            sum = _mm512_fmadd_ps(
+                _mm512_maskz_loadu_ps(mask, values + i),
+                _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, index, x, 4), sum);
+        }
+        return reduce_add(sum);
+    } else if constexpr (std::is_same_v<T, double> && sizeof(Index) == 4) {
+        __m512d sum{_mm512_setzero_pd()};
+        for (; i + 8 <= count; i += 8) {
+            const __m256i index{
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i))};
+            sum = _mm512_fmadd_pd(
+                _mm512_loadu_pd(values + i),
+                _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, index, x, 8), sum);
+        }
+        if (i < count) {
+            const auto mask{static_cast<__mmask8>((1U << (count - i)) - 1)};
+            const __m256i index{_mm256_castpd_si256(_mm512_maskz_extractf64x4_pd(
+                0xF, _mm512_castsi512_pd(_mm512_maskz_loadu_epi32(mask, indices + i)), 0))};
+            sum = _mm512_fmadd_pd(
+                _mm512_maskz_loadu_pd(mask, values + i),
+                _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, index, x, 8), sum);
+        }
+        return reduce_add(sum);
+    } else if constexpr (std::is_same_v<T, double> && sizeof(Index) == 8) {
+        __m512d sum{_mm512_setzero_pd()};
+        for (; i + 8 <= count; i += 8) {
+            const __m512i index{_mm512_loadu_si512(indices + i)};
+            sum = _mm512_fmadd_pd(
+                _mm512_loadu_pd(values + i),
+                _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, index, x, 8), sum);
+        }
+        if (i < count) {
+            const auto mask{static_cast<__mmask8>((1U << (count - i)) - 1)};
+            const __m512i index{_mm512_maskz_loadu_epi64(mask, indices + i)};
+            sum = _mm512_fmadd_pd(
+                _mm512_maskz_loadu_pd(mask, values + i),
+                _mm512_mask_i64gather_pd(_mm512_setzero_pd(), mask, index, x, 8), sum);
+        }
+        return reduce_add(sum);
+    }
+#elif defined(__AVX2__)
+    if constexpr (std::is_same_v<T, float> && sizeof(Index) == 4) {
+        __m256 sum{_mm256_setzero_ps()};
+        for (; i + 8 <= count; i += 8) {
+            const __m256i index{
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i))};
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(values + i),
+                                  _mm256_i32gather_ps(x, index, 4), sum);
+        }
+        __m128 half{_mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1))};
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_movehdup_ps(half));
+        T result{_mm_cvtss_f32(half)};
+        for (; i < count; ++i) {
+            result += values[i] * x[indices[i]];
+        }
+        return result;
+    } else if constexpr (std::is_same_v<T, double> && sizeof(Index) == 4) {
+        __m256d sum{_mm256_setzero_pd()};
+        for (; i + 4 <= count; i += 4) {
+            const __m128i index{_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i))};
+            sum = _mm256_fmadd_pd(_mm256_loadu_pd(values + i),
+                                  _mm256_i32gather_pd(x, index, 8), sum);
+        }
+        __m128d half{_mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1))};
+        half = _mm_add_sd(half, _mm_unpackhi_pd(half, half));
+        T result{_mm_cvtsd_f64(half)};
+        for (; i < count; ++i) {
+            result += values[i] * x[indices[i]];
+        }
+        return result;
+    }
+#endif
+    // independent partial sums so the loads of x overlap
+    T sums[4]{};
+    for (; i + 4 <= count; i += 4) {
+        for (size_t lane{0}; lane < 4; ++lane) {
+            sums[lane] += values[i + lane] * x[indices[i + lane]];
+        }
+    }
+    for (; i < count; ++i) {
+        sums[0] += values[i] * x[indices[i]];
+    }
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+// Runs body(first, last) over ranges of [0, outer) holding roughly equal numbers of nonzeros,
+// sharing them out over matrix_threads() when there are enough of them.
+template <typename Index, typename Func>
+void for_each_outer_range(const shiv::Vector<Index>& offsets, size_t outer, size_t work,
+                          Func&& body) {
+    const size_t nonzeros{static_cast<size_t>(offsets[outer])};
+    const std::shared_ptr<ThreadPool> pool{matrix_pool()};
+    const size_t parts{shiv::min(work / sparse_chunk_nonzeros, pool->size() * 4)};
+    if (parts < 2 || outer < parts) {
+        body(size_t{0}, outer);
+        return;
+    }
+    const auto boundary{[&](size_t part) {
+        if (part == parts) {
+            return outer;
+        }
+        const Index target{static_cast<Index>(nonzeros / parts * part)};
+        return static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.begin() + outer,
+                                                    target) -
+                                   offsets.begin()) -
+               1;
+    }};
+    pool->parallel_for(parts, [&](size_t part) {
+        const size_t first{part == 0 ? 0 : boundary(part)};
+        const size_t last{boundary(part + 1)};
+        if (first < last) {
+            body(first, last);
+        }
+    });
+}
+} // namespace detail
+
+/// Coordinate list of (row, col, value) nonzeros in any order, the usual way to assemble a
+/// SparseMatrix. Entries repeating a position are summed when it is compressed.
+template <shiv::Arithmetic T, shiv::Integral Index = uint32_t>
+class CooMatrix {
+    size_t m_rows{0};
+    size_t m_cols{0};
+    shiv::Vector<Index> m_row_indices{};
+    shiv::Vector<Index> m_col_indices{};
+    shiv::Vector<T> m_values{};
+
+  public:
+    using value_type = T;
+    using index_type = Index;
+
+    /// throws std::length_error if a dimension does not fit in Index
+    CooMatrix(size_t rows, size_t cols, size_t capacity = 16)
+    : m_rows{rows}
+    , m_cols{cols}
+    , m_row_indices(capacity)
+    , m_col_indices(capacity)
+    , m_values(capacity) {
+        detail::check_index_range<Index>(rows);
+        detail::check_index_range<Index>(cols);
+    }
+
+    /// throws std::out_of_range if the position is outside the matrix
+    void add(size_t row, size_t col, const T& value) {
+        if (row >= m_rows || col >= m_cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        m_row_indices.push_back(static_cast<Index>(row));
+        m_col_indices.push_back(static_cast<Index>(col));
+        m_values.push_back(value);
+    }
+
+    [[nodiscard]] size_t rows() const noexcept {
+        return m_rows;
+    }
+    [[nodiscard]] size_t cols() const noexcept {
+        return m_cols;
+    }
+    /// entries added so far, counting repeats
+    [[nodiscard]] size_t size() const noexcept {
+        return m_values.size();
+    }
+    [[nodiscard]] const shiv::Vector<Index>& row_indices() const noexcept {
+        return m_row_indices;
+    }
+    [[nodiscard]] const shiv::Vector<Index>& col_indices() const noexcept {
+        return m_col_indices;
+    }
+    [[nodiscard]] const shiv::Vector<T>& values() const noexcept {
+        return m_values;
+    }
+};
+
+/// Compressed sparse matrix. csr keeps each row's nonzeros together, sorted by column, with
+/// offsets()[i] the first of row i; csc is the same along columns. Index is the integer type
+/// of the offsets and indices, uint32_t halves their memory over uint64_t as long as the
+/// dimensions and nonzeros fit in it. Matrix vector and sparse dense products of a csr matrix
+/// are shared out over matrix_threads() by nonzeros and gather x with SIMD; csc products
+/// scatter into the result and run on one thread, convert with to_csr() for repeated use.
+template <shiv::Arithmetic T, SparseFormat format = SparseFormat::csr,
+          shiv::Integral Index = uint32_t>
+class SparseMatrix {
+    static_assert(std::is_unsigned_v<Index>, "Sparse indices must be unsigned");
+
+    template <shiv::Arithmetic, SparseFormat, shiv::Integral>
+    friend class SparseMatrix;
+
+  public:
+    using value_type = T;
+    using index_type = Index;
+    static constexpr SparseFormat storage_format{format};
+
+  private:
+    static constexpr bool is_csr{format == SparseFormat::csr};
+
+    size_t m_rows{0};
+    size_t m_cols{0};
+    shiv::Vector<Index> m_offsets{detail::filled_vector(1, Index{0})};
+    shiv::Vector<Index> m_indices{};
+    shiv::Vector<T> m_values{};
+
+    [[nodiscard]] size_t outer() const noexcept {
+        return is_csr ? m_rows : m_cols;
+    }
+    [[nodiscard]] size_t inner() const noexcept {
+        return is_csr ? m_cols : m_rows;
+    }
+
+    // the same nonzeros compressed along the other dimension, inner indices come out sorted
+    // because the outer ones are visited in order
+    template <SparseFormat other_format>
+    [[nodiscard]] SparseMatrix<T, other_format, Index> recompress(size_t rows,
+                                                                  size_t cols) const {
+        SparseMatrix<T, other_format, Index> result{};
+        result.m_rows = rows;
+        result.m_cols = cols;
+        const size_t new_outer{inner()};
+        const size_t count{nonzeros()};
+        result.m_offsets = detail::filled_vector(new_outer + 1, Index{0});
+        for (size_t k{0}; k < count; ++k) {
+            ++result.m_offsets[m_indices[k] + 1];
+        }
+        for (size_t i{0}; i < new_outer; ++i) {
+            result.m_offsets[i + 1] += result.m_offsets[i];
+        }
+        result.m_indices = detail::filled_vector(count, Index{0});
+        result.m_values = detail::filled_vector(count, T{});
+        auto next{result.m_offsets};
+        for (size_t i{0}; i < outer(); ++i) {
+            for (size_t k{m_offsets[i]}; k < m_offsets[i + 1]; ++k) {
+                const size_t position{next[m_indices[k]]++};
+                result.m_indices[position] = static_cast<Index>(i);
+                result.m_values[position] = m_values[k];
+            }
+        }
+        return result;
+    }
+
+  public:
+    SparseMatrix() = default;
+    /// an empty rows x cols matrix
+    SparseMatrix(size_t rows, size_t cols)
+    : m_rows{rows}
+    , m_cols{cols}
+    , m_offsets{detail::filled_vector((is_csr ? rows : cols) + 1, Index{0})} {
+        detail::check_index_range<Index>(rows);
+        detail::check_index_range<Index>(cols);
+    }
+    /// compresses the entries with a counting sort by outer index and then a sort of each row
+    /// (or column), repeated positions are summed in the order they were added
+    explicit SparseMatrix(const CooMatrix<T, Index>& coo)
+    : SparseMatrix(coo.rows(), coo.cols()) {
+        const auto& outer_indices{is_csr ? coo.row_indices() : coo.col_indices()};
+        const auto& inner_indices{is_csr ? coo.col_indices() : coo.row_indices()};
+        const size_t count{coo.size()};
+        detail::check_index_range<Index>(count);
+
+        // bucket the entries by outer index, in insertion order within each bucket
+        shiv::Vector<Index> next{detail::filled_vector(outer() + 1, Index{0})};
+        for (size_t k{0}; k < count; ++k) {
+            ++next[outer_indices[k] + 1];
+        }
+        for (size_t i{0}; i < outer(); ++i) {
+            next[i + 1] += next[i];
+        }
+        std::vector<std::pair<Index, T>> entries(count);
+        for (size_t k{0}; k < count; ++k) {
+            entries[next[outer_indices[k]]++] = {inner_indices[k], coo.values()[k]};
+        }
+
+        // then sort each bucket by inner index, buckets are short so this stays in cache
+        m_indices = shiv::Vector<Index>(count);
+        m_values = shiv::Vector<T>(count);
+        size_t k{0};
+        for (size_t i{0}; i < outer(); ++i) {
+            const size_t end{static_cast<size_t>(next[i])};
+            std::stable_sort(entries.begin() + static_cast<ptrdiff_t>(k),
+                             entries.begin() + static_cast<ptrdiff_t>(end),
+                             [](const auto& lhs, const auto& rhs) {
+                                 return lhs.first < rhs.first;
+                             });
+            while (k < end) {
+                const Index index{entries[k].first};
+                T value{entries[k].second};
+                for (++k; k < end && entries[k].first == index; ++k) {
+                    value += entries[k].second;
+                }
+                m_indices.push_back(index);
+                m_values.push_back(value);
+            }
+            m_offsets[i + 1] = static_cast<Index>(m_values.size());
+        }
+    }
+
+    [[nodiscard]] size_t rows() const noexcept {
+        return m_rows;
+    }
+    [[nodiscard]] size_t cols() const noexcept {
+        return m_cols;
+    }
+    [[nodiscard]] size_t nonzeros() const noexcept {
+        return m_values.size();
+    }
+    /// bytes held by the offsets, indices and values
+    [[nodiscard]] size_t storage_bytes() const noexcept {
+        return (m_offsets.size() + m_indices.size()) * sizeof(Index) +
+               m_values.size() * sizeof(T);
+    }
+    /// outer() + 1 entries, the nonzeros of row (or column) i are [offsets()[i], offsets()[i + 1])
+    [[nodiscard]] const shiv::Vector<Index>& offsets() const noexcept {
+        return m_offsets;
+    }
+    [[nodiscard]] const shiv::Vector<Index>& indices() const noexcept {
+        return m_indices;
+    }
+    [[nodiscard]] const shiv::Vector<T>& values() const noexcept {
+        return m_values;
+    }
+
+    // Element access
+    /// unchecked, zero where nothing is stored, a binary search of the row (or column)
+    [[nodiscard]] T operator()(size_t row, size_t col) const noexcept {
+        const size_t outer_index{is_csr ? row : col};
+        const auto first{m_indices.begin() + m_offsets[outer_index]};
+        const auto last{m_indices.begin() + m_offsets[outer_index + 1]};
+        const auto found{std::lower_bound(first, last, static_cast<Index>(is_csr ? col : row))};
+        if (found == last || *found != static_cast<Index>(is_csr ? col : row)) {
+            return T{};
+        }
+        return m_values[static_cast<size_t>(found - m_indices.begin())];
+    }
+    [[nodiscard]] T at(size_t row, size_t col) const {
+        if (row >= m_rows || col >= m_cols) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return (*this)(row, col);
+    }
+
+    // Conversion
+    [[nodiscard]] SparseMatrix<T, SparseFormat::csr, Index> to_csr() const {
+        if constexpr (is_csr) {
+            return *this;
+        } else {
+            return recompress<SparseFormat::csr>(m_rows, m_cols);
+        }
+    }
+    [[nodiscard]] SparseMatrix<T, SparseFormat::csc, Index> to_csc() const {
+        if constexpr (is_csr) {
+            return recompress<SparseFormat::csc>(m_rows, m_cols);
+        } else {
+            return *this;
+        }
+    }
+    [[nodiscard]] SparseMatrix get_transpose() const {
+        // the csr arrays of A are the csc arrays of A^T, so only the outer dimension changes
+        return recompress<format>(m_cols, m_rows);
+    }
+    [[nodiscard]] DynMatrix<T> to_dense() const {
+        DynMatrix<T> result{m_rows, m_cols};
+        for (size_t i{0}; i < outer(); ++i) {
+            for (size_t k{m_offsets[i]}; k < m_offsets[i + 1]; ++k) {
+                if constexpr (is_csr) {
+                    result[i][m_indices[k]] = m_values[k];
+                } else {
+                    result[m_indices[k]][i] = m_values[k];
+                }
+            }
+        }
+        return result;
+    }
+
+    // Products
+    /// y = A * x, x holds cols() elements and y rows(), they must not overlap
+    void multiply(const T* x, T* y) const {
+        if constexpr (is_csr) {
+            const bool can_gather{m_cols <= size_t{std::numeric_limits<int32_t>::max()}};
+            detail::for_each_outer_range(m_offsets, m_rows, nonzeros(),
+                                         [&](size_t first, size_t last) {
+                for (size_t i{first}; i < last; ++i) {
+                    const size_t begin{m_offsets[i]};
+                    const size_t count{m_offsets[i + 1] - begin};
+                    const Index* indices{m_indices.begin() + begin};
+                    const T* values{m_values.begin() + begin};
+                    if (can_gather) {
+                        y[i] = detail::sparse_dot(indices, values, count, x);
+                    } else {
+                        T sum{};
+                        for (size_t k{0}; k < count; ++k) {
+                            sum += values[k] * x[indices[k]];
+                        }
+                        y[i] = sum;
+                    }
+                }
+            });
+        } else {
+            std::fill(y, y + m_rows, T{});
+            for (size_t j{0}; j < m_cols; ++j) {
+                const T scalar{x[j]};
+                for (size_t k{m_offsets[j]}; k < m_offsets[j + 1]; ++k) {
+                    y[m_indices[k]] += m_values[k] * scalar;
+                }
+            }
+        }
+    }
+    /// throws std::invalid_argument if x does not have cols() elements
+    [[nodiscard]] friend shiv::Vector<T> operator*(const SparseMatrix& lhs,
+                                                   const shiv::Vector<T>& x) {
+        if (x.size() != lhs.m_cols) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        shiv::Vector<T> y{detail::filled_vector(lhs.m_rows, T{})};
+        lhs.multiply(x.begin(), y.begin());
+        return y;
+    }
+    /// the dense product, each nonzero scales a row of rhs into a row of the result
+    [[nodiscard]] friend DynMatrix<T> operator*(const SparseMatrix& lhs, const DynMatrix<T>& rhs) {
+        if (rhs.rows() != lhs.m_cols) {
+            throw std::invalid_argument{"Matrix dimensions do not match"};
+        }
+        DynMatrix<T> result{lhs.m_rows, rhs.cols()};
+        const size_t cols{rhs.cols()};
+        const auto scale_row_into{[cols](T* out, const T* in, T scalar) {
+            for (size_t j{0}; j < cols; ++j) {
+                out[j] += scalar * in[j];
+            }
+        }};
+        if constexpr (is_csr) {
+            detail::for_each_outer_range(lhs.m_offsets, lhs.m_rows, lhs.nonzeros() * cols,
+                                         [&](size_t first, size_t last) {
+                for (size_t i{first}; i < last; ++i) {
+                    for (size_t k{lhs.m_offsets[i]}; k < lhs.m_offsets[i + 1]; ++k) {
+                        scale_row_into(result[i], rhs[lhs.m_indices[k]], lhs.m_values[k]);
+                    }
+                }
+            });
+        } else {
+            for (size_t j{0}; j < lhs.m_cols; ++j) {
+                for (size_t k{lhs.m_offsets[j]}; k < lhs.m_offsets[j + 1]; ++k) {
+                    scale_row_into(result[lhs.m_indices[k]], rhs[j], lhs.m_values[k]);
+                }
+            }
+        }
+        return result;
+    }
+
+    // Comparison
+    [[nodiscard]] friend bool operator==(const SparseMatrix& lhs, const SparseMatrix& rhs) {
+        return lhs.m_rows == rhs.m_rows && lhs.m_cols == rhs.m_cols &&
+               lhs.nonzeros() == rhs.nonzeros() && lhs.m_offsets == rhs.m_offsets &&
+               lhs.m_indices == rhs.m_indices && lhs.m_values == rhs.m_values;
+    }
+    [[nodiscard]] friend bool operator!=(const SparseMatrix& lhs, const SparseMatrix& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+template <shiv::Arithmetic T, shiv::Integral Index = uint32_t>
+using CsrMatrix = SparseMatrix<T, SparseFormat::csr, Index>;
+template <shiv::Arithmetic T, shiv::Integral Index = uint32_t>
+using CscMatrix = SparseMatrix<T, SparseFormat::csc, Index>;
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_SPARSE_MATRIX_HPP
@@ -0,0 +1,173 @@
+#ifndef SHIVLIB_DATASTRUCTURE_SPLIT_HPP
+#define SHIVLIB_DATASTRUCTURE_SPLIT_HPP
+
+#include "../cstddef.hpp"
+#include "string_kernels.hpp"
+#include "string_view.hpp"
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace shiv {
+enum class EmptyTokens {
+    keep, // "a,,b," gives "a", "", "b" and ""
+    skip, // runs of delimiters count as one and empty tokens never show up
+};
+
+/// The tokens of a text between delimiters, found lazily as the range is walked, without
+/// allocating. The delimiter is a char, a string or a CharSet of single character delimiters.
+/// Each iterator carries a ByteScanner, so the delimiters are found a register at a time and
+/// stepping to the next token is usually a countr_zero and a bit clear. A string delimiter is
+/// scanned for by its first character and checked in full where that matches. Like
+/// std::views::split an empty text has no tokens and a trailing delimiter gives a trailing empty
+/// one. The text must outlive the range, and the range its iterators.
+template <typename Delimiter>
+class SplitRange {
+    StringView<char> m_text;
+    Delimiter m_delimiter;
+    EmptyTokens m_empty;
+
+    [[nodiscard]] detail::ByteScanner scanner() const noexcept {
+        if constexpr (std::is_same_v<Delimiter, CharSet>) {
+            return detail::ByteScanner{m_text.data(), m_text.size(), m_delimiter.table()};
+        } else if constexpr (std::is_same_v<Delimiter, char>) {
+            return detail::ByteScanner{m_text.data(), m_text.size(), m_delimiter};
+        } else {
+            return detail::ByteScanner{m_text.data(), m_text.size(), m_delimiter[0]};
+        }
+    }
+    [[nodiscard]] size_t delimiter_size() const noexcept {
+        if constexpr (std::is_same_v<Delimiter, StringView<char>>) {
+            return m_delimiter.size();
+        } else {
+            return 1;
+        }
+    }
+
+  public:
+    class Iterator {
+        const SplitRange* m_range{nullptr};
+        detail::ByteScanner m_scanner{nullptr, 0, '\0'};
+        // the current token is [m_begin, m_end), m_end is the text size for the last one
+        size_t m_begin{0};
+        size_t m_end{0};
+        bool m_done{true};
+
+        // the end of the token starting at begin, the next delimiter or the end of the text
+        [[nodiscard]] size_t find_delimiter(size_t begin) noexcept {
+            const StringView<char> text{m_range->m_text};
+            if constexpr (std::is_same_v<Delimiter, StringView<char>>) {
+                const StringView<char> delimiter{m_range->m_delimiter};
+                // first characters inside the last delimiter found are not candidates
+                m_scanner.skip_to(begin);
+                while (true) {
+                    const size_t found{m_scanner.next()};
+                    if (found == detail::not_found || found + delimiter.size() > text.size()) {
+                        return text.size();
+                    }
+                    if (std::memcmp(text.data() + found + 1, delimiter.data() + 1,
+                                    delimiter.size() - 1) == 0) {
+                        return found;
+                    }
+                }
+            } else {
+                // every delimiter ends a token, so the scanner's next is the one after begin
+                const size_t found{m_scanner.next()};
+                return found == detail::not_found ? text.size() : found;
+            }
+        }
+        // the token starting at begin, past any empty ones when they are skipped
+        void read_token(size_t begin) noexcept {
+            const size_t text_size{m_range->m_text.size()};
+            const size_t step{m_range->delimiter_size()};
+            while (true) {
+                m_begin = begin;
+                m_end = find_delimiter(begin);
+                if (m_range->m_empty == EmptyTokens::keep || m_end > m_begin) {
+                    return;
+                }
+                if (m_end == text_size) {
+                    m_done = true;
+                    return;
+                }
+                begin = m_end + step;
+            }
+        }
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StringView<char>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const StringView<char>*;
+        using reference = StringView<char>;
+
+        Iterator() noexcept = default;
+        explicit Iterator(const SplitRange& range) noexcept
+        : m_range{&range}
+        , m_scanner{range.scanner()}
+        , m_done{range.m_text.empty()} {
+            if (!m_done) {
+                read_token(0);
+            }
+        }
+
+        [[nodiscard]] StringView<char> operator*() const noexcept {
+            return StringView<char>{m_range->m_text.data() + m_begin, m_end - m_begin};
+        }
+        Iterator& operator++() noexcept {
+            if (m_end == m_range->m_text.size()) {
+                m_done = true;
+            } else {
+                read_token(m_end + m_range->delimiter_size());
+            }
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            auto copy{*this};
+            ++*this;
+            return copy;
+        }
+        [[nodiscard]] friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.m_done == rhs.m_done && (lhs.m_done || lhs.m_begin == rhs.m_begin);
+        }
+        [[nodiscard]] friend bool operator==(const Iterator& lhs,
+                                             std::default_sentinel_t) noexcept {
+            return lhs.m_done;
+        }
+    };
+
+    SplitRange(StringView<char> text, Delimiter delimiter, EmptyTokens empty) noexcept
+    : m_text{text}
+    , m_delimiter{delimiter}
+    , m_empty{empty} {
+    }
+
+    [[nodiscard]] Iterator begin() const noexcept {
+        return Iterator{*this};
+    }
+    [[nodiscard]] std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+    }
+};
+
+/// the tokens of text between each delimiter character
+[[nodiscard]] inline SplitRange<char> split(StringView<char> text, char delimiter,
+                                            EmptyTokens empty = EmptyTokens::keep) noexcept {
+    return SplitRange<char>{text, delimiter, empty};
+}
+/// the tokens of text between each occurrence of delimiter, which must not be empty
+[[nodiscard]] inline SplitRange<StringView<char>>
+split(StringView<char> text, StringView<char> delimiter,
+      EmptyTokens empty = EmptyTokens::keep) noexcept {
+    assert(!delimiter.empty() && "Delimiter must not be empty");
+    return SplitRange<StringView<char>>{text, delimiter, empty};
+}
+/// the tokens of text between characters of delimiters
+[[nodiscard]] inline SplitRange<CharSet> split(StringView<char> text, const CharSet& delimiters,
+                                               EmptyTokens empty = EmptyTokens::keep) noexcept {
+    return SplitRange<CharSet>{text, delimiters, empty};
+}
+} // namespace shiv
+
+#endif //SHIVLIB_DATASTRUCTURE_SPLIT_HPP
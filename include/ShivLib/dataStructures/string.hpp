@@ -1,12 +1,47 @@
 #ifndef SHIVLIB_STRING_HPP
 #define SHIVLIB_STRING_HPP
 
+#include "../concepts.hpp"
+#include "string_view.hpp"
+#include "vector.hpp"
+#include <bit>
+#include <cassert>
 #include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace shiv {
-template <typename T>
-class string {
+/// An owning, null terminated string that keeps up to short_capacity characters, 23 for char,
+/// inside its own 24 bytes and only allocates past that, so short keys never touch the heap.
+/// The last character of the short form holds the room left, which makes a full short string
+/// end in its own terminator. A long string's capacity is stored with its top bit set, which
+/// lands in that same last byte and tells the two apart. Grows as Vector does.
+template <shiv::Character T = char, typename A = std::allocator<T>>
+class String {
+    static_assert(std::endian::native == std::endian::little,
+                  "String's short form relies on a little endian layout");
+    using alloc = std::allocator_traits<A>;
+    using traits = std::char_traits<T>;
+
+    struct Long {
+        T* data;
+        size_t size;
+        size_t capacity;
+    };
+    struct Short {
+        T data[sizeof(Long) / sizeof(T)];
+    };
+    union Storage {
+        Long long_form;
+        Short short_form;
+    };
+    static constexpr size_t long_flag{size_t{1} << (sizeof(size_t) * 8 - 1)};
+
+  public:
     using value_type = T;
+    using allocator_type = A;
     using pointer = T*;
     using iterator = T*;
     using const_iterator = const T*;
@@ -15,7 +50,365 @@ class string {
     using reference = T&;
     using const_reference = const T&;
     using rvalue_reference = T&&;
+
+    static constexpr size_t npos = size_t{static_cast<size_t>(-1)};
+    /// the longest string kept without allocating
+    static constexpr size_t short_capacity{sizeof(Long) / sizeof(T) - 1};
+
+  private:
+    Storage m_storage{};
+    [[no_unique_address]] A m_allocator{};
+
+    [[nodiscard]] bool is_long() const noexcept {
+        // the top byte of the long capacity, or the room left in the short form
+        const auto* bytes{reinterpret_cast<const unsigned char*>(&m_storage)};
+        return (bytes[sizeof(Storage) - 1] & 0x80) != 0;
+    }
+    void set_size(size_t new_size) noexcept {
+        T* characters{m_storage.long_form.data};
+        if (is_long()) {
+            m_storage.long_form.size = new_size;
+        } else {
+            characters = m_storage.short_form.data;
+            characters[short_capacity] = static_cast<T>(short_capacity - new_size);
+        }
+        // after the room left, which a full short string's terminator overwrites with 0 anyway
+        characters[new_size] = T{};
+    }
+    void release() noexcept {
+        if (is_long()) {
+            alloc::deallocate(m_allocator, m_storage.long_form.data, capacity() + 1);
+        }
+    }
+    // moves to a buffer of new_capacity holding the first keep characters followed by count
+    // from source. source may point into the old buffer, which is only freed once it is copied.
+    void reallocate(size_t new_capacity, size_t keep, const T* source, size_t count) {
+        T* new_data{alloc::allocate(m_allocator, new_capacity + 1)};
+        traits::copy(new_data, data(), keep);
+        if (count != 0) {
+            traits::copy(new_data + keep, source, count);
+        }
+        release();
+        m_storage.long_form = Long{new_data, keep + count, new_capacity | long_flag};
+        new_data[keep + count] = T{};
+    }
+    void reserve_more(size_t required) {
+        if (required > capacity()) {
+            reallocate(detail::grow_capacity(capacity(), required), size(), nullptr, 0);
+        }
+    }
+    void initialise(const T* source, size_t count) {
+        if (count <= short_capacity) {
+            traits::copy(m_storage.short_form.data, source, count);
+            set_size(count);
+        } else {
+            set_size(0);
+            reallocate(count, 0, source, count);
+        }
+    }
+
+  public:
+    String() noexcept(noexcept(A{}))
+    : String(A{}) {
+    }
+    explicit String(const A& allocator) noexcept
+    : m_allocator{allocator} {
+        set_size(0);
+    }
+    String(StringView<T> view, const A& allocator = A{})
+    : m_allocator{allocator} {
+        initialise(view.data(), view.size());
+    }
+    String(const T* str, const A& allocator = A{})
+    : String(StringView<T>{str}, allocator) {
+    }
+    String(const T* str, size_t count, const A& allocator = A{})
+    : String(StringView<T>{str, count}, allocator) {
+    }
+    String(size_t count, T c, const A& allocator = A{})
+    : String(allocator) {
+        append(count, c);
+    }
+
+    String(const String& other)
+    : m_allocator{alloc::select_on_container_copy_construction(other.m_allocator)} {
+        initialise(other.data(), other.size());
+    }
+    String(String&& other) noexcept
+    : m_storage{other.m_storage}
+    , m_allocator{std::move(other.m_allocator)} {
+        other.m_storage = Storage{};
+        other.set_size(0);
+    }
+    String& operator=(const String& other) {
+        if (this != &other) {
+            if constexpr (alloc::propagate_on_container_copy_assignment::value) {
+                if (m_allocator != other.m_allocator) {
+                    release();
+                    m_storage = Storage{};
+                    set_size(0);
+                }
+                m_allocator = other.m_allocator;
+            }
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+    String& operator=(String&& other) noexcept(
+        alloc::propagate_on_container_move_assignment::value || alloc::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (!alloc::propagate_on_container_move_assignment::value &&
+                      !alloc::is_always_equal::value) {
+            if (m_allocator != other.m_allocator) {
+                // the other string's buffer cannot be freed through this allocator
+                assign(other.data(), other.size());
+                return *this;
+            }
+        }
+        release();
+        m_storage = other.m_storage;
+        if constexpr (alloc::propagate_on_container_move_assignment::value) {
+            m_allocator = std::move(other.m_allocator);
+        }
+        other.m_storage = Storage{};
+        other.set_size(0);
+        return *this;
+    }
+    String& operator=(StringView<T> view) {
+        return assign(view.data(), view.size());
+    }
+    ~String() {
+        release();
+    }
+
+    /// replaces the contents, source may point into this string
+    String& assign(const T* source, size_t count) {
+        if (count > capacity()) {
+            reallocate(count, 0, source, count);
+        } else {
+            traits::move(data(), source, count);
+            set_size(count);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] A get_allocator() const noexcept {
+        return m_allocator;
+    }
+
+    // adding characters, view may be part of this string
+    String& append(StringView<T> view) {
+        const size_t length{size()};
+        if (length + view.size() > capacity()) {
+            reallocate(detail::grow_capacity(capacity(), length + view.size()), length,
+                       view.data(), view.size());
+        } else {
+            traits::move(data() + length, view.data(), view.size());
+            set_size(length + view.size());
+        }
+        return *this;
+    }
+    String& append(const T* str) {
+        return append(StringView<T>{str});
+    }
+    String& append(const T* str, size_t count) {
+        return append(StringView<T>{str, count});
+    }
+    String& append(size_t count, T c) {
+        const size_t length{size()};
+        reserve_more(length + count);
+        traits::assign(data() + length, count, c);
+        set_size(length + count);
+        return *this;
+    }
+    void push_back(T c) {
+        const size_t length{size()};
+        reserve_more(length + 1);
+        data()[length] = c;
+        set_size(length + 1);
+    }
+    String& operator+=(StringView<T> view) {
+        return append(view);
+    }
+    String& operator+=(const T* str) {
+        return append(StringView<T>{str});
+    }
+    String& operator+=(T c) {
+        push_back(c);
+        return *this;
+    }
+
+    /// makes room for at least new_capacity characters without changing the contents
+    void reserve(size_t new_capacity) {
+        if (new_capacity > capacity()) {
+            reallocate(new_capacity, size(), nullptr, 0);
+        }
+    }
+    void resize(size_t new_size, T c = T{}) {
+        const size_t length{size()};
+        if (new_size > length) {
+            append(new_size - length, c);
+        } else {
+            set_size(new_size);
+        }
+    }
+    /// resize without writing the new characters, for a caller that is about to overwrite them,
+    /// such as a formatter or a read from a socket
+    void resize_for_overwrite(size_t new_size) {
+        reserve_more(new_size);
+        set_size(new_size);
+    }
+
+    // removing characters
+    void pop_back() noexcept {
+        assert(!empty());
+        set_size(size() - 1);
+    }
+    void clear() noexcept {
+        set_size(0);
+    }
+    /// moves back into the short form if the contents fit, or to a buffer of exactly size()
+    void shrink_to_fit() {
+        if (!is_long() || capacity() == size()) {
+            return;
+        }
+        const size_t length{size()};
+        if (length > short_capacity) {
+            reallocate(length, length, nullptr, 0);
+            return;
+        }
+        const Long old{m_storage.long_form};
+        m_storage = Storage{};
+        traits::copy(m_storage.short_form.data, old.data, length);
+        set_size(length);
+        alloc::deallocate(m_allocator, old.data, (old.capacity & ~long_flag) + 1);
+    }
+
+    void swap(String& other) noexcept {
+        std::swap(m_storage, other.m_storage);
+        if constexpr (alloc::propagate_on_container_swap::value) {
+            std::swap(m_allocator, other.m_allocator);
+        }
+    }
+
+    // Element Access
+    [[nodiscard]] T* data() noexcept {
+        return is_long() ? m_storage.long_form.data : m_storage.short_form.data;
+    }
+    [[nodiscard]] const T* data() const noexcept {
+        return is_long() ? m_storage.long_form.data : m_storage.short_form.data;
+    }
+    [[nodiscard]] const T* c_str() const noexcept {
+        return data();
+    }
+    [[nodiscard]] reference operator[](size_t index) noexcept {
+        assert((index < size()) && ("Index out of range"));
+        return data()[index];
+    }
+    [[nodiscard]] const_reference operator[](size_t index) const noexcept {
+        assert((index < size()) && ("Index out of range"));
+        return data()[index];
+    }
+    [[nodiscard]] reference at(size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return data()[index];
+    }
+    [[nodiscard]] const_reference at(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range{"Element out of range"};
+        }
+        return data()[index];
+    }
+    [[nodiscard]] reference front() noexcept {
+        return *begin();
+    }
+    [[nodiscard]] const_reference front() const noexcept {
+        return *begin();
+    }
+    [[nodiscard]] reference back() noexcept {
+        return *(end() - 1);
+    }
+    [[nodiscard]] const_reference back() const noexcept {
+        return *(end() - 1);
+    }
+
+    [[nodiscard]] StringView<T> view() const noexcept {
+        return StringView<T>{data(), size()};
+    }
+    operator StringView<T>() const noexcept {
+        return view();
+    }
+
+    // Iterators
+    [[nodiscard]] auto begin() noexcept {
+        return iterator{data()};
+    }
+    [[nodiscard]] auto begin() const noexcept {
+        return const_iterator{data()};
+    }
+    [[nodiscard]] auto cbegin() const noexcept {
+        return const_iterator{data()};
+    }
+    [[nodiscard]] auto rbegin() noexcept {
+        return reverse_iterator{end()};
+    }
+    [[nodiscard]] auto rbegin() const noexcept {
+        return const_reverse_iterator{end()};
+    }
+    [[nodiscard]] auto crbegin() const noexcept {
+        return const_reverse_iterator{end()};
+    }
+    [[nodiscard]] auto end() noexcept {
+        return iterator{data() + size()};
+    }
+    [[nodiscard]] auto end() const noexcept {
+        return const_iterator{data() + size()};
+    }
+    [[nodiscard]] auto cend() const noexcept {
+        return const_iterator{data() + size()};
+    }
+    [[nodiscard]] auto rend() noexcept {
+        return reverse_iterator{begin()};
+    }
+    [[nodiscard]] auto rend() const noexcept {
+        return const_reverse_iterator{begin()};
+    }
+    [[nodiscard]] auto crend() const noexcept {
+        return const_reverse_iterator{begin()};
+    }
+
+    // Capacity
+    [[nodiscard]] size_t size() const noexcept {
+        if (is_long()) {
+            return m_storage.long_form.size;
+        }
+        return short_capacity - static_cast<size_t>(m_storage.short_form.data[short_capacity]);
+    }
+    [[nodiscard]] size_t length() const noexcept {
+        return size();
+    }
+    [[nodiscard]] size_t capacity() const noexcept {
+        return is_long() ? m_storage.long_form.capacity & ~long_flag : short_capacity;
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // comparison
+    [[nodiscard]] int compare(StringView<T> other) const noexcept {
+        return view().compare(other);
+    }
+    [[nodiscard]] friend bool operator==(const String& lhs, StringView<T> rhs) noexcept {
+        return lhs.view() == rhs;
+    }
 };
+
+/// the string of chars, as std::string is std::basic_string<char>
+using string = String<char>;
 } // namespace shiv
 
 #endif //SHIVLIB_STRING_HPP
@@ -0,0 +1,473 @@
+#ifndef SHIVLIB_DATASTRUCTURE_STRING_KERNELS_HPP
+#define SHIVLIB_DATASTRUCTURE_STRING_KERNELS_HPP
+
+#include "../cstddef.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Byte searches shared by the string classes. Each takes a run of bytes and returns an offset
+// into it or not_found. They are for run time only, the classes keep scalar loops for constant
+// evaluation and for characters wider than a byte.
+
+namespace shiv::detail {
+inline constexpr size_t not_found{static_cast<size_t>(-1)};
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+/// One register of bytes, the widest of AVX-512BW, AVX2 and SSE4.1 compiled for, so each search
+/// is written once. A mask has a bit per byte, lowest address in the lowest bit. classify finds
+/// the bytes in a set held as two 16 entry tables: the low nibble picks a row of 8 bits from the
+/// table for its half of the byte range and the high nibble picks the bit.
+struct ByteVec {
+#if defined(__AVX512BW__)
+    using reg = __m512i;
+    using mask_type = uint64_t;
+#elif defined(__AVX2__)
+    using reg = __m256i;
+    using mask_type = uint32_t;
+#else
+    using reg = __m128i;
+    using mask_type = uint32_t;
+#endif
+    static constexpr size_t width{sizeof(reg)};
+    static constexpr mask_type all{static_cast<mask_type>(~uint64_t{0} >> (64 - width))};
+
+    static reg load(const char* ptr) noexcept {
+        reg value;
+        std::memcpy(&value, ptr, sizeof(reg));
+        return value;
+    }
+    /// from data to the next register boundary, 1 to width. A search that has checked the first
+    /// register steps this far so the rest of its loads are aligned, a 64 byte register that
+    /// is not would straddle two cache lines on every load.
+    static size_t aligned_step(const char* data) noexcept {
+        return width - reinterpret_cast<uintptr_t>(data) % width;
+    }
+    /// the same for a search running backwards from end
+    static size_t aligned_back_step(const char* end) noexcept {
+        const size_t offset{reinterpret_cast<uintptr_t>(end) % width};
+        return offset == 0 ? width : offset;
+    }
+
+#if defined(__AVX512BW__)
+    static reg broadcast(char value) noexcept {
+        return _mm512_set1_epi8(value);
+    }
+    /// the same 16 bytes in each 128 bit lane, as the shuffles read them. The zero masked
+    /// form, as the plain one leaves GCC warning that its undefined source is uninitialized.
+    static reg broadcast(const uint8_t* table) noexcept {
+        return _mm512_maskz_broadcast_i32x4(
+            0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+    }
+    static mask_type matches(reg a, reg b) noexcept {
+        return _mm512_cmpeq_epi8_mask(a, b);
+    }
+    static mask_type classify(reg bytes, reg low_table, reg high_table, reg bit_table) noexcept {
+        const reg nibble{_mm512_set1_epi8(0x0F)};
+        const reg low{_mm512_and_si512(bytes, nibble)};
+        const reg row{_mm512_mask_blend_epi8(_mm512_movepi8_mask(bytes),
+                                             _mm512_shuffle_epi8(low_table, low),
+                                             _mm512_shuffle_epi8(high_table, low))};
+        const reg high{_mm512_and_si512(_mm512_srli_epi16(bytes, 4), nibble)};
+        return _mm512_test_epi8_mask(row, _mm512_shuffle_epi8(bit_table, high));
+    }
+#elif defined(__AVX2__)
+    static reg broadcast(char value) noexcept {
+        return _mm256_set1_epi8(value);
+    }
+    static reg broadcast(const uint8_t* table) noexcept {
+        return _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+    }
+    static mask_type matches(reg a, reg b) noexcept {
+        return static_cast<mask_type>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    }
+    static mask_type classify(reg bytes, reg low_table, reg high_table, reg bit_table) noexcept {
+        const reg nibble{_mm256_set1_epi8(0x0F)};
+        const reg low{_mm256_and_si256(bytes, nibble)};
+        const reg row{_mm256_blendv_epi8(_mm256_shuffle_epi8(low_table, low),
+                                         _mm256_shuffle_epi8(high_table, low), bytes)};
+        const reg high{_mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble)};
+        const reg bit{_mm256_shuffle_epi8(bit_table, high)};
+        return matches(_mm256_and_si256(row, bit), bit);
+    }
+#else
+    static reg broadcast(char value) noexcept {
+        return _mm_set1_epi8(value);
+    }
+    static reg broadcast(const uint8_t* table) noexcept {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+    }
+    static mask_type matches(reg a, reg b) noexcept {
+        return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    }
+    static mask_type classify(reg bytes, reg low_table, reg high_table, reg bit_table) noexcept {
+        const reg nibble{_mm_set1_epi8(0x0F)};
+        const reg low{_mm_and_si128(bytes, nibble)};
+        const reg row{_mm_blendv_epi8(_mm_shuffle_epi8(low_table, low),
+                                      _mm_shuffle_epi8(high_table, low), bytes)};
+        const reg high{_mm_and_si128(_mm_srli_epi16(bytes, 4), nibble)};
+        const reg bit{_mm_shuffle_epi8(bit_table, high)};
+        return matches(_mm_and_si128(row, bit), bit);
+    }
+#endif
+};
+#endif
+
+/// first offset holding value
+[[nodiscard]] inline size_t find_byte(const char* data, size_t size, char value) noexcept {
+    size_t i{0};
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    using V = ByteVec;
+    const auto needle{V::broadcast(value)};
+    if (size >= V::width) {
+        const V::mask_type mask{V::matches(V::load(data), needle)};
+        if (mask != 0) {
+            return static_cast<size_t>(std::countr_zero(mask));
+        }
+        i = V::aligned_step(data);
+    }
+    // two registers a step, told apart only once either has a match
+    for (; i + 2 * V::width <= size; i += 2 * V::width) {
+        const V::mask_type first{V::matches(V::load(data + i), needle)};
+        const V::mask_type second{V::matches(V::load(data + i + V::width), needle)};
+        if ((first | second) != 0) {
+            return first != 0 ? i + static_cast<size_t>(std::countr_zero(first))
+                              : i + V::width + static_cast<size_t>(std::countr_zero(second));
+        }
+    }
+    for (; i + V::width <= size; i += V::width) {
+        const V::mask_type mask{V::matches(V::load(data + i), needle)};
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return not_found;
+}
+
+/// last offset holding value
+[[nodiscard]] inline size_t rfind_byte(const char* data, size_t size, char value) noexcept {
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    using V = ByteVec;
+    const auto needle{V::broadcast(value)};
+    if (size >= V::width) {
+        const V::mask_type mask{V::matches(V::load(data + size - V::width), needle)};
+        if (mask != 0) {
+            return size - V::width + static_cast<size_t>(std::bit_width(mask)) - 1;
+        }
+        size -= V::aligned_back_step(data + size);
+    }
+    for (; size >= 2 * V::width; size -= 2 * V::width) {
+        const V::mask_type high{V::matches(V::load(data + size - V::width), needle)};
+        const V::mask_type low{V::matches(V::load(data + size - 2 * V::width), needle)};
+        if ((high | low) != 0) {
+            return high != 0 ? size - V::width + static_cast<size_t>(std::bit_width(high)) - 1
+                             : size - 2 * V::width + static_cast<size_t>(std::bit_width(low)) - 1;
+        }
+    }
+    for (; size >= V::width; size -= V::width) {
+        const V::mask_type mask{V::matches(V::load(data + size - V::width), needle)};
+        if (mask != 0) {
+            return size - V::width + static_cast<size_t>(std::bit_width(mask)) - 1;
+        }
+    }
+#endif
+    while (size > 0) {
+        --size;
+        if (data[size] == value) {
+            return size;
+        }
+    }
+    return not_found;
+}
+
+/// first offset of needle. Candidates are found a register at a time by comparing the first and
+/// last bytes of the needle at once and only those are compared in full, so on most text the
+/// cost is close to find_byte however long the needle.
+[[nodiscard]] inline size_t find_bytes(const char* data, size_t size, const char* needle,
+                                       size_t length) noexcept {
+    if (length == 0) {
+        return 0;
+    }
+    if (length > size) {
+        return not_found;
+    }
+    if (length == 1) {
+        return find_byte(data, size, needle[0]);
+    }
+    size_t i{0};
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    using V = ByteVec;
+    const auto first{V::broadcast(needle[0])};
+    const auto last{V::broadcast(needle[length - 1])};
+    const char* tail{data + length - 1};
+    // candidates starting in the register at block
+    const auto filter{[&](size_t block) {
+        return V::matches(V::load(data + block), first) & V::matches(V::load(tail + block), last);
+    }};
+    // the first of them that is a match
+    const auto verify{[&](size_t block, V::mask_type mask) {
+        for (; mask != 0; mask &= mask - 1) {
+            const size_t at{block + static_cast<size_t>(std::countr_zero(mask))};
+            if (std::memcmp(data + at + 1, needle + 1, length - 2) == 0) {
+                return at;
+            }
+        }
+        return not_found;
+    }};
+    if (length - 1 + V::width <= size) {
+        if (const size_t at{verify(0, filter(0))}; at != not_found) {
+            return at;
+        }
+        i = V::aligned_step(data);
+    }
+    for (; i + length - 1 + 2 * V::width <= size; i += 2 * V::width) {
+        const V::mask_type low{filter(i)};
+        const V::mask_type high{filter(i + V::width)};
+        if ((low | high) != 0) {
+            if (const size_t at{verify(i, low)}; at != not_found) {
+                return at;
+            }
+            if (const size_t at{verify(i + V::width, high)}; at != not_found) {
+                return at;
+            }
+        }
+    }
+    for (; i + length - 1 + V::width <= size; i += V::width) {
+        if (const size_t at{verify(i, filter(i))}; at != not_found) {
+            return at;
+        }
+    }
+#endif
+    for (; i + length <= size; ++i) {
+        if (data[i] == needle[0] && std::memcmp(data + i + 1, needle + 1, length - 1) == 0) {
+            return i;
+        }
+    }
+    return not_found;
+}
+
+/// last offset of needle, the same filter run backwards
+[[nodiscard]] inline size_t rfind_bytes(const char* data, size_t size, const char* needle,
+                                        size_t length) noexcept {
+    if (length > size) {
+        return not_found;
+    }
+    if (length == 0) {
+        return size;
+    }
+    if (length == 1) {
+        return rfind_byte(data, size, needle[0]);
+    }
+    // candidates start in [0, end)
+    size_t end{size - length + 1};
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    using V = ByteVec;
+    const auto first{V::broadcast(needle[0])};
+    const auto last{V::broadcast(needle[length - 1])};
+    const char* tail{data + length - 1};
+    for (bool aligned{false}; end >= V::width;
+         end -= aligned ? V::width : V::aligned_back_step(data + end), aligned = true) {
+        const size_t block{end - V::width};
+        V::mask_type mask{V::matches(V::load(data + block), first) &
+                          V::matches(V::load(tail + block), last)};
+        while (mask != 0) {
+            const auto top{static_cast<size_t>(std::bit_width(mask)) - 1};
+            if (std::memcmp(data + block + top + 1, needle + 1, length - 2) == 0) {
+                return block + top;
+            }
+            mask &= ~(V::mask_type{1} << top);
+        }
+    }
+#endif
+    while (end > 0) {
+        --end;
+        if (data[end] == needle[0] && std::memcmp(data + end + 1, needle + 1, length - 1) == 0) {
+            return end;
+        }
+    }
+    return not_found;
+}
+
+/// whether byte is in a set held as two 16 entry tables, see CharSet
+[[nodiscard]] constexpr bool in_byte_set(const uint8_t* table, char value) noexcept {
+    const auto byte{static_cast<uint8_t>(value)};
+    return ((table[(byte >> 7) * 16 + (byte & 0x0F)] >> ((byte >> 4) & 7)) & 1) != 0;
+}
+
+/// first offset whose byte is, or with member false is not, in the set
+[[nodiscard]] inline size_t find_in_byte_set(const char* data, size_t size, const uint8_t* table,
+                                             bool member) noexcept {
+    size_t i{0};
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    using V = ByteVec;
+    const auto low_table{V::broadcast(table)};
+    const auto high_table{V::broadcast(table + 16)};
+    constexpr uint8_t bits[16]{1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const auto bit_table{V::broadcast(bits)};
+    const V::mask_type flip{member ? V::mask_type{0} : V::all};
+    if (size >= V::width) {
+        const V::mask_type mask{
+            V::classify(V::load(data), low_table, high_table, bit_table) ^ flip};
+        if (mask != 0) {
+            return static_cast<size_t>(std::countr_zero(mask));
+        }
+        i = V::aligned_step(data);
+    }
+    for (; i + 2 * V::width <= size; i += 2 * V::width) {
+        const V::mask_type first{
+            V::classify(V::load(data + i), low_table, high_table, bit_table) ^ flip};
+        const V::mask_type second{
+            V::classify(V::load(data + i + V::width), low_table, high_table, bit_table) ^ flip};
+        if ((first | second) != 0) {
+            return first != 0 ? i + static_cast<size_t>(std::countr_zero(first))
+                              : i + V::width + static_cast<size_t>(std::countr_zero(second));
+        }
+    }
+    for (; i + V::width <= size; i += V::width) {
+        const V::mask_type mask{
+            V::classify(V::load(data + i), low_table, high_table, bit_table) ^ flip};
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (in_byte_set(table, data[i]) == member) {
+            return i;
+        }
+    }
+    return not_found;
+}
+
+/// Hands out every offset whose byte is value, or is in a set table, in order. The matches of
+/// one register are kept as a bitmask and handed out by clearing the lowest bit, so stepping
+/// from one delimiter to the next costs a countr_zero and the loop carries nothing slower than
+/// the bit clear, a load per register aside, rather than a fresh search per delimiter.
+class ByteScanner {
+    const char* m_data;
+    size_t m_size;
+    const uint8_t* m_table{nullptr};
+    char m_value{'\0'};
+    // offsets before m_scanned have been looked at, the matches of the register at m_block not
+    // yet handed out are in m_mask
+    size_t m_scanned{0};
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    size_t m_block{0};
+    ByteVec::mask_type m_mask{0};
+
+    [[nodiscard]] ByteVec::mask_type match(const char* ptr) const noexcept {
+        using V = ByteVec;
+        if (!m_table) {
+            return V::matches(V::load(ptr), V::broadcast(m_value));
+        }
+        constexpr uint8_t bits[16]{1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        return V::classify(V::load(ptr), V::broadcast(m_table), V::broadcast(m_table + 16),
+                           V::broadcast(bits));
+    }
+    // loads registers until one has a match, false at the end of the data. A loop of its own
+    // so next is a test, a countr_zero and a bit clear, written inline GCC kept the mask in an
+    // AVX-512 mask register and moved it out and back for every match.
+    bool refill() noexcept {
+        using V = ByteVec;
+        while (m_mask == 0) {
+            if (m_scanned >= m_size) {
+                return false;
+            }
+            // the aligned register holding the first byte not looked at, the last one moved
+            // back inside the data, with the bytes already looked at masked off
+            const size_t misalignment{reinterpret_cast<uintptr_t>(m_data + m_scanned) % V::width};
+            m_block = m_scanned < V::width ? 0
+                                           : std::min(m_scanned - misalignment, m_size - V::width);
+            m_mask = match(m_data + m_block) &
+                     static_cast<V::mask_type>(V::all << (m_scanned - m_block));
+            m_scanned = m_block + V::width;
+        }
+        return true;
+    }
+#endif
+
+  public:
+    ByteScanner(const char* data, size_t size, char value) noexcept
+    : m_data{data}
+    , m_size{size}
+    , m_value{value} {
+    }
+    ByteScanner(const char* data, size_t size, const uint8_t* table) noexcept
+    : m_data{data}
+    , m_size{size}
+    , m_table{table} {
+    }
+
+    /// the next matching offset, each is handed out once
+    [[nodiscard]] size_t next() noexcept {
+#if defined(__AVX2__) || defined(__SSE4_1__)
+        using V = ByteVec;
+        if (m_size >= V::width) {
+            if (m_mask == 0 && !refill()) {
+                return not_found;
+            }
+            const size_t found{m_block + static_cast<size_t>(std::countr_zero(m_mask))};
+            m_mask &= m_mask - 1;
+            return found;
+        }
+#endif
+        for (; m_scanned < m_size; ++m_scanned) {
+            if (m_table ? in_byte_set(m_table, m_data[m_scanned])
+                        : m_data[m_scanned] == m_value) {
+                return m_scanned++;
+            }
+        }
+        return not_found;
+    }
+    /// drops the matches before from, after a match that covers more than its own byte
+    void skip_to(size_t from) noexcept {
+#if defined(__AVX2__) || defined(__SSE4_1__)
+        if (m_size >= ByteVec::width && from < m_scanned) {
+            if (from > m_block) {
+                m_mask &= static_cast<ByteVec::mask_type>(ByteVec::all << (from - m_block));
+            }
+            return;
+        }
+        m_mask = 0;
+#endif
+        m_scanned = std::max(m_scanned, from);
+    }
+};
+
+/// whether two runs of size bytes match. The size is fixed so this unrolls into a few 16 byte
+/// compares, the last overlapping the one before where size is not a multiple of 16, and a
+/// single test at the end rather than a branch per word.
+template <size_t size>
+[[nodiscard]] inline bool equal_bytes(const char* lhs, const char* rhs) noexcept {
+#if defined(__SSE2__)
+    if constexpr (size >= 16) {
+        const auto load{[](const char* ptr) {
+            __m128i value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return value;
+        }};
+        __m128i equal{_mm_cmpeq_epi8(load(lhs + size - 16), load(rhs + size - 16))};
+        for (size_t i{0}; i + 16 < size; i += 16) {
+            equal = _mm_and_si128(equal, _mm_cmpeq_epi8(load(lhs + i), load(rhs + i)));
+        }
+        return _mm_movemask_epi8(equal) == 0xFFFF;
+    }
+#endif
+    return std::memcmp(lhs, rhs, size) == 0;
+}
+} // namespace shiv::detail
+
+#endif //SHIVLIB_DATASTRUCTURE_STRING_KERNELS_HPP
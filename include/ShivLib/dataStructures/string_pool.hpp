@@ -0,0 +1,261 @@
+#ifndef SHIVLIB_DATASTRUCTURE_STRING_POOL_HPP
+#define SHIVLIB_DATASTRUCTURE_STRING_POOL_HPP
+
+#include "../cstddef.hpp"
+#include "../hash.hpp"
+#include "string_view.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace shiv {
+class StringPool;
+
+/// A handle to a string interned in a StringPool, equal exactly when the strings are. The
+/// default Symbol is the empty string of every pool.
+class Symbol {
+    uint32_t m_id{0};
+
+    friend class StringPool;
+    explicit constexpr Symbol(uint32_t id) noexcept
+    : m_id{id} {
+    }
+
+  public:
+    constexpr Symbol() noexcept = default;
+
+    /// ids count up from 0 in the order strings were first interned
+    [[nodiscard]] constexpr uint32_t id() const noexcept {
+        return m_id;
+    }
+    [[nodiscard]] friend constexpr bool operator==(Symbol lhs, Symbol rhs) noexcept = default;
+};
+
+/// Stores each distinct string once and hands out a 32 bit Symbol for it. The characters live
+/// in arena blocks that never move, so the StringView for a Symbol stays valid for the life of
+/// the pool. Lookups are lock free: an open addressing table of slots packing a 32 bit hash tag
+/// with the id, so a probe only touches a string whose tag matches. Interning a new string takes
+/// a lock. A grown table is published with a single store and the old one kept until the pool
+/// is destroyed, for readers still probing it, which at most doubles the table memory.
+class StringPool {
+    // Each string is stored as a record, its length then its characters, and an entry is just
+    // a pointer to the record. A length under 255 is one byte, longer ones are 255 followed by
+    // four bytes of length.
+    using Entry = const unsigned char*;
+    static constexpr unsigned char long_length{255};
+    static constexpr unsigned char empty_record[1]{0};
+    struct Table {
+        // hash tag in the top half, id + 1 in the bottom, 0 for an empty slot
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+        size_t mask;
+    };
+
+    // entries by id in segments of doubling size, so an entry never moves once written
+    static constexpr size_t first_segment_bits{10};
+    static constexpr size_t segment_count{33 - first_segment_bits};
+    static constexpr size_t block_size{size_t{1} << 16};
+
+    std::atomic<Entry*> m_segments[segment_count]{};
+    std::atomic<const Table*> m_table{nullptr};
+    std::atomic<uint32_t> m_size{0};
+
+    // only touched with m_mutex held
+    mutable std::mutex m_mutex{};
+    std::vector<std::unique_ptr<Table>> m_tables{};
+    std::vector<std::unique_ptr<unsigned char[]>> m_blocks{};
+    unsigned char* m_cursor{nullptr};
+    size_t m_remaining{0};
+    size_t m_bytes{0};
+
+    [[nodiscard]] static uint32_t hash(StringView<char> str) noexcept {
+        const uint64_t full{hash_bytes(str.data(), str.size())};
+        return static_cast<uint32_t>(full ^ (full >> 32));
+    }
+    [[nodiscard]] static std::pair<size_t, size_t> locate(uint32_t id) noexcept {
+        const size_t index{size_t{id} + (size_t{1} << first_segment_bits)};
+        const size_t segment{static_cast<size_t>(std::bit_width(index)) - 1 - first_segment_bits};
+        return {segment, index - (size_t{1} << (segment + first_segment_bits))};
+    }
+    [[nodiscard]] StringView<char> entry(uint32_t id) const noexcept {
+        const auto [segment, offset]{locate(id)};
+        const Entry record{m_segments[segment].load(std::memory_order_acquire)[offset]};
+        if (record[0] != long_length) {
+            return StringView<char>{reinterpret_cast<const char*>(record + 1), record[0]};
+        }
+        uint32_t size{};
+        std::memcpy(&size, record + 1, sizeof(size));
+        return StringView<char>{reinterpret_cast<const char*>(record + 1 + sizeof(size)), size};
+    }
+
+    [[nodiscard]] std::optional<Symbol> lookup(const Table& table, StringView<char> str,
+                                               uint32_t tag) const noexcept {
+        for (size_t i{tag & table.mask};; i = (i + 1) & table.mask) {
+            const uint64_t slot{table.slots[i].load(std::memory_order_acquire)};
+            if (slot == 0) {
+                return std::nullopt;
+            }
+            if (static_cast<uint32_t>(slot >> 32) == tag) {
+                const auto id{static_cast<uint32_t>(slot) - 1};
+                const StringView<char> found{entry(id)};
+                if (found.size() == str.size() &&
+                    std::memcmp(found.data(), str.data(), str.size()) == 0) {
+                    return Symbol{id};
+                }
+            }
+        }
+    }
+    static void place(const Table& table, uint64_t slot) noexcept {
+        size_t i{static_cast<uint32_t>(slot >> 32) & table.mask};
+        while (table.slots[i].load(std::memory_order_relaxed) != 0) {
+            i = (i + 1) & table.mask;
+        }
+        table.slots[i].store(slot, std::memory_order_release);
+    }
+    // a table twice the size of the current one holding every slot of it, or the first table
+    [[nodiscard]] const Table* grow(const Table* current) {
+        const size_t slot_count{current ? (current->mask + 1) * 2 : size_t{1} << 12};
+        auto table{std::make_unique<Table>(
+            Table{std::make_unique<std::atomic<uint64_t>[]>(slot_count), slot_count - 1})};
+        if (current) {
+            for (size_t i{0}; i <= current->mask; ++i) {
+                if (const uint64_t slot{current->slots[i].load(std::memory_order_relaxed)}) {
+                    place(*table, slot);
+                }
+            }
+        }
+        m_bytes += slot_count * sizeof(uint64_t);
+        m_tables.push_back(std::move(table));
+        return m_tables.back().get();
+    }
+
+    [[nodiscard]] Entry store(StringView<char> str) {
+        if (str.empty()) {
+            return empty_record;
+        }
+        const size_t header{str.size() < long_length ? size_t{1} : 1 + sizeof(uint32_t)};
+        const size_t record_size{header + str.size()};
+        unsigned char* record{nullptr};
+        if (record_size > block_size / 4) {
+            // long strings get a block to themselves rather than waste the rest of one
+            record = m_blocks.emplace_back(new unsigned char[record_size]).get();
+            m_bytes += record_size;
+        } else {
+            if (record_size > m_remaining) {
+                m_cursor = m_blocks.emplace_back(new unsigned char[block_size]).get();
+                m_remaining = block_size;
+                m_bytes += block_size;
+            }
+            record = m_cursor;
+            m_cursor += record_size;
+            m_remaining -= record_size;
+        }
+        if (header == 1) {
+            record[0] = static_cast<unsigned char>(str.size());
+        } else {
+            const auto size{static_cast<uint32_t>(str.size())};
+            record[0] = long_length;
+            std::memcpy(record + 1, &size, sizeof(size));
+        }
+        std::memcpy(record + header, str.data(), str.size());
+        return record;
+    }
+
+    [[nodiscard]] Symbol insert(StringView<char> str, uint32_t tag) {
+        const uint32_t id{m_size.load(std::memory_order_relaxed)};
+        if (id == UINT32_MAX) {
+            throw std::length_error{"StringPool is full"};
+        }
+        const auto [segment, offset]{locate(id)};
+        Entry* entries{m_segments[segment].load(std::memory_order_relaxed)};
+        if (!entries) {
+            const size_t entry_count{size_t{1} << (segment + first_segment_bits)};
+            entries = new Entry[entry_count];
+            m_bytes += entry_count * sizeof(Entry);
+            m_segments[segment].store(entries, std::memory_order_release);
+        }
+        entries[offset] = store(str);
+
+        // kept at most three quarters full, the tags keep the longer probes cheap
+        const Table* table{m_table.load(std::memory_order_relaxed)};
+        if ((size_t{id} + 1) * 4 > (table->mask + 1) * 3) {
+            table = grow(table);
+            m_table.store(table, std::memory_order_release);
+        }
+        // publishes the entry along with the slot
+        place(*table, uint64_t{tag} << 32 | (uint64_t{id} + 1));
+        m_size.store(id + 1, std::memory_order_release);
+        return Symbol{id};
+    }
+
+  public:
+    StringPool() {
+        m_table.store(grow(nullptr), std::memory_order_relaxed);
+        // the empty string is always id 0, what a default Symbol refers to
+        (void)insert(StringView<char>{"", 0}, hash(StringView<char>{"", 0}));
+    }
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    ~StringPool() {
+        for (auto& segment : m_segments) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    /// the Symbol for str, adding a copy of it to the pool if it is not there yet
+    [[nodiscard]] Symbol intern(StringView<char> str) {
+        if (str.size() > UINT32_MAX) {
+            throw std::length_error{"String too long to intern"};
+        }
+        const uint32_t tag{hash(str)};
+        if (const auto found{lookup(*m_table.load(std::memory_order_acquire), str, tag)}) {
+            return *found;
+        }
+        const std::lock_guard lock{m_mutex};
+        // another thread may have added it, or grown the table, since the lock free probe
+        if (const auto found{lookup(*m_table.load(std::memory_order_relaxed), str, tag)}) {
+            return *found;
+        }
+        return insert(str, tag);
+    }
+    /// the Symbol for str if it has been interned, never adds it
+    [[nodiscard]] std::optional<Symbol> find(StringView<char> str) const noexcept {
+        return lookup(*m_table.load(std::memory_order_acquire), str, hash(str));
+    }
+
+    /// the interned string, symbol must come from this pool
+    [[nodiscard]] StringView<char> view(Symbol symbol) const noexcept {
+        return entry(symbol.id());
+    }
+    [[nodiscard]] StringView<char> operator[](Symbol symbol) const noexcept {
+        return view(symbol);
+    }
+
+    /// the number of distinct strings, the empty string included
+    [[nodiscard]] size_t size() const noexcept {
+        return m_size.load(std::memory_order_acquire);
+    }
+    /// bytes allocated for characters, entries and tables, old tables included
+    [[nodiscard]] size_t memory_usage() const {
+        const std::lock_guard lock{m_mutex};
+        return m_bytes;
+    }
+};
+} // namespace shiv
+
+/// hashes the id, so Symbol can key the standard unordered containers
+template <>
+struct std::hash<shiv::Symbol> {
+    [[nodiscard]] size_t operator()(shiv::Symbol symbol) const noexcept {
+        return std::hash<uint32_t>{}(symbol.id());
+    }
+};
+
+#endif //SHIVLIB_DATASTRUCTURE_STRING_POOL_HPP
@@ -3,17 +3,64 @@
 
 #include "../algorithm.hpp"
 #include "../concepts.hpp"
+#include "string_kernels.hpp"
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <limits>
+#include <string>
+#include <type_traits>
 
 namespace shiv {
+/// A set of byte sized characters for find_first_of and find_first_not_of, kept as the two 16
+/// entry tables the SIMD search looks bytes up in. constexpr, so a fixed set such as a
+/// protocol's delimiters is built once at compile time.
+class CharSet {
+    // bit (c >> 4) & 7 of entry (c >> 7) * 16 + (c & 15) is set if c is in the set
+    uint8_t m_table[32]{};
+
+  public:
+    constexpr CharSet() noexcept = default;
+    explicit constexpr CharSet(const char* chars) noexcept {
+        while (*chars != '\0') {
+            insert(*chars++);
+        }
+    }
+    explicit constexpr CharSet(const char* chars, size_t count) noexcept {
+        for (size_t i{0}; i < count; ++i) {
+            insert(chars[i]);
+        }
+    }
+
+    constexpr void insert(char c) noexcept {
+        const auto byte{static_cast<uint8_t>(c)};
+        m_table[(byte >> 7) * 16 + (byte & 0x0F)] |= static_cast<uint8_t>(1 << ((byte >> 4) & 7));
+    }
+    [[nodiscard]] constexpr bool contains(char c) const noexcept {
+        return detail::in_byte_set(m_table, c);
+    }
+    [[nodiscard]] constexpr const uint8_t* table() const noexcept {
+        return m_table;
+    }
+};
 
 template <shiv::Character T = char>
 class StringView {
     const T* m_view{nullptr};
     size_t m_length{};
 
+    // byte sized characters go through the SIMD kernels, except at compile time
+    [[nodiscard]] static constexpr bool use_kernels() noexcept {
+        return sizeof(T) == 1 && !std::is_constant_evaluated();
+    }
+    [[nodiscard]] const char* bytes() const noexcept {
+        return reinterpret_cast<const char*>(m_view);
+    }
+    [[nodiscard]] static constexpr size_t from(size_t pos, size_t found) noexcept {
+        return found == detail::not_found ? npos : pos + found;
+    }
+
   public:
     using value_type = T;
     using pointer = T*;
@@ -28,24 +75,21 @@ class StringView {
     static constexpr size_t npos = size_t{static_cast<size_t>(-1)};
 
     constexpr StringView(const T* view)
-    : m_view{view} /*, m_length{strlen(m_view)}*/ {
-        int i{0};
-        while (view[i] != T{}) {
-            ++i;
-        }
-        m_length = i;
+    : m_view{view}
+    , m_length{std::char_traits<T>::length(view)} {
     }
     constexpr StringView(const T* view, size_t count)
     : m_view{view}
     , m_length{count} {
     }
     template <typename Begin, typename End> // TODO: concepts for iterators!!!!
+    requires(!std::is_convertible_v<End, size_t>)
     constexpr StringView(Begin begin, End end)
     : m_view{begin}
-    , m_length{end - begin} {
+    , m_length{static_cast<size_t>(end - begin)} {
     }
     constexpr StringView(const std::string& str)
-    : StringView(str.data()) {
+    : StringView(str.data(), str.size()) {
     }
 
     constexpr const_iterator data() const noexcept {
@@ -62,7 +106,7 @@ class StringView {
     }
 
     constexpr StringView substr(size_t index, size_t n = npos) const noexcept {
-        assert(index < m_length);
+        assert(index <= m_length);
         n = shiv::min(n, length() - index);
         return StringView(m_view + index, n);
     }
@@ -77,25 +121,164 @@ class StringView {
     }
 
     // comparison
+    /// -1, 0 or 1 as this orders before, the same as or after view, at run time as at compile
+    /// time. Characters compare as unsigned like std::string_view and a prefix orders first.
     constexpr int compare(StringView view) const noexcept {
-        size_t min_len{shiv::min(length(), view.length())};
-        // loop through
-        // -1 if lt
-        for (size_t i{0}; i < min_len; ++i) {
-            if ((*this)[i] < view[i]) {
-                return (*this)[i] - view[i];
+        const size_t min_len{shiv::min(length(), view.length())};
+        if (use_kernels()) {
+            const int result{min_len == 0 ? 0 : std::memcmp(bytes(), view.bytes(), min_len)};
+            if (result != 0) {
+                return result < 0 ? -1 : 1;
             }
-            if ((*this)[i] > view[i]) {
-                return (*this)[i] - view[i];
+        } else {
+            for (size_t i{0}; i < min_len; ++i) {
+                if (m_view[i] != view.m_view[i]) {
+                    using unsigned_type = std::make_unsigned_t<T>;
+                    return static_cast<unsigned_type>(m_view[i]) <
+                                   static_cast<unsigned_type>(view.m_view[i])
+                               ? -1
+                               : 1;
+                }
             }
         }
-        return length() - view.length();
+        return length() < view.length() ? -1 : (length() > view.length() ? 1 : 0);
     }
     constexpr int compare(size_t pos1, size_t count1, StringView view, size_t pos2 = 0,
                           size_t count2 = npos) const noexcept {
         return substr(pos1, count1).compare(view.substr(pos2, count2));
     }
 
+    // searching, each returns the index of the first character of the match or npos
+    [[nodiscard]] constexpr size_t find(T c, size_t pos = 0) const noexcept {
+        if (pos >= m_length) {
+            return npos;
+        }
+        if (use_kernels()) {
+            return from(pos,
+                        detail::find_byte(bytes() + pos, m_length - pos, static_cast<char>(c)));
+        }
+        for (size_t i{pos}; i < m_length; ++i) {
+            if (m_view[i] == c) {
+                return i;
+            }
+        }
+        return npos;
+    }
+    [[nodiscard]] constexpr size_t find(StringView view, size_t pos = 0) const noexcept {
+        if (pos > m_length || view.length() > m_length - pos) {
+            return npos;
+        }
+        if (use_kernels()) {
+            return from(pos, detail::find_bytes(bytes() + pos, m_length - pos, view.bytes(),
+                                                view.length()));
+        }
+        for (size_t i{pos}; i + view.length() <= m_length; ++i) {
+            if (substr(i, view.length()) == view) {
+                return i;
+            }
+        }
+        return npos;
+    }
+    [[nodiscard]] constexpr size_t find(const T* str, size_t pos = 0) const {
+        return find(StringView(str), pos);
+    }
+
+    /// the last match starting at or before pos
+    [[nodiscard]] constexpr size_t rfind(T c, size_t pos = npos) const noexcept {
+        if (m_length == 0) {
+            return npos;
+        }
+        const size_t count{shiv::min(pos, m_length - 1) + 1};
+        if (use_kernels()) {
+            return from(0, detail::rfind_byte(bytes(), count, static_cast<char>(c)));
+        }
+        for (size_t i{count}; i > 0; --i) {
+            if (m_view[i - 1] == c) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+    [[nodiscard]] constexpr size_t rfind(StringView view, size_t pos = npos) const noexcept {
+        if (view.length() > m_length) {
+            return npos;
+        }
+        const size_t last{shiv::min(pos, m_length - view.length())};
+        if (use_kernels()) {
+            return from(0, detail::rfind_bytes(bytes(), last + view.length(), view.bytes(),
+                                               view.length()));
+        }
+        for (size_t i{last + 1}; i > 0; --i) {
+            if (substr(i - 1, view.length()) == view) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+    [[nodiscard]] constexpr size_t rfind(const T* str, size_t pos = npos) const {
+        return rfind(StringView(str), pos);
+    }
+
+    /// the first character in chars. A CharSet built once is quicker than a StringView, which
+    /// is turned into one on every call.
+    [[nodiscard]] constexpr size_t find_first_of(const CharSet& chars,
+                                                 size_t pos = 0) const noexcept
+    requires(sizeof(T) == 1) {
+        return find_in_set(chars, pos, true);
+    }
+    [[nodiscard]] constexpr size_t find_first_of(StringView chars, size_t pos = 0) const noexcept {
+        if constexpr (sizeof(T) == 1) {
+            return find_in_set(make_set(chars), pos, true);
+        } else {
+            for (size_t i{pos}; i < m_length; ++i) {
+                if (chars.contains(m_view[i])) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+    }
+    [[nodiscard]] constexpr size_t find_first_of(T c, size_t pos = 0) const noexcept {
+        return find(c, pos);
+    }
+    /// the first character not in chars
+    [[nodiscard]] constexpr size_t find_first_not_of(const CharSet& chars,
+                                                     size_t pos = 0) const noexcept
+    requires(sizeof(T) == 1) {
+        return find_in_set(chars, pos, false);
+    }
+    [[nodiscard]] constexpr size_t find_first_not_of(StringView chars,
+                                                     size_t pos = 0) const noexcept {
+        if constexpr (sizeof(T) == 1) {
+            return find_in_set(make_set(chars), pos, false);
+        } else {
+            for (size_t i{pos}; i < m_length; ++i) {
+                if (!chars.contains(m_view[i])) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+    }
+    [[nodiscard]] constexpr size_t find_first_not_of(T c, size_t pos = 0) const noexcept {
+        for (size_t i{pos}; i < m_length; ++i) {
+            if (m_view[i] != c) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    [[nodiscard]] constexpr bool contains(StringView view) const noexcept {
+        return find(view) != npos;
+    }
+    [[nodiscard]] constexpr bool contains(T c) const noexcept {
+        return find(c) != npos;
+    }
+    [[nodiscard]] constexpr bool contains(const T* str) const {
+        return find(str) != npos;
+    }
+
     // *_with
     constexpr bool starts_with(const StringView view) const noexcept {
         return substr(0, view.length()) == view;
@@ -179,8 +362,39 @@ class StringView {
 
     [[nodiscard]] friend constexpr bool operator==(const StringView& lhs,
                                                    const StringView& rhs) noexcept {
+        if (lhs.length() != rhs.length()) {
+            return false;
+        }
+        if (use_kernels()) {
+            return lhs.empty() || std::memcmp(lhs.bytes(), rhs.bytes(), lhs.length()) == 0;
+        }
         return std::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
+
+  private:
+    [[nodiscard]] static constexpr CharSet make_set(StringView chars) noexcept {
+        CharSet set{};
+        for (const T c : chars) {
+            set.insert(static_cast<char>(c));
+        }
+        return set;
+    }
+    [[nodiscard]] constexpr size_t find_in_set(const CharSet& chars, size_t pos,
+                                               bool member) const noexcept {
+        if (pos >= m_length) {
+            return npos;
+        }
+        if (use_kernels()) {
+            return from(pos, detail::find_in_byte_set(bytes() + pos, m_length - pos,
+                                                      chars.table(), member));
+        }
+        for (size_t i{pos}; i < m_length; ++i) {
+            if (chars.contains(static_cast<char>(m_view[i])) == member) {
+                return i;
+            }
+        }
+        return npos;
+    }
 };
 } // namespace shiv
 
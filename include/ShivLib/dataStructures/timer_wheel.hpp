@@ -0,0 +1,362 @@
+#ifndef SHIVLIB_TIMER_WHEEL_HPP
+#define SHIVLIB_TIMER_WHEEL_HPP
+
+#include "../cstddef.hpp"
+#include "array.hpp"
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace shiv {
+class TimerWheel;
+
+/// Intrusive timer, embed or inherit it in the object that owns the timeout so scheduling never
+/// allocates. The callback receives the node back, static_cast it to the owning type.
+class TimerNode {
+    friend class TimerWheel;
+
+    TimerNode* m_prev{this};
+    TimerNode* m_next{this};
+    uint64_t m_expiry{0};
+    uint16_t m_level{0};
+    uint16_t m_slot{0};
+    bool m_scheduled{false};
+
+    void unlink() noexcept {
+        m_prev->m_next = m_next;
+        m_next->m_prev = m_prev;
+        m_prev = this;
+        m_next = this;
+    }
+    void link_before(TimerNode& position) noexcept {
+        m_prev = position.m_prev;
+        m_next = &position;
+        position.m_prev->m_next = this;
+        position.m_prev = this;
+    }
+    [[nodiscard]] bool list_empty() const noexcept {
+        return m_next == this;
+    }
+
+  public:
+    using callback_type = void (*)(TimerNode&);
+
+    callback_type callback{nullptr};
+
+    constexpr TimerNode() = default;
+    explicit TimerNode(callback_type func)
+    : callback{func} {
+    }
+    // a scheduled node is linked into the wheel by address
+    TimerNode(const TimerNode&) = delete;
+    TimerNode& operator=(const TimerNode&) = delete;
+    ~TimerNode() {
+        assert(!m_scheduled && "Destroyed a scheduled timer");
+    }
+
+    [[nodiscard]] bool is_scheduled() const noexcept {
+        return m_scheduled;
+    }
+    [[nodiscard]] uint64_t expiry() const noexcept {
+        return m_expiry;
+    }
+};
+
+/// Hashed hierarchical timer wheel over integer ticks. Four levels of 256 slots cover 2^32
+/// ticks, anything further out sits in the top level and is re-hashed as it comes into range.
+/// Scheduling and cancelling are O(1), each tick fires its whole slot in one batch and every 256
+/// ticks one slot of the level above is cascaded down.
+class TimerWheel {
+    static constexpr size_t slot_bits{8};
+    static constexpr size_t slot_count{1 << slot_bits};
+    static constexpr size_t slot_mask{slot_count - 1};
+    static constexpr size_t level_count{4};
+    static constexpr uint64_t max_delta{(uint64_t{1} << (slot_bits * level_count)) - 1};
+
+    shiv::Array<shiv::Array<TimerNode, slot_count>, level_count> m_slots{};
+    // a set bit marks a non empty slot so the next expiry can be found without walking slots
+    shiv::Array<shiv::Array<uint64_t, slot_count / 64>, level_count> m_occupied{};
+    uint64_t m_now{0};
+    size_t m_size{0};
+
+    void insert(TimerNode& node) noexcept {
+        uint64_t expiry{node.m_expiry < m_now ? m_now : node.m_expiry};
+        uint64_t delta{expiry - m_now};
+        if (delta > max_delta) {
+            delta = max_delta;
+            expiry = m_now + max_delta;
+        }
+        size_t level{0};
+        while (level < level_count - 1 && delta >= (uint64_t{1} << (slot_bits * (level + 1)))) {
+            ++level;
+        }
+        const size_t slot{(expiry >> (slot_bits * level)) & slot_mask};
+        node.m_level = static_cast<uint16_t>(level);
+        node.m_slot = static_cast<uint16_t>(slot);
+        node.link_before(m_slots[level][slot]);
+        m_occupied[level][slot / 64] |= uint64_t{1} << (slot % 64);
+    }
+
+    void remove(TimerNode& node) noexcept {
+        node.unlink();
+        auto& head{m_slots[node.m_level][node.m_slot]};
+        if (head.list_empty()) {
+            m_occupied[node.m_level][node.m_slot / 64] &= ~(uint64_t{1} << (node.m_slot % 64));
+        }
+    }
+
+    // moves a whole slot onto a local list head in O(1)
+    void detach_slot(size_t level, size_t slot, TimerNode& out) noexcept {
+        auto& head{m_slots[level][slot]};
+        if (!head.list_empty()) {
+            out.m_next = head.m_next;
+            out.m_prev = head.m_prev;
+            out.m_next->m_prev = &out;
+            out.m_prev->m_next = &out;
+            head.m_next = &head;
+            head.m_prev = &head;
+        }
+        m_occupied[level][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+    }
+
+    void cascade(size_t level) noexcept {
+        const size_t slot{(m_now >> (slot_bits * level)) & slot_mask};
+        TimerNode pending{};
+        detach_slot(level, slot, pending);
+        while (!pending.list_empty()) {
+            TimerNode& node{*pending.m_next};
+            node.unlink();
+            insert(node);
+        }
+    }
+
+    [[nodiscard]] std::optional<size_t> first_occupied(size_t level, size_t from) const noexcept {
+        for (size_t word{from / 64}; word < slot_count / 64; ++word) {
+            uint64_t bits{m_occupied[level][word]};
+            if (word == from / 64) {
+                bits &= ~uint64_t{0} << (from % 64);
+            }
+            if (bits != 0) {
+                return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// The next tick that fires a level 0 slot or cascades a non empty slot, every tick before
+    /// it can be skipped. Looks one level further up each time the levels below are empty.
+    [[nodiscard]] std::optional<uint64_t> next_event() const noexcept {
+        if ((m_now & slot_mask) == 0) {
+            // m_now still has to cascade, which may land anywhere in this window
+            for (size_t level{1}; level < level_count; ++level) {
+                if (first_occupied(level, 0)) {
+                    return m_now;
+                }
+            }
+        }
+        if (auto slot{first_occupied(0, m_now & slot_mask)}) {
+            return (m_now & ~uint64_t{slot_mask}) + *slot;
+        }
+        uint64_t boundary{(m_now | slot_mask) + 1};
+        if (first_occupied(0, 0)) {
+            return boundary;
+        }
+        for (size_t level{1}; level < level_count; ++level) {
+            const size_t shift{slot_bits * level};
+            const size_t index{(boundary >> shift) & slot_mask};
+            if (auto slot{first_occupied(level, index)}) {
+                // on an index 0 boundary the levels above cascade first
+                for (size_t above{level + 1}; index == 0 && above < level_count; ++above) {
+                    if (first_occupied(above, 0)) {
+                        return boundary;
+                    }
+                }
+                return boundary + (static_cast<uint64_t>(*slot - index) << shift);
+            }
+            // boundary is aligned to the level above when index is 0
+            const uint64_t window_end{(boundary | ((uint64_t{1} << (shift + slot_bits)) - 1)) + 1};
+            if (first_occupied(level, 0)) {
+                return window_end;
+            }
+            if (index != 0) {
+                boundary = window_end;
+            }
+        }
+        return std::nullopt;
+    }
+
+  public:
+    explicit TimerWheel(uint64_t start_tick = 0)
+    : m_now{start_tick} {
+    }
+    // slot heads are self referencing
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    ~TimerWheel() {
+        clear();
+    }
+
+    /// a node that is already scheduled is moved, an expiry in the past fires on the next tick
+    void schedule(TimerNode& node, uint64_t expiry_tick) noexcept {
+        if (node.m_scheduled) {
+            remove(node);
+        } else {
+            node.m_scheduled = true;
+            ++m_size;
+        }
+        node.m_expiry = expiry_tick;
+        insert(node);
+    }
+    void schedule_after(TimerNode& node, uint64_t ticks) noexcept {
+        schedule(node, m_now + ticks);
+    }
+
+    /// returns false if the node was not scheduled
+    bool cancel(TimerNode& node) noexcept {
+        if (!node.m_scheduled) {
+            return false;
+        }
+        remove(node);
+        node.m_scheduled = false;
+        --m_size;
+        return true;
+    }
+
+    /// fires every timer due at or before tick, returns how many fired. Callbacks may schedule
+    /// and cancel any timer, including the one that fired.
+    size_t advance_to(uint64_t tick) {
+        size_t fired{0};
+        while (m_now <= tick) {
+            const size_t slot{m_now & slot_mask};
+            for (size_t level{1}; level < level_count; ++level) {
+                if (((m_now >> (slot_bits * (level - 1))) & slot_mask) != 0) {
+                    break;
+                }
+                cascade(level);
+            }
+            TimerNode expired{};
+            detach_slot(0, slot, expired);
+            // anything the callbacks schedule for now lands on the next tick, not this slot
+            ++m_now;
+            while (!expired.list_empty()) {
+                TimerNode& node{*expired.m_next};
+                node.unlink();
+                node.m_scheduled = false;
+                --m_size;
+                ++fired;
+                if (node.callback != nullptr) {
+                    node.callback(node);
+                }
+            }
+            if (m_now <= tick) {
+                const auto next{next_event()};
+                m_now = next && *next <= tick ? *next : tick + 1;
+            }
+        }
+        return fired;
+    }
+
+    /// Earliest tick at which advance_to may have work to do, never later than the next expiry.
+    [[nodiscard]] std::optional<uint64_t> next_expiry() const noexcept {
+        return next_event();
+    }
+
+    /// unschedules everything without firing
+    void clear() noexcept {
+        for (size_t level{0}; level < level_count; ++level) {
+            for (size_t slot{0}; slot < slot_count; ++slot) {
+                TimerNode pending{};
+                detach_slot(level, slot, pending);
+                while (!pending.list_empty()) {
+                    TimerNode& node{*pending.m_next};
+                    node.unlink();
+                    node.m_scheduled = false;
+                }
+            }
+        }
+        m_size = 0;
+    }
+
+    /// the next tick advance_to will process, inside a callback one past the tick that fired
+    [[nodiscard]] uint64_t now() const noexcept {
+        return m_now;
+    }
+    [[nodiscard]] size_t size() const noexcept {
+        return m_size;
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return m_size == 0;
+    }
+};
+
+/// Drives a TimerWheel from a clock for an event loop: schedule against time points, call poll()
+/// whenever the loop wakes and sleep for at most timeout(). Callbacks run on the polling thread,
+/// hand the work to a thread pool from the callback if it is heavy.
+template <typename Clock = std::chrono::steady_clock>
+class TimerDriver {
+  public:
+    using clock = Clock;
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+  private:
+    TimerWheel m_wheel{};
+    time_point m_start;
+    duration m_resolution;
+
+    [[nodiscard]] uint64_t to_tick(time_point time) const noexcept {
+        if (time <= m_start) {
+            return 0;
+        }
+        return static_cast<uint64_t>((time - m_start) / m_resolution);
+    }
+
+  public:
+    explicit TimerDriver(duration resolution = std::chrono::milliseconds{1},
+                         time_point start = Clock::now())
+    : m_start{start}
+    , m_resolution{resolution} {
+    }
+
+    /// fires no earlier than deadline, and no later than the first poll one tick after it
+    void schedule_at(TimerNode& node, time_point deadline) noexcept {
+        const auto since_start{deadline - m_start};
+        // round up so a timer never fires before its deadline
+        const auto ticks{(since_start + m_resolution - duration{1}) / m_resolution};
+        m_wheel.schedule(node, since_start <= duration{0} ? 0 : static_cast<uint64_t>(ticks));
+    }
+    void schedule_after(TimerNode& node, duration delay) noexcept {
+        schedule_at(node, Clock::now() + delay);
+    }
+    bool cancel(TimerNode& node) noexcept {
+        return m_wheel.cancel(node);
+    }
+
+    /// fires everything due by now
+    size_t poll(time_point now = Clock::now()) {
+        return m_wheel.advance_to(to_tick(now));
+    }
+
+    /// how long the event loop can block before the next poll is needed
+    [[nodiscard]] std::optional<duration> timeout(time_point now = Clock::now()) const noexcept {
+        const auto next{m_wheel.next_expiry()};
+        if (!next) {
+            return std::nullopt;
+        }
+        const time_point deadline{m_start +
+                                  static_cast<typename duration::rep>(*next) * m_resolution};
+        return deadline > now ? deadline - now : duration{0};
+    }
+
+    [[nodiscard]] TimerWheel& wheel() noexcept {
+        return m_wheel;
+    }
+    [[nodiscard]] const TimerWheel& wheel() const noexcept {
+        return m_wheel;
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_TIMER_WHEEL_HPP
@@ -10,6 +10,14 @@
 #include <utility>
 
 namespace shiv {
+namespace detail {
+/// the capacity a growable container moves to when it needs room for required elements,
+/// doubling so a run of appends costs amortised constant time, shared by Vector and String
+[[nodiscard]] constexpr size_t grow_capacity(size_t current, size_t required) noexcept {
+    return current * 2 > required ? current * 2 : required;
+}
+} // namespace detail
+
 template <typename T, typename A = std::allocator<T>>
 class Vector {
     using alloc = std::allocator_traits<A>;
@@ -70,6 +78,13 @@ class Vector {
 
     constexpr Vector& operator=(Vector&& other) noexcept {
         if (this != &other) {
+            // release what this vector held before taking over the other buffer
+            if (m_data != nullptr) {
+                for (size_t i{0}; i < m_size; ++i) {
+                    alloc::destroy(allocator, &m_data[i]);
+                }
+                alloc::deallocate(allocator, m_data, m_capacity);
+            }
             m_data = std::exchange(other.m_data, nullptr);
             m_size = other.m_size;
             m_capacity = other.m_capacity;
@@ -116,7 +131,7 @@ class Vector {
     // adding elements
     constexpr void push_back(const_reference value) {
         if (m_size >= m_capacity) {
-            reallocate(m_capacity * 2);
+            reallocate(detail::grow_capacity(m_capacity, m_size + 1));
         }
         m_data[m_size] = value;
         ++m_size;
@@ -129,7 +144,7 @@ class Vector {
     template <typename... args>
     constexpr reference emplace_back(args&&... values) {
         if (m_size >= m_capacity) {
-            reallocate(m_capacity * 2);
+            reallocate(detail::grow_capacity(m_capacity, m_size + 1));
         }
         alloc::construct(allocator, &m_data[m_size], std::forward<args>(values)...);
         return m_data[m_size++];
@@ -140,7 +155,7 @@ class Vector {
         ptrdiff_t distance{position - cbegin()};
         assert(position >= cbegin() && position <= cend());
         if (m_size >= m_capacity) {
-            reallocate(m_capacity * 2);
+            reallocate(detail::grow_capacity(m_capacity, m_size + 1));
         }
         std::move_backward(cbegin() + distance, cend(), end() + 1);
         m_data[distance] = shiv::move(T(shiv::forward<Args>(args)...));
@@ -155,7 +170,7 @@ class Vector {
     constexpr iterator insert(iterator position, size_t amount, const T& value) {
         ptrdiff_t distance{position - cbegin()};
         if (m_size + amount > m_capacity) {
-            reallocate(m_capacity * 2);
+            reallocate(detail::grow_capacity(m_capacity, m_size + amount));
         }
         std::move_backward(cbegin() + distance, cend(), end() + amount);
         m_size += amount;
@@ -168,7 +183,7 @@ class Vector {
         ptrdiff_t distance{position - cbegin()};
         assert(position >= cbegin() && position <= cend());
         if (m_size + value_list.size() > m_capacity) {
-            reallocate(m_capacity * 2);
+            reallocate(detail::grow_capacity(m_capacity, m_size + value_list.size()));
         }
         std::move_backward(cbegin() + distance, cend(), end() + value_list.size());
         m_size += value_list.size();
@@ -211,8 +226,9 @@ class Vector {
     }
 
     constexpr void swap(Vector& other) noexcept {
-        std::swap_ranges(begin(), end(), other.begin());
+        std::swap(m_data, other.m_data);
         std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
     }
 
     // Element Access
@@ -318,7 +334,7 @@ class Vector {
 
     // comparison
     [[nodiscard]] friend constexpr bool operator==(const Vector& lhs, const Vector& rhs) {
-        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
     [[nodiscard]] friend constexpr std::partial_ordering operator<=>(const Vector& lhs,
                                                                      const Vector& rhs) {
@@ -0,0 +1,402 @@
+#ifndef SHIVLIB_FLOAT16_HPP
+#define SHIVLIB_FLOAT16_HPP
+
+#include "concepts.hpp"
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__F16C__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace shiv {
+namespace detail {
+/// IEEE binary16 bits of a float, rounded to nearest even. F16C does it in one instruction at
+/// run time when compiled for it, the bit twiddling below is the same rounding for compile time
+[[nodiscard]] constexpr uint16_t float_to_half(float value) noexcept {
+#ifdef __F16C__
+    if (!std::is_constant_evaluated()) {
+        return static_cast<uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    const uint32_t bits{std::bit_cast<uint32_t>(value)};
+    const auto sign{static_cast<uint16_t>((bits >> 16) & 0x8000U)};
+    const uint32_t magnitude{bits & 0x7FFFFFFFU};
+    const uint32_t exponent{magnitude >> 23};
+    if (exponent == 0xFF) {
+        // infinity stays infinity, a nan keeps the top of its payload and is made quiet
+        const uint32_t nan{magnitude > 0x7F800000U ? 0x200U | ((magnitude >> 13) & 0x3FFU) : 0};
+        return static_cast<uint16_t>(sign | 0x7C00U | nan);
+    }
+    if (exponent > 142) {
+        return static_cast<uint16_t>(sign | 0x7C00U);
+    }
+    // the low bits that are shifted out decide the rounding, a carry may run into the exponent
+    const auto round{[](uint32_t kept, uint32_t dropped, uint32_t shift) {
+        const uint32_t half_way{1U << (shift - 1)};
+        return kept + (dropped > half_way || (dropped == half_way && (kept & 1) != 0) ? 1 : 0);
+    }};
+    if (exponent < 113) {
+        // below the smallest normal half, the result is a subnormal multiple of 2^-24
+        const uint32_t shift{126 - exponent};
+        if (shift > 24) {
+            return sign;
+        }
+        const uint32_t mantissa{(magnitude & 0x7FFFFFU) | 0x800000U};
+        return static_cast<uint16_t>(
+            sign | round(mantissa >> shift, mantissa & ((1U << shift) - 1), shift));
+    }
+    const uint32_t kept{((exponent - 112) << 10) | ((magnitude >> 13) & 0x3FFU)};
+    return static_cast<uint16_t>(sign | round(kept, magnitude & 0x1FFFU, 13));
+}
+/// every binary16 value is exactly representable as a float
+[[nodiscard]] constexpr float half_to_float(uint16_t half) noexcept {
+#ifdef __F16C__
+    if (!std::is_constant_evaluated()) {
+        return _cvtsh_ss(half);
+    }
+#endif
+    const uint32_t sign{static_cast<uint32_t>(half & 0x8000U) << 16};
+    const uint32_t exponent{(half >> 10) & 0x1FU};
+    const uint32_t mantissa{half & 0x3FFU};
+    if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13));
+    }
+    if (exponent == 0) {
+        // zero or subnormal, mantissa * 2^-24
+        const float value{static_cast<float>(mantissa) * 0x1p-24F};
+        return sign != 0 ? -value : value;
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+/// bfloat16 is the top half of a float, rounded to nearest even
+[[nodiscard]] constexpr uint16_t float_to_brain(float value) noexcept {
+    const uint32_t bits{std::bit_cast<uint32_t>(value)};
+    if ((bits & 0x7FFFFFFFU) > 0x7F800000U) {
+        return static_cast<uint16_t>((bits >> 16) | 0x40U);
+    }
+    return static_cast<uint16_t>((bits + 0x7FFFU + ((bits >> 16) & 1)) >> 16);
+}
+[[nodiscard]] constexpr float brain_to_float(uint16_t brain) noexcept {
+    return std::bit_cast<float>(static_cast<uint32_t>(brain) << 16);
+}
+
+/// A value as a float that rounds to 16 bits the same way the value itself would. Wider values
+/// are truncated with the last bit set if anything was dropped, round to odd, so the one
+/// rounding to nearest even that follows decides ties correctly rather than rounding twice.
+template <shiv::Arithmetic U>
+[[nodiscard]] constexpr float narrow_to_float(U value) noexcept {
+    if constexpr (std::is_same_v<U, float> || sizeof(U) < sizeof(float)) {
+        return static_cast<float>(value);
+    } else {
+        const auto wide{static_cast<double>(value)};
+        const auto rounded{static_cast<float>(wide)};
+        if (wide != wide || static_cast<double>(rounded) == wide) {
+            return rounded;
+        }
+        uint32_t bits{std::bit_cast<uint32_t>(rounded)};
+        if ((rounded > wide) == (wide > 0)) {
+            // rounded away from zero, step back towards it
+            --bits;
+        }
+        return std::bit_cast<float>(bits | 1U);
+    }
+}
+} // namespace detail
+
+/// IEEE half precision, 1 sign, 5 exponent and 10 mantissa bits. A storage type: arithmetic
+/// converts to float, computes there and rounds the result back, so sums over many elements
+/// belong in float, see dot and the gemm overload for 16 bit matrices.
+class float16 {
+  public:
+    constexpr float16() noexcept = default;
+    /// rounds once to nearest even, doubles included
+    template <shiv::Arithmetic U>
+    constexpr float16(U value) noexcept
+    : m_bits{detail::float_to_half(detail::narrow_to_float(value))} {
+    }
+
+    [[nodiscard]] static constexpr float16 from_bits(uint16_t bits) noexcept {
+        float16 result{};
+        result.m_bits = bits;
+        return result;
+    }
+    [[nodiscard]] constexpr uint16_t bits() const noexcept {
+        return m_bits;
+    }
+    template <shiv::Arithmetic U>
+    [[nodiscard]] constexpr explicit operator U() const noexcept {
+        return static_cast<U>(detail::half_to_float(m_bits));
+    }
+
+    [[nodiscard]] friend constexpr float16 operator+(float16 lhs, float16 rhs) noexcept {
+        return float16{static_cast<float>(lhs) + static_cast<float>(rhs)};
+    }
+    [[nodiscard]] friend constexpr float16 operator-(float16 lhs, float16 rhs) noexcept {
+        return float16{static_cast<float>(lhs) - static_cast<float>(rhs)};
+    }
+    [[nodiscard]] friend constexpr float16 operator*(float16 lhs, float16 rhs) noexcept {
+        return float16{static_cast<float>(lhs) * static_cast<float>(rhs)};
+    }
+    [[nodiscard]] friend constexpr float16 operator/(float16 lhs, float16 rhs) noexcept {
+        return float16{static_cast<float>(lhs) / static_cast<float>(rhs)};
+    }
+    [[nodiscard]] constexpr float16 operator-() const noexcept {
+        return from_bits(static_cast<uint16_t>(m_bits ^ 0x8000U));
+    }
+    constexpr float16& operator+=(float16 other) noexcept {
+        return *this = *this + other;
+    }
+    constexpr float16& operator-=(float16 other) noexcept {
+        return *this = *this - other;
+    }
+    constexpr float16& operator*=(float16 other) noexcept {
+        return *this = *this * other;
+    }
+    constexpr float16& operator/=(float16 other) noexcept {
+        return *this = *this / other;
+    }
+
+    // compared as floats, so -0 == +0 and a nan is unordered
+    [[nodiscard]] friend constexpr bool operator==(float16 lhs, float16 rhs) noexcept {
+        return static_cast<float>(lhs) == static_cast<float>(rhs);
+    }
+    [[nodiscard]] friend constexpr std::partial_ordering operator<=>(float16 lhs,
+                                                                     float16 rhs) noexcept {
+        return static_cast<float>(lhs) <=> static_cast<float>(rhs);
+    }
+
+  private:
+    uint16_t m_bits{0};
+};
+
+/// bfloat16, 1 sign, 8 exponent and 7 mantissa bits: the range of a float at a third of the
+/// precision of float16. Arithmetic goes through float the same way.
+class bfloat16 {
+  public:
+    constexpr bfloat16() noexcept = default;
+    template <shiv::Arithmetic U>
+    constexpr bfloat16(U value) noexcept
+    : m_bits{detail::float_to_brain(detail::narrow_to_float(value))} {
+    }
+
+    [[nodiscard]] static constexpr bfloat16 from_bits(uint16_t bits) noexcept {
+        bfloat16 result{};
+        result.m_bits = bits;
+        return result;
+    }
+    [[nodiscard]] constexpr uint16_t bits() const noexcept {
+        return m_bits;
+    }
+    template <shiv::Arithmetic U>
+    [[nodiscard]] constexpr explicit operator U() const noexcept {
+        return static_cast<U>(detail::brain_to_float(m_bits));
+    }
+
+    [[nodiscard]] friend constexpr bfloat16 operator+(bfloat16 lhs, bfloat16 rhs) noexcept {
+        return bfloat16{static_cast<float>(lhs) + static_cast<float>(rhs)};
+    }
+    [[nodiscard]] friend constexpr bfloat16 operator-(bfloat16 lhs, bfloat16 rhs) noexcept {
+        return bfloat16{static_cast<float>(lhs) - static_cast<float>(rhs)};
+    }
+    [[nodiscard]] friend constexpr bfloat16 operator*(bfloat16 lhs, bfloat16 rhs) noexcept {
+        return bfloat16{static_cast<float>(lhs) * static_cast<float>(rhs)};
+    }
+    [[nodiscard]] friend constexpr bfloat16 operator/(bfloat16 lhs, bfloat16 rhs) noexcept {
+        return bfloat16{static_cast<float>(lhs) / static_cast<float>(rhs)};
+    }
+    [[nodiscard]] constexpr bfloat16 operator-() const noexcept {
+        return from_bits(static_cast<uint16_t>(m_bits ^ 0x8000U));
+    }
+    constexpr bfloat16& operator+=(bfloat16 other) noexcept {
+        return *this = *this + other;
+    }
+    constexpr bfloat16& operator-=(bfloat16 other) noexcept {
+        return *this = *this - other;
+    }
+    constexpr bfloat16& operator*=(bfloat16 other) noexcept {
+        return *this = *this * other;
+    }
+    constexpr bfloat16& operator/=(bfloat16 other) noexcept {
+        return *this = *this / other;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(bfloat16 lhs, bfloat16 rhs) noexcept {
+        return static_cast<float>(lhs) == static_cast<float>(rhs);
+    }
+    [[nodiscard]] friend constexpr std::partial_ordering operator<=>(bfloat16 lhs,
+                                                                     bfloat16 rhs) noexcept {
+        return static_cast<float>(lhs) <=> static_cast<float>(rhs);
+    }
+
+  private:
+    uint16_t m_bits{0};
+};
+
+namespace detail {
+template <typename T>
+inline constexpr bool is_half_precision_v{std::is_same_v<std::remove_cv_t<T>, float16> ||
+                                          std::is_same_v<std::remove_cv_t<T>, bfloat16>};
+
+/// what sums of T are kept in, float for the 16 bit types
+template <typename T>
+using accumulator_t = std::conditional_t<is_half_precision_v<T>, float, T>;
+
+#if defined(__AVX512F__)
+// sixteen lanes widened to float in a register. Full masks throughout, GCC 12 warns about the
+// undefined registers behind the unmasked conversions
+inline __m512 load_widened(const float* source) noexcept {
+    return _mm512_loadu_ps(source);
+}
+inline __m512 load_widened(const float16* source) noexcept {
+    return _mm512_maskz_cvtph_ps(0xFFFF,
+                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+}
+inline __m512 load_widened(const bfloat16* source) noexcept {
+    const __m256i bits{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source))};
+    return _mm512_castsi512_ps(
+        _mm512_maskz_slli_epi32(0xFFFF, _mm512_maskz_cvtepu16_epi32(0xFFFF, bits), 16));
+}
+#elif defined(__AVX2__) && defined(__F16C__)
+// eight lanes widened to float in a register
+inline __m256 load_widened(const float* source) noexcept {
+    return _mm256_loadu_ps(source);
+}
+inline __m256 load_widened(const float16* source) noexcept {
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+}
+inline __m256 load_widened(const bfloat16* source) noexcept {
+    const __m128i bits{_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))};
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(bits), 16));
+}
+#endif
+
+template <typename T>
+concept Float32Or16 = std::is_same_v<T, float> || is_half_precision_v<T>;
+} // namespace detail
+
+/// widens count 16 bit values to float, sixteen at a time with AVX-512 or eight with F16C
+inline void convert(const float16* source, float* target, size_t count) noexcept {
+    size_t i{0};
+#if defined(__AVX512F__)
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_ps(target + i, detail::load_widened(source + i));
+    }
+#elif defined(__F16C__)
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(target + i, _mm256_cvtph_ps(_mm_loadu_si128(
+                                         reinterpret_cast<const __m128i*>(source + i))));
+    }
+#endif
+    for (; i < count; ++i) {
+        target[i] = static_cast<float>(source[i]);
+    }
+}
+inline void convert(const bfloat16* source, float* target, size_t count) noexcept {
+    size_t i{0};
+#if defined(__AVX512F__)
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_ps(target + i, detail::load_widened(source + i));
+    }
+#endif
+    // a shift, which the compiler vectorises well enough without help
+    for (; i < count; ++i) {
+        target[i] = static_cast<float>(source[i]);
+    }
+}
+/// narrows count floats, rounding to nearest even
+inline void convert(const float* source, float16* target, size_t count) noexcept {
+    size_t i{0};
+#if defined(__AVX512F__)
+    for (; i + 16 <= count; i += 16) {
+        const __m256i half{_mm512_maskz_cvtps_ph(
+            0xFFFF, _mm512_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), half);
+    }
+#elif defined(__F16C__)
+    for (; i + 8 <= count; i += 8) {
+        const __m128i half{_mm256_cvtps_ph(_mm256_loadu_ps(source + i),
+                                           _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), half);
+    }
+#endif
+    for (; i < count; ++i) {
+        target[i] = float16{source[i]};
+    }
+}
+/// the same rounding as bfloat16's constructor, done on integer lanes rather than with
+/// AVX512-BF16's vcvtneps2bf16, which flushes subnormal inputs to zero
+inline void convert(const float* source, bfloat16* target, size_t count) noexcept {
+    size_t i{0};
+#if defined(__AVX512F__)
+    const __m512i bias{_mm512_set1_epi32(0x7FFF)};
+    const __m512i one{_mm512_set1_epi32(1)};
+    const __m512i infinity{_mm512_set1_epi32(0x7F800000)};
+    const __m512i magnitude_mask{_mm512_set1_epi32(0x7FFFFFFF)};
+    for (; i + 16 <= count; i += 16) {
+        const __m512i bits{_mm512_loadu_si512(source + i)};
+        const __m512i odd{_mm512_and_si512(_mm512_maskz_srli_epi32(0xFFFF, bits, 16), one)};
+        const __m512i rounded{_mm512_add_epi32(bits, _mm512_add_epi32(bias, odd))};
+        const __mmask16 nan{_mm512_cmpgt_epu32_mask(_mm512_and_si512(bits, magnitude_mask),
+                                                     infinity)};
+        const __m512i quiet{_mm512_or_si512(bits, _mm512_set1_epi32(0x400000))};
+        const __m512i top{_mm512_maskz_srli_epi32(
+            0xFFFF, _mm512_mask_mov_epi32(rounded, nan, quiet), 16)};
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i),
+                            _mm512_maskz_cvtepi32_epi16(0xFFFF, top));
+    }
+#endif
+    for (; i < count; ++i) {
+        target[i] = bfloat16{source[i]};
+    }
+}
+
+/// sum of a[i] * b[i] accumulated in float whatever mix of float, float16 and bfloat16 the two
+/// sides are stored as, widening in registers so only the 16 bit data crosses the memory bus
+template <detail::Float32Or16 A, detail::Float32Or16 B>
+[[nodiscard]] float dot(const A* a, const B* b, size_t count) noexcept {
+    size_t i{0};
+    float sum{0};
+#if defined(__AVX512F__)
+    __m512 first{_mm512_setzero_ps()};
+    __m512 second{_mm512_setzero_ps()};
+    for (; i + 32 <= count; i += 32) {
+        first = _mm512_fmadd_ps(detail::load_widened(a + i), detail::load_widened(b + i), first);
+        second = _mm512_fmadd_ps(detail::load_widened(a + i + 16),
+                                 detail::load_widened(b + i + 16), second);
+    }
+    if (i + 16 <= count) {
+        first = _mm512_fmadd_ps(detail::load_widened(a + i), detail::load_widened(b + i), first);
+        i += 16;
+    }
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, _mm512_add_ps(first, second));
+    for (const float lane : lanes) {
+        sum += lane;
+    }
+#elif defined(__AVX2__) && defined(__F16C__) && defined(__FMA__)
+    __m256 first{_mm256_setzero_ps()};
+    __m256 second{_mm256_setzero_ps()};
+    for (; i + 16 <= count; i += 16) {
+        first = _mm256_fmadd_ps(detail::load_widened(a + i), detail::load_widened(b + i), first);
+        second = _mm256_fmadd_ps(detail::load_widened(a + i + 8),
+                                 detail::load_widened(b + i + 8), second);
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_add_ps(first, second));
+    for (const float lane : lanes) {
+        sum += lane;
+    }
+#endif
+    for (; i < count; ++i) {
+        sum += static_cast<float>(a[i]) * static_cast<float>(b[i]);
+    }
+    return sum;
+}
+} // namespace shiv
+
+#endif //SHIVLIB_FLOAT16_HPP
@@ -0,0 +1,454 @@
+#ifndef SHIVLIB_HASH_HPP
+#define SHIVLIB_HASH_HPP
+
+#include "concepts.hpp"
+#include "cstddef.hpp"
+#include "dataStructures/array.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// A 64 bit non cryptographic hash in the wyhash family. Up to 16 bytes are read as two
+// overlapping words and mixed with one 64x64->128 bit multiply, up to bulk_threshold bytes go
+// 48 at a time through three independent multiply chains, and anything longer goes through an
+// XXH3 style accumulator of eight 64 bit lanes, a 64 byte stripe at a time, that maps directly
+// onto SIMD registers. Every path has a scalar form used for constant evaluation that gives the
+// same value as the SIMD one, so strings can be hashed at compile time and matched at run time.
+// Values are the same on every platform, but may change between versions of the library, so
+// they should not be stored.
+
+namespace shiv {
+namespace detail {
+inline constexpr uint64_t hash_secret[4]{0x2d358dccaa6c78a5, 0x8bb84b93962eacc9,
+                                         0x4b33a62ed433d4a3, 0x4d5a2da51de1aa47};
+inline constexpr size_t bulk_threshold{256};
+inline constexpr size_t stripe_size{64};
+inline constexpr size_t stripes_per_block{16};
+inline constexpr uint64_t scramble_prime{0x9E3779B1};
+
+__extension__ using uint128 = unsigned __int128;
+
+/// lhs and rhs replaced by the low and high halves of their 128 bit product
+constexpr void multiply(uint64_t& lhs, uint64_t& rhs) noexcept {
+    const uint128 product{static_cast<uint128>(lhs) * rhs};
+    lhs = static_cast<uint64_t>(product);
+    rhs = static_cast<uint64_t>(product >> 64);
+}
+[[nodiscard]] constexpr uint64_t mix(uint64_t lhs, uint64_t rhs) noexcept {
+    multiply(lhs, rhs);
+    return lhs ^ rhs;
+}
+
+// little endian loads, bytes one at a time when constant evaluated
+template <typename Word>
+[[nodiscard]] constexpr Word read(const char* data) noexcept {
+    if (std::is_constant_evaluated()) {
+        Word value{0};
+        for (size_t i{0}; i < sizeof(Word); ++i) {
+            value |= static_cast<Word>(static_cast<unsigned char>(data[i])) << (8 * i);
+        }
+        return value;
+    }
+    Word value;
+    std::memcpy(&value, data, sizeof(Word));
+    if constexpr (std::endian::native == std::endian::big) {
+        if constexpr (sizeof(Word) == 8) {
+            value = __builtin_bswap64(value);
+        } else {
+            value = __builtin_bswap32(value);
+        }
+    }
+    return value;
+}
+[[nodiscard]] constexpr uint64_t read8(const char* data) noexcept {
+    return read<uint64_t>(data);
+}
+[[nodiscard]] constexpr uint64_t read4(const char* data) noexcept {
+    return read<uint32_t>(data);
+}
+
+// splitmix64 of the secret, one key per lane and stripe of a block plus the scramble keys
+inline constexpr std::array<uint64_t, stripes_per_block + 8> bulk_keys{[] {
+    std::array<uint64_t, stripes_per_block + 8> keys{};
+    uint64_t state{hash_secret[0]};
+    for (auto& key : keys) {
+        state += 0x9E3779B97F4A7C15;
+        uint64_t z{state};
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        key = z ^ (z >> 31);
+    }
+    return keys;
+}()};
+
+// The bulk accumulator. Each 64 bit lane adds the product of the two 32 bit halves of its data
+// word xor a key, and its neighbour's data word unchanged so no input is lost to a zero product.
+// After every block of 16 stripes each lane is scrambled so the high bits feed back down.
+constexpr void accumulate_scalar(uint64_t (&acc)[8], const char* stripe,
+                                 const uint64_t* keys) noexcept {
+    for (size_t i{0}; i < 8; ++i) {
+        const uint64_t value{read8(stripe + 8 * i)};
+        const uint64_t keyed{value ^ keys[i]};
+        acc[i ^ 1] += value;
+        acc[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+}
+constexpr void scramble_scalar(uint64_t (&acc)[8], const uint64_t* keys) noexcept {
+    for (size_t i{0}; i < 8; ++i) {
+        acc[i] ^= acc[i] >> 47;
+        acc[i] ^= keys[i];
+        acc[i] *= scramble_prime;
+    }
+}
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(_M_X64))
+/// The accumulator lanes in the widest of AVX-512F, AVX2 and SSE2 registers compiled for, so
+/// the bulk loop is written once. swap exchanges the 64 bit halves of each 128 bit lane, which
+/// is the i ^ 1 neighbour of the scalar loop.
+struct HashVec {
+#if defined(__AVX512F__)
+    // the maskz forms, as GCC warns the plain ones read an uninitialised register
+    using reg = __m512i;
+    static reg load(const void* data) noexcept {
+        return _mm512_loadu_si512(data);
+    }
+    static void store(void* data, reg value) noexcept {
+        _mm512_storeu_si512(data, value);
+    }
+    static reg set1(uint64_t value) noexcept {
+        return _mm512_set1_epi64(static_cast<long long>(value));
+    }
+    static reg add(reg lhs, reg rhs) noexcept {
+        return _mm512_add_epi64(lhs, rhs);
+    }
+    static reg bit_xor(reg lhs, reg rhs) noexcept {
+        return _mm512_xor_si512(lhs, rhs);
+    }
+    static reg multiply_low(reg lhs, reg rhs) noexcept {
+        return _mm512_maskz_mul_epu32(0xFF, lhs, rhs);
+    }
+    template <int shift>
+    static reg shift_right(reg value) noexcept {
+        return _mm512_maskz_srli_epi64(0xFF, value, shift);
+    }
+    template <int shift>
+    static reg shift_left(reg value) noexcept {
+        return _mm512_maskz_slli_epi64(0xFF, value, shift);
+    }
+    static reg swap(reg value) noexcept {
+        return _mm512_maskz_shuffle_epi32(0xFFFF, value, static_cast<_MM_PERM_ENUM>(0x4E));
+    }
+#elif defined(__AVX2__)
+    using reg = __m256i;
+    static reg load(const void* data) noexcept {
+        return _mm256_loadu_si256(static_cast<const reg*>(data));
+    }
+    static void store(void* data, reg value) noexcept {
+        _mm256_storeu_si256(static_cast<reg*>(data), value);
+    }
+    static reg set1(uint64_t value) noexcept {
+        return _mm256_set1_epi64x(static_cast<long long>(value));
+    }
+    static reg add(reg lhs, reg rhs) noexcept {
+        return _mm256_add_epi64(lhs, rhs);
+    }
+    static reg bit_xor(reg lhs, reg rhs) noexcept {
+        return _mm256_xor_si256(lhs, rhs);
+    }
+    static reg multiply_low(reg lhs, reg rhs) noexcept {
+        return _mm256_mul_epu32(lhs, rhs);
+    }
+    template <int shift>
+    static reg shift_right(reg value) noexcept {
+        return _mm256_srli_epi64(value, shift);
+    }
+    template <int shift>
+    static reg shift_left(reg value) noexcept {
+        return _mm256_slli_epi64(value, shift);
+    }
+    static reg swap(reg value) noexcept {
+        return _mm256_shuffle_epi32(value, 0x4E);
+    }
+#else
+    using reg = __m128i;
+    static reg load(const void* data) noexcept {
+        return _mm_loadu_si128(static_cast<const reg*>(data));
+    }
+    static void store(void* data, reg value) noexcept {
+        _mm_storeu_si128(static_cast<reg*>(data), value);
+    }
+    static reg set1(uint64_t value) noexcept {
+        return _mm_set1_epi64x(static_cast<long long>(value));
+    }
+    static reg add(reg lhs, reg rhs) noexcept {
+        return _mm_add_epi64(lhs, rhs);
+    }
+    static reg bit_xor(reg lhs, reg rhs) noexcept {
+        return _mm_xor_si128(lhs, rhs);
+    }
+    static reg multiply_low(reg lhs, reg rhs) noexcept {
+        return _mm_mul_epu32(lhs, rhs);
+    }
+    template <int shift>
+    static reg shift_right(reg value) noexcept {
+        return _mm_srli_epi64(value, shift);
+    }
+    template <int shift>
+    static reg shift_left(reg value) noexcept {
+        return _mm_slli_epi64(value, shift);
+    }
+    static reg swap(reg value) noexcept {
+        return _mm_shuffle_epi32(value, 0x4E);
+    }
+#endif
+    static constexpr size_t count{stripe_size / sizeof(reg)};
+
+    static void accumulate(reg (&acc)[count], const char* stripe, const uint64_t* keys) noexcept {
+        for (size_t i{0}; i < count; ++i) {
+            const reg value{load(stripe + i * sizeof(reg))};
+            const reg keyed{bit_xor(value, load(keys + i * sizeof(reg) / 8))};
+            const reg product{multiply_low(keyed, shift_right<32>(keyed))};
+            acc[i] = add(acc[i], add(product, swap(value)));
+        }
+    }
+    static void scramble(reg (&acc)[count], const uint64_t* keys) noexcept {
+        const reg prime{set1(scramble_prime)};
+        for (size_t i{0}; i < count; ++i) {
+            reg value{bit_xor(acc[i], shift_right<47>(acc[i]))};
+            value = bit_xor(value, load(keys + i * sizeof(reg) / 8));
+            // a 64x32 bit multiply from two 32x32->64 bit ones
+            const reg low{multiply_low(value, prime)};
+            const reg high{multiply_low(shift_right<32>(value), prime)};
+            acc[i] = add(low, shift_left<32>(high));
+        }
+    }
+};
+#endif
+
+// runs of 16 stripes with a scramble after each, then the stripes left and the last 64 bytes
+template <typename Accumulate, typename Scramble>
+constexpr void bulk_loop(const char* data, size_t size, Accumulate&& accumulate,
+                         Scramble&& scramble) noexcept {
+    constexpr size_t block_size{stripe_size * stripes_per_block};
+    const size_t blocks{(size - 1) / block_size};
+    for (size_t block{0}; block < blocks; ++block) {
+        for (size_t stripe{0}; stripe < stripes_per_block; ++stripe) {
+            accumulate(data + block * block_size + stripe * stripe_size, bulk_keys.data() + stripe);
+        }
+        scramble(bulk_keys.data() + stripes_per_block);
+    }
+    // the final stripe is always the last 64 bytes, overlapping the ones before if need be
+    const size_t stripes{(size - 1 - blocks * block_size) / stripe_size};
+    for (size_t stripe{0}; stripe < stripes; ++stripe) {
+        accumulate(data + blocks * block_size + stripe * stripe_size, bulk_keys.data() + stripe);
+    }
+    accumulate(data + size - stripe_size, bulk_keys.data() + 7);
+}
+
+[[nodiscard]] constexpr uint64_t hash_bulk(const char* data, size_t size, uint64_t seed) noexcept {
+    uint64_t acc[8]{};
+    for (size_t i{0}; i < 8; ++i) {
+        acc[i] = bulk_keys[i] ^ seed;
+    }
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(_M_X64))
+    if (!std::is_constant_evaluated()) {
+        HashVec::reg lanes[HashVec::count];
+        for (size_t i{0}; i < HashVec::count; ++i) {
+            lanes[i] = HashVec::load(acc + i * sizeof(HashVec::reg) / 8);
+        }
+        bulk_loop(
+            data, size,
+            [&](const char* stripe, const uint64_t* keys) {
+                HashVec::accumulate(lanes, stripe, keys);
+            },
+            [&](const uint64_t* keys) { HashVec::scramble(lanes, keys); });
+        for (size_t i{0}; i < HashVec::count; ++i) {
+            HashVec::store(acc + i * sizeof(HashVec::reg) / 8, lanes[i]);
+        }
+    } else
+#endif
+    {
+        bulk_loop(
+            data, size,
+            [&](const char* stripe, const uint64_t* keys) { accumulate_scalar(acc, stripe, keys); },
+            [&](const uint64_t* keys) { scramble_scalar(acc, keys); });
+    }
+    uint64_t result{size * 0x9E3779B97F4A7C15};
+    for (size_t i{0}; i < 8; i += 2) {
+        result += mix(acc[i] ^ bulk_keys[i + 11], acc[i + 1] ^ bulk_keys[i + 12]);
+    }
+    return result;
+}
+} // namespace detail
+
+/// The 64 bit hash of size bytes at data. A seed other than 0, such as one from random_seed,
+/// gives an unrelated hash function, which keeps crafted keys from all landing in one bucket.
+[[nodiscard]] constexpr uint64_t hash_bytes(const char* data, size_t size,
+                                            uint64_t seed = 0) noexcept {
+    using detail::hash_secret;
+    using detail::mix;
+    using detail::read4;
+    using detail::read8;
+    seed ^= mix(seed ^ hash_secret[0], hash_secret[1]);
+    uint64_t a{0};
+    uint64_t b{0};
+    if (size <= 16) {
+        if (size >= 4) {
+            // two overlapping pairs of words, which between them cover every byte
+            const size_t middle{(size >> 3) << 2};
+            a = read4(data) << 32 | read4(data + middle);
+            b = read4(data + size - 4) << 32 | read4(data + size - 4 - middle);
+        } else if (size > 0) {
+            a = uint64_t{static_cast<unsigned char>(data[0])} << 16 |
+                uint64_t{static_cast<unsigned char>(data[size >> 1])} << 8 |
+                static_cast<unsigned char>(data[size - 1]);
+        }
+    } else {
+        if (size > detail::bulk_threshold) {
+            seed = detail::hash_bulk(data, size, seed);
+        } else {
+            size_t remaining{size};
+            const char* cursor{data};
+            if (remaining > 48) {
+                uint64_t second{seed};
+                uint64_t third{seed};
+                do {
+                    seed = mix(read8(cursor) ^ hash_secret[1], read8(cursor + 8) ^ seed);
+                    second = mix(read8(cursor + 16) ^ hash_secret[2], read8(cursor + 24) ^ second);
+                    third = mix(read8(cursor + 32) ^ hash_secret[3], read8(cursor + 40) ^ third);
+                    cursor += 48;
+                    remaining -= 48;
+                } while (remaining > 48);
+                seed ^= second ^ third;
+            }
+            while (remaining > 16) {
+                seed = mix(read8(cursor) ^ hash_secret[1], read8(cursor + 8) ^ seed);
+                cursor += 16;
+                remaining -= 16;
+            }
+        }
+        a = read8(data + size - 16);
+        b = read8(data + size - 8);
+    }
+    a ^= hash_secret[1];
+    b ^= seed;
+    detail::multiply(a, b);
+    return mix(a ^ hash_secret[0] ^ size, b ^ hash_secret[1]);
+}
+
+/// mixes two hashes into one, order matters
+[[nodiscard]] constexpr uint64_t hash_combine(uint64_t lhs, uint64_t rhs) noexcept {
+    return detail::mix(lhs ^ detail::hash_secret[0], rhs ^ detail::hash_secret[2]);
+}
+
+/// a seed that differs between runs of the program
+[[nodiscard]] inline uint64_t random_seed() {
+    std::random_device device{};
+    return uint64_t{device()} << 32 | device();
+}
+
+namespace detail {
+// contiguous characters, which hash as their text whatever holds them
+template <typename T>
+concept Text = requires(const T& text) {
+    requires Character<std::remove_cvref_t<decltype(*text.data())>>;
+    { text.size() } -> std::convertible_to<size_t>;
+};
+
+// the hasher state, just a seed
+struct SeededHash {
+    uint64_t seed{0};
+
+    constexpr SeededHash() noexcept = default;
+    explicit constexpr SeededHash(uint64_t seed_) noexcept
+    : seed{seed_} {
+    }
+};
+} // namespace detail
+
+/// A hasher for the standard and shiv unordered containers, Hash<T>{seed} for a seeded one.
+/// Strings of any kind hash as their characters, so a StringView, String, InlineString and
+/// std::string of the same text hash equal. Types with unique object representations, integers,
+/// enums, pointers and structs without padding, hash as their bytes, and floating point as
+/// their value. Arrays of anything else combine the hashes of their elements.
+template <typename T>
+struct Hash;
+
+template <detail::Text T>
+struct Hash<T> : detail::SeededHash {
+    using detail::SeededHash::SeededHash;
+
+    [[nodiscard]] constexpr size_t operator()(const T& text) const noexcept {
+        using Char = std::remove_cvref_t<decltype(*text.data())>;
+        if constexpr (std::is_same_v<Char, char>) {
+            return hash_bytes(text.data(), text.size(), seed);
+        } else {
+            return hash_bytes(reinterpret_cast<const char*>(text.data()),
+                              text.size() * sizeof(Char), seed);
+        }
+    }
+};
+
+template <typename T>
+requires(!detail::Text<T> && !FloatingPoint<T> && std::has_unique_object_representations_v<T>)
+struct Hash<T> : detail::SeededHash {
+    using detail::SeededHash::SeededHash;
+
+    [[nodiscard]] constexpr size_t operator()(const T& value) const noexcept {
+        if (std::is_constant_evaluated()) {
+            const auto bytes{std::bit_cast<std::array<char, sizeof(T)>>(value)};
+            return hash_bytes(bytes.data(), sizeof(T), seed);
+        }
+        return hash_bytes(reinterpret_cast<const char*>(&value), sizeof(T), seed);
+    }
+};
+
+// long double is left out, its padding bytes would hash too
+template <FloatingPoint T>
+requires(sizeof(T) <= sizeof(double))
+struct Hash<T> : detail::SeededHash {
+    using detail::SeededHash::SeededHash;
+
+    [[nodiscard]] constexpr size_t operator()(T value) const noexcept {
+        // -0.0 == 0.0, so they must hash the same
+        const auto bytes{std::bit_cast<std::array<char, sizeof(T)>>(value == T{0} ? T{0} : value)};
+        return hash_bytes(bytes.data(), sizeof(T), seed);
+    }
+};
+
+template <typename T, size_t N>
+requires(!detail::Text<Array<T, N>> && !std::has_unique_object_representations_v<Array<T, N>>)
+struct Hash<Array<T, N>> : detail::SeededHash {
+    using detail::SeededHash::SeededHash;
+
+    [[nodiscard]] constexpr size_t operator()(const Array<T, N>& array) const noexcept {
+        uint64_t result{hash_bytes(nullptr, 0, seed) ^ N};
+        for (const auto& elem : array) {
+            result = hash_combine(result, Hash<T>{seed}(elem));
+        }
+        return result;
+    }
+};
+
+/// the hash of value, hash(value, seed) for a seeded one
+template <typename T>
+[[nodiscard]] constexpr uint64_t hash(const T& value, uint64_t seed = 0) noexcept {
+    return Hash<T>{seed}(value);
+}
+/// the hash of a string literal's characters, the same as any other string of them
+template <size_t N>
+[[nodiscard]] constexpr uint64_t hash(const char (&text)[N], uint64_t seed = 0) noexcept {
+    return hash_bytes(text, N - 1, seed);
+}
+} // namespace shiv
+
+#endif //SHIVLIB_HASH_HPP
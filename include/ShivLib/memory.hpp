@@ -1,6 +1,446 @@
 #ifndef SHIVLIB_MEMORY_HPP
 #define SHIVLIB_MEMORY_HPP
 
-namespace shiv {}
+#include "algorithm.hpp"
+#include "cstddef.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace shiv {
+// fixed rather than std::hardware_destructive_interference_size, which is not ABI stable
+inline constexpr size_t cache_line_size{64};
+
+/// allocator for storage that SIMD kernels load from, aligned to a cache line by default
+template <typename T, size_t alignment = cache_line_size>
+struct AlignedAllocator {
+    static_assert(alignment >= alignof(T) && (alignment & (alignment - 1)) == 0,
+                  "Alignment must be a power of two no smaller than alignof(T)");
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, alignment>&) noexcept {
+    }
+
+    [[nodiscard]] T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignment}));
+    }
+    void deallocate(T* ptr, size_t) noexcept {
+        ::operator delete(ptr, std::align_val_t{alignment});
+    }
+
+    template <typename U>
+    friend constexpr bool operator==(const AlignedAllocator&,
+                                     const AlignedAllocator<U, alignment>&) noexcept {
+        return true;
+    }
+};
+
+// an object that has been unlinked but may still be read by other threads
+struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+
+    void reclaim() const {
+        deleter(ptr);
+    }
+};
+
+template <typename T>
+void default_retire_deleter(void* ptr) {
+    delete static_cast<T*>(ptr);
+}
+
+/// Epoch based reclamation. Each thread registers a Handle, pins the domain while it reads shared
+/// pointers and retires unlinked objects into per-thread limbo lists. An object retired during
+/// epoch e is freed in a batch once the global epoch has reached e + 2, which can only happen
+/// after every thread pinned at e has unpinned. Unreclaimed memory is unbounded while a thread
+/// stays pinned, use HazardDomain where that matters.
+class EpochDomain {
+    struct alignas(cache_line_size) Record {
+        // (epoch << 1) | pinned, written by the owning thread and read by whoever advances
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<bool> in_use{true};
+        Record* next{nullptr};
+
+        // only touched by the owning thread
+        uint32_t pin_depth{0};
+        size_t retired_since_collect{0};
+        std::array<std::vector<Retired>, 3> limbo{};
+        std::array<uint64_t, 3> limbo_epoch{};
+    };
+
+    alignas(cache_line_size) std::atomic<uint64_t> m_epoch{0};
+    alignas(cache_line_size) std::atomic<Record*> m_records{nullptr};
+    std::atomic<size_t> m_unreclaimed{0};
+    size_t m_batch_size;
+
+    Record* acquire_record() {
+        for (Record* record{m_records.load(std::memory_order_acquire)}; record != nullptr;
+             record = record->next) {
+            bool expected{false};
+            if (!record->in_use.load(std::memory_order_relaxed) &&
+                record->in_use.compare_exchange_strong(expected, true,
+                                                       std::memory_order_acquire)) {
+                return record;
+            }
+        }
+        auto* record{new Record{}};
+        Record* head{m_records.load(std::memory_order_relaxed)};
+        do {
+            record->next = head;
+        } while (!m_records.compare_exchange_weak(head, record, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+        return record;
+    }
+
+    void free_bucket(std::vector<Retired>& bucket) {
+        for (auto&& retired : bucket) {
+            retired.reclaim();
+        }
+        m_unreclaimed.fetch_sub(bucket.size(), std::memory_order_relaxed);
+        bucket.clear();
+    }
+
+    void pin(Record& record) {
+        if (record.pin_depth++ == 0) {
+            record.epoch.store((m_epoch.load(std::memory_order_relaxed) << 1) | 1,
+                               std::memory_order_relaxed);
+            // the pinned epoch must be visible before any shared pointer is read
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void unpin(Record& record) {
+        assert(record.pin_depth > 0);
+        if (--record.pin_depth == 0) {
+            record.epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    void retire(Record& record, Retired retired) {
+        // tagged with the global epoch at retirement, which is at least that of any reader
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint64_t epoch{m_epoch.load(std::memory_order_relaxed)};
+        auto& bucket{record.limbo[epoch % 3]};
+        if (record.limbo_epoch[epoch % 3] != epoch) {
+            // anything left from three epochs ago is already safe to free
+            free_bucket(bucket);
+            record.limbo_epoch[epoch % 3] = epoch;
+        }
+        bucket.push_back(retired);
+        m_unreclaimed.fetch_add(1, std::memory_order_relaxed);
+        if (++record.retired_since_collect >= m_batch_size) {
+            try_advance();
+            collect(record);
+        }
+    }
+
+    void collect(Record& record) {
+        record.retired_since_collect = 0;
+        const uint64_t epoch{m_epoch.load(std::memory_order_acquire)};
+        for (size_t i{0}; i < 3; ++i) {
+            if (!record.limbo[i].empty() && record.limbo_epoch[i] + 2 <= epoch) {
+                free_bucket(record.limbo[i]);
+            }
+        }
+    }
+
+  public:
+    class Guard;
+    class Handle;
+
+    explicit EpochDomain(size_t batch_size = 64)
+    : m_batch_size{batch_size} {
+    }
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /// all handles must have been destroyed, anything still in limbo is freed
+    ~EpochDomain() {
+        Record* record{m_records.load(std::memory_order_acquire)};
+        while (record != nullptr) {
+            assert(!record->in_use.load() && "Handle outlived its EpochDomain");
+            for (auto&& bucket : record->limbo) {
+                free_bucket(bucket);
+            }
+            delete std::exchange(record, record->next);
+        }
+    }
+
+    [[nodiscard]] Handle register_thread();
+
+    /// moves the global epoch forward if every pinned thread has observed the current one
+    bool try_advance() {
+        uint64_t epoch{m_epoch.load(std::memory_order_acquire)};
+        for (Record* record{m_records.load(std::memory_order_acquire)}; record != nullptr;
+             record = record->next) {
+            const uint64_t local{record->epoch.load(std::memory_order_acquire)};
+            if ((local & 1) != 0 && (local >> 1) != epoch) {
+                return false;
+            }
+        }
+        return m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+    }
+
+    [[nodiscard]] uint64_t epoch() const noexcept {
+        return m_epoch.load(std::memory_order_relaxed);
+    }
+    /// number of retired objects that have not been freed yet
+    [[nodiscard]] size_t unreclaimed() const noexcept {
+        return m_unreclaimed.load(std::memory_order_relaxed);
+    }
+};
+
+/// pins the domain for the owning thread for as long as it lives, guards can nest
+class EpochDomain::Guard {
+    EpochDomain* m_domain;
+    Record* m_record;
+
+  public:
+    Guard(EpochDomain& domain, Record& record)
+    : m_domain{&domain}
+    , m_record{&record} {
+        m_domain->pin(*m_record);
+    }
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+    ~Guard() {
+        m_domain->unpin(*m_record);
+    }
+};
+
+/// a thread's membership of a domain, must only be used by one thread at a time
+class EpochDomain::Handle {
+    EpochDomain* m_domain;
+    Record* m_record;
+
+  public:
+    explicit Handle(EpochDomain& domain)
+    : m_domain{&domain}
+    , m_record{domain.acquire_record()} {
+    }
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+    Handle(Handle&& other) noexcept
+    : m_domain{other.m_domain}
+    , m_record{std::exchange(other.m_record, nullptr)} {
+    }
+    Handle& operator=(Handle&&) = delete;
+
+    // the limbo lists stay with the record and are freed by its next owner or the domain
+    ~Handle() {
+        if (m_record != nullptr) {
+            assert(m_record->pin_depth == 0 && "Handle destroyed while pinned");
+            m_record->in_use.store(false, std::memory_order_release);
+        }
+    }
+
+    [[nodiscard]] Guard pin() {
+        return Guard{*m_domain, *m_record};
+    }
+
+    /// ptr must already be unreachable for threads that pin after this call
+    void retire(void* ptr, void (*deleter)(void*)) {
+        m_domain->retire(*m_record, Retired{ptr, deleter});
+    }
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, &default_retire_deleter<T>);
+    }
+
+    /// tries to advance the epoch and frees whatever this thread has retired that is now safe
+    void collect() {
+        m_domain->try_advance();
+        m_domain->collect(*m_record);
+    }
+};
+
+inline EpochDomain::Handle EpochDomain::register_thread() {
+    return Handle{*this};
+}
+
+/// Hazard pointer reclamation. A reader publishes the pointer it is about to dereference in a
+/// hazard slot, and retired objects are only freed when no slot holds them. Readers pay a store
+/// and a fence per protected pointer, in exchange unreclaimed memory is bounded by the scan
+/// threshold plus the number of slots no matter how long a reader stalls.
+class HazardDomain {
+    struct alignas(cache_line_size) Slot {
+        std::atomic<void*> ptr{nullptr};
+        std::atomic<bool> in_use{true};
+        Slot* next{nullptr};
+    };
+    struct RetiredNode {
+        Retired retired;
+        RetiredNode* next;
+    };
+
+    alignas(cache_line_size) std::atomic<Slot*> m_slots{nullptr};
+    std::atomic<size_t> m_slot_count{0};
+    alignas(cache_line_size) std::atomic<RetiredNode*> m_retired{nullptr};
+    std::atomic<size_t> m_unreclaimed{0};
+    size_t m_batch_size;
+
+    Slot* acquire_slot() {
+        for (Slot* slot{m_slots.load(std::memory_order_acquire)}; slot != nullptr;
+             slot = slot->next) {
+            bool expected{false};
+            if (!slot->in_use.load(std::memory_order_relaxed) &&
+                slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return slot;
+            }
+        }
+        auto* slot{new Slot{}};
+        Slot* head{m_slots.load(std::memory_order_relaxed)};
+        do {
+            slot->next = head;
+        } while (!m_slots.compare_exchange_weak(head, slot, std::memory_order_release,
+                                                std::memory_order_relaxed));
+        m_slot_count.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    static void release_slot(Slot& slot) {
+        slot.ptr.store(nullptr, std::memory_order_release);
+        slot.in_use.store(false, std::memory_order_release);
+    }
+
+    void push_retired(RetiredNode* first, RetiredNode* last) {
+        RetiredNode* head{m_retired.load(std::memory_order_relaxed)};
+        do {
+            last->next = head;
+        } while (!m_retired.compare_exchange_weak(head, first, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] size_t scan_threshold() const noexcept {
+        return shiv::max(m_batch_size, 2 * m_slot_count.load(std::memory_order_relaxed));
+    }
+
+  public:
+    class Guard;
+
+    explicit HazardDomain(size_t batch_size = 64)
+    : m_batch_size{batch_size} {
+    }
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+
+    /// all guards must have been destroyed, every retired object is freed
+    ~HazardDomain() {
+        RetiredNode* node{m_retired.load(std::memory_order_acquire)};
+        while (node != nullptr) {
+            node->retired.reclaim();
+            delete std::exchange(node, node->next);
+        }
+        Slot* slot{m_slots.load(std::memory_order_acquire)};
+        while (slot != nullptr) {
+            assert(!slot->in_use.load() && "Guard outlived its HazardDomain");
+            delete std::exchange(slot, slot->next);
+        }
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) {
+        auto* node{new RetiredNode{{ptr, deleter}, nullptr}};
+        push_retired(node, node);
+        if (m_unreclaimed.fetch_add(1, std::memory_order_relaxed) + 1 >= scan_threshold()) {
+            scan();
+        }
+    }
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, &default_retire_deleter<T>);
+    }
+
+    /// frees every retired object that is not currently protected by a guard
+    void scan() {
+        RetiredNode* list{m_retired.exchange(nullptr, std::memory_order_acquire)};
+        if (list == nullptr) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::vector<void*> hazards{};
+        for (Slot* slot{m_slots.load(std::memory_order_acquire)}; slot != nullptr;
+             slot = slot->next) {
+            if (void* ptr{slot->ptr.load(std::memory_order_acquire)}; ptr != nullptr) {
+                hazards.push_back(ptr);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        RetiredNode* kept_first{nullptr};
+        RetiredNode* kept_last{nullptr};
+        size_t freed{0};
+        while (list != nullptr) {
+            RetiredNode* node{std::exchange(list, list->next)};
+            if (std::binary_search(hazards.begin(), hazards.end(), node->retired.ptr)) {
+                node->next = kept_first;
+                kept_first = node;
+                if (kept_last == nullptr) {
+                    kept_last = node;
+                }
+            } else {
+                node->retired.reclaim();
+                delete node;
+                ++freed;
+            }
+        }
+        if (kept_first != nullptr) {
+            push_retired(kept_first, kept_last);
+        }
+        m_unreclaimed.fetch_sub(freed, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t unreclaimed() const noexcept {
+        return m_unreclaimed.load(std::memory_order_relaxed);
+    }
+};
+
+/// owns one hazard slot, the protected pointer stays valid until reset or destruction
+class HazardDomain::Guard {
+    HazardDomain* m_domain;
+    Slot* m_slot;
+
+  public:
+    explicit Guard(HazardDomain& domain)
+    : m_domain{&domain}
+    , m_slot{domain.acquire_slot()} {
+    }
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+    ~Guard() {
+        release_slot(*m_slot);
+    }
+
+    /// publishes the pointer currently held by source, retrying until it is stable
+    template <typename T>
+    T* protect(const std::atomic<T*>& source) {
+        T* ptr{source.load(std::memory_order_relaxed)};
+        while (true) {
+            m_slot->ptr.store(ptr, std::memory_order_seq_cst);
+            T* current{source.load(std::memory_order_acquire)};
+            if (current == ptr) {
+                return ptr;
+            }
+            ptr = current;
+        }
+    }
+
+    void reset() noexcept {
+        m_slot->ptr.store(nullptr, std::memory_order_release);
+    }
+};
+} // namespace shiv
 
 #endif //SHIVLIB_MEMORY_HPP
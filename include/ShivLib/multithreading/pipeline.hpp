@@ -0,0 +1,570 @@
+#ifndef SHIVLIB_PIPELINE_HPP
+#define SHIVLIB_PIPELINE_HPP
+
+#include "../memory.hpp"
+#include "ring_buffer.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace shiv {
+struct PipelineOptions {
+    size_t capacity{1024}; // per ring, rounded up to a power of two
+    size_t batch_size{32}; // messages moved per ring synchronisation, at most capacity
+};
+
+/// how the replicas of a parallel stage hand their output on
+enum class Merge {
+    ordered,   // round robin in and out, downstream sees the original order
+    unordered, // replicas share one MPMC ring each way and whoever is free takes the next message
+};
+
+struct StageStats {
+    std::string name;
+    size_t replicas;
+    uint64_t processed;
+    size_t queue_depth; // messages waiting in the stage's input rings
+    double throughput;  // messages per second since start
+};
+
+template <typename In>
+class Pipeline;
+template <typename In, typename Out>
+class PipelineBuilder;
+
+namespace detail {
+// spin briefly, then yield, then sleep so an idle pipeline does not burn whole cores
+class Backoff {
+    unsigned m_count{0};
+
+  public:
+    void wait() {
+        if (m_count < 16) {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+        } else if (m_count < 128) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+        }
+        ++m_count;
+    }
+    void reset() noexcept {
+        m_count = 0;
+    }
+};
+
+/// Connects the replicas of one stage to the replicas of the next. When both sides can keep a
+/// round robin order there is one SPSC lane per producer and consumer pair: message s goes from
+/// producer s % P to consumer s % C, so each side knows which lane holds its next message and
+/// the order survives the hop. Otherwise everyone shares a single MPMC ring.
+template <typename T>
+class Channel {
+    size_t m_producers;
+    size_t m_consumers;
+    size_t m_batch_size;
+    std::vector<std::unique_ptr<SpscRing<T>>> m_lanes{};
+    std::unique_ptr<MpmcRing<T>> m_shared{};
+    std::unique_ptr<std::atomic<bool>[]> m_closed;
+    std::atomic<size_t> m_open_producers;
+
+    [[nodiscard]] bool uses_lanes() const noexcept {
+        return !m_lanes.empty();
+    }
+
+  public:
+    Channel(size_t producers, size_t consumers, bool lanes, const PipelineOptions& options)
+    : m_producers{producers}
+    , m_consumers{consumers}
+    , m_batch_size{options.batch_size}
+    , m_closed{new std::atomic<bool>[producers]}
+    , m_open_producers{producers} {
+        if (lanes) {
+            for (size_t i{0}; i < producers * consumers; ++i) {
+                m_lanes.push_back(std::make_unique<SpscRing<T>>(options.capacity));
+            }
+        } else {
+            m_shared = std::make_unique<MpmcRing<T>>(options.capacity);
+        }
+        for (size_t i{0}; i < producers; ++i) {
+            m_closed[i].store(false, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] size_t depth() const noexcept {
+        if (!uses_lanes()) {
+            return m_shared->size();
+        }
+        size_t total{0};
+        for (auto&& lane : m_lanes) {
+            total += lane->size();
+        }
+        return total;
+    }
+
+    /// one producer's end, stages messages per lane and publishes them a batch at a time
+    class Writer {
+        Channel* m_channel;
+        size_t m_producer;
+        size_t m_sequence; // global sequence number of the next message from this producer
+        std::vector<std::vector<T>> m_staged;
+
+        // pushes as much of the lane as its ring has room for, false if nothing fit
+        bool publish(size_t lane) {
+            auto& staged{m_staged[lane]};
+            const size_t pushed{
+                m_channel->uses_lanes()
+                    ? m_channel->m_lanes[m_producer * m_channel->m_consumers + lane]
+                          ->try_push_batch(staged.begin(), staged.size())
+                    : m_channel->m_shared->try_push_batch(staged.begin(), staged.size())};
+            staged.erase(staged.begin(), staged.begin() + static_cast<std::ptrdiff_t>(pushed));
+            return pushed != 0;
+        }
+
+        void flush_lane(size_t lane) {
+            Backoff backoff{};
+            while (!m_staged[lane].empty()) {
+                if (publish(lane)) {
+                    backoff.reset();
+                    continue;
+                }
+                // the consumer is behind, but it may be waiting on a message staged for another
+                // lane, so hand those on before holding the producer back
+                for (size_t other{0}; other < m_staged.size(); ++other) {
+                    if (other != lane && !m_staged[other].empty()) {
+                        publish(other);
+                    }
+                }
+                backoff.wait();
+            }
+        }
+
+      public:
+        Writer(Channel& channel, size_t producer)
+        : m_channel{&channel}
+        , m_producer{producer}
+        , m_sequence{producer}
+        , m_staged(channel.uses_lanes() ? channel.m_consumers : 1) {
+        }
+
+        void push(T&& value) {
+            size_t lane{0};
+            if (m_channel->uses_lanes()) {
+                lane = m_sequence % m_channel->m_consumers;
+                m_sequence += m_channel->m_producers;
+            }
+            m_staged[lane].push_back(std::move(value));
+            if (m_staged[lane].size() >= m_channel->m_batch_size) {
+                flush_lane(lane);
+            }
+        }
+        void flush() {
+            for (size_t lane{0}; lane < m_staged.size(); ++lane) {
+                flush_lane(lane);
+            }
+        }
+        /// no more messages from this producer
+        void close() {
+            flush();
+            m_channel->m_closed[m_producer].store(true, std::memory_order_release);
+            m_channel->m_open_producers.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    };
+
+    /// one consumer's end, pulls whole batches from a ring and hands them out one at a time
+    class Reader {
+        Channel* m_channel;
+        size_t m_consumer;
+        size_t m_sequence; // global sequence number of the next message for this consumer
+        std::vector<std::vector<T>> m_staged;
+        std::vector<size_t> m_position;
+
+        [[nodiscard]] size_t next_lane() const noexcept {
+            return m_channel->uses_lanes() ? m_sequence % m_channel->m_producers : 0;
+        }
+
+        bool refill(size_t lane) {
+            auto& staged{m_staged[lane]};
+            staged.clear();
+            m_position[lane] = 0;
+            auto out{std::back_inserter(staged)};
+            if (m_channel->uses_lanes()) {
+                return m_channel->m_lanes[lane * m_channel->m_consumers + m_consumer]
+                           ->try_pop_batch(out, m_channel->m_batch_size) != 0;
+            }
+            return m_channel->m_shared->try_pop_batch(out, m_channel->m_batch_size) != 0;
+        }
+
+        [[nodiscard]] bool finished(size_t lane) const noexcept {
+            if (m_channel->uses_lanes()) {
+                return m_channel->m_closed[lane].load(std::memory_order_acquire);
+            }
+            return m_channel->m_open_producers.load(std::memory_order_acquire) == 0;
+        }
+
+        void take(size_t lane, std::optional<T>& out) {
+            out.emplace(std::move(m_staged[lane][m_position[lane]++]));
+            if (m_channel->uses_lanes()) {
+                m_sequence += m_channel->m_consumers;
+            }
+        }
+
+      public:
+        Reader(Channel& channel, size_t consumer)
+        : m_channel{&channel}
+        , m_consumer{consumer}
+        , m_sequence{consumer}
+        , m_staged(channel.uses_lanes() ? channel.m_producers : 1)
+        , m_position(m_staged.size(), 0) {
+        }
+
+        /// never blocks, false if nothing is ready right now
+        bool try_pop(std::optional<T>& out) {
+            const size_t lane{next_lane()};
+            if (m_position[lane] == m_staged[lane].size() && !refill(lane)) {
+                return false;
+            }
+            take(lane, out);
+            return true;
+        }
+
+        /// blocks until a message arrives, false once the producers feeding us have all closed
+        bool pop(std::optional<T>& out) {
+            const size_t lane{next_lane()};
+            Backoff backoff{};
+            while (m_position[lane] == m_staged[lane].size() && !refill(lane)) {
+                // closed is checked before the final look so nothing published before it is lost
+                if (finished(lane)) {
+                    if (!refill(lane)) {
+                        return false;
+                    }
+                    break;
+                }
+                backoff.wait();
+            }
+            take(lane, out);
+            return true;
+        }
+    };
+};
+
+template <typename Out>
+struct Producer {
+    std::shared_ptr<Channel<Out>> output{};
+    size_t producers{1}; // replicas writing to output
+    // each replica received its input round robin, so its output can keep that order
+    bool balanced{true};
+
+    virtual ~Producer() = default;
+};
+
+// sinks are stages that produce nothing
+template <>
+struct Producer<void> {
+    size_t producers{1};
+    bool balanced{true};
+
+    virtual ~Producer() = default;
+};
+template <>
+class Channel<void> {
+  public:
+    struct Writer {
+        Writer(Channel&, size_t) {
+        }
+    };
+};
+
+template <typename In>
+struct Source : Producer<In> {};
+
+class StageBase {
+    struct alignas(cache_line_size) Counter {
+        std::atomic<uint64_t> value{0};
+    };
+
+  protected:
+    std::unique_ptr<Counter[]> m_processed;
+
+    void publish_processed(size_t replica, uint64_t count) noexcept {
+        m_processed[replica].value.store(count, std::memory_order_relaxed);
+    }
+
+  public:
+    std::string name;
+    size_t replicas;
+
+    StageBase(std::string stage_name, size_t replica_count)
+    : m_processed{new Counter[replica_count]}
+    , name{std::move(stage_name)}
+    , replicas{replica_count} {
+    }
+    virtual ~StageBase() = default;
+
+    virtual void run(size_t replica) = 0;
+    [[nodiscard]] virtual size_t queue_depth() const noexcept = 0;
+
+    [[nodiscard]] uint64_t processed() const noexcept {
+        uint64_t total{0};
+        for (size_t i{0}; i < replicas; ++i) {
+            total += m_processed[i].value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+// Out is void for a sink
+template <typename In, typename Out, typename Func>
+class Stage : public StageBase, public Producer<Out> {
+    std::vector<Func> m_funcs; // one copy per replica so stateful functors need no locking
+    std::shared_ptr<Channel<In>> m_input;
+    size_t m_batch_size;
+
+  public:
+    Stage(std::string stage_name, size_t replica_count, const Func& func,
+          std::shared_ptr<Channel<In>> input, bool balanced, size_t batch_size)
+    : StageBase{std::move(stage_name), replica_count}
+    , m_funcs(replica_count, func)
+    , m_input{std::move(input)}
+    , m_batch_size{batch_size} {
+        this->producers = replica_count;
+        this->balanced = balanced;
+    }
+
+    void run(size_t replica) override {
+        typename Channel<In>::Reader reader{*m_input, replica};
+        std::optional<typename Channel<Out>::Writer> writer{};
+        if constexpr (!std::is_void_v<Out>) {
+            writer.emplace(*this->output, replica);
+        }
+        std::optional<In> message{}; // so In needs no default constructor
+        uint64_t count{0};
+        while (true) {
+            if (!reader.try_pop(message)) {
+                // about to wait, so let downstream have what is staged
+                if constexpr (!std::is_void_v<Out>) {
+                    writer->flush();
+                }
+                publish_processed(replica, count);
+                if (!reader.pop(message)) {
+                    break;
+                }
+            }
+            if constexpr (std::is_void_v<Out>) {
+                m_funcs[replica](std::move(*message));
+            } else {
+                writer->push(m_funcs[replica](std::move(*message)));
+            }
+            if (++count % m_batch_size == 0) {
+                publish_processed(replica, count);
+            }
+        }
+        if constexpr (!std::is_void_v<Out>) {
+            writer->close();
+        }
+        publish_processed(replica, count);
+    }
+
+    [[nodiscard]] size_t queue_depth() const noexcept override {
+        return m_input->depth();
+    }
+};
+} // namespace detail
+
+/// Builds a pipeline one stage at a time, each call returns a builder for the new output type.
+/// Every stage must turn one message into exactly one message, which is what lets ordered
+/// parallel stages merge back into the original order.
+template <typename In, typename Out>
+class PipelineBuilder {
+    template <typename, typename>
+    friend class PipelineBuilder;
+    friend class Pipeline<In>;
+
+    PipelineOptions m_options;
+    std::unique_ptr<detail::Source<In>> m_source;
+    std::vector<std::unique_ptr<detail::StageBase>> m_stages;
+    detail::Producer<Out>* m_last;
+
+    PipelineBuilder(PipelineOptions options, std::unique_ptr<detail::Source<In>> source,
+                    std::vector<std::unique_ptr<detail::StageBase>> stages,
+                    detail::Producer<Out>* last)
+    : m_options{options}
+    , m_source{std::move(source)}
+    , m_stages{std::move(stages)}
+    , m_last{last} {
+    }
+
+    template <typename Next, typename Func>
+    auto add_stage(std::string name, size_t replicas, Func func, Merge merge) {
+        if (replicas == 0) {
+            throw std::invalid_argument{"A stage needs at least one replica"};
+        }
+        // lanes need round robin on both sides of the hop
+        const bool lanes{(m_last->producers == 1 || m_last->balanced) &&
+                         (replicas == 1 || merge == Merge::ordered)};
+        auto channel{
+            std::make_shared<detail::Channel<Out>>(m_last->producers, replicas, lanes, m_options)};
+        m_last->output = channel;
+        auto stage{std::make_unique<detail::Stage<Out, Next, Func>>(
+            std::move(name), replicas, func, std::move(channel), lanes, m_options.batch_size)};
+        auto* last{stage.get()};
+        m_stages.push_back(std::move(stage));
+        return PipelineBuilder<In, Next>{m_options, std::move(m_source), std::move(m_stages),
+                                         last};
+    }
+
+  public:
+    /// func is called as Next func(Out&&)
+    template <typename Func>
+    [[nodiscard]] auto stage(std::string name, Func func) && {
+        return std::move(*this).parallel_stage(std::move(name), 1, std::move(func));
+    }
+    template <typename Func>
+    [[nodiscard]] auto parallel_stage(std::string name, size_t replicas, Func func,
+                                      Merge merge = Merge::ordered) && {
+        using Next = std::remove_cvref_t<std::invoke_result_t<Func&, Out&&>>;
+        static_assert(!std::is_void_v<Next>, "Use sink for the final stage");
+        return add_stage<Next>(std::move(name), replicas, std::move(func), merge);
+    }
+
+    /// func is called as func(Out&&), finishes the pipeline
+    template <typename Func>
+    [[nodiscard]] Pipeline<In> sink(std::string name, Func func) && {
+        return std::move(*this).parallel_sink(std::move(name), 1, std::move(func));
+    }
+    template <typename Func>
+    [[nodiscard]] Pipeline<In> parallel_sink(std::string name, size_t replicas, Func func,
+                                             Merge merge = Merge::ordered) && {
+        auto finished{add_stage<void>(std::move(name), replicas, std::move(func), merge)};
+        return Pipeline<In>{std::move(finished.m_source), std::move(finished.m_stages)};
+    }
+};
+
+/// Staged pipeline: every stage replica runs on its own thread and stages are joined by
+/// bounded rings, so a slow stage pushes back on everything upstream of it. push() must only
+/// be called from one thread. Pushed messages are staged and handed to the first stage a batch
+/// at a time, call flush() to hand on a partial batch before going idle.
+template <typename In>
+class Pipeline {
+    template <typename, typename>
+    friend class PipelineBuilder;
+
+    std::unique_ptr<detail::Source<In>> m_source;
+    std::vector<std::unique_ptr<detail::StageBase>> m_stages;
+    std::vector<std::thread> m_threads{};
+    std::optional<typename detail::Channel<In>::Writer> m_writer{};
+    std::chrono::steady_clock::time_point m_start{};
+    std::chrono::steady_clock::time_point m_end{};
+    bool m_running{false};
+
+    Pipeline(std::unique_ptr<detail::Source<In>> source,
+             std::vector<std::unique_ptr<detail::StageBase>> stages)
+    : m_source{std::move(source)}
+    , m_stages{std::move(stages)} {
+    }
+
+  public:
+    /// throws std::invalid_argument unless 0 < batch_size <= capacity
+    [[nodiscard]] static PipelineBuilder<In, In> builder(PipelineOptions options = {}) {
+        if (options.batch_size == 0 || options.batch_size > options.capacity) {
+            throw std::invalid_argument{"Pipeline batch size must be between 1 and the capacity"};
+        }
+        auto source{std::make_unique<detail::Source<In>>()};
+        auto* last{source.get()};
+        return PipelineBuilder<In, In>{options, std::move(source), {}, last};
+    }
+
+    /// other is left stopped and empty, so destroying it does not close the input again
+    Pipeline(Pipeline&& other) noexcept
+    : m_source{std::move(other.m_source)}
+    , m_stages{std::move(other.m_stages)}
+    , m_threads{std::move(other.m_threads)}
+    , m_writer{std::move(other.m_writer)}
+    , m_start{other.m_start}
+    , m_end{other.m_end}
+    , m_running{std::exchange(other.m_running, false)} {
+        other.m_writer.reset();
+    }
+    Pipeline& operator=(Pipeline&&) = delete;
+    ~Pipeline() {
+        if (m_running) {
+            finish();
+        }
+    }
+
+    void start() {
+        assert(!m_running);
+        m_writer.emplace(*m_source->output, 0);
+        m_start = std::chrono::steady_clock::now();
+        for (auto&& stage : m_stages) {
+            for (size_t replica{0}; replica < stage->replicas; ++replica) {
+                m_threads.emplace_back([stage = stage.get(), replica] { stage->run(replica); });
+            }
+        }
+        m_running = true;
+    }
+
+    /// stages the message, publishing once batch_size are waiting. Blocks while the first
+    /// stage is full.
+    void push(In message) {
+        m_writer->push(std::move(message));
+    }
+    /// publishes the whole range in batches
+    template <typename InputIt>
+    void push_batch(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            m_writer->push(std::move(*first));
+        }
+        m_writer->flush();
+    }
+    /// publishes the messages staged by push
+    void flush() {
+        m_writer->flush();
+    }
+
+    /// closes the input and waits for every message to reach the sink
+    void finish() {
+        if (!m_running) {
+            return;
+        }
+        m_writer->close();
+        for (auto&& thread : m_threads) {
+            thread.join();
+        }
+        m_threads.clear();
+        m_end = std::chrono::steady_clock::now();
+        m_running = false;
+    }
+
+    [[nodiscard]] std::vector<StageStats> stats() const {
+        const auto end{m_running ? std::chrono::steady_clock::now() : m_end};
+        const double seconds{std::chrono::duration<double>(end - m_start).count()};
+        std::vector<StageStats> result{};
+        for (auto&& stage : m_stages) {
+            const uint64_t processed{stage->processed()};
+            result.push_back(StageStats{stage->name, stage->replicas, processed,
+                                        stage->queue_depth(),
+                                        seconds > 0 ? static_cast<double>(processed) / seconds
+                                                    : 0.0});
+        }
+        return result;
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_PIPELINE_HPP
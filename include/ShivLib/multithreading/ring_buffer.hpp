@@ -0,0 +1,323 @@
+#ifndef SHIVLIB_RING_BUFFER_HPP
+#define SHIVLIB_RING_BUFFER_HPP
+
+#include "../memory.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace shiv {
+namespace detail {
+[[nodiscard]] constexpr size_t round_up_pow2(size_t value) noexcept {
+    size_t rounded{1};
+    while (rounded < value) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+// uninitialised storage for one element
+template <typename T>
+struct RingSlot {
+    alignas(T) std::byte bytes[sizeof(T)];
+
+    [[nodiscard]] T* get() noexcept {
+        return std::launder(reinterpret_cast<T*>(bytes));
+    }
+};
+} // namespace detail
+
+/// Bounded single producer single consumer queue. Each side caches the other side's index so
+/// the shared cache lines are only touched when the cached view runs out, and the batch calls
+/// publish a whole batch with one store.
+template <typename T>
+class SpscRing {
+    struct alignas(cache_line_size) ProducerSide {
+        std::atomic<size_t> tail{0};
+        size_t cached_head{0};
+    };
+    struct alignas(cache_line_size) ConsumerSide {
+        std::atomic<size_t> head{0};
+        size_t cached_tail{0};
+    };
+
+    ProducerSide m_producer{};
+    ConsumerSide m_consumer{};
+    size_t m_mask;
+    std::unique_ptr<detail::RingSlot<T>[]> m_slots;
+
+    [[nodiscard]] size_t free_slots(size_t tail) noexcept {
+        size_t free{capacity() - (tail - m_producer.cached_head)};
+        if (free == 0) {
+            m_producer.cached_head = m_consumer.head.load(std::memory_order_acquire);
+            free = capacity() - (tail - m_producer.cached_head);
+        }
+        return free;
+    }
+    [[nodiscard]] size_t ready_slots(size_t head) noexcept {
+        size_t ready{m_consumer.cached_tail - head};
+        if (ready == 0) {
+            m_consumer.cached_tail = m_producer.tail.load(std::memory_order_acquire);
+            ready = m_consumer.cached_tail - head;
+        }
+        return ready;
+    }
+
+  public:
+    using value_type = T;
+
+    /// capacity is rounded up to a power of two
+    explicit SpscRing(size_t capacity)
+    : m_mask{detail::round_up_pow2(capacity) - 1}
+    , m_slots{new detail::RingSlot<T>[m_mask + 1]} {
+    }
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    ~SpscRing() {
+        const size_t tail{m_producer.tail.load(std::memory_order_relaxed)};
+        for (size_t head{m_consumer.head.load(std::memory_order_relaxed)}; head != tail; ++head) {
+            std::destroy_at(m_slots[head & m_mask].get());
+        }
+    }
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        const size_t tail{m_producer.tail.load(std::memory_order_relaxed)};
+        if (free_slots(tail) == 0) {
+            return false;
+        }
+        std::construct_at(m_slots[tail & m_mask].get(), std::forward<Args>(args)...);
+        m_producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push(const T& value) {
+        return try_emplace(value);
+    }
+    bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    /// moves up to count elements in from first, returns how many fit
+    template <typename InputIt>
+    size_t try_push_batch(InputIt first, size_t count) {
+        const size_t tail{m_producer.tail.load(std::memory_order_relaxed)};
+        const size_t pushed{shiv::min(count, free_slots(tail))};
+        for (size_t i{0}; i < pushed; ++i, ++first) {
+            std::construct_at(m_slots[(tail + i) & m_mask].get(), std::move(*first));
+        }
+        if (pushed != 0) {
+            m_producer.tail.store(tail + pushed, std::memory_order_release);
+        }
+        return pushed;
+    }
+
+    bool try_pop(T& out) {
+        const size_t head{m_consumer.head.load(std::memory_order_relaxed)};
+        if (ready_slots(head) == 0) {
+            return false;
+        }
+        T* slot{m_slots[head & m_mask].get()};
+        out = std::move(*slot);
+        std::destroy_at(slot);
+        m_consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// moves up to max_count elements out to out, returns how many were available
+    template <typename OutputIt>
+    size_t try_pop_batch(OutputIt out, size_t max_count) {
+        const size_t head{m_consumer.head.load(std::memory_order_relaxed)};
+        const size_t popped{shiv::min(max_count, ready_slots(head))};
+        for (size_t i{0}; i < popped; ++i, ++out) {
+            T* slot{m_slots[(head + i) & m_mask].get()};
+            *out = std::move(*slot);
+            std::destroy_at(slot);
+        }
+        if (popped != 0) {
+            m_consumer.head.store(head + popped, std::memory_order_release);
+        }
+        return popped;
+    }
+
+    /// exact when called from either end, approximate from anywhere else
+    [[nodiscard]] size_t size() const noexcept {
+        return m_producer.tail.load(std::memory_order_acquire) -
+               m_consumer.head.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+    [[nodiscard]] size_t capacity() const noexcept {
+        return m_mask + 1;
+    }
+};
+
+/// Bounded multi producer multi consumer queue (Vyukov). Every cell carries a sequence number
+/// that tells a producer or consumer whether the cell is its turn, so the only contended
+/// operation is one CAS on the enqueue or dequeue position. The batch calls claim the whole run
+/// of ready cells with that one CAS.
+template <typename T>
+class MpmcRing {
+    struct Cell {
+        std::atomic<size_t> sequence;
+        detail::RingSlot<T> slot;
+    };
+
+    alignas(cache_line_size) std::atomic<size_t> m_enqueue_pos{0};
+    alignas(cache_line_size) std::atomic<size_t> m_dequeue_pos{0};
+    alignas(cache_line_size) size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    // hands the element to sink before the cell is released, so no temporary T is needed
+    template <typename Sink>
+    bool try_consume(Sink&& sink) {
+        size_t pos{m_dequeue_pos.load(std::memory_order_relaxed)};
+        while (true) {
+            Cell& cell{m_cells[pos & m_mask]};
+            const size_t sequence{cell.sequence.load(std::memory_order_acquire)};
+            const auto diff{static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos + 1)};
+            if (diff == 0) {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed)) {
+                    T* slot{cell.slot.get()};
+                    sink(std::move(*slot));
+                    std::destroy_at(slot);
+                    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claims up to count consecutive cells from position with one CAS, those whose sequence is
+    // their position plus ready, 0 for a producer and 1 for a consumer. Returns how many, the
+    // first at pos. A cell seen ready stays so until its position is claimed, which would fail
+    // the CAS, so the run checked before it is still free to take.
+    size_t claim(std::atomic<size_t>& position, size_t ready, size_t count, size_t& pos) {
+        pos = position.load(std::memory_order_relaxed);
+        while (count != 0) {
+            size_t run{0};
+            ptrdiff_t diff{0};
+            for (; run < count; ++run) {
+                const size_t sequence{
+                    m_cells[(pos + run) & m_mask].sequence.load(std::memory_order_acquire)};
+                diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos + run + ready);
+                if (diff != 0) {
+                    break;
+                }
+            }
+            if (run != 0) {
+                if (position.compare_exchange_weak(pos, pos + run, std::memory_order_relaxed)) {
+                    return run;
+                }
+            } else if (diff < 0) {
+                return 0; // full for a producer, empty for a consumer
+            } else {
+                pos = position.load(std::memory_order_relaxed); // another thread took pos
+            }
+        }
+        return 0;
+    }
+
+  public:
+    using value_type = T;
+
+    /// capacity is rounded up to a power of two, and is at least 2
+    explicit MpmcRing(size_t capacity)
+    : m_mask{detail::round_up_pow2(shiv::max(capacity, size_t{2})) - 1}
+    , m_cells{new Cell[m_mask + 1]} {
+        for (size_t i{0}; i <= m_mask; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+    ~MpmcRing() {
+        const size_t enqueued{m_enqueue_pos.load(std::memory_order_relaxed)};
+        for (size_t pos{m_dequeue_pos.load(std::memory_order_relaxed)}; pos != enqueued; ++pos) {
+            std::destroy_at(m_cells[pos & m_mask].slot.get());
+        }
+    }
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t pos{m_enqueue_pos.load(std::memory_order_relaxed)};
+        while (true) {
+            Cell& cell{m_cells[pos & m_mask]};
+            const size_t sequence{cell.sequence.load(std::memory_order_acquire)};
+            const auto diff{static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos)};
+            if (diff == 0) {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed)) {
+                    std::construct_at(cell.slot.get(), std::forward<Args>(args)...);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    bool try_push(const T& value) {
+        return try_emplace(value);
+    }
+    bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    /// moves up to count elements in from first, returns how many fit
+    template <typename InputIt>
+    size_t try_push_batch(InputIt first, size_t count) {
+        size_t pos{0};
+        const size_t pushed{claim(m_enqueue_pos, 0, count, pos)};
+        for (size_t i{0}; i < pushed; ++i, ++first) {
+            Cell& cell{m_cells[(pos + i) & m_mask]};
+            std::construct_at(cell.slot.get(), std::move(*first));
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return pushed;
+    }
+
+    bool try_pop(T& out) {
+        return try_consume([&out](T&& value) { out = std::move(value); });
+    }
+
+    /// moves up to max_count elements out to out, returns how many were available
+    template <typename OutputIt>
+    size_t try_pop_batch(OutputIt out, size_t max_count) {
+        size_t pos{0};
+        const size_t popped{claim(m_dequeue_pos, 1, max_count, pos)};
+        for (size_t i{0}; i < popped; ++i, ++out) {
+            Cell& cell{m_cells[(pos + i) & m_mask]};
+            T* slot{cell.slot.get()};
+            *out = std::move(*slot);
+            std::destroy_at(slot);
+            cell.sequence.store(pos + i + m_mask + 1, std::memory_order_release);
+        }
+        return popped;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        const size_t enqueued{m_enqueue_pos.load(std::memory_order_acquire)};
+        const size_t dequeued{m_dequeue_pos.load(std::memory_order_acquire)};
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+    [[nodiscard]] size_t capacity() const noexcept {
+        return m_mask + 1;
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_RING_BUFFER_HPP
@@ -0,0 +1,260 @@
+#ifndef SHIVLIB_SHARDED_COUNTER_HPP
+#define SHIVLIB_SHARDED_COUNTER_HPP
+
+#include "../memory.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace shiv {
+enum class ShardBy {
+    thread, // thread local slot index handed out round robin, no syscall on the hot path
+    cpu,    // the cpu the caller is running on, best when threads outnumber cores
+};
+
+namespace detail {
+[[nodiscard]] inline size_t thread_shard() noexcept {
+    static std::atomic<size_t> next_index{0};
+    thread_local const size_t index{next_index.fetch_add(1, std::memory_order_relaxed)};
+    return index;
+}
+
+[[nodiscard]] inline size_t cpu_shard() noexcept {
+#ifdef __linux__
+    if (const int cpu{sched_getcpu()}; cpu >= 0) {
+        return static_cast<size_t>(cpu);
+    }
+#endif
+    return thread_shard();
+}
+
+[[nodiscard]] inline size_t default_shard_count() noexcept {
+    size_t count{1};
+    while (count < std::thread::hardware_concurrency()) {
+        count <<= 1;
+    }
+    return count;
+}
+
+/// one cache line per shard so writers on different shards never contend, reads sum every shard
+template <ShardBy shard_by>
+class ShardedSlots {
+    struct alignas(cache_line_size) Slot {
+        std::atomic<int64_t> value{0};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+
+    [[nodiscard]] static size_t checked_count(size_t shard_count) {
+        if (shard_count == 0 || (shard_count & (shard_count - 1)) != 0) {
+            throw std::invalid_argument{"Shard count must be a nonzero power of two"};
+        }
+        return shard_count;
+    }
+
+  public:
+    explicit ShardedSlots(size_t shard_count)
+    : m_slots{new Slot[checked_count(shard_count)]}
+    , m_mask{shard_count - 1} {
+    }
+
+    void add(int64_t amount) noexcept {
+        const size_t shard{shard_by == ShardBy::cpu ? cpu_shard() : thread_shard()};
+        m_slots[shard & m_mask].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] int64_t sum() const noexcept {
+        int64_t total{0};
+        for (size_t i{0}; i <= m_mask; ++i) {
+            total += m_slots[i].value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void store(int64_t value) noexcept {
+        for (size_t i{1}; i <= m_mask; ++i) {
+            m_slots[i].value.store(0, std::memory_order_relaxed);
+        }
+        m_slots[0].value.store(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t shard_count() const noexcept {
+        return m_mask + 1;
+    }
+};
+} // namespace detail
+
+enum class MetricKind { counter, gauge };
+
+/// Every named counter and gauge registers itself here so exporters can enumerate them without
+/// knowing where they live. Registration takes a lock, the counters themselves never do.
+class CounterRegistry {
+  public:
+    struct Sample {
+        std::string name;
+        MetricKind kind;
+        int64_t value;
+    };
+
+  private:
+    struct Entry {
+        std::string name;
+        MetricKind kind;
+        const void* metric;
+        int64_t (*read)(const void*);
+    };
+
+    mutable std::mutex m_mutex{};
+    std::vector<Entry> m_entries{};
+
+  public:
+    [[nodiscard]] static CounterRegistry& global() {
+        static CounterRegistry registry{};
+        return registry;
+    }
+
+    template <typename Metric>
+    void add(std::string name, MetricKind kind, const Metric& metric) {
+        std::lock_guard lock{m_mutex};
+        m_entries.push_back(Entry{std::move(name), kind, &metric, [](const void* ptr) {
+                                      return static_cast<const Metric*>(ptr)->value();
+                                  }});
+    }
+
+    void remove(const void* metric) {
+        std::lock_guard lock{m_mutex};
+        std::erase_if(m_entries, [metric](const Entry& entry) { return entry.metric == metric; });
+    }
+
+    /// calls func(name, kind, value) for every registered metric
+    template <typename Func>
+    void for_each(Func&& func) const {
+        std::lock_guard lock{m_mutex};
+        for (auto&& entry : m_entries) {
+            func(entry.name, entry.kind, entry.read(entry.metric));
+        }
+    }
+
+    [[nodiscard]] std::vector<Sample> snapshot() const {
+        std::vector<Sample> samples{};
+        for_each([&samples](const std::string& name, MetricKind kind, int64_t value) {
+            samples.push_back(Sample{name, kind, value});
+        });
+        return samples;
+    }
+
+    [[nodiscard]] size_t size() const {
+        std::lock_guard lock{m_mutex};
+        return m_entries.size();
+    }
+};
+
+namespace detail {
+template <ShardBy shard_by, MetricKind kind>
+class ShardedMetric {
+  protected:
+    ShardedSlots<shard_by> m_slots;
+    CounterRegistry* m_registry{nullptr};
+
+  public:
+    /// unnamed metrics are not registered anywhere. shard_count must be a nonzero power of two,
+    /// anything else throws std::invalid_argument
+    explicit ShardedMetric(size_t shard_count = default_shard_count())
+    : m_slots{shard_count} {
+    }
+    ShardedMetric(std::string name, CounterRegistry& registry = CounterRegistry::global(),
+                  size_t shard_count = default_shard_count())
+    : m_slots{shard_count}
+    , m_registry{&registry} {
+        m_registry->add(std::move(name), kind, *this);
+    }
+    // the registry holds our address
+    ShardedMetric(const ShardedMetric&) = delete;
+    ShardedMetric& operator=(const ShardedMetric&) = delete;
+    ~ShardedMetric() {
+        if (m_registry != nullptr) {
+            m_registry->remove(this);
+        }
+    }
+
+    /// sums every shard, concurrent updates may or may not be included
+    [[nodiscard]] int64_t value() const noexcept {
+        return m_slots.sum();
+    }
+    [[nodiscard]] size_t shard_count() const noexcept {
+        return m_slots.shard_count();
+    }
+};
+} // namespace detail
+
+/// a monotonic event count that can be bumped from any thread without sharing a cache line
+template <ShardBy shard_by = ShardBy::thread>
+class ShardedCounter : public detail::ShardedMetric<shard_by, MetricKind::counter> {
+  public:
+    using detail::ShardedMetric<shard_by, MetricKind::counter>::ShardedMetric;
+
+    void increment() noexcept {
+        this->m_slots.add(1);
+    }
+    void add(uint64_t amount) noexcept {
+        this->m_slots.add(static_cast<int64_t>(amount));
+    }
+    ShardedCounter& operator++() noexcept {
+        increment();
+        return *this;
+    }
+    ShardedCounter& operator+=(uint64_t amount) noexcept {
+        add(amount);
+        return *this;
+    }
+    /// not atomic with respect to concurrent increments
+    void reset() noexcept {
+        this->m_slots.store(0);
+    }
+};
+
+/// a level that moves both ways, e.g. queue depth or open sessions
+template <ShardBy shard_by = ShardBy::thread>
+class ShardedGauge : public detail::ShardedMetric<shard_by, MetricKind::gauge> {
+  public:
+    using detail::ShardedMetric<shard_by, MetricKind::gauge>::ShardedMetric;
+
+    void increment() noexcept {
+        this->m_slots.add(1);
+    }
+    void decrement() noexcept {
+        this->m_slots.add(-1);
+    }
+    void add(int64_t amount) noexcept {
+        this->m_slots.add(amount);
+    }
+    void sub(int64_t amount) noexcept {
+        this->m_slots.add(-amount);
+    }
+    ShardedGauge& operator+=(int64_t amount) noexcept {
+        add(amount);
+        return *this;
+    }
+    ShardedGauge& operator-=(int64_t amount) noexcept {
+        sub(amount);
+        return *this;
+    }
+    /// not atomic with respect to concurrent updates
+    void set(int64_t value) noexcept {
+        this->m_slots.store(value);
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_SHARDED_COUNTER_HPP
@@ -0,0 +1,153 @@
+#ifndef SHIVLIB_THREAD_POOL_HPP
+#define SHIVLIB_THREAD_POOL_HPP
+
+#include "../algorithm.hpp"
+#include "../cstddef.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace shiv {
+/// Fork join pool for data parallel loops. parallel_for hands indices out to the workers and
+/// the calling thread, which all take the next one until none are left, then returns once every
+/// index has run. Workers sleep between loops. The pool runs one loop at a time, a loop started
+/// while it is busy, or from inside one of its own loops, runs inline on the calling thread
+/// rather than waiting. Loops on different pools nest freely.
+class ThreadPool {
+    std::vector<std::thread> m_workers{};
+    std::mutex m_loop_mutex{}; // held by whoever owns the workers for the current loop
+    std::mutex m_mutex{};
+    std::condition_variable m_wake{};
+    std::condition_variable m_finished{};
+
+    const std::function<void(size_t)>* m_body{nullptr};
+    size_t m_count{0};
+    std::atomic<size_t> m_next{0};
+    size_t m_busy{0};
+    uint64_t m_generation{0};
+    bool m_stopping{false};
+    std::exception_ptr m_error{};
+
+    // the loops this thread is running indices of, innermost first
+    struct ActiveLoop {
+        const ThreadPool* pool;
+        const ActiveLoop* outer;
+    };
+    [[nodiscard]] static const ActiveLoop*& innermost_loop() noexcept {
+        thread_local const ActiveLoop* innermost{nullptr};
+        return innermost;
+    }
+    [[nodiscard]] bool inside_loop() const noexcept {
+        for (const ActiveLoop* loop{innermost_loop()}; loop != nullptr; loop = loop->outer) {
+            if (loop->pool == this) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run_indices() {
+        const ActiveLoop loop{this, innermost_loop()};
+        innermost_loop() = &loop;
+        for (size_t index{m_next.fetch_add(1, std::memory_order_relaxed)}; index < m_count;
+             index = m_next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                (*m_body)(index);
+            } catch (...) {
+                // the remaining indices are skipped and the first error reaches the caller
+                m_next.store(m_count, std::memory_order_relaxed);
+                const std::lock_guard lock{m_mutex};
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+        innermost_loop() = loop.outer;
+    }
+
+    void work() {
+        uint64_t seen{0};
+        while (true) {
+            {
+                std::unique_lock lock{m_mutex};
+                m_wake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+                if (m_stopping) {
+                    return;
+                }
+                seen = m_generation;
+            }
+            run_indices();
+            const std::lock_guard lock{m_mutex};
+            if (--m_busy == 0) {
+                m_finished.notify_one();
+            }
+        }
+    }
+
+  public:
+    /// threads includes the caller of parallel_for, so threads - 1 workers are started
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) {
+        threads = shiv::max(threads, size_t{1});
+        m_workers.reserve(threads - 1);
+        for (size_t i{1}; i < threads; ++i) {
+            m_workers.emplace_back([this] { work(); });
+        }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool() {
+        {
+            const std::lock_guard lock{m_mutex};
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    /// threads taking part in a loop, counting the caller
+    [[nodiscard]] size_t size() const noexcept {
+        return m_workers.size() + 1;
+    }
+
+    /// runs body(index) for every index in [0, count), rethrowing the first exception thrown
+    void parallel_for(size_t count, const std::function<void(size_t)>& body) {
+        if (count == 0) {
+            return;
+        }
+        std::unique_lock loop_lock{m_loop_mutex, std::defer_lock};
+        if (m_workers.empty() || count == 1 || inside_loop() || !loop_lock.try_lock()) {
+            for (size_t index{0}; index < count; ++index) {
+                body(index);
+            }
+            return;
+        }
+        {
+            const std::lock_guard lock{m_mutex};
+            m_body = &body;
+            m_count = count;
+            m_next.store(0, std::memory_order_relaxed);
+            m_busy = m_workers.size();
+            m_error = nullptr;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+        run_indices();
+        std::unique_lock lock{m_mutex};
+        m_finished.wait(lock, [&] { return m_busy == 0; });
+        m_body = nullptr;
+        if (m_error) {
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+        }
+    }
+};
+} // namespace shiv
+
+#endif //SHIVLIB_THREAD_POOL_HPP
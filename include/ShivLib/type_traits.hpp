@@ -5,6 +5,10 @@
 #include <cstddef> // std::byte
 
 namespace shiv {
+// 16 bit floating point storage types, defined in float16.hpp
+class float16;
+class bfloat16;
+
 // remove refness of a type
 template <typename T>
 struct remove_reference {
@@ -204,6 +208,10 @@ template <>
 struct is_floating_point_helper<double> : public true_type {};
 template <>
 struct is_floating_point_helper<long double> : public true_type {};
+template <>
+struct is_floating_point_helper<float16> : public true_type {};
+template <>
+struct is_floating_point_helper<bfloat16> : public true_type {};
 
 template <typename T>
 struct is_floating_point : public is_floating_point_helper<remove_cv_t<T>> {};
@@ -0,0 +1,250 @@
+#include <ShivLib/charconv.hpp>
+#include <bit>
+#include <boost/test/unit_test.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// both parsers must agree on the error, the length read and, when it worked, the value
+template <typename T>
+void check_against_std(const std::string& text) {
+    T expected{};
+    T actual{};
+    const auto [ptr, error]{std::from_chars(text.data(), text.data() + text.size(), expected)};
+    const shiv::FromCharsResult result{shiv::from_chars(shiv::StringView<char>{text}, actual)};
+    BOOST_TEST_CONTEXT("text \"" << text << "\"") {
+        BOOST_TEST((result.error == error));
+        BOOST_TEST(result.consumed == (error == std::errc::invalid_argument
+                                           ? size_t{0}
+                                           : static_cast<size_t>(ptr - text.data())));
+        if (error == std::errc{}) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::isnan(expected)) {
+                    BOOST_TEST(std::isnan(actual));
+                } else {
+                    BOOST_TEST(std::bit_cast<uint64_t>(double{actual}) ==
+                               std::bit_cast<uint64_t>(double{expected}));
+                }
+            } else {
+                BOOST_TEST(actual == expected);
+            }
+        }
+    }
+}
+
+template <typename T>
+constexpr T parse(const char* text) {
+    T value{};
+    (void)shiv::from_chars(shiv::StringView<char>{text}, value);
+    return value;
+}
+template <typename T>
+constexpr T parse_fixed(const char* text, unsigned decimals) {
+    T value{};
+    (void)shiv::from_chars_fixed(shiv::StringView<char>{text}, value, decimals);
+    return value;
+}
+
+std::string random_digits(std::mt19937_64& generator, size_t count) {
+    std::string digits(count, '0');
+    for (auto& digit : digits) {
+        digit = static_cast<char>('0' + generator() % 10);
+    }
+    return digits;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(charconv_test)
+BOOST_AUTO_TEST_CASE(integer_test) {
+    static_assert(parse<int>("-1234567890") == -1234567890);
+    static_assert(parse<uint64_t>("18446744073709551615") == UINT64_MAX);
+
+    int64_t value{0};
+    BOOST_TEST((shiv::from_chars("12345678901234567xyz", value) ==
+                shiv::FromCharsResult{17, std::errc{}}));
+    BOOST_TEST(value == 12345678901234567);
+    BOOST_TEST((shiv::from_chars("-x", value) ==
+                shiv::FromCharsResult{0, std::errc::invalid_argument}));
+    BOOST_TEST((shiv::from_chars("9223372036854775808", value) ==
+                shiv::FromCharsResult{19, std::errc::result_out_of_range}));
+    BOOST_TEST(value == 12345678901234567);
+    BOOST_TEST(static_cast<bool>(shiv::from_chars("-9223372036854775808", value)));
+    BOOST_TEST(value == INT64_MIN);
+    uint8_t byte{0};
+    BOOST_TEST((shiv::from_chars("256", byte).error == std::errc::result_out_of_range));
+    BOOST_TEST((shiv::from_chars("-1", byte).error == std::errc::invalid_argument));
+
+    const std::vector<std::string> edges{"",
+                                         "0",
+                                         "-0",
+                                         "+1",
+                                         "00000000000000000000000000042",
+                                         "18446744073709551615",
+                                         "18446744073709551616",
+                                         "28446744073709551615",
+                                         "99999999999999999999",
+                                         "100000000000000000000",
+                                         "-128",
+                                         "-129",
+                                         "2147483648",
+                                         "12345678 "};
+    for (const auto& text : edges) {
+        check_against_std<int8_t>(text);
+        check_against_std<int32_t>(text);
+        check_against_std<uint32_t>(text);
+        check_against_std<int64_t>(text);
+        check_against_std<uint64_t>(text);
+    }
+    std::mt19937_64 generator{42};
+    for (int i{0}; i < 20'000; ++i) {
+        std::string text{generator() % 4 == 0 ? "-" : ""};
+        text += random_digits(generator, generator() % 24);
+        if (generator() % 2 == 0) {
+            text += static_cast<char>(' ' + generator() % 90);
+        }
+        check_against_std<int16_t>(text);
+        check_against_std<uint16_t>(text);
+        check_against_std<int64_t>(text);
+        check_against_std<uint64_t>(text);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(float_test) {
+    double value{0};
+    BOOST_TEST((shiv::from_chars("1.5e3,", value) == shiv::FromCharsResult{5, std::errc{}}));
+    BOOST_TEST(value == 1500.0);
+    BOOST_TEST((shiv::from_chars("2e", value) == shiv::FromCharsResult{1, std::errc{}}));
+    BOOST_TEST((shiv::from_chars("1e400", value) ==
+                shiv::FromCharsResult{5, std::errc::result_out_of_range}));
+    BOOST_TEST(value == 2.0);
+
+    const std::vector<std::string> edges{"",
+                                         "-",
+                                         ".",
+                                         "-.5",
+                                         "5.",
+                                         ".e1",
+                                         "1e+",
+                                         "1e-5x",
+                                         "1E+308",
+                                         "inf",
+                                         "-Infinity",
+                                         "infinit",
+                                         "nan",
+                                         "-NaN(123abc)",
+                                         "nan(",
+                                         "0.0000000000000000000000000000000000001",
+                                         "1.7976931348623157e308",
+                                         "1.7976931348623159e308",
+                                         "2.2250738585072011e-308",
+                                         "2.2250738585072014e-308",
+                                         "4.9406564584124654e-324",
+                                         "2.4703282292062328e-324",
+                                         "2.4703282292062327e-324",
+                                         "1e-400",
+                                         "9007199254740993",
+                                         "9007199254740995",
+                                         "123456789012345678901234567890",
+                                         "0.10000000000000000555111512312578"
+                                         "27021181583404541015625",
+                                         "3.4028235e38",
+                                         "3.4028236e38",
+                                         "1.4e-45",
+                                         "7e-46",
+                                         "0e999999999999"};
+    for (const auto& text : edges) {
+        check_against_std<double>(text);
+        check_against_std<float>(text);
+    }
+
+    // random decimal text over the whole range, and the shortest and 17 digit text of random
+    // doubles, the forms other programs write
+    std::mt19937_64 generator{7};
+    for (int i{0}; i < 50'000; ++i) {
+        std::string text{generator() % 2 == 0 ? "-" : ""};
+        const std::string digits{random_digits(generator, 1 + generator() % 22)};
+        const size_t point{generator() % (digits.size() + 1)};
+        text += digits.substr(0, point) + "." + digits.substr(point);
+        if (generator() % 2 == 0) {
+            text += "e" + std::to_string(static_cast<int>(generator() % 700) - 350);
+        }
+        check_against_std<double>(text);
+        check_against_std<float>(text);
+
+        const double random{std::bit_cast<double>(generator())};
+        char buffer[64];
+        const auto shortest{std::to_chars(buffer, buffer + sizeof(buffer), random)};
+        check_against_std<double>(std::string{buffer, shortest.ptr});
+        const int length{std::snprintf(buffer, sizeof(buffer), "%.17g", random)};
+        check_against_std<double>(std::string{buffer, static_cast<size_t>(length)});
+        const float random_float{std::bit_cast<float>(static_cast<uint32_t>(generator()))};
+        const auto shortest_float{std::to_chars(buffer, buffer + sizeof(buffer), random_float)};
+        check_against_std<float>(std::string{buffer, shortest_float.ptr});
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fixed_test) {
+    static_assert(parse_fixed<int64_t>("123.45", 4) == 1234500);
+    static_assert(parse_fixed<int32_t>("-0.01", 2) == -1);
+
+    int64_t price{0};
+    BOOST_TEST((shiv::from_chars_fixed("123.45|", price, 2) == shiv::FromCharsResult{6, {}}));
+    BOOST_TEST(price == 12345);
+    BOOST_TEST((shiv::from_chars_fixed("123.4500", price, 2) == shiv::FromCharsResult{8, {}}));
+    BOOST_TEST(price == 12345);
+    BOOST_TEST((shiv::from_chars_fixed("7", price, 3) == shiv::FromCharsResult{1, {}}));
+    BOOST_TEST(price == 7000);
+    BOOST_TEST((shiv::from_chars_fixed(".5", price, 1) == shiv::FromCharsResult{2, {}}));
+    BOOST_TEST(price == 5);
+    BOOST_TEST((shiv::from_chars_fixed("5.", price, 1) == shiv::FromCharsResult{2, {}}));
+    BOOST_TEST(price == 50);
+    BOOST_TEST((shiv::from_chars_fixed("0.12345678", price, 8) == shiv::FromCharsResult{10, {}}));
+    BOOST_TEST(price == 12345678);
+    BOOST_TEST((shiv::from_chars_fixed("123.456", price, 2) ==
+                shiv::FromCharsResult{7, std::errc::result_out_of_range}));
+    BOOST_TEST(price == 12345678);
+    BOOST_TEST((shiv::from_chars_fixed(".", price, 2) ==
+                shiv::FromCharsResult{0, std::errc::invalid_argument}));
+    BOOST_TEST((shiv::from_chars_fixed("-", price, 2) ==
+                shiv::FromCharsResult{0, std::errc::invalid_argument}));
+    BOOST_TEST((shiv::from_chars_fixed("92233720368547758.08", price, 2) ==
+                shiv::FromCharsResult{20, std::errc::result_out_of_range}));
+    BOOST_TEST(static_cast<bool>(shiv::from_chars_fixed("-92233720368547758.08", price, 2)));
+    BOOST_TEST(price == INT64_MIN);
+    int32_t small{0};
+    BOOST_TEST((shiv::from_chars_fixed("300000.0", small, 4).error ==
+                std::errc::result_out_of_range));
+    uint32_t unsigned_price{0};
+    BOOST_TEST((shiv::from_chars_fixed("-1.0", unsigned_price, 1).error ==
+                std::errc::invalid_argument));
+
+    // every price printed with its decimals, and with zeros past them, parses back exactly
+    std::mt19937_64 generator{3};
+    for (int i{0}; i < 20'000; ++i) {
+        const unsigned decimals{static_cast<unsigned>(generator() % 9)};
+        const auto units{static_cast<int64_t>(generator() >> (generator() % 64)) *
+                         (generator() % 2 == 0 ? 1 : -1)};
+        const uint64_t scale{shiv::detail::powers_of_ten[decimals]};
+        const uint64_t magnitude{units < 0 ? 0 - static_cast<uint64_t>(units)
+                                           : static_cast<uint64_t>(units)};
+        std::string text{(units < 0 ? "-" : "") + std::to_string(magnitude / scale)};
+        if (decimals > 0) {
+            std::string fraction{std::to_string(magnitude % scale)};
+            fraction.insert(0, decimals - fraction.size(), '0');
+            text += "." + fraction + std::string(generator() % 3, '0');
+        }
+        int64_t parsed{0};
+        BOOST_TEST_CONTEXT("text \"" << text << "\" decimals " << decimals) {
+            const shiv::FromCharsResult result{shiv::from_chars_fixed(text, parsed, decimals)};
+            BOOST_TEST((result == shiv::FromCharsResult{text.size(), {}}));
+            BOOST_TEST(parsed == units);
+        }
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
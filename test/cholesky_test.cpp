@@ -0,0 +1,127 @@
+#include <ShivLib/dataStructures/cholesky.hpp>
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/matrix_view.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <stdexcept>
+
+namespace {
+// B * B^T plus the size on the diagonal is comfortably positive definite
+shiv::DynMatrix<double> random_spd(size_t size, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    shiv::DynMatrix<double> root{size, size};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < size; ++j) {
+            root[i][j] = distribution(generator);
+        }
+    }
+    auto matrix{root * root.get_transpose()};
+    for (size_t i{0}; i < size; ++i) {
+        matrix[i][i] += static_cast<double>(size);
+    }
+    return matrix;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(cholesky_test)
+BOOST_AUTO_TEST_CASE(factor_test, *boost::unit_test::tolerance(1e-12)) {
+    const shiv::Matrix<double, 3, 3> matrix{{{{4, 12, -16}, {12, 37, -43}, {-16, -43, 98}}}};
+    const shiv::Cholesky cholesky{matrix};
+    BOOST_TEST(cholesky.is_positive_definite());
+    const auto& packed{cholesky.packed()};
+    const shiv::Matrix<double, 3, 3> expected{{{{2, 6, -8}, {6, 1, 5}, {-8, 5, 3}}}};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            BOOST_TEST(packed[i][j] == expected[i][j]);
+        }
+    }
+    BOOST_TEST(cholesky.determinant() == 36.0);
+
+    const shiv::Matrix<double, 3, 2> rhs{{{{-8, 1}, {-6, 0}, {39, 2}}}};
+    const auto solution{cholesky.solve(rhs)};
+    const auto check{matrix * solution};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 2; ++j) {
+            BOOST_TEST(check[i][j] == rhs[i][j]);
+        }
+    }
+    const auto identity{matrix * cholesky.inverse()};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            BOOST_TEST(identity[i][j] == (i == j ? 1.0 : 0.0));
+        }
+    }
+
+    // only the lower triangle is read
+    auto lower_only{matrix};
+    lower_only[0][2] = 1e9;
+    BOOST_TEST((shiv::Cholesky{lower_only}.packed() == cholesky.packed()));
+}
+
+BOOST_AUTO_TEST_CASE(not_positive_definite_test) {
+    const shiv::Matrix<double, 2, 2> indefinite{{{{1, 2}, {2, 1}}}};
+    const shiv::Cholesky cholesky{indefinite};
+    BOOST_TEST(!cholesky.is_positive_definite());
+    BOOST_CHECK_THROW((void)cholesky.inverse(), std::domain_error);
+    BOOST_CHECK_THROW((shiv::Cholesky{shiv::DynMatrix<double>{2, 3}}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_test, *boost::unit_test::tolerance(1e-9)) {
+    // several panels and more than one block of trailing columns
+    constexpr size_t size{300};
+    const auto matrix{random_spd(size, 3)};
+    const shiv::Cholesky cholesky{matrix};
+    BOOST_TEST(cholesky.is_positive_definite());
+    BOOST_TEST(cholesky.size() == size);
+
+    std::mt19937 generator{11};
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    shiv::DynMatrix<double> expected{size, 70};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < 70; ++j) {
+            expected[i][j] = distribution(generator);
+        }
+    }
+    const auto solution{cholesky.solve(matrix * expected)};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < 70; ++j) {
+            BOOST_TEST(solution[i][j] == expected[i][j]);
+        }
+    }
+    // L * L^T rebuilt from the lower triangle matches A
+    shiv::DynMatrix<double> lower{size, size};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j <= i; ++j) {
+            lower[i][j] = cholesky.packed()[i][j];
+        }
+    }
+    const auto rebuilt{lower * lower.get_transpose()};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < size; ++j) {
+            BOOST_TEST(rebuilt[i][j] == matrix[i][j]);
+        }
+    }
+
+    // the same factorization in place in the top left of a bigger matrix
+    auto storage{random_spd(size + 5, 3)};
+    shiv::MatrixView<double> view{storage};
+    const auto block{view.submatrix(0, 0, size, size)};
+    const auto original{block.to_dyn_matrix()};
+    const double corner{storage[size][size]};
+    const shiv::Cholesky in_place{block};
+    BOOST_TEST(in_place.is_positive_definite());
+    BOOST_TEST(storage[size][size] == corner);
+    BOOST_TEST(storage[size - 1][size - 1] != original[size - 1][size - 1]);
+    auto rhs{original * expected};
+    in_place.solve_in_place(rhs);
+    BOOST_TEST(rhs[7][9] == expected[7][9]);
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    constexpr shiv::Matrix<double, 2, 2> matrix{{{{4, 2}, {2, 5}}}};
+    static_assert(shiv::Cholesky{matrix}.packed()[1][0] == 1.0);
+    static_assert(shiv::Cholesky{matrix}.solve(shiv::Matrix<double, 2, 1>{{{{6}, {7}}}}) ==
+                  shiv::Matrix<double, 2, 1>{{{{1}, {1}}}});
+}
+BOOST_AUTO_TEST_SUITE_END()
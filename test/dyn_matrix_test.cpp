@@ -0,0 +1,113 @@
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <utility>
+
+BOOST_AUTO_TEST_SUITE(dyn_matrix_test)
+BOOST_AUTO_TEST_CASE(layout_test) {
+    shiv::DynMatrix<float> matrix{3, 5};
+    BOOST_TEST(matrix.rows() == 3U);
+    BOOST_TEST(matrix.cols() == 5U);
+    BOOST_TEST(matrix.stride() == 16U);
+    BOOST_TEST(matrix.size() == 15U);
+    for (size_t i{0}; i < matrix.rows(); ++i) {
+        BOOST_TEST(reinterpret_cast<uintptr_t>(matrix[i]) % 64 == 0U);
+    }
+    BOOST_TEST(matrix.at(2, 4) == 0.0F);
+    BOOST_CHECK_THROW((void)matrix.at(3, 0), std::out_of_range);
+    BOOST_TEST(shiv::DynMatrix<int>{}.empty());
+}
+
+BOOST_AUTO_TEST_CASE(construct_test) {
+    const shiv::Matrix<int, 2, 3> fixed{{{{1, 2, 3}, {4, 5, 6}}}};
+    const shiv::DynMatrix<int> from_fixed{fixed};
+    const shiv::DynMatrix<int> from_list{{1, 2, 3}, {4, 5, 6}};
+    BOOST_TEST((from_fixed == from_list));
+    BOOST_TEST((from_list != shiv::DynMatrix<int>(2, 3, 7)));
+    BOOST_CHECK_THROW((shiv::DynMatrix<int>{{1, 2}, {3}}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(move_test) {
+    shiv::DynMatrix<double> matrix{{1, 2}, {3, 4}};
+    const double* buffer{matrix.data()};
+    shiv::DynMatrix<double> moved{std::move(matrix)};
+    BOOST_TEST(moved.data() == buffer);
+    BOOST_TEST(matrix.empty());
+    shiv::DynMatrix<double> assigned{};
+    assigned = std::move(moved);
+    BOOST_TEST(assigned.data() == buffer);
+    BOOST_TEST(assigned[1][0] == 3.0);
+
+    const shiv::DynMatrix<double> copy{assigned};
+    BOOST_TEST(copy.data() != buffer);
+    BOOST_TEST((copy == assigned));
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic_test) {
+    const shiv::DynMatrix<float> lhs{{0, 1, 2}, {3, 4, 5}};
+    const shiv::DynMatrix<float> rhs{{1, 1, 1}, {2, 2, 2}};
+    BOOST_TEST((lhs + rhs == shiv::DynMatrix<float>{{1, 2, 3}, {5, 6, 7}}));
+    BOOST_TEST((lhs - rhs == shiv::DynMatrix<float>{{-1, 0, 1}, {1, 2, 3}}));
+    BOOST_TEST((lhs * 2 == shiv::DynMatrix<float>{{0, 2, 4}, {6, 8, 10}}));
+    BOOST_TEST((lhs + 1 == shiv::DynMatrix<float>{{1, 2, 3}, {4, 5, 6}}));
+    BOOST_TEST((-lhs == shiv::DynMatrix<float>{{0, -1, -2}, {-3, -4, -5}}));
+    BOOST_CHECK_THROW((void)(lhs + shiv::DynMatrix<float>(3, 2)), std::invalid_argument);
+
+    shiv::DynMatrix<float> accumulated{lhs};
+    accumulated += rhs;
+    accumulated -= 1;
+    accumulated /= 2;
+    BOOST_TEST((accumulated == shiv::DynMatrix<float>{{0, 0.5, 1}, {2, 2.5, 3}}));
+}
+
+BOOST_AUTO_TEST_CASE(multiply_test) {
+    const shiv::DynMatrix<double> lhs{{1, 2, 3}, {4, 5, 6}};
+    const shiv::DynMatrix<double> rhs{{7, 8}, {9, 10}, {11, 12}};
+    BOOST_TEST((lhs * rhs == shiv::DynMatrix<double>{{58, 64}, {139, 154}}));
+    const shiv::DynMatrix<int> lhs_int{{1, 2, 3}, {4, 5, 6}};
+    const shiv::DynMatrix<int> rhs_int{{7, 8}, {9, 10}, {11, 12}};
+    BOOST_TEST((lhs_int * rhs_int == shiv::DynMatrix<int>{{58, 64}, {139, 154}}));
+    BOOST_CHECK_THROW((void)(lhs * lhs), std::invalid_argument);
+
+    // large enough to cross the kernel's cache blocks, checked against Matrix
+    auto fixed_lhs{std::make_unique<shiv::Matrix<double, 70, 300>>()};
+    auto fixed_rhs{std::make_unique<shiv::Matrix<double, 300, 50>>()};
+    for (size_t i{0}; i < fixed_lhs->size(); ++i) {
+        fixed_lhs->begin()[i] = static_cast<double>(i % 17) - 8;
+    }
+    for (size_t i{0}; i < fixed_rhs->size(); ++i) {
+        fixed_rhs->begin()[i] = static_cast<double>(i % 13) - 6;
+    }
+    const auto fixed_product{*fixed_lhs * *fixed_rhs};
+    const shiv::DynMatrix<double> product{shiv::DynMatrix<double>{*fixed_lhs} *
+                                          shiv::DynMatrix<double>{*fixed_rhs}};
+    BOOST_TEST((product == shiv::DynMatrix<double>{fixed_product}));
+}
+
+BOOST_AUTO_TEST_CASE(transpose_test) {
+    const shiv::DynMatrix<int> matrix{{1, 2, 3}, {4, 5, 6}};
+    BOOST_TEST((matrix.get_transpose() == shiv::DynMatrix<int>{{1, 4}, {2, 5}, {3, 6}}));
+}
+
+BOOST_AUTO_TEST_CASE(determinant_test, *boost::unit_test::tolerance(0.01)) {
+    const shiv::DynMatrix<double> matrix4x4{{0.0, 8.0, 2.0, 3.0},
+                                            {4.0, 5.0, 12.0, 7.0},
+                                            {4.0, 9.0, 10.0, 11.0},
+                                            {12.0, 77.0, 14.0, 14.0}};
+    BOOST_TEST(matrix4x4.get_determinant() == -5904);
+    BOOST_TEST((shiv::DynMatrix<float>{{0, 1}, {3, 4}}.get_determinant()) == -3);
+    BOOST_CHECK_THROW((void)shiv::DynMatrix<float>(2, 3).get_determinant(), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(inverse_test, *boost::unit_test::tolerance(0.0001)) {
+    const shiv::DynMatrix<double> matrix{{3, 7, 8}, {5, 1, 5}, {7, 2, 5}};
+    const auto product{matrix * matrix.get_inverse()};
+    const auto identity{shiv::DynMatrix<double>::identity(3)};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            BOOST_TEST(product[i][j] == identity[i][j]);
+        }
+    }
+    BOOST_TEST(shiv::DynMatrix<int>::identity(2).is_orthogonal());
+}
+BOOST_AUTO_TEST_SUITE_END()
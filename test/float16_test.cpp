@@ -0,0 +1,157 @@
+#include <ShivLib/dataStructures/array.hpp>
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/float16.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(float16_test)
+BOOST_AUTO_TEST_CASE(conversion_test) {
+    static_assert(shiv::FloatingPoint<shiv::float16>);
+    static_assert(shiv::Arithmetic<const shiv::bfloat16>);
+    static_assert(sizeof(shiv::float16) == 2 && std::is_trivially_copyable_v<shiv::float16>);
+    // the software rounding is what runs at compile time
+    static_assert(shiv::float16{1.0F}.bits() == 0x3C00);
+    static_assert(shiv::float16{65504.0F}.bits() == 0x7BFF);
+    static_assert(shiv::float16{65520.0F}.bits() == 0x7C00);
+    static_assert(shiv::float16{0x1p-24F}.bits() == 0x0001);
+    static_assert(shiv::float16{0x1p-25F}.bits() == 0x0000);
+    static_assert(shiv::float16{1.0F + 0x1p-11F}.bits() == 0x3C00);
+    static_assert(shiv::float16{1.0F + 0x3p-11F}.bits() == 0x3C02);
+    static_assert(static_cast<float>(shiv::float16::from_bits(0x0001)) == 0x1p-24F);
+    static_assert(shiv::bfloat16{1.0F + 0x1p-8F}.bits() == 0x3F80);
+    static_assert(shiv::bfloat16{1.0F + 0x3p-8F}.bits() == 0x3F82);
+    static_assert(shiv::float16{1.5} + shiv::float16{2} == shiv::float16{3.5F});
+    static_assert(-shiv::bfloat16{2} < shiv::bfloat16{1});
+    // doubles just past a tie would round to the tie as floats first, they round up directly
+    static_assert(shiv::float16{1.0 + 0x1p-11 + 0x1p-40}.bits() == 0x3C01);
+    static_assert(shiv::float16{-1.0 - 0x1p-11 - 0x1p-40}.bits() == 0xBC01);
+    static_assert(shiv::float16{1.0 + 0x1p-11}.bits() == 0x3C00);
+    static_assert(shiv::bfloat16{1.0 + 0x1p-8 + 0x1p-40}.bits() == 0x3F81);
+    static_assert(shiv::float16{65519.999}.bits() == 0x7BFF);
+    static_assert(shiv::float16{1e300}.bits() == 0x7C00);
+
+    // every half round trips through float, and the run time rounding matches compile time
+    for (uint32_t bits{0}; bits <= 0xFFFF; ++bits) {
+        const auto half{shiv::float16::from_bits(static_cast<uint16_t>(bits))};
+        const auto value{static_cast<float>(half)};
+        if (std::isnan(value)) {
+            BOOST_TEST(std::isnan(static_cast<float>(shiv::float16{value})));
+            continue;
+        }
+        BOOST_TEST(shiv::float16{value}.bits() == bits);
+        BOOST_TEST(shiv::detail::half_to_float(static_cast<uint16_t>(bits)) == value);
+    }
+    std::mt19937 generator{5};
+    std::uniform_int_distribution<uint32_t> any_bits{};
+    for (size_t i{0}; i < 100000; ++i) {
+        const auto value{std::bit_cast<float>(any_bits(generator))};
+        const auto rounded{shiv::float16{value}};
+        const auto nearest{static_cast<float>(rounded)};
+        if (std::isnan(value) || std::abs(value) >= 65520.0F) {
+            continue;
+        }
+        // nothing representable lies nearer than the neighbours either side
+        const auto below{static_cast<float>(shiv::float16::from_bits(
+            static_cast<uint16_t>(rounded.bits() - ((rounded.bits() & 0x7FFF) != 0 ? 1 : 0))))};
+        BOOST_TEST(std::abs(nearest - value) <= std::abs(below - value));
+        BOOST_TEST(std::abs(nearest - value) <= std::ldexp(std::abs(value), -11) + 0x1p-25F);
+    }
+    // random doubles round to the same half at run time, through F16C when it is there
+    std::uniform_real_distribution<double> doubles{-70000, 70000};
+    for (size_t i{0}; i < 100000; ++i) {
+        const double value{doubles(generator)};
+        const auto rounded{shiv::float16{value}};
+        if (std::abs(value) >= 65520.0) {
+            BOOST_TEST(std::isinf(static_cast<float>(rounded)));
+            continue;
+        }
+        const auto below{shiv::float16::from_bits(static_cast<uint16_t>(rounded.bits() - 1))};
+        const auto above{shiv::float16::from_bits(static_cast<uint16_t>(rounded.bits() + 1))};
+        const double error{std::abs(static_cast<double>(rounded) - value)};
+        BOOST_TEST(error <= std::abs(static_cast<double>(below) - value));
+        BOOST_TEST(error <= std::abs(static_cast<double>(above) - value));
+    }
+    BOOST_TEST(std::isinf(static_cast<float>(shiv::float16{1e6})));
+    BOOST_TEST(std::isnan(static_cast<float>(shiv::bfloat16{std::nanf("")})));
+    BOOST_TEST((shiv::float16{-0.0F} == shiv::float16{0.0F}));
+}
+
+BOOST_AUTO_TEST_CASE(bulk_test) {
+    std::vector<float> source(1003);
+    std::mt19937 generator{9};
+    std::uniform_real_distribution<float> distribution{-100, 100};
+    for (auto& value : source) {
+        value = distribution(generator);
+    }
+    source[3] = std::numeric_limits<float>::infinity();
+    source[40] = 0x1p-130F;
+    std::vector<shiv::float16> half(source.size());
+    std::vector<shiv::bfloat16> brain(source.size());
+    shiv::convert(source.data(), half.data(), source.size());
+    shiv::convert(source.data(), brain.data(), source.size());
+    std::vector<float> back(source.size());
+    std::vector<float> brain_back(source.size());
+    shiv::convert(half.data(), back.data(), source.size());
+    shiv::convert(brain.data(), brain_back.data(), source.size());
+    for (size_t i{0}; i < source.size(); ++i) {
+        BOOST_TEST(half[i].bits() == shiv::float16{source[i]}.bits());
+        BOOST_TEST(brain[i].bits() == shiv::bfloat16{source[i]}.bits());
+        BOOST_TEST(back[i] == static_cast<float>(half[i]));
+        BOOST_TEST(brain_back[i] == static_cast<float>(brain[i]));
+    }
+
+    // the sum is kept in float, so it is far closer than adding in float16 would be
+    std::vector<float> weights(source.size(), 0.25F);
+    source[3] = 1;
+    shiv::convert(source.data(), half.data(), source.size());
+    double expected{0};
+    shiv::float16 naive{};
+    for (size_t i{0}; i < source.size(); ++i) {
+        expected += static_cast<double>(half[i]) * 0.25;
+        naive += half[i] * shiv::float16{0.25F};
+    }
+    const float sum{shiv::dot(half.data(), weights.data(), half.size())};
+    BOOST_TEST(std::abs(sum - expected) < 1e-3);
+    BOOST_TEST(std::abs(sum - expected) < std::abs(static_cast<double>(naive) - expected));
+    BOOST_TEST(shiv::dot(weights.data(), half.data(), half.size()) == sum);
+}
+
+BOOST_AUTO_TEST_CASE(matrix_test) {
+    shiv::Array<shiv::float16, 8> array{1, 2, 3, 4, 5, 6, 7, 8};
+    BOOST_TEST(sizeof(array) == 16U);
+    BOOST_TEST(static_cast<float>(array[6]) == 7.0F);
+
+    constexpr shiv::Matrix<shiv::float16, 2, 2> small{{{{1, 2}, {3, 4}}}};
+    static_assert((small * small)[1][1] == shiv::float16{22});
+    BOOST_TEST(static_cast<float>(small.get_determinant()) == -2.0F);
+    BOOST_TEST(static_cast<float>(small.get_inverse()[1][0]) == 1.5F);
+
+    // big enough for the blocked kernel, the sums are exact in float so each element of the
+    // product is rounded once
+    constexpr size_t n{70};
+    shiv::DynMatrix<shiv::bfloat16> a{n, 300};
+    shiv::DynMatrix<shiv::bfloat16> b{300, n};
+    for (size_t i{0}; i < n; ++i) {
+        for (size_t k{0}; k < 300; ++k) {
+            a[i][k] = static_cast<float>((i + k) % 7) - 3;
+            b[k][i] = static_cast<float>((i * k) % 5) - 2;
+        }
+    }
+    const auto expected{a.cast<float>() * b.cast<float>()};
+    BOOST_TEST(((a * b) == expected.cast<shiv::bfloat16>()));
+    BOOST_TEST((a.cast<float>().cast<shiv::bfloat16>() == a));
+
+    // A * A^T with the transpose read through strides and a beta, in float16
+    const auto half_a{a.cast<float>().cast<shiv::float16>()};
+    shiv::DynMatrix<shiv::float16> c{n, n, shiv::float16{1}};
+    const auto stride{static_cast<ptrdiff_t>(half_a.stride())};
+    shiv::gemm(n, n, 300, shiv::float16{2}, half_a[0], stride, 1, half_a[0], 1, stride,
+               shiv::float16{-1}, c[0], static_cast<ptrdiff_t>(c.stride()), 1);
+    const auto wide{half_a.cast<float>()};
+    const auto gram{(wide * wide.get_transpose()) * 2.0F - 1.0F};
+    BOOST_TEST((c == gram.cast<shiv::float16>()));
+}
+BOOST_AUTO_TEST_SUITE_END()
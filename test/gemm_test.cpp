@@ -0,0 +1,246 @@
+#include <ShivLib/dataStructures/gemm.hpp>
+#include <ShivLib/dataStructures/matrix.hpp>
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+template <typename T>
+std::vector<T> random_values(size_t count, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<T> distribution{-1, 1};
+    std::vector<T> values(count);
+    for (auto&& value : values) {
+        value = distribution(generator);
+    }
+    return values;
+}
+
+// plain triple loop over row major storage, the reference every shape is checked against
+template <typename T>
+std::vector<T> reference_product(size_t m, size_t n, size_t k, const std::vector<T>& a,
+                                 const std::vector<T>& b) {
+    std::vector<T> c(m * n);
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            double sum{0};
+            for (size_t p{0}; p < k; ++p) {
+                sum += static_cast<double>(a[i * k + p]) * static_cast<double>(b[p * n + j]);
+            }
+            c[i * n + j] = static_cast<T>(sum);
+        }
+    }
+    return c;
+}
+
+template <typename T>
+T max_error(const std::vector<T>& lhs, const std::vector<T>& rhs) {
+    T error{0};
+    for (size_t i{0}; i < lhs.size(); ++i) {
+        error = std::max(error, std::abs(lhs[i] - rhs[i]));
+    }
+    return error;
+}
+
+template <typename T>
+void check_shapes(T tolerance) {
+    // sizes either side of the register tile and cache block edges
+    const size_t sizes[][3]{{1, 1, 1},   {3, 5, 7},     {13, 33, 17},  {64, 64, 64},
+                            {97, 45, 300}, {200, 130, 530}, {300, 4200, 9}};
+    for (auto&& [m, n, k] : sizes) {
+        const auto a{random_values<T>(m * k, 1)};
+        const auto b{random_values<T>(k * n, 2)};
+        std::vector<T> c(m * n, T{0});
+        shiv::gemm<T>(m, n, k, 1, a.data(), k, 1, b.data(), n, 1, 0, c.data(), n, 1);
+        BOOST_TEST(max_error(c, reference_product(m, n, k, a, b)) < tolerance);
+    }
+}
+// every value of A and B, including -128 and 255, with the exact int32 reference
+template <typename A, typename B>
+void check_int8(size_t m, size_t n, size_t k, int32_t beta) {
+    std::mt19937 generator{static_cast<unsigned>(m * n + k)};
+    std::uniform_int_distribution<int> any_byte{0, 255};
+    std::vector<A> a(m * k);
+    std::vector<B> b(k * n);
+    for (auto&& value : a) {
+        value = static_cast<A>(any_byte(generator));
+    }
+    for (auto&& value : b) {
+        value = static_cast<B>(any_byte(generator));
+    }
+    a[0] = std::is_signed_v<A> ? -128 : 255;
+    std::vector<int32_t> c(m * n, 3);
+    std::vector<int32_t> expected(m * n);
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            int32_t sum{beta * 3};
+            for (size_t p{0}; p < k; ++p) {
+                sum += int32_t{a[i * k + p]} * int32_t{b[p * n + j]};
+            }
+            expected[i * n + j] = sum;
+        }
+    }
+    shiv::gemm(m, n, k, a.data(), static_cast<ptrdiff_t>(k), 1, b.data(),
+               static_cast<ptrdiff_t>(n), 1, beta, c.data(), static_cast<ptrdiff_t>(n), 1);
+    BOOST_TEST((c == expected));
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(gemm_test)
+BOOST_AUTO_TEST_CASE(shape_test) {
+    check_shapes<float>(1e-3F);
+    check_shapes<double>(1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(alpha_beta_test) {
+    constexpr size_t m{20};
+    constexpr size_t n{37};
+    constexpr size_t k{15};
+    const auto a{random_values<double>(m * k, 3)};
+    const auto b{random_values<double>(k * n, 4)};
+    auto c{random_values<double>(m * n, 5)};
+    auto expected{reference_product(m, n, k, a, b)};
+    for (size_t i{0}; i < m * n; ++i) {
+        expected[i] = 2.0 * expected[i] + 0.5 * c[i];
+    }
+    shiv::gemm<double>(m, n, k, 2.0, a.data(), k, 1, b.data(), n, 1, 0.5, c.data(), n, 1);
+    BOOST_TEST(max_error(c, expected) < 1e-12);
+
+    // k of zero only scales C
+    shiv::gemm<double>(m, n, 0, 1.0, a.data(), 0, 1, b.data(), n, 1, 0.0, c.data(), n, 1);
+    BOOST_TEST(max_error(c, std::vector<double>(m * n, 0.0)) == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(stride_test) {
+    constexpr size_t m{19};
+    constexpr size_t n{23};
+    constexpr size_t k{29};
+    const auto a{random_values<double>(m * k, 6)};
+    const auto b{random_values<double>(k * n, 7)};
+    const auto expected{reference_product(m, n, k, a, b)};
+
+    // A stored column major, B stored transposed and C written column major
+    std::vector<double> a_column_major(m * k);
+    std::vector<double> b_transposed(k * n);
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t p{0}; p < k; ++p) {
+            a_column_major[p * m + i] = a[i * k + p];
+        }
+    }
+    for (size_t p{0}; p < k; ++p) {
+        for (size_t j{0}; j < n; ++j) {
+            b_transposed[j * k + p] = b[p * n + j];
+        }
+    }
+    std::vector<double> c_column_major(m * n);
+    shiv::gemm<double>(m, n, k, 1.0, a_column_major.data(), 1, m, b_transposed.data(), 1, k, 0.0,
+                       c_column_major.data(), 1, m);
+    std::vector<double> c(m * n);
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            c[i * n + j] = c_column_major[j * m + i];
+        }
+    }
+    BOOST_TEST(max_error(c, expected) < 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(matrix_product_test) {
+    // non square shapes, big enough to take the blocked path
+    auto lhs{std::make_unique<shiv::Matrix<double, 24, 40>>()};
+    auto rhs{std::make_unique<shiv::Matrix<double, 40, 17>>()};
+    const auto a{random_values<double>(24 * 40, 8)};
+    const auto b{random_values<double>(40 * 17, 9)};
+    std::copy(a.begin(), a.end(), &(*lhs)[0][0]);
+    std::copy(b.begin(), b.end(), &(*rhs)[0][0]);
+    const shiv::Matrix<double, 24, 17> product{*lhs * *rhs};
+    const auto expected{reference_product<double>(24, 17, 40, a, b)};
+    BOOST_TEST(max_error(std::vector<double>(&product[0][0], &product[0][0] + 24 * 17),
+                         expected) < 1e-12);
+
+    // and at compile time through the scalar loop
+    constexpr shiv::Matrix<int, 2, 3> small_lhs{{{{1, 2, 3}, {4, 5, 6}}}};
+    constexpr shiv::Matrix<int, 3, 1> small_rhs{{{{1}, {0}, {2}}}};
+    constexpr shiv::Matrix<int, 2, 1> small_product{small_lhs * small_rhs};
+    static_assert(small_product[0][0] == 7 && small_product[1][0] == 16);
+}
+BOOST_AUTO_TEST_CASE(threaded_test) {
+    // more threads than macro tiles in one direction and odd edges in the other
+    shiv::set_matrix_threads(5);
+    BOOST_TEST(shiv::matrix_threads() == 5U);
+    const size_t sizes[][3]{{130, 1000, 140}, {517, 263, 300}, {1100, 129, 150}};
+    for (auto&& [m, n, k] : sizes) {
+        const auto a{random_values<double>(m * k, 3)};
+        const auto b{random_values<double>(k * n, 4)};
+        std::vector<double> c(m * n, 1.0);
+        shiv::gemm<double>(m, n, k, 1, a.data(), k, 1, b.data(), n, 1, 0, c.data(), n, 1);
+        BOOST_TEST(max_error(c, reference_product(m, n, k, a, b)) < 1e-10);
+    }
+
+    // the pool can be replaced while products run on other threads
+    const auto a{random_values<double>(200 * 200, 5)};
+    const auto b{random_values<double>(200 * 200, 6)};
+    const auto expected{reference_product(200, 200, 200, a, b)};
+    std::atomic<bool> correct{true};
+    std::vector<std::thread> callers{};
+    for (size_t caller{0}; caller < 2; ++caller) {
+        callers.emplace_back([&] {
+            std::vector<double> c(200 * 200);
+            for (size_t i{0}; i < 4; ++i) {
+                shiv::gemm<double>(200, 200, 200, 1, a.data(), 200, 1, b.data(), 200, 1, 0,
+                                   c.data(), 200, 1);
+                correct = correct && max_error(c, expected) < 1e-10;
+            }
+        });
+    }
+    for (size_t threads : {2, 4, 3, 1, 5}) {
+        shiv::set_matrix_threads(threads);
+    }
+    for (auto&& caller : callers) {
+        caller.join();
+    }
+    BOOST_TEST(correct.load());
+    shiv::set_matrix_threads(0);
+}
+BOOST_AUTO_TEST_CASE(int8_test) {
+    // k off the group size and across a cache block, n across a register tile
+    const size_t sizes[][3]{{1, 1, 1}, {15, 33, 7}, {40, 70, 513}, {3, 5, 1030}};
+    for (auto&& [m, n, k] : sizes) {
+        check_int8<int8_t, int8_t>(m, n, k, 0);
+        check_int8<uint8_t, int8_t>(m, n, k, 1);
+        check_int8<int8_t, uint8_t>(m, n, k, 2);
+        check_int8<uint8_t, uint8_t>(m, n, k, -1);
+    }
+
+    // A read column major and C written transposed, over several threads
+    shiv::set_matrix_threads(3);
+    constexpr size_t m{150};
+    constexpr size_t n{140};
+    constexpr size_t k{130};
+    std::vector<int8_t> a(m * k);
+    std::vector<uint8_t> b(k * n);
+    for (size_t i{0}; i < a.size(); ++i) {
+        a[i] = static_cast<int8_t>(i * 7);
+    }
+    for (size_t i{0}; i < b.size(); ++i) {
+        b[i] = static_cast<uint8_t>(i * 13);
+    }
+    std::vector<int32_t> c(m * n);
+    shiv::gemm(m, n, k, a.data(), 1, m, b.data(), n, 1, 0, c.data(), 1, m);
+    for (size_t i{0}; i < m; i += 7) {
+        for (size_t j{0}; j < n; j += 5) {
+            int32_t sum{0};
+            for (size_t p{0}; p < k; ++p) {
+                sum += int32_t{a[p * m + i]} * int32_t{b[p * n + j]};
+            }
+            BOOST_TEST(c[j * m + i] == sum);
+        }
+    }
+    shiv::set_matrix_threads(0);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,183 @@
+#include <ShivLib/dataStructures/inline_string.hpp>
+#include <ShivLib/dataStructures/string.hpp>
+#include <ShivLib/hash.hpp>
+#include <algorithm>
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+constexpr std::array<size_t, 24> lengths{0,   1,   2,   3,   4,   7,    8,    9,
+                                         15,  16,  17,  47,  48,  49,   96,   255,
+                                         256, 257, 300, 1023, 1024, 1025, 1089, 2100};
+
+constexpr std::array<char, 2100> pattern() {
+    std::array<char, 2100> bytes{};
+    uint32_t state{12345};
+    for (auto& byte : bytes) {
+        state = state * 1664525 + 1013904223;
+        byte = static_cast<char>(state >> 24);
+    }
+    return bytes;
+}
+
+// every length hashed at compile time, through the scalar paths
+constexpr std::array<uint64_t, lengths.size()> compile_time_hashes() {
+    const auto bytes{pattern()};
+    std::array<uint64_t, lengths.size()> hashes{};
+    for (size_t i{0}; i < lengths.size(); ++i) {
+        hashes[i] = shiv::hash_bytes(bytes.data(), lengths[i], 7);
+    }
+    return hashes;
+}
+
+struct Packed {
+    uint32_t id;
+    uint32_t quantity;
+    uint64_t price;
+};
+enum class Side : uint8_t { buy, sell };
+
+std::vector<std::string> random_keys(size_t count, size_t size, std::mt19937_64& generator) {
+    std::vector<std::string> keys(count, std::string(size, '\0'));
+    for (auto& key : keys) {
+        for (auto& c : key) {
+            c = static_cast<char>(generator());
+        }
+    }
+    return keys;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(hash_test)
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    // the SIMD bulk path and the unaligned loads must match constant evaluation exactly
+    static constexpr auto expected{compile_time_hashes()};
+    const auto bytes{pattern()};
+    std::vector<char> copy(bytes.size() + 1);
+    for (size_t i{0}; i < lengths.size(); ++i) {
+        BOOST_TEST(shiv::hash_bytes(bytes.data(), lengths[i], 7) == expected[i]);
+        std::copy(bytes.begin(), bytes.end(), copy.begin() + 1);
+        BOOST_TEST(shiv::hash_bytes(copy.data() + 1, lengths[i], 7) == expected[i]);
+    }
+
+    static_assert(shiv::hash("VOD.L") != shiv::hash("VOD.M"));
+    constexpr uint64_t vod{shiv::hash("VOD.L")};
+    const std::string text{"VOD.L"};
+    BOOST_TEST(shiv::hash(text) == vod);
+    BOOST_TEST(shiv::hash(shiv::StringView<char>{text}) == vod);
+    BOOST_TEST(shiv::hash(std::string_view{text}) == vod);
+    BOOST_TEST(shiv::hash(shiv::String<char>{"VOD.L"}) == vod);
+    BOOST_TEST(shiv::hash(shiv::InlineString<8>{"VOD.L"}) == vod);
+    BOOST_TEST(shiv::hash(text, 1) != vod);
+}
+
+BOOST_AUTO_TEST_CASE(type_test) {
+    BOOST_TEST(shiv::hash(42) == shiv::hash(42));
+    BOOST_TEST(shiv::hash(42) != shiv::hash(43));
+    BOOST_TEST(shiv::hash(Side::buy) != shiv::hash(Side::sell));
+    BOOST_TEST(shiv::hash(Packed{1, 2, 3}) == shiv::hash(Packed{1, 2, 3}));
+    BOOST_TEST(shiv::hash(Packed{1, 2, 3}) != shiv::hash(Packed{2, 1, 3}));
+    static_assert(shiv::hash(uint64_t{99}) == shiv::hash(uint64_t{99}));
+
+    BOOST_TEST(shiv::hash(0.0) == shiv::hash(-0.0));
+    BOOST_TEST(shiv::hash(1.5) != shiv::hash(-1.5));
+    BOOST_TEST(shiv::hash(1.5F) != shiv::hash(2.5F));
+
+    using Ints = shiv::Array<int, 4>;
+    BOOST_TEST(shiv::hash(Ints{1, 2, 3, 4}) == shiv::hash(Ints{1, 2, 3, 4}));
+    BOOST_TEST(shiv::hash(Ints{1, 2, 3, 4}) != shiv::hash(Ints{1, 2, 4, 3}));
+    using Doubles = shiv::Array<double, 3>;
+    BOOST_TEST(shiv::hash(Doubles{1.0, 0.0, 2.0}) == shiv::hash(Doubles{1.0, -0.0, 2.0}));
+    BOOST_TEST(shiv::hash(Doubles{1.0, 0.0, 2.0}) != shiv::hash(Doubles{2.0, 0.0, 1.0}));
+
+    std::unordered_map<std::string, int, shiv::Hash<std::string>> positions{};
+    positions["VOD.L"] = 100;
+    positions["BARC.L"] = -50;
+    positions["VOD.L"] += 20;
+    BOOST_TEST(positions.at("VOD.L") == 120);
+    const shiv::Hash<std::string> seeded{shiv::random_seed()};
+    std::unordered_set<std::string, shiv::Hash<std::string>> seen{16, seeded};
+    seen.insert("VOD.L");
+    BOOST_TEST(seen.contains("VOD.L"));
+    BOOST_TEST(!seen.contains("BARC.L"));
+}
+
+BOOST_AUTO_TEST_CASE(avalanche_test) {
+    // SMHasher style: flipping any one input bit should flip each output bit half the time. The
+    // flip rates are totalled per output bit over every input bit of many random keys, the
+    // lengths cover each of the short, medium and bulk paths.
+    std::mt19937_64 generator{42};
+    for (const size_t size : {3, 4, 8, 12, 16, 24, 31, 64, 100, 255, 257, 700, 1100}) {
+        const size_t key_count{std::max<size_t>(8, 60'000 / (8 * size))};
+        std::array<size_t, 64> flips{};
+        size_t trials{0};
+        for (auto& key : random_keys(key_count, size, generator)) {
+            const uint64_t original{shiv::hash(key)};
+            for (size_t bit{0}; bit < size * 8; ++bit) {
+                key[bit / 8] = static_cast<char>(key[bit / 8] ^ (1 << (bit % 8)));
+                const uint64_t changed{original ^ shiv::hash(key)};
+                key[bit / 8] = static_cast<char>(key[bit / 8] ^ (1 << (bit % 8)));
+                for (size_t out{0}; out < 64; ++out) {
+                    flips[out] += (changed >> out) & 1;
+                }
+                ++trials;
+            }
+        }
+        for (size_t out{0}; out < 64; ++out) {
+            const double rate{static_cast<double>(flips[out]) / static_cast<double>(trials)};
+            BOOST_TEST_CONTEXT("size " << size << " bit " << out) {
+                BOOST_TEST(rate > 0.48);
+                BOOST_TEST(rate < 0.52);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(collision_test) {
+    // sequential integers and their decimal text, the keys weak hashes do worst on
+    constexpr size_t count{1 << 18};
+    constexpr size_t bucket_count{1 << 10};
+    std::unordered_set<uint64_t> integers{};
+    std::unordered_set<uint64_t> texts{};
+    std::vector<size_t> buckets(bucket_count);
+    for (uint64_t i{0}; i < count; ++i) {
+        const uint64_t hash{shiv::hash(i)};
+        integers.insert(hash);
+        texts.insert(shiv::hash(std::to_string(i)));
+        ++buckets[hash % bucket_count];
+    }
+    BOOST_TEST(integers.size() == count);
+    BOOST_TEST(texts.size() == count);
+    // the low bits alone spread evenly, 256 a bucket on average
+    const auto [least, most]{std::minmax_element(buckets.begin(), buckets.end())};
+    BOOST_TEST(*least > 256 - 6 * 16);
+    BOOST_TEST(*most < 256 + 6 * 16);
+
+    // sparse keys, every 32 byte key with two bits set, and runs of zeros that differ only in
+    // length, which a seeded hash must still tell apart
+    std::unordered_set<uint64_t> sparse{};
+    size_t sparse_count{0};
+    for (size_t first{0}; first < 256; ++first) {
+        for (size_t second{first + 1}; second < 256; ++second) {
+            std::array<char, 32> key{};
+            key[first / 8] = static_cast<char>(key[first / 8] | (1 << (first % 8)));
+            key[second / 8] = static_cast<char>(key[second / 8] | (1 << (second % 8)));
+            sparse.insert(shiv::hash_bytes(key.data(), key.size()));
+            ++sparse_count;
+        }
+    }
+    BOOST_TEST(sparse.size() == sparse_count);
+    const std::vector<char> zeros(2048);
+    std::unordered_set<uint64_t> zero_runs{};
+    for (size_t size{0}; size < zeros.size(); ++size) {
+        zero_runs.insert(shiv::hash_bytes(zeros.data(), size, 5));
+    }
+    BOOST_TEST(zero_runs.size() == zeros.size());
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+#include <ShivLib/dataStructures/inline_string.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+// the layout of a wire message, copied in and out of buffers with memcpy
+struct NewOrder {
+    shiv::InlineString<15> symbol;
+    shiv::InlineString<31> client_order_id;
+    uint32_t quantity;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(inline_string_test)
+BOOST_AUTO_TEST_CASE(layout_test) {
+    static_assert(sizeof(shiv::InlineString<15>) == 16);
+    static_assert(sizeof(shiv::InlineString<63>) == 64);
+    static_assert(alignof(shiv::InlineString<31>) == 1);
+    static_assert(std::is_trivially_copyable_v<shiv::InlineString<31>>);
+    static_assert(std::is_trivially_copyable_v<NewOrder>);
+
+    const NewOrder order{"VOD.L", "a7f3c9e1-20241019-000042", 500};
+    unsigned char buffer[sizeof(NewOrder)];
+    std::memcpy(buffer, &order, sizeof(order));
+    NewOrder received{};
+    std::memcpy(&received, buffer, sizeof(received));
+    BOOST_TEST((received.symbol == "VOD.L"));
+    BOOST_TEST((received.client_order_id == order.client_order_id));
+    BOOST_TEST(received.quantity == 500U);
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    constexpr shiv::InlineString<8> symbol{"AAPL"};
+    static_assert(symbol.size() == 4);
+    static_assert(symbol.view().ends_with("PL"));
+    static_assert(symbol == shiv::InlineString<8>{"AAPL"});
+    static_assert(!(symbol == shiv::InlineString<8>{"AAP"}));
+    constexpr auto appended{[] {
+        shiv::InlineString<8> result{"BRK"};
+        result += ".B";
+        result.push_back('!');
+        result.pop_back();
+        return result;
+    }()};
+    static_assert(appended == shiv::StringView<char>{"BRK.B"});
+    static_assert((appended <=> shiv::StringView<char>{"BRK.A"}) > 0);
+}
+
+BOOST_AUTO_TEST_CASE(modifier_test) {
+    shiv::InlineString<16> tag{"35=D"};
+    tag.append("|49=");
+    BOOST_TEST((tag == "35=D|49="));
+    BOOST_CHECK_THROW(tag.append("0123456789"), std::length_error);
+    BOOST_CHECK_THROW((shiv::InlineString<4>{"TOO LONG"}), std::length_error);
+    BOOST_TEST((tag == "35=D|49="));
+    tag.resize(10, 'x');
+    BOOST_TEST((tag == "35=D|49=xx"));
+    tag.resize(2);
+    BOOST_TEST(tag.back() == '5');
+    BOOST_TEST(tag.at(1) == '5');
+    BOOST_CHECK_THROW((void)tag.at(2), std::out_of_range);
+
+    // shrinking clears the bytes it gives up, so == can compare the whole object
+    shiv::InlineString<16> shrunk{"35=Dxxxxxxxxxxxx"};
+    shrunk = shiv::StringView<char>{"35"};
+    BOOST_TEST((shrunk == tag));
+    shiv::InlineString<16> full{"0123456789abcdef"};
+    BOOST_TEST(full.size() == 16U);
+    BOOST_TEST(!(full == shiv::InlineString<16>{"0123456789abcdeF"}));
+    BOOST_TEST(!(full == shiv::InlineString<16>{"0123456789abcde"}));
+    full.clear();
+    BOOST_TEST((full == shiv::InlineString<16>{}));
+}
+
+BOOST_AUTO_TEST_CASE(key_test) {
+    std::unordered_map<shiv::InlineString<15>, int> positions{};
+    positions["VOD.L"] = 100;
+    positions["BARC.L"] = -50;
+    positions["VOD.L"] += 20;
+    BOOST_TEST(positions.size() == 2U);
+    BOOST_TEST(positions.at("VOD.L") == 120);
+    BOOST_TEST(positions.count("HSBA.L") == 0U);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/lu.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE(lu_test)
+BOOST_AUTO_TEST_CASE(factor_test, *boost::unit_test::tolerance(1e-9)) {
+    // a zero in the top left needs a row swap that the old Gauss-Jordan inverse did not do
+    const shiv::Matrix<double, 3, 3> matrix{{{{0, 2, 1}, {4, 1, 3}, {2, 5, 7}}}};
+    const shiv::LU lu{matrix};
+    BOOST_TEST(!lu.is_singular());
+    BOOST_TEST(lu.pivot(0) == 1U);
+    BOOST_TEST(lu.determinant() == -26.0);
+    BOOST_TEST(matrix.get_determinant() == -26.0);
+
+    // rebuild P * A from the packed factors
+    const auto& packed{lu.packed()};
+    shiv::Matrix<double, 3, 3> lower{};
+    shiv::Matrix<double, 3, 3> upper{};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            if (j < i) {
+                lower[i][j] = packed[i][j];
+            } else {
+                upper[i][j] = packed[i][j];
+            }
+        }
+        lower[i][i] = 1;
+    }
+    auto permuted{matrix};
+    for (size_t i{0}; i < 3; ++i) {
+        shiv::detail::swap_rows(permuted, i, lu.pivot(i), 3);
+    }
+    const auto product{lower * upper};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            BOOST_TEST(product[i][j] == permuted[i][j]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(solve_test, *boost::unit_test::tolerance(1e-9)) {
+    const shiv::Matrix<double, 3, 3> matrix{{{{0, 2, 1}, {4, 1, 3}, {2, 5, 7}}}};
+    const shiv::LU lu{matrix};
+    const shiv::Matrix<double, 3, 2> rhs{{{{5, 1}, {14, 0}, {28, 2}}}};
+    const auto solution{lu.solve(rhs)};
+    const auto check{matrix * solution};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 2; ++j) {
+            BOOST_TEST(check[i][j] == rhs[i][j]);
+        }
+    }
+    BOOST_TEST(solution[0][0] == 1.0);
+    BOOST_TEST(solution[1][0] == 1.0);
+    BOOST_TEST(solution[2][0] == 3.0);
+
+    const auto inverse{lu.inverse()};
+    const auto identity{matrix * inverse};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            BOOST_TEST(identity[i][j] == (i == j ? 1.0 : 0.0));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(singular_test) {
+    const shiv::Matrix<float, 3, 3> matrix{{{{1, 2, 3}, {2, 4, 6}, {1, 0, 1}}}};
+    const shiv::LU lu{matrix};
+    BOOST_TEST(lu.is_singular());
+    BOOST_TEST(lu.determinant() == 0.0F);
+    BOOST_CHECK_THROW((void)lu.inverse(), std::domain_error);
+    BOOST_CHECK_THROW((void)matrix.get_inverse(), std::domain_error);
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_test, *boost::unit_test::tolerance(1e-8)) {
+    // several panels wide so the blocked update and solves are exercised
+    constexpr size_t size{150};
+    shiv::DynMatrix<double> matrix{size, size};
+    std::mt19937 generator{7};
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < size; ++j) {
+            matrix[i][j] = distribution(generator);
+        }
+    }
+    const shiv::LU lu{matrix};
+    BOOST_TEST(lu.size() == size);
+    shiv::DynMatrix<double> expected{size, 70};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < 70; ++j) {
+            expected[i][j] = distribution(generator);
+        }
+    }
+    const auto solution{lu.solve(matrix * expected)};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < 70; ++j) {
+            BOOST_TEST(solution[i][j] == expected[i][j]);
+        }
+    }
+    const auto identity{matrix * matrix.get_inverse()};
+    for (size_t i{0}; i < size; ++i) {
+        for (size_t j{0}; j < size; ++j) {
+            BOOST_TEST(identity[i][j] == (i == j ? 1.0 : 0.0));
+        }
+    }
+    BOOST_CHECK_THROW((shiv::LU{shiv::DynMatrix<double>{2, 3}}), std::invalid_argument);
+    BOOST_CHECK_THROW((void)lu.solve(shiv::DynMatrix<double>{3, 1}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    constexpr shiv::Matrix<double, 2, 2> matrix{{{{0, 1}, {2, 3}}}};
+    static_assert(shiv::LU{matrix}.determinant() == -2.0);
+    constexpr auto inverse{matrix.get_inverse()};
+    static_assert(inverse == shiv::Matrix<double, 2, 2>{{{{-1.5, 0.5}, {1, 0}}}});
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+#include <ShivLib/dataStructures/matrix_batch.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+// a batch that does not fill its last block, so the padding is exercised
+template <typename T, size_t rows, size_t cols>
+shiv::Vector<shiv::Matrix<T, rows, cols>> random_matrices(size_t count, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<T> distribution{-2, 2};
+    shiv::Vector<shiv::Matrix<T, rows, cols>> matrices(count);
+    for (size_t i{0}; i < count; ++i) {
+        shiv::Matrix<T, rows, cols> matrix{};
+        for (auto&& value : matrix) {
+            value = distribution(generator);
+        }
+        matrices.push_back(matrix);
+    }
+    return matrices;
+}
+
+template <typename T, size_t n>
+void check_square(T tolerance) {
+    const auto matrices{random_matrices<T, n, n>(37, 1)};
+    const auto others{random_matrices<T, n, n>(37, 2)};
+    const shiv::MatrixBatch<T, n, n> batch{matrices};
+    const shiv::MatrixBatch<T, n, n> other_batch{others};
+    const auto product{batch * other_batch};
+    const auto inverse{batch.get_inverse()};
+    const auto determinants{batch.get_determinant()};
+    BOOST_TEST(determinants.size() == 37U);
+    for (size_t index{0}; index < 37; ++index) {
+        const auto expected_product{matrices[index] * others[index]};
+        const auto expected_inverse{matrices[index].get_inverse()};
+        BOOST_TEST(std::abs(determinants[index] - matrices[index].get_determinant()) < tolerance);
+        for (size_t i{0}; i < n; ++i) {
+            for (size_t j{0}; j < n; ++j) {
+                BOOST_TEST(std::abs(product(index, i, j) - expected_product[i][j]) < tolerance);
+                BOOST_TEST(std::abs(inverse(index, i, j) - expected_inverse[i][j]) < tolerance);
+            }
+        }
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(matrix_batch_test)
+BOOST_AUTO_TEST_CASE(layout_test) {
+    using batch_type = shiv::MatrixBatch<float, 2, 3>;
+    BOOST_TEST(batch_type::lanes == 16U);
+    const auto matrices{random_matrices<float, 2, 3>(20, 3)};
+    const batch_type batch{matrices};
+    BOOST_TEST(batch.size() == 20U);
+    BOOST_TEST(batch.blocks() == 2U);
+    // element (1, 2) of matrix 17 is in the second block, sixth element, second lane
+    BOOST_TEST(batch.block(1)[5 * 16 + 1] == matrices[17][1][2]);
+    BOOST_TEST(batch.block(1)[5 * 16 + 4] == 0.0F);
+    BOOST_TEST(batch.at(17, 1, 2) == matrices[17][1][2]);
+    BOOST_CHECK_THROW((void)batch.at(20, 0, 0), std::out_of_range);
+
+    const auto round_trip{batch.to_vector()};
+    BOOST_TEST(round_trip.size() == 20U);
+    for (size_t i{0}; i < 20; ++i) {
+        BOOST_TEST((round_trip[i] == matrices[i]));
+        BOOST_TEST((batch.get(i) == matrices[i]));
+    }
+
+    // assigning fewer matrices reuses the storage and zeroes the lanes left over
+    batch_type reused{matrices};
+    const auto fewer{random_matrices<float, 2, 3>(3, 4)};
+    reused.assign(fewer);
+    BOOST_TEST(reused.size() == 3U);
+    BOOST_TEST(reused.blocks() == 1U);
+    BOOST_TEST((reused.get(2) == fewer[2]));
+    BOOST_TEST(reused.block(0)[5 * 16 + 3] == 0.0F);
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic_test) {
+    const auto lhs{random_matrices<double, 3, 2>(10, 4)};
+    const auto rhs{random_matrices<double, 3, 2>(10, 5)};
+    const auto square{random_matrices<double, 2, 4>(10, 6)};
+    shiv::MatrixBatch<double, 3, 2> batch{lhs};
+    const shiv::MatrixBatch<double, 3, 2> other{rhs};
+    const auto sum{batch + other};
+    const auto difference{batch - other};
+    const auto scaled{batch * 3.0};
+    const auto product{batch * shiv::MatrixBatch<double, 2, 4>{square}};
+    for (size_t index{0}; index < 10; ++index) {
+        BOOST_TEST((sum.get(index) == (lhs[index] + rhs[index]).eval()));
+        BOOST_TEST((difference.get(index) == (lhs[index] - rhs[index]).eval()));
+        BOOST_TEST((scaled.get(index) == (lhs[index] * 3.0).eval()));
+        // the two kernels may fuse their multiply adds differently
+        const auto expected_product{lhs[index] * square[index]};
+        for (size_t i{0}; i < 3; ++i) {
+            for (size_t j{0}; j < 4; ++j) {
+                BOOST_TEST(std::abs(product(index, i, j) - expected_product[i][j]) < 1e-12);
+            }
+        }
+    }
+    batch += other;
+    BOOST_TEST((batch == sum));
+    batch *= 2.0;
+    BOOST_TEST((batch == sum * 2.0));
+    batch -= other;
+    BOOST_TEST((batch == sum * 2.0 - other));
+    BOOST_CHECK_THROW((void)(batch + shiv::MatrixBatch<double, 3, 2>{9}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(square_test) {
+    check_square<float, 2>(1e-2F);
+    check_square<float, 3>(1e-2F);
+    check_square<float, 4>(1e-2F);
+    check_square<double, 2>(1e-9);
+    check_square<double, 3>(1e-9);
+    check_square<double, 4>(1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(singular_test) {
+    shiv::MatrixBatch<double, 2, 2> batch{3};
+    for (size_t i{0}; i < 3; ++i) {
+        batch(i, 0, 0) = 1;
+        batch(i, 1, 1) = 1;
+    }
+    BOOST_TEST((batch.get_inverse() == batch));
+    batch(1, 1, 1) = 0;
+    BOOST_CHECK_THROW((void)batch.get_inverse(), std::domain_error);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+#include <ShivLib/dataStructures/matrix.hpp>
+#include <boost/test/unit_test.hpp>
+#include <type_traits>
+
+namespace {
+shiv::Matrix<int, 2, 2> filled(int value) {
+    return shiv::Matrix<int, 2, 2>{{{{value, value}, {value, value}}}};
+}
+// the expression outlives every matrix it was built from
+auto from_temporaries() {
+    return -(filled(1) + filled(2) * 3) - 1;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(matrix_expression_test)
+BOOST_AUTO_TEST_CASE(lazy_test) {
+    const shiv::Matrix<int, 2, 2> a{{{{1, 2}, {3, 4}}}};
+    const shiv::Matrix<int, 2, 2> b{{{{5, 6}, {7, 8}}}};
+    const shiv::Matrix<int, 2, 2> c{{{{1, 1}, {1, 1}}}};
+    auto expression{a * 2 + b - c};
+    static_assert(!shiv::detail::is_matrix_v<decltype(expression)>);
+    static_assert(shiv::MatrixExpression<decltype(expression)>);
+    BOOST_TEST(expression(1, 0) == 12);
+
+    const shiv::Matrix<int, 2, 2> expected{{{{6, 9}, {12, 15}}}};
+    const shiv::Matrix<int, 2, 2> copy_initialised = expression;
+    const shiv::Matrix<int, 2, 2> brace_initialised{expression};
+    BOOST_TEST(copy_initialised == expected);
+    BOOST_TEST(brace_initialised == expected);
+    BOOST_TEST((-(a - b) / 2).eval() == (shiv::Matrix<int, 2, 2>{{{{2, 2}, {2, 2}}}}));
+}
+
+BOOST_AUTO_TEST_CASE(temporary_test) {
+    // named matrices are referred to, temporaries are moved into the node
+    using Matrix = shiv::Matrix<int, 2, 2>;
+    static_assert(std::is_reference_v<shiv::detail::expression_storage_t<const Matrix&>>);
+    static_assert(!std::is_reference_v<shiv::detail::expression_storage_t<Matrix>>);
+    const auto expression{from_temporaries()};
+    BOOST_TEST(expression.eval() == filled(-8));
+    auto sum{filled(4) + filled(5)};
+    BOOST_TEST(sum(1, 1) == 9);
+}
+
+BOOST_AUTO_TEST_CASE(in_place_test) {
+    shiv::Matrix<float, 2, 3> matrix{{{{0, 1, 2}, {3, 4, 5}}}};
+    const shiv::Matrix<float, 2, 3> ones{{{{1, 1, 1}, {1, 1, 1}}}};
+    // the right hand side reads the matrix it is assigned to
+    matrix = matrix * 2 + matrix;
+    BOOST_TEST(matrix == (shiv::Matrix<float, 2, 3>{{{{0, 3, 6}, {9, 12, 15}}}}));
+    matrix += ones * 3;
+    matrix -= matrix / 2;
+    matrix *= 2;
+    matrix -= 1;
+    BOOST_TEST(matrix == (shiv::Matrix<float, 2, 3>{{{{2, 5, 8}, {11, 14, 17}}}}));
+}
+
+BOOST_AUTO_TEST_CASE(product_test) {
+    const shiv::Matrix<int, 2, 2> a{{{{1, 2}, {3, 4}}}};
+    const shiv::Matrix<int, 2, 1> v{{{{1}, {1}}}};
+    const shiv::Matrix<int, 2, 1> expected{{{{6}, {14}}}};
+    BOOST_TEST((a * 2) * v == expected);
+    BOOST_TEST(a * (v + v) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    constexpr shiv::Matrix<int, 2, 2> a{{{{1, 2}, {3, 4}}}};
+    constexpr shiv::Matrix<int, 2, 2> b{{{{4, 3}, {2, 1}}}};
+    constexpr shiv::Matrix<int, 2, 2> sum{a + b * 2 - 1};
+    static_assert(sum == shiv::Matrix<int, 2, 2>{{{{8, 7}, {6, 5}}}});
+    constexpr auto scaled{[] {
+        shiv::Matrix<int, 2, 2> matrix{{{{1, 2}, {3, 4}}}};
+        matrix += matrix * 3;
+        return matrix;
+    }()};
+    static_assert(scaled == shiv::Matrix<int, 2, 2>{{{{4, 8}, {12, 16}}}});
+}
+BOOST_AUTO_TEST_SUITE_END()
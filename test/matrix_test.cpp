@@ -6,6 +6,9 @@
 #endif
 
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
 
 BOOST_AUTO_TEST_SUITE(matrix_test)
 BOOST_AUTO_TEST_CASE(multiply_test) {
@@ -18,7 +21,7 @@ BOOST_AUTO_TEST_CASE(multiply_test) {
     shiv::Matrix<float, 3, 3> expectedMatrix2 = {{{{0, 5, 10}, {15, 20, 25}, {30, 35, 40}}}};
     BOOST_TEST((matrix1 * matrix2) == expectedMatrix);
     BOOST_TEST((matrix1i * matrix2i) == expectedMatrixi);
-    BOOST_TEST((matrix1 * 5) == expectedMatrix2);
+    BOOST_TEST((matrix1 * 5).eval() == expectedMatrix2);
 }
 
 BOOST_AUTO_TEST_CASE(divide_test) {
@@ -34,7 +37,11 @@ BOOST_AUTO_TEST_CASE(divide_test) {
     shiv::Matrix<double, 3, 3> expectedMatrix2 = {{{{2, 3, 4}, {1, 1.2, 1.6}, {2.8, 1.4, 17.6}}}};
     [[maybe_unused]] auto result1{matrix1 / matrix2};
     // BOOST_TEST(result1 == expectedMatrix); fails due to floating point rounding errors
-    BOOST_TEST((matrix3 / 5.0) == expectedMatrix2);
+    BOOST_TEST((matrix3 / 5.0).eval() == expectedMatrix2);
+    // a singular divisor throws rather than terminating
+    const shiv::Matrix<double, 3, 3> singular = {{{{1, 2, 3}, {2, 4, 6}, {0, 1, 1}}}};
+    BOOST_CHECK_THROW((void)(matrix1 / singular), std::domain_error);
+    BOOST_CHECK_THROW(matrix1 /= singular, std::domain_error);
 }
 
 BOOST_AUTO_TEST_CASE(addition_test) {
@@ -42,8 +49,8 @@ BOOST_AUTO_TEST_CASE(addition_test) {
     shiv::Matrix<float, 3, 3> matrix2 = {{{{0, 1, 2}, {3, 4, 5}, {6, 7, 8}}}};
     shiv::Matrix<float, 3, 3> expectedMatrix12 = {{{{0, 2, 4}, {6, 8, 10}, {12, 14, 16}}}};
     shiv::Matrix<float, 3, 3> expectedMatrix1S = {{{{7, 8, 9}, {10, 11, 12}, {13, 14, 15}}}};
-    BOOST_TEST((matrix1 + matrix2) == expectedMatrix12);
-    BOOST_TEST((matrix1 + 7) == expectedMatrix1S);
+    BOOST_TEST((matrix1 + matrix2).eval() == expectedMatrix12);
+    BOOST_TEST((matrix1 + 7).eval() == expectedMatrix1S);
     shiv::Matrix<float, 3, 3> addTest = {{{{1, 1, 1}, {1, 1, 1}, {1, 1, 1}}}};
     expectedMatrix1S += addTest;
     shiv::Matrix<float, 3, 3> expectedTest = {{{{8, 9, 10}, {11, 12, 13}, {14, 15, 16}}}};
@@ -56,9 +63,9 @@ BOOST_AUTO_TEST_CASE(subtraction_test) {
     shiv::Matrix<float, 3, 3> expectedMatrix12 = {{{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}}};
     shiv::Matrix<float, 3, 3> expectedMatrix1S = {{{{-5, -4, -3}, {-2, -1, 0}, {1, 2, 3}}}};
     shiv::Matrix<float, 3, 3> negMatrix = {{{{-0, -1, -2}, {-3, -4, -5}, {-6, -7, -8}}}};
-    BOOST_TEST((matrix1 - matrix2) == expectedMatrix12);
-    BOOST_TEST((matrix1 - 5) == expectedMatrix1S);
-    BOOST_TEST(-matrix1 == negMatrix);
+    BOOST_TEST((matrix1 - matrix2).eval() == expectedMatrix12);
+    BOOST_TEST((matrix1 - 5).eval() == expectedMatrix1S);
+    BOOST_TEST((-matrix1).eval() == negMatrix);
 }
 
 BOOST_AUTO_TEST_CASE(determinant_test, *boost::unit_test::tolerance(0.01)) {
@@ -79,18 +86,49 @@ BOOST_AUTO_TEST_CASE(determinant_test, *boost::unit_test::tolerance(0.01)) {
     BOOST_TEST(matrix5x5.get_determinant() == 5182129.02628431);
 }
 
-// FIXME:
-//BOOST_AUTO_TEST_CASE(row_echelon_test, *boost::unit_test::tolerance(0.001)) {
-//    shiv::Matrix<float, 3, 3> matrix3x3 = {{{{0, 1, 2}, {3, 4, 5}, {6, 7, 8}}}};
-//    shiv::Matrix<float, 3, 3> expectedMatrix3x3 = {{{{3, 4, 5}, {0, 1, 2}, {0, 0, 0}}}};
-//    auto [result3x3, isAddition] = matrix3x3.get_row_echelon();
-//    BOOST_TEST(result3x3 == expectedMatrix3x3);
-//    shiv::Matrix<float, 4, 4> matrix4x4
-//        = {{{{5, 8, 2, 3}, {4, 5, 12, 7}, {4, 9, 10, 11}, {12, 77, 14, 14}}}};
-//    shiv::Matrix<float, 4, 4> expectedMatrix4x4 = {
-//        {{{5, 8, 2, 3}, {0, -1.4, 10.399, 4.599}, {0, 0, 27.714, 17.142}, {0, 3.814, 0, -74.567}}}};
-//    BOOST_TEST(get<0>(matrix4x4.get_row_echelon()) == expectedMatrix4x4);
-//}
+BOOST_AUTO_TEST_CASE(row_echelon_test) {
+    constexpr shiv::Matrix<float, 3, 3> matrix3x3 = {{{{0, 1, 2}, {3, 4, 5}, {6, 7, 8}}}};
+    constexpr shiv::Matrix<float, 3, 3> expectedMatrix3x3 = {{{{3, 4, 5}, {0, 1, 2}, {0, 0, 0}}}};
+    constexpr auto echelon{matrix3x3.get_row_echelon()};
+    static_assert(std::get<0>(echelon) == expectedMatrix3x3);
+    static_assert(std::get<1>(echelon));
+    auto [result3x3, isAddition] = matrix3x3.get_row_echelon();
+    BOOST_TEST(result3x3 == expectedMatrix3x3);
+    BOOST_TEST(isAddition);
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    // a calibration style table folded at compile time, past the unrolled 4x4 kernels
+    constexpr shiv::Matrix<double, 5, 5> matrix5x5 = {{{{2, 1, 0, 0, 3},
+                                                        {1, 3, 1, 0, 0},
+                                                        {0, 1, 4, 1, 0},
+                                                        {0, 0, 1, 5, 1},
+                                                        {1, 0, 0, 1, 6}}}};
+    constexpr double determinant{matrix5x5.get_determinant()};
+    static_assert(determinant > 339.999 && determinant < 340.001);
+    constexpr auto inverse{matrix5x5.get_inverse()};
+    constexpr auto identity{matrix5x5 * inverse};
+    for (size_t i{0}; i < 5; ++i) {
+        for (size_t j{0}; j < 5; ++j) {
+            BOOST_TEST(std::abs(identity[i][j] - (i == j ? 1.0 : 0.0)) < 1e-12);
+        }
+    }
+    // the same answers as the run time kernels, to rounding
+    BOOST_TEST(std::abs(matrix5x5.get_determinant() - determinant) < 1e-9);
+    BOOST_TEST(std::abs(matrix5x5.get_inverse()[4][0] - inverse[4][0]) < 1e-12);
+
+    // integers are exact, truncating division in row echelon form would give 720 here
+    constexpr shiv::Matrix<int, 5, 5> integers = {{{{2, 1, 0, 0, 3},
+                                                    {1, 3, 1, 0, 0},
+                                                    {0, 1, 4, 1, 0},
+                                                    {0, 0, 1, 5, 1},
+                                                    {1, 0, 0, 1, 6}}}};
+    static_assert(integers.get_determinant() == 340);
+    constexpr shiv::Matrix<long, 4, 4> swapped = {
+        {{{0, 2, 0, 0}, {3, 0, 0, 0}, {0, 0, 0, 5}, {0, 0, 7, 1}}}};
+    static_assert(swapped.get_determinant() == 210);
+    BOOST_TEST(integers.get_determinant() == 340);
+}
 
 BOOST_AUTO_TEST_CASE(transpose_test) {
     shiv::Matrix<float, 3, 3> matrix3x3 = {{{{0, 1, 2}, {3, 4, 5}, {6, 7, 8}}}};
@@ -101,6 +139,9 @@ BOOST_AUTO_TEST_CASE(transpose_test) {
     shiv::Matrix<int, 4, 4> expectedMatrix4x4 = {
         {{{5, 4, 4, 12}, {8, 5, 9, 77}, {2, 12, 10, 14}, {3, 7, 11, 14}}}};
     BOOST_TEST(matrix4x4.get_transpose() == expectedMatrix4x4);
+    constexpr shiv::Matrix<int, 2, 3> matrix2x3 = {{{{1, 2, 3}, {4, 5, 6}}}};
+    constexpr shiv::Matrix<int, 3, 2> expectedMatrix3x2 = {{{{1, 4}, {2, 5}, {3, 6}}}};
+    static_assert(matrix2x3.get_transpose() == expectedMatrix3x2);
 }
 
 BOOST_AUTO_TEST_CASE(augment_test) {
@@ -117,12 +158,18 @@ BOOST_AUTO_TEST_CASE(identity_test) {
     BOOST_TEST(matrix3x3.get_identity() == expectedMatrix3x3);
 }
 
-BOOST_AUTO_TEST_CASE(inverse_test, *boost::unit_test::tolerance(0.01)) {
+BOOST_AUTO_TEST_CASE(inverse_test, *boost::unit_test::tolerance(0.01F)) {
     shiv::Matrix<float, 3, 3> matrix3x3 = {{{{3, 7, 8}, {5, 1, 5}, {7, 2, 5}}}};
     shiv::Matrix<float, 3, 3> expectedMatrix3x3 = {{{{-0.0632911697, -0.240506232, 0.341772079},
                                                      {0.12658228, -0.518987358, 0.316455722},
                                                      {0.0379746817, 0.544303775, -0.405063301}}}};
-    BOOST_TEST(matrix3x3.get_inverse() == expectedMatrix3x3);
+    // pivoting changes the rounding, so compare element wise within the tolerance
+    const auto inverse{matrix3x3.get_inverse()};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            BOOST_TEST(inverse[i][j] == expectedMatrix3x3[i][j]);
+        }
+    }
 }
 
 BOOST_AUTO_TEST_CASE(orthogonal_test) {
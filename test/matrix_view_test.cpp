@@ -0,0 +1,113 @@
+#include <ShivLib/dataStructures/matrix_view.hpp>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_SUITE(matrix_view_test)
+BOOST_AUTO_TEST_CASE(slicing_test) {
+    shiv::Matrix<int, 3, 4> matrix{{{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}}}};
+    shiv::MatrixView view{matrix};
+    BOOST_TEST(view.rows() == 3U);
+    BOOST_TEST(view.cols() == 4U);
+    BOOST_TEST(view[1][2] == 7);
+    BOOST_TEST(view.at(2, 3) == 12);
+    BOOST_CHECK_THROW((void)view.at(3, 0), std::out_of_range);
+
+    const auto block{view.submatrix(1, 1, 2, 2)};
+    BOOST_TEST(block(0, 0) == 6);
+    BOOST_TEST(block(1, 1) == 11);
+    BOOST_CHECK_THROW((void)view.submatrix(2, 0, 2, 1), std::out_of_range);
+
+    const auto transposed{view.transposed()};
+    BOOST_TEST(transposed.rows() == 4U);
+    BOOST_TEST(transposed(3, 1) == 8);
+    BOOST_TEST((transposed.to_dyn_matrix() == shiv::DynMatrix<int>{matrix.get_transpose()}));
+
+    const auto column{view.col(2)};
+    BOOST_TEST(column.rows() == 3U);
+    BOOST_TEST(column(2, 0) == 11);
+    const auto row{transposed.row(1)};
+    BOOST_TEST(row.cols() == 3U);
+    BOOST_TEST(row(0, 2) == 10);
+
+    // writes go to the viewed matrix
+    block(0, 1) = 70;
+    BOOST_TEST(matrix[1][2] == 70);
+    column.fill(0);
+    BOOST_TEST(matrix[0][2] == 0);
+    BOOST_TEST(matrix[2][2] == 0);
+    view.row(0) *= 2;
+    BOOST_TEST(matrix[0][3] == 8);
+
+    const shiv::MatrixView<const int> read_only{view};
+    BOOST_TEST(read_only(0, 0) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(external_buffer_test) {
+    // a column major 2 x 3 matrix in a plain array, padded to a leading dimension of 3
+    double buffer[9]{1, 4, -1, 2, 5, -1, 3, 6, -1};
+    const shiv::MatrixView view{buffer, 2, 3, 1, 3};
+    const shiv::DynMatrix<double> expected{{1, 2, 3}, {4, 5, 6}};
+    BOOST_TEST((view == expected));
+    BOOST_TEST((view.to_dyn_matrix() == expected));
+
+    view.submatrix(0, 1, 2, 2).assign(shiv::DynMatrix<double>{{7, 8}, {9, 10}});
+    BOOST_TEST(buffer[3] == 7.0);
+    BOOST_TEST(buffer[7] == 10.0);
+    BOOST_TEST(buffer[8] == -1.0);
+    BOOST_CHECK_THROW(view.assign(expected.get_transpose()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic_test) {
+    shiv::DynMatrix<double> big{6, 6};
+    for (size_t i{0}; i < 6; ++i) {
+        for (size_t j{0}; j < 6; ++j) {
+            big[i][j] = static_cast<double>(i * 6 + j);
+        }
+    }
+    const shiv::MatrixView<const double> view{big};
+    const auto top_left{view.submatrix(0, 0, 3, 3)};
+    const auto bottom_right{view.submatrix(3, 3, 3, 3)};
+    const auto dense_top_left{top_left.to_dyn_matrix()};
+    const auto dense_bottom_right{bottom_right.to_dyn_matrix()};
+    BOOST_TEST(((top_left + bottom_right) == (dense_top_left + dense_bottom_right)));
+    BOOST_TEST(((top_left - dense_bottom_right) == (dense_top_left - dense_bottom_right)));
+    BOOST_TEST(((top_left * bottom_right) == (dense_top_left * dense_bottom_right)));
+    BOOST_TEST(((top_left.transposed() * bottom_right) ==
+                (dense_top_left.get_transpose() * dense_bottom_right)));
+    BOOST_TEST(((top_left * 2.0) == (dense_top_left * 2.0)));
+    BOOST_CHECK_THROW((void)(view.row(0) * view.row(1)), std::invalid_argument);
+
+    // C22 += A21 * B12 in place, the pattern blocked algorithms need
+    shiv::DynMatrix<double> target{big};
+    shiv::MatrixView<double> target_view{target};
+    shiv::gemm(1.0, view.submatrix(3, 0, 3, 3), view.submatrix(0, 3, 3, 3), 1.0,
+               target_view.submatrix(3, 3, 3, 3));
+    const auto product{view.submatrix(3, 0, 3, 3) * view.submatrix(0, 3, 3, 3)};
+    for (size_t i{0}; i < 3; ++i) {
+        for (size_t j{0}; j < 3; ++j) {
+            BOOST_TEST(target[i + 3][j + 3] == big[i + 3][j + 3] + product[i][j]);
+            BOOST_TEST(target[i][j] == big[i][j]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lu_test, *boost::unit_test::tolerance(1e-9)) {
+    // factor and solve the top left block of a bigger matrix without copying it out
+    shiv::DynMatrix<double> storage{{4, 3, 0, 9}, {6, 3, 1, 9}, {2, 5, 7, 9}, {9, 9, 9, 9}};
+    const auto original{shiv::MatrixView<const double>{storage}.submatrix(0, 0, 3, 3)
+                            .to_dyn_matrix()};
+    shiv::MatrixView<double> view{storage};
+    const shiv::LU lu{view.submatrix(0, 0, 3, 3)};
+    BOOST_TEST(lu.determinant() == original.get_determinant());
+    BOOST_TEST(storage[3][3] == 9.0);
+
+    // the right hand side is a view over a plain array
+    double rhs_buffer[3]{1, 2, 3};
+    const shiv::MatrixView<double> rhs{rhs_buffer, 3, 1};
+    lu.solve_in_place(rhs);
+    const auto check{original * rhs};
+    BOOST_TEST(check[0][0] == 1.0);
+    BOOST_TEST(check[1][0] == 2.0);
+    BOOST_TEST(check[2][0] == 3.0);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+#include <ShivLib/memory.hpp>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Counted {
+    static inline std::atomic<int> alive{0};
+    int value;
+    explicit Counted(int input)
+    : value{input} {
+        ++alive;
+    }
+    ~Counted() {
+        --alive;
+    }
+};
+
+// Treiber stack, the usual customer of deferred reclamation
+struct Node {
+    int value;
+    Node* next;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(memory_test)
+BOOST_AUTO_TEST_CASE(epoch_retire_test) {
+    {
+        shiv::EpochDomain domain{4};
+        auto handle{domain.register_thread()};
+        for (int i{0}; i < 3; ++i) {
+            auto guard{handle.pin()};
+            handle.retire(new Counted{i});
+        }
+        BOOST_TEST(Counted::alive == 3);
+        BOOST_TEST(domain.unreclaimed() == 3U);
+
+        // nothing can be freed until the epoch has moved on twice
+        handle.collect();
+        handle.collect();
+        BOOST_TEST(Counted::alive == 0);
+        BOOST_TEST(domain.unreclaimed() == 0U);
+
+        handle.retire(new Counted{3});
+    }
+    // the domain frees whatever is left in limbo
+    BOOST_TEST(Counted::alive == 0);
+}
+
+BOOST_AUTO_TEST_CASE(epoch_pinned_reader_test) {
+    shiv::EpochDomain domain{1};
+    auto reader{domain.register_thread()};
+    auto writer{domain.register_thread()};
+    {
+        auto guard{reader.pin()};
+        auto nested{reader.pin()};
+        writer.retire(new Counted{0});
+        for (int i{0}; i < 8; ++i) {
+            writer.collect();
+        }
+        // the reader may still be looking at it
+        BOOST_TEST(Counted::alive == 1);
+    }
+    writer.collect();
+    writer.collect();
+    BOOST_TEST(Counted::alive == 0);
+}
+
+BOOST_AUTO_TEST_CASE(hazard_protect_test) {
+    shiv::HazardDomain domain{1};
+    std::atomic<Counted*> shared{new Counted{7}};
+    {
+        shiv::HazardDomain::Guard guard{domain};
+        Counted* protected_ptr{guard.protect(shared)};
+        shared.store(nullptr);
+        domain.retire(protected_ptr);
+        domain.scan();
+        BOOST_TEST(Counted::alive == 1);
+        BOOST_TEST(protected_ptr->value == 7);
+        guard.reset();
+        domain.scan();
+        BOOST_TEST(Counted::alive == 0);
+    }
+    BOOST_TEST(domain.unreclaimed() == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_stack_test) {
+    constexpr int threads{4};
+    constexpr int iterations{20000};
+    shiv::EpochDomain epoch_domain{};
+    shiv::HazardDomain hazard_domain{};
+    std::atomic<Node*> epoch_head{nullptr};
+    std::atomic<Node*> hazard_head{nullptr};
+    std::atomic<long> popped_sum{0};
+
+    std::vector<std::thread> workers{};
+    for (int t{0}; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto handle{epoch_domain.register_thread()};
+            for (int i{0}; i < iterations; ++i) {
+                const int value{t * iterations + i};
+                for (auto* head : {&epoch_head, &hazard_head}) {
+                    auto* node{new Node{value, head->load()}};
+                    while (!head->compare_exchange_weak(node->next, node)) {
+                    }
+                }
+                {
+                    auto guard{handle.pin()};
+                    Node* node{epoch_head.load()};
+                    while (node != nullptr && !epoch_head.compare_exchange_weak(node, node->next)) {
+                    }
+                    if (node != nullptr) {
+                        popped_sum += node->value;
+                        handle.retire(node);
+                    }
+                }
+                {
+                    shiv::HazardDomain::Guard guard{hazard_domain};
+                    Node* node{guard.protect(hazard_head)};
+                    while (node != nullptr &&
+                           !hazard_head.compare_exchange_weak(node, node->next)) {
+                        node = guard.protect(hazard_head);
+                    }
+                    if (node != nullptr) {
+                        popped_sum -= node->value;
+                        guard.reset();
+                        hazard_domain.retire(node);
+                    }
+                }
+            }
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    // both stacks saw the same pushes and every iteration popped from both
+    BOOST_TEST(epoch_head.load() == nullptr);
+    BOOST_TEST(hazard_head.load() == nullptr);
+    BOOST_TEST(popped_sum == 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,287 @@
+#include <ShivLib/multithreading/pipeline.hpp>
+#include <ShivLib/multithreading/ring_buffer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+// no default constructor, messages must be built in place
+struct Tick {
+    explicit Tick(long tick_value)
+    : value{tick_value} {
+    }
+    long value;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(pipeline_test)
+BOOST_AUTO_TEST_CASE(spsc_ring_test) {
+    shiv::SpscRing<int> ring{3};
+    BOOST_TEST(ring.capacity() == 4U);
+    BOOST_TEST(ring.try_push(1));
+    BOOST_TEST(ring.try_emplace(2));
+    std::vector<int> batch{3, 4, 5};
+    BOOST_TEST(ring.try_push_batch(batch.begin(), batch.size()) == 2U);
+    BOOST_TEST(!ring.try_push(6));
+    BOOST_TEST(ring.size() == 4U);
+
+    int value{0};
+    BOOST_TEST(ring.try_pop(value));
+    BOOST_TEST(value == 1);
+    std::vector<int> out{};
+    BOOST_TEST(ring.try_pop_batch(std::back_inserter(out), 8) == 3U);
+    BOOST_TEST(out == (std::vector<int>{2, 3, 4}));
+    BOOST_TEST(ring.empty());
+    BOOST_TEST(!ring.try_pop(value));
+}
+
+BOOST_AUTO_TEST_CASE(ring_destroys_remaining_test) {
+    auto tracked{std::make_shared<int>(0)};
+    {
+        shiv::SpscRing<std::shared_ptr<int>> spsc{4};
+        shiv::MpmcRing<std::shared_ptr<int>> mpmc{4};
+        BOOST_TEST(spsc.try_push(tracked));
+        BOOST_TEST(mpmc.try_push(tracked));
+        BOOST_TEST(mpmc.try_push(tracked));
+        BOOST_TEST(tracked.use_count() == 4);
+    }
+    BOOST_TEST(tracked.use_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(spsc_concurrent_test) {
+    constexpr int count{200000};
+    shiv::SpscRing<int> ring{64};
+    std::thread producer{[&] {
+        for (int i{0}; i < count; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+    bool in_order{true};
+    for (int expected{0}; expected < count;) {
+        int value{0};
+        if (ring.try_pop(value)) {
+            in_order = in_order && value == expected;
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    BOOST_TEST(in_order);
+}
+
+BOOST_AUTO_TEST_CASE(mpmc_concurrent_test) {
+    constexpr int threads{4};
+    constexpr int count{50000};
+    shiv::MpmcRing<int> ring{128};
+    std::atomic<long> sum{0};
+    std::atomic<int> popped{0};
+    std::vector<std::thread> workers{};
+    for (int t{0}; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i{1}; i <= count; ++i) {
+                while (!ring.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        workers.emplace_back([&] {
+            int value{0};
+            while (popped.load() < threads * count) {
+                if (ring.try_pop(value)) {
+                    sum += value;
+                    ++popped;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    BOOST_TEST(sum.load() == long{threads} * count * (count + 1) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(mpmc_batch_test) {
+    shiv::MpmcRing<int> ring{4};
+    std::vector<int> batch{1, 2, 3, 4, 5};
+    BOOST_TEST(ring.try_push_batch(batch.begin(), batch.size()) == 4U);
+    BOOST_TEST(ring.try_push_batch(batch.begin(), batch.size()) == 0U);
+    std::vector<int> out{};
+    BOOST_TEST(ring.try_pop_batch(std::back_inserter(out), 3) == 3U);
+    BOOST_TEST(ring.try_push_batch(batch.begin(), batch.size()) == 3U);
+    BOOST_TEST(ring.try_pop_batch(std::back_inserter(out), 8) == 4U);
+    BOOST_TEST(out == (std::vector<int>{1, 2, 3, 4, 1, 2, 3}));
+    BOOST_TEST(ring.empty());
+
+    // batches of every size racing for the same positions
+    constexpr int threads{3};
+    constexpr int count{30000};
+    shiv::MpmcRing<int> shared{64};
+    std::atomic<long> sum{0};
+    std::atomic<int> popped{0};
+    std::vector<std::thread> workers{};
+    for (int t{0}; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::vector<int> values(count);
+            for (int i{0}; i < count; ++i) {
+                values[i] = i + 1;
+            }
+            for (size_t i{0}; i < values.size();) {
+                const size_t size{std::min<size_t>(1 + (i + t) % 23, values.size() - i)};
+                const size_t pushed{shared.try_push_batch(values.begin() + i, size)};
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                i += pushed;
+            }
+        });
+        workers.emplace_back([&, t] {
+            std::vector<int> values{};
+            while (popped.load() < threads * count) {
+                values.clear();
+                const size_t taken{shared.try_pop_batch(std::back_inserter(values), 1 + t * 7)};
+                if (taken == 0) {
+                    std::this_thread::yield();
+                }
+                for (const int value : values) {
+                    sum += value;
+                }
+                popped += static_cast<int>(taken);
+            }
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    BOOST_TEST(popped.load() == threads * count);
+    BOOST_TEST(sum.load() == long{threads} * count * (count + 1) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(ordered_pipeline_test) {
+    constexpr int count{20000};
+    std::vector<long> received{};
+    auto pipeline{shiv::Pipeline<int>::builder({64, 8})
+                      .stage("widen", [](int value) { return long{value}; })
+                      .parallel_stage("square", 3, [](long value) { return value * value; })
+                      .parallel_stage("negate", 2, [](long value) { return -value; })
+                      .sink("collect", [&received](long value) { received.push_back(value); })};
+    pipeline.start();
+    for (int i{0}; i < count; ++i) {
+        pipeline.push(i);
+    }
+    pipeline.finish();
+
+    BOOST_TEST(received.size() == size_t{count});
+    bool in_order{true};
+    for (int i{0}; i < count; ++i) {
+        in_order = in_order && received[i] == -long{i} * i;
+    }
+    BOOST_TEST(in_order);
+
+    const auto stats{pipeline.stats()};
+    BOOST_TEST(stats.size() == 4U);
+    BOOST_TEST(stats[1].name == "square");
+    BOOST_TEST(stats[1].replicas == 3U);
+    for (auto&& stage : stats) {
+        BOOST_TEST(stage.processed == uint64_t{count});
+        BOOST_TEST(stage.queue_depth == 0U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(unordered_pipeline_test) {
+    constexpr int count{20000};
+    std::atomic<long> sum{0};
+    std::atomic<int> received{0};
+    std::vector<int> input(count);
+    for (int i{0}; i < count; ++i) {
+        input[i] = i;
+    }
+    auto pipeline{
+        shiv::Pipeline<int>::builder()
+            .parallel_stage("double", 4, [](int value) { return 2 * value; },
+                            shiv::Merge::unordered)
+            .parallel_stage("add", 2, [](int value) { return value + 1; })
+            .parallel_sink("sum", 2, [&](int value) {
+                sum += value;
+                ++received;
+            }, shiv::Merge::unordered)};
+    pipeline.start();
+    pipeline.push_batch(input.begin(), input.end());
+    pipeline.finish();
+    BOOST_TEST(received.load() == count);
+    BOOST_TEST(sum.load() == long{count} * (count - 1) + count);
+}
+
+BOOST_AUTO_TEST_CASE(empty_pipeline_test) {
+    int received{0};
+    auto pipeline{shiv::Pipeline<int>::builder()
+                      .parallel_stage("identity", 2, [](int value) { return value; })
+                      .sink("count", [&received](int) { ++received; })};
+    pipeline.start();
+    pipeline.finish();
+    BOOST_TEST(received == 0);
+}
+
+BOOST_AUTO_TEST_CASE(move_test) {
+    int received{0};
+    auto pipeline{shiv::Pipeline<int>::builder({64, 8})
+                      .parallel_stage("identity", 2, [](int value) { return value; })
+                      .sink("count", [&received](int) { ++received; })};
+    pipeline.start();
+    // fewer than a batch stay with the writer until flushed
+    for (int i{0}; i < 5; ++i) {
+        pipeline.push(i);
+    }
+    BOOST_TEST(pipeline.stats()[0].processed == 0U);
+    // the moved from pipeline outlives the one it moved into and must not touch its rings
+    {
+        std::optional<shiv::Pipeline<int>> moved{std::move(pipeline)};
+        moved->flush();
+        for (int i{0}; i < 100; ++i) {
+            moved->push(i);
+        }
+        moved->finish();
+    }
+    BOOST_TEST(received == 105);
+    BOOST_TEST(pipeline.stats().empty());
+}
+
+BOOST_AUTO_TEST_CASE(options_test) {
+    BOOST_CHECK_THROW(shiv::Pipeline<int>::builder({8, 16}), std::invalid_argument);
+    BOOST_CHECK_THROW(shiv::Pipeline<int>::builder({8, 0}), std::invalid_argument);
+    BOOST_CHECK_THROW(shiv::Pipeline<int>::builder().parallel_stage("none", 0,
+                                                                    [](int value) {
+                                                                        return value;
+                                                                    }),
+                      std::invalid_argument);
+
+    // full batches the size of the rings, so producers regularly find a lane full while other
+    // lanes still hold staged messages that a waiting consumer needs
+    constexpr long count{20000};
+    std::vector<long> received{};
+    auto pipeline{shiv::Pipeline<Tick>::builder({4, 4})
+                      .parallel_stage("square", 3,
+                                      [](Tick tick) { return Tick{tick.value * tick.value}; })
+                      .parallel_stage("negate", 2, [](Tick tick) { return Tick{-tick.value}; })
+                      .sink("collect", [&received](Tick tick) { received.push_back(tick.value); })};
+    pipeline.start();
+    for (long i{0}; i < count; ++i) {
+        pipeline.push(Tick{i});
+    }
+    pipeline.finish();
+    bool in_order{received.size() == size_t{count}};
+    for (long i{0}; in_order && i < count; ++i) {
+        in_order = received[i] == -i * i;
+    }
+    BOOST_TEST(in_order);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/qr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_SUITE(qr_test)
+BOOST_AUTO_TEST_CASE(least_squares_test, *boost::unit_test::tolerance(1e-12)) {
+    // a straight line through four points that do not quite lie on one
+    const shiv::Matrix<double, 4, 2> design{{{{1, 0}, {1, 1}, {1, 2}, {1, 3}}}};
+    const shiv::Matrix<double, 4, 1> observed{{{{1}, {3}, {4}, {4}}}};
+    const shiv::QR qr{design};
+    BOOST_TEST(!qr.is_rank_deficient());
+    BOOST_TEST(qr.rows() == 4U);
+    BOOST_TEST(qr.cols() == 2U);
+    const shiv::Matrix<double, 2, 1> fit{qr.solve(observed)};
+    BOOST_TEST(fit[0][0] == 1.5);
+    BOOST_TEST(fit[1][0] == 1.0);
+
+    // the rows after the solution hold the rotated residual
+    auto rotated{observed};
+    qr.solve_in_place(rotated);
+    const double residual{rotated[2][0] * rotated[2][0] + rotated[3][0] * rotated[3][0]};
+    BOOST_TEST(residual == 0.25 + 0.25 + 0.25 + 0.25);
+
+    // |R| on the diagonal is the norm of what is left of each column
+    BOOST_TEST(std::abs(qr.packed()[0][0]) == 2.0);
+    auto unit{observed};
+    qr.multiply_qt_in_place(unit);
+    BOOST_TEST(unit[0][0] * unit[0][0] + unit[1][0] * unit[1][0] + residual == 1.0 + 9 + 16 + 16);
+}
+
+BOOST_AUTO_TEST_CASE(rank_deficient_test) {
+    const shiv::Matrix<double, 3, 2> design{{{{1, 2}, {2, 4}, {3, 6}}}};
+    const shiv::QR qr{design};
+    BOOST_TEST(qr.is_rank_deficient());
+    BOOST_CHECK_THROW((void)qr.solve(shiv::Matrix<double, 3, 1>{}), std::domain_error);
+    // a failed solve leaves the right hand side alone
+    shiv::Matrix<double, 3, 1> rhs{{{{1}, {2}, {3}}}};
+    BOOST_CHECK_THROW(qr.solve_in_place(rhs), std::domain_error);
+    BOOST_TEST((rhs == shiv::Matrix<double, 3, 1>{{{{1}, {2}, {3}}}}));
+    BOOST_CHECK_THROW((shiv::QR{shiv::DynMatrix<double>{2, 3}}), std::invalid_argument);
+    const shiv::QR dynamic{shiv::DynMatrix<double>{3, 2, 1.0}};
+    BOOST_CHECK_THROW((void)dynamic.solve(shiv::DynMatrix<double>{2, 1}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_test, *boost::unit_test::tolerance(1e-9)) {
+    // several panels, wide enough that the panels are applied through gemm, and a consistent
+    // system so the least squares solution is exact
+    constexpr size_t rows{400};
+    constexpr size_t cols{150};
+    std::mt19937 generator{5};
+    std::uniform_real_distribution<double> distribution{-1, 1};
+    shiv::DynMatrix<double> design{rows, cols};
+    for (size_t i{0}; i < rows; ++i) {
+        for (size_t j{0}; j < cols; ++j) {
+            design[i][j] = distribution(generator);
+        }
+    }
+    shiv::DynMatrix<double> expected{cols, 70};
+    for (size_t i{0}; i < cols; ++i) {
+        for (size_t j{0}; j < 70; ++j) {
+            expected[i][j] = distribution(generator);
+        }
+    }
+    const shiv::QR qr{design};
+    const auto solution{qr.solve(design * expected)};
+    BOOST_TEST(solution.rows() == cols);
+    BOOST_TEST(solution.cols() == 70U);
+    for (size_t i{0}; i < cols; ++i) {
+        for (size_t j{0}; j < 70; ++j) {
+            BOOST_TEST(solution[i][j] == expected[i][j]);
+        }
+    }
+
+    // with noise the residual is orthogonal to the columns of A
+    auto observed{design * expected};
+    for (size_t i{0}; i < rows; ++i) {
+        observed[i][3] += distribution(generator);
+    }
+    const auto fit{qr.solve(observed)};
+    const auto residual{observed - design * fit};
+    const auto gradient{design.get_transpose() * residual};
+    for (size_t i{0}; i < cols; ++i) {
+        BOOST_TEST(gradient[i][3] + 1.0 == 1.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    constexpr shiv::Matrix<double, 3, 2> design{{{{1, 0}, {0, 1}, {0, 0}}}};
+    static_assert(shiv::QR{design}.solve(shiv::Matrix<double, 3, 1>{{{{2}, {3}, {4}}}}) ==
+                  shiv::Matrix<double, 2, 1>{{{{2}, {3}}}});
+    // a reflector that needs a square root at compile time
+    constexpr shiv::Matrix<double, 2, 1> column{{{{3}, {4}}}};
+    static_assert(shiv::QR{column}.packed()[0][0] == -5.0);
+    static_assert(shiv::QR{column}.solve(shiv::Matrix<double, 2, 1>{{{{6}, {8}}}})[0][0] == 2.0);
+    constexpr double root_two{shiv::detail::constexpr_sqrt(2.0)};
+    static_assert(root_two * root_two - 2.0 < 1e-15 && 2.0 - root_two * root_two < 1e-15);
+}
+BOOST_AUTO_TEST_SUITE_END()
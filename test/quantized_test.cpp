@@ -0,0 +1,122 @@
+#include <ShivLib/dataStructures/dyn_matrix.hpp>
+#include <ShivLib/dataStructures/matrix_view.hpp>
+#include <ShivLib/dataStructures/quantized.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace {
+shiv::DynMatrix<float> random_matrix(size_t rows, size_t cols, float low, float high,
+                                     unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<float> distribution{low, high};
+    shiv::DynMatrix<float> result{rows, cols};
+    for (size_t i{0}; i < rows; ++i) {
+        for (size_t j{0}; j < cols; ++j) {
+            result[i][j] = distribution(generator);
+        }
+    }
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(quantized_test)
+BOOST_AUTO_TEST_CASE(widening_product_test) {
+    // 127 * 127 * 3 is far past int8 and int16
+    constexpr shiv::Matrix<int8_t, 2, 3> lhs{{{{127, 127, 127}, {-128, 0, 1}}}};
+    constexpr shiv::Matrix<uint8_t, 3, 2> rhs{{{{255, 0}, {255, 1}, {255, 2}}}};
+    constexpr auto at_compile_time{shiv::widening_product(lhs, rhs)};
+    static_assert(at_compile_time[0][0] == 127 * 255 * 3);
+    static_assert(at_compile_time[1][0] == -128 * 255 + 255);
+    const auto at_run_time{shiv::widening_product(lhs, rhs)};
+    BOOST_TEST((at_run_time == at_compile_time));
+
+    const shiv::DynMatrix<uint8_t> dynamic_lhs{{1, 2}, {3, 4}, {200, 100}};
+    const shiv::DynMatrix<int8_t> dynamic_rhs{{-1, 2, 3}, {4, -128, 6}};
+    const auto product{shiv::widening_product(dynamic_lhs, dynamic_rhs)};
+    BOOST_TEST(product.rows() == 3U);
+    BOOST_TEST(product[0][1] == 2 - 256);
+    BOOST_TEST(product[2][1] == 400 - 12800);
+    BOOST_CHECK_THROW((void)shiv::widening_product(dynamic_rhs, dynamic_rhs),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(quantize_test) {
+    const shiv::DynMatrix<float> matrix{{-1.0F, 0.5F, 0.25F}, {0.0F, 2.0F, 4.0F}};
+    const auto by_row{shiv::quantize<int8_t>(matrix, shiv::QuantizeAxis::rows)};
+    BOOST_TEST(by_row.scales[1] == 4.0F / 127);
+    BOOST_TEST(by_row.zero_points[0] == 0);
+    BOOST_TEST(by_row.values[0][0] == -127);
+    BOOST_TEST(by_row.values[1][2] == 127);
+    BOOST_TEST(by_row.values[0][1] == 64);
+
+    // affine, zero stays exact and the range is used end to end
+    const auto by_col{shiv::quantize<uint8_t>(matrix, shiv::QuantizeAxis::cols)};
+    BOOST_TEST(by_col.scales.size() == 3U);
+    BOOST_TEST(by_col.values[0][0] == 0);
+    BOOST_TEST(by_col.values[1][0] == by_col.zero_points[0]);
+    BOOST_TEST(by_col.values[1][2] == 255);
+    BOOST_TEST(by_col.zero_points[2] == 0);
+
+    // a transposed view quantized by column is the matrix quantized by row, transposed
+    const shiv::MatrixView<const float> view{matrix};
+    const auto transposed{shiv::quantize<int8_t>(view.transposed(), shiv::QuantizeAxis::cols)};
+    BOOST_TEST(transposed.scales == by_row.scales);
+    BOOST_TEST((transposed.values == by_row.values.get_transpose()));
+
+    // every element is within half a step of where it started
+    const auto wide{random_matrix(37, 70, -3, 5, 1)};
+    for (const auto axis : {shiv::QuantizeAxis::rows, shiv::QuantizeAxis::cols}) {
+        const auto narrow{shiv::quantize<int8_t>(wide, axis)};
+        const auto affine{shiv::quantize<uint8_t>(wide, axis)};
+        const auto back{narrow.dequantize()};
+        const auto affine_back{affine.dequantize()};
+        for (size_t i{0}; i < wide.rows(); ++i) {
+            for (size_t j{0}; j < wide.cols(); ++j) {
+                const size_t which{axis == shiv::QuantizeAxis::rows ? i : j};
+                BOOST_TEST(std::abs(back[i][j] - wide[i][j]) <= narrow.scales[which] * 0.501F);
+                BOOST_TEST(std::abs(affine_back[i][j] - wide[i][j]) <=
+                           affine.scales[which] * 0.501F);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(product_test) {
+    constexpr size_t m{45};
+    constexpr size_t k{300};
+    constexpr size_t n{70};
+    const auto activations{random_matrix(m, k, 0, 6, 2)};
+    const auto weights{random_matrix(k, n, -1, 1, 3)};
+    const auto expected{activations * weights};
+    const auto weights_q{shiv::quantize<int8_t>(weights, shiv::QuantizeAxis::cols)};
+
+    // the integer path gives exactly the product of the dequantized matrices, up to float
+    // rounding, for symmetric and affine left hand sides alike
+    const auto signed_q{shiv::quantize<int8_t>(activations, shiv::QuantizeAxis::rows)};
+    const auto unsigned_q{shiv::quantize<uint8_t>(activations, shiv::QuantizeAxis::rows)};
+    const auto reference{signed_q.dequantize() * weights_q.dequantize()};
+    const auto affine_reference{unsigned_q.dequantize() * weights_q.dequantize()};
+    const auto product{signed_q * weights_q};
+    const auto affine_product{unsigned_q * weights_q};
+    BOOST_TEST(product.rows() == m);
+    BOOST_TEST(affine_product.cols() == n);
+    float largest{0};
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            largest = std::max(largest, std::abs(expected[i][j]));
+            BOOST_TEST(std::abs(product[i][j] - reference[i][j]) < 1e-3F);
+            BOOST_TEST(std::abs(affine_product[i][j] - affine_reference[i][j]) < 1e-3F);
+        }
+    }
+    // and is close to the float product
+    for (size_t i{0}; i < m; ++i) {
+        for (size_t j{0}; j < n; ++j) {
+            BOOST_TEST(std::abs(affine_product[i][j] - expected[i][j]) < 0.02F * largest);
+        }
+    }
+    BOOST_CHECK_THROW((void)(weights_q * signed_q), std::invalid_argument);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+#include <ShivLib/dataStructures/rope.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+std::string flatten(const shiv::Rope& rope) {
+    std::string result{};
+    for (const auto chunk : rope.chunks()) {
+        result.append(chunk.data(), chunk.size());
+    }
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(rope_test)
+BOOST_AUTO_TEST_CASE(edit_test) {
+    shiv::Rope rope{"8=FIX.4.4|35=D|"};
+    rope.append("55=VOD.L|");
+    rope.insert(0, "[");
+    rope += "]";
+    BOOST_TEST((rope == "[8=FIX.4.4|35=D|55=VOD.L|]"));
+    rope.erase(1, 10);
+    BOOST_TEST((rope == "[35=D|55=VOD.L|]"));
+    rope.erase(6);
+    BOOST_TEST((rope == "[35=D|"));
+    BOOST_TEST(rope.at(1) == '3');
+    BOOST_CHECK_THROW((void)rope.at(6), std::out_of_range);
+    BOOST_CHECK_THROW(rope.insert(7, "x"), std::out_of_range);
+    rope.prepend(shiv::Rope{"head"});
+    BOOST_TEST((rope.substr(2, 4) == "ad[3"));
+    BOOST_TEST((rope.substr(4) == "[35=D|"));
+    BOOST_TEST(rope.substr(10).empty());
+    rope.clear();
+    BOOST_TEST(rope.empty());
+    BOOST_TEST(rope.flatten().empty());
+}
+
+BOOST_AUTO_TEST_CASE(random_edit_test) {
+    // the same edits on a rope and a std::string, with pieces either side of merge_limit
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+    std::uniform_int_distribution<int> operation{0, 4};
+    std::uniform_int_distribution<size_t> length{0, 2 * shiv::Rope::merge_limit};
+    shiv::Rope rope{};
+    std::string expected{};
+    for (int i{0}; i < 2000; ++i) {
+        std::string piece(length(generator) / (i % 3 == 0 ? 1 : 64), ' ');
+        for (auto& c : piece) {
+            c = static_cast<char>(letter(generator));
+        }
+        const size_t index{std::uniform_int_distribution<size_t>{0, expected.size()}(generator)};
+        const size_t count{length(generator)};
+        switch (operation(generator)) {
+        case 0:
+            rope.append(shiv::StringView<char>{piece});
+            expected += piece;
+            break;
+        case 1:
+            rope.prepend(shiv::Rope{shiv::StringView<char>{piece}});
+            expected.insert(0, piece);
+            break;
+        case 2:
+        case 3:
+            rope.insert(index, shiv::StringView<char>{piece});
+            expected.insert(index, piece);
+            break;
+        default:
+            rope.erase(index, count);
+            expected.erase(index, count);
+            break;
+        }
+        BOOST_REQUIRE(rope.size() == expected.size());
+    }
+    BOOST_TEST(flatten(rope) == expected);
+    for (size_t index{0}; index < expected.size(); index += 97) {
+        BOOST_REQUIRE(rope[index] == expected[index]);
+    }
+    const size_t middle{expected.size() / 2};
+    BOOST_TEST(flatten(rope.substr(middle, 1000)) == expected.substr(middle, 1000));
+
+    // AVL balanced, so at most 1.44 log2 of the chunk count deep
+    size_t chunks{0};
+    for (const auto chunk : rope.chunks()) {
+        BOOST_REQUIRE(!chunk.empty());
+        ++chunks;
+    }
+    BOOST_TEST(rope.depth() <= 1.45 * std::log2(static_cast<double>(chunks) + 2));
+}
+
+BOOST_AUTO_TEST_CASE(sharing_test) {
+    std::string text(4000, 'x');
+    text[1234] = 'y';
+    const shiv::Rope original{shiv::StringView<char>{text}};
+    // a copy and a substr share the original's chunk
+    shiv::Rope copy{original};
+    const shiv::Rope middle{original.substr(1000, 500)};
+    const void* shared{(*middle.chunks().begin()).data()};
+    const void* expected{(*original.chunks().begin()).data() + 1000};
+    BOOST_TEST(shared == expected);
+    copy.insert(2000, "inserted");
+    BOOST_TEST((original == shiv::StringView<char>{text}));
+    BOOST_TEST(copy.size() == text.size() + 8);
+    BOOST_TEST(middle[234] == 'y');
+    // appending to a rope that shares its last chunk copies rather than writing into it
+    shiv::Rope head{original.substr(0, 100)};
+    head.append("zz");
+    shiv::Rope grown{copy};
+    grown.append("zz");
+    BOOST_TEST(original[100] == 'x');
+    BOOST_TEST(copy.size() == text.size() + 8);
+    BOOST_TEST((head.substr(98) == "xxzz"));
+
+    // the same text split into different chunks still compares equal
+    shiv::Rope pieces{};
+    for (size_t i{0}; i < text.size(); i += 700) {
+        pieces.append(shiv::Rope{shiv::StringView<char>{text}.substr(i, 700)});
+    }
+    BOOST_TEST((pieces == original));
+    BOOST_TEST(!(pieces == copy));
+    const shiv::Rope doubled{pieces + pieces};
+    BOOST_TEST(flatten(doubled) == text + text);
+
+    // flatten leaves a single chunk, and a copy taken before keeps its own tree
+    const shiv::Rope before{pieces};
+    BOOST_TEST(pieces.depth() > 0U);
+    BOOST_TEST((pieces.flatten() == shiv::StringView<char>{text}));
+    BOOST_TEST(pieces.depth() == 0U);
+    BOOST_TEST(before.depth() > 0U);
+    BOOST_TEST((before == pieces));
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+#include <ShivLib/multithreading/sharded_counter.hpp>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(sharded_counter_test)
+BOOST_AUTO_TEST_CASE(counter_test) {
+    shiv::ShardedCounter<> counter{};
+    ++counter;
+    counter += 4;
+    counter.increment();
+    BOOST_TEST(counter.value() == 6);
+    counter.reset();
+    BOOST_TEST(counter.value() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(gauge_test) {
+    shiv::ShardedGauge<shiv::ShardBy::cpu> gauge{4};
+    BOOST_TEST(gauge.shard_count() == 4U);
+    gauge += 10;
+    gauge.decrement();
+    gauge -= 12;
+    BOOST_TEST(gauge.value() == -3);
+    gauge.set(42);
+    BOOST_TEST(gauge.value() == 42);
+
+    BOOST_CHECK_THROW(shiv::ShardedGauge<>{0}, std::invalid_argument);
+    BOOST_CHECK_THROW(shiv::ShardedGauge<>{6}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test) {
+    constexpr int threads{8};
+    constexpr int iterations{100000};
+    shiv::ShardedCounter<> thread_counter{2};
+    shiv::ShardedCounter<shiv::ShardBy::cpu> cpu_counter{};
+    std::vector<std::thread> workers{};
+    for (int t{0}; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i{0}; i < iterations; ++i) {
+                thread_counter.increment();
+                cpu_counter.increment();
+            }
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    BOOST_TEST(thread_counter.value() == threads * iterations);
+    BOOST_TEST(cpu_counter.value() == threads * iterations);
+}
+
+BOOST_AUTO_TEST_CASE(registry_test) {
+    shiv::CounterRegistry registry{};
+    {
+        shiv::ShardedCounter<> requests{"requests", registry};
+        shiv::ShardedGauge<> sessions{"sessions", registry};
+        requests += 3;
+        sessions += 2;
+        auto samples{registry.snapshot()};
+        BOOST_TEST(samples.size() == 2U);
+        BOOST_TEST(samples[0].name == "requests");
+        BOOST_TEST((samples[0].kind == shiv::MetricKind::counter));
+        BOOST_TEST(samples[0].value == 3);
+        BOOST_TEST(samples[1].name == "sessions");
+        BOOST_TEST((samples[1].kind == shiv::MetricKind::gauge));
+        BOOST_TEST(samples[1].value == 2);
+    }
+    BOOST_TEST(registry.size() == 0U);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,79 @@
+#include <ShivLib/dataStructures/matrix.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+template <typename T, size_t n>
+shiv::Matrix<T, n, n> random_matrix(std::mt19937& generator) {
+    std::uniform_real_distribution<T> distribution{-2, 2};
+    shiv::Matrix<T, n, n> matrix{};
+    for (auto&& value : matrix) {
+        value = distribution(generator);
+    }
+    return matrix;
+}
+
+// the specialised kernels against the generic ones Matrix uses for every other size
+template <typename T, size_t n>
+void check_against_generic(T tolerance) {
+    std::mt19937 generator{static_cast<unsigned>(n)};
+    for (int iteration{0}; iteration < 20; ++iteration) {
+        const auto lhs{random_matrix<T, n>(generator)};
+        const auto rhs{random_matrix<T, n>(generator)};
+
+        const auto product{lhs * rhs};
+        const auto transpose{lhs.get_transpose()};
+        const auto inverse{lhs.get_inverse()};
+        const shiv::LU lu{lhs};
+        const auto lu_inverse{lu.inverse()};
+        BOOST_TEST(std::abs(lhs.get_determinant() - lu.determinant()) < tolerance);
+        for (size_t i{0}; i < n; ++i) {
+            for (size_t j{0}; j < n; ++j) {
+                T sum{0};
+                for (size_t k{0}; k < n; ++k) {
+                    sum += lhs[i][k] * rhs[k][j];
+                }
+                BOOST_TEST(std::abs(product[i][j] - sum) < tolerance);
+                BOOST_TEST(transpose[j][i] == lhs[i][j]);
+                BOOST_TEST(std::abs(inverse[i][j] - lu_inverse[i][j]) <
+                           tolerance * (1 + std::abs(lu_inverse[i][j])));
+            }
+        }
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(small_matrix_test)
+BOOST_AUTO_TEST_CASE(float_test) {
+    check_against_generic<float, 2>(1e-3F);
+    check_against_generic<float, 3>(1e-3F);
+    check_against_generic<float, 4>(1e-3F);
+}
+
+BOOST_AUTO_TEST_CASE(double_test) {
+    check_against_generic<double, 2>(1e-9);
+    check_against_generic<double, 3>(1e-9);
+    check_against_generic<double, 4>(1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(singular_test) {
+    const shiv::Matrix<double, 4, 4> matrix{
+        {{{1, 2, 3, 4}, {2, 4, 6, 8}, {0, 1, 0, 1}, {5, 0, 2, 1}}}};
+    BOOST_TEST(matrix.get_determinant() == 0.0);
+    BOOST_CHECK_THROW((void)matrix.get_inverse(), std::domain_error);
+    BOOST_CHECK_THROW((void)(shiv::Matrix<float, 2, 2>{}.get_inverse()), std::domain_error);
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+    constexpr shiv::Matrix<double, 4, 4> matrix{
+        {{{2, 0, 0, 1}, {0, 4, 0, 0}, {0, 0, 8, 0}, {0, 0, 0, 1}}}};
+    static_assert(matrix.get_determinant() == 64.0);
+    static_assert(matrix * matrix.get_inverse() == matrix.get_identity());
+    static_assert(matrix.get_transpose()[3][0] == 1.0);
+    constexpr shiv::Matrix<float, 3, 3> rotation{{{{0, -1, 0}, {1, 0, 0}, {0, 0, 1}}}};
+    static_assert(rotation.get_inverse() == rotation.get_transpose());
+    static_assert(rotation.is_orthogonal());
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+#include <ShivLib/dataStructures/sparse_matrix.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+// a random coo list with repeated positions, alongside the dense matrix it should compress to
+template <typename T, typename Index>
+std::pair<shiv::CooMatrix<T, Index>, shiv::DynMatrix<T>> random_coo(size_t rows, size_t cols,
+                                                                     size_t count, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<size_t> row{0, rows - 1};
+    std::uniform_int_distribution<size_t> col{0, cols - 1};
+    std::uniform_int_distribution<int> value{-4, 4};
+    shiv::CooMatrix<T, Index> coo{rows, cols};
+    shiv::DynMatrix<T> dense{rows, cols};
+    for (size_t k{0}; k < count; ++k) {
+        const size_t i{row(generator)};
+        const size_t j{col(generator)};
+        const T entry{static_cast<T>(value(generator))};
+        coo.add(i, j, entry);
+        dense[i][j] += entry;
+    }
+    return {coo, dense};
+}
+
+template <typename T, shiv::SparseFormat format, typename Index>
+void check_products(size_t rows, size_t cols, size_t count) {
+    const auto [coo, dense]{random_coo<T, Index>(rows, cols, count, 7)};
+    const shiv::SparseMatrix<T, format, Index> sparse{coo};
+    BOOST_TEST((sparse.to_dense() == dense));
+
+    shiv::Vector<T> x(cols);
+    for (size_t j{0}; j < cols; ++j) {
+        x.push_back(static_cast<T>(j % 7) - 3);
+    }
+    const auto y{sparse * x};
+    BOOST_TEST(y.size() == rows);
+    for (size_t i{0}; i < rows; ++i) {
+        T expected{};
+        for (size_t j{0}; j < cols; ++j) {
+            expected += dense[i][j] * x[j];
+        }
+        BOOST_TEST(y[i] == expected);
+    }
+
+    shiv::DynMatrix<T> rhs{cols, 5};
+    for (size_t i{0}; i < cols; ++i) {
+        for (size_t j{0}; j < 5; ++j) {
+            rhs[i][j] = static_cast<T>((i + j) % 5) - 2;
+        }
+    }
+    BOOST_TEST(((sparse * rhs) == (dense * rhs)));
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(sparse_matrix_test)
+BOOST_AUTO_TEST_CASE(compress_test) {
+    shiv::CooMatrix<double> coo{3, 4};
+    coo.add(2, 1, 5);
+    coo.add(0, 3, 1);
+    coo.add(0, 0, 2);
+    coo.add(2, 1, -1);
+    coo.add(1, 2, 3);
+    BOOST_CHECK_THROW(coo.add(3, 0, 1), std::out_of_range);
+    BOOST_TEST(coo.size() == 5U);
+
+    const shiv::CsrMatrix<double> csr{coo};
+    BOOST_TEST(csr.nonzeros() == 4U);
+    const shiv::Vector<uint32_t> offsets{0, 2, 3, 4};
+    const shiv::Vector<uint32_t> indices{0, 3, 2, 1};
+    const shiv::Vector<double> values{2, 1, 3, 4};
+    BOOST_TEST((csr.offsets() == offsets));
+    BOOST_TEST((csr.indices() == indices));
+    BOOST_TEST((csr.values() == values));
+    BOOST_TEST(csr(2, 1) == 4.0);
+    BOOST_TEST(csr(2, 2) == 0.0);
+    BOOST_TEST(csr.at(0, 3) == 1.0);
+    BOOST_CHECK_THROW((void)csr.at(0, 4), std::out_of_range);
+
+    const shiv::CscMatrix<double> csc{coo};
+    BOOST_TEST(csc.offsets().size() == 5U);
+    BOOST_TEST(csc(2, 1) == 4.0);
+    BOOST_TEST((csc.to_csr() == csr));
+    BOOST_TEST((csr.to_csc() == csc));
+    BOOST_TEST((csc.to_dense() == csr.to_dense()));
+
+    const auto transpose{csr.get_transpose()};
+    BOOST_TEST(transpose.rows() == 4U);
+    BOOST_TEST(transpose.cols() == 3U);
+    BOOST_TEST((transpose.to_dense() == csr.to_dense().get_transpose()));
+    BOOST_TEST((transpose.get_transpose() == csr));
+}
+
+BOOST_AUTO_TEST_CASE(index_width_test) {
+    const auto [coo, dense]{random_coo<float, uint64_t>(50, 40, 300, 3)};
+    const shiv::CsrMatrix<float, uint64_t> wide{coo};
+    const auto [narrow_coo, narrow_dense]{random_coo<float, uint32_t>(50, 40, 300, 3)};
+    const shiv::CsrMatrix<float> narrow{narrow_coo};
+    BOOST_TEST((wide.to_dense() == narrow.to_dense()));
+    BOOST_TEST(narrow.storage_bytes() < wide.storage_bytes());
+    BOOST_CHECK_THROW((shiv::CooMatrix<float, uint8_t>{256, 2}), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(product_test) {
+    // small integers keep every sum exact, whichever order the kernels add in
+    check_products<float, shiv::SparseFormat::csr, uint32_t>(61, 45, 400);
+    check_products<double, shiv::SparseFormat::csr, uint32_t>(61, 45, 400);
+    check_products<double, shiv::SparseFormat::csr, uint64_t>(61, 45, 400);
+    check_products<int, shiv::SparseFormat::csr, uint32_t>(61, 45, 400);
+    check_products<double, shiv::SparseFormat::csc, uint32_t>(61, 45, 400);
+    // enough nonzeros to be shared out over the pool
+    shiv::set_matrix_threads(4);
+    check_products<double, shiv::SparseFormat::csr, uint32_t>(2000, 300, 200000);
+    shiv::set_matrix_threads(0);
+
+    const shiv::CsrMatrix<double> sparse{3, 4};
+    BOOST_CHECK_THROW((void)(sparse * shiv::Vector<double>{1, 2, 3}), std::invalid_argument);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+#include <ShivLib/dataStructures/split.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace {
+template <typename Range>
+std::vector<std::string> collect(const Range& range) {
+    std::vector<std::string> tokens{};
+    for (const auto token : range) {
+        tokens.emplace_back(token.data(), token.size());
+    }
+    return tokens;
+}
+
+// the tokens by plain string searching, what the splits are checked against
+std::vector<std::string> reference_split(const std::string& text, const std::string& delimiters,
+                                         bool any_of, shiv::EmptyTokens empty) {
+    std::vector<std::string> tokens{};
+    if (text.empty()) {
+        return tokens;
+    }
+    size_t begin{0};
+    while (true) {
+        const size_t end{any_of ? text.find_first_of(delimiters, begin)
+                                : text.find(delimiters, begin)};
+        const std::string token{text.substr(begin, end - begin)};
+        if (empty == shiv::EmptyTokens::keep || !token.empty()) {
+            tokens.push_back(token);
+        }
+        if (end == std::string::npos) {
+            return tokens;
+        }
+        begin = end + (any_of ? 1 : delimiters.size());
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(split_test)
+BOOST_AUTO_TEST_CASE(delimiter_test) {
+    static_assert(std::ranges::forward_range<shiv::SplitRange<char>>);
+    using tokens = std::vector<std::string>;
+    BOOST_TEST(collect(shiv::split("a,,b,", ',')) == (tokens{"a", "", "b", ""}));
+    BOOST_TEST(collect(shiv::split("a,,b,", ',', shiv::EmptyTokens::skip)) == (tokens{"a", "b"}));
+    BOOST_TEST(collect(shiv::split(",,,", ',', shiv::EmptyTokens::skip)).empty());
+    BOOST_TEST(collect(shiv::split("", ',')).empty());
+    BOOST_TEST(collect(shiv::split("abc", ',')) == (tokens{"abc"}));
+    BOOST_TEST(collect(shiv::split("8=FIX.4.4\r\n35=D\r\n\r\n", "\r\n")) ==
+               (tokens{"8=FIX.4.4", "35=D", "", ""}));
+    BOOST_TEST(collect(shiv::split("a---b", "--")) == (tokens{"a", "-b"}));
+    BOOST_TEST(collect(shiv::split("a-b--c-", "--")) == (tokens{"a-b", "c-"}));
+    const shiv::CharSet whitespace{" \t\n"};
+    BOOST_TEST(collect(shiv::split("  GET\t/index.html HTTP/1.1\n", whitespace,
+                                   shiv::EmptyTokens::skip)) ==
+               (tokens{"GET", "/index.html", "HTTP/1.1"}));
+
+    // iterators can be copied and walked independently
+    const auto range{shiv::split("x|y|z", '|')};
+    auto first{range.begin()};
+    auto second{first};
+    ++second;
+    BOOST_TEST(((*first == "x") && (*second == "y")));
+    BOOST_TEST(std::ranges::distance(range) == 3);
+}
+
+BOOST_AUTO_TEST_CASE(random_test) {
+    // long lines with delimiters dense and sparse, so tokens cross register boundaries and the
+    // scanner steps over registers without a match
+    std::mt19937 generator{11};
+    for (const int density : {2, 8, 200}) {
+        std::uniform_int_distribution<int> pick{0, density};
+        std::string text(3000, ' ');
+        for (auto& c : text) {
+            const int r{pick(generator)};
+            c = r == 0 ? ',' : r == 1 ? ';' : static_cast<char>('a' + r % 26);
+        }
+        for (const auto empty : {shiv::EmptyTokens::keep, shiv::EmptyTokens::skip}) {
+            for (size_t offset{0}; offset < 70; offset += 23) {
+                const std::string line{text.substr(offset)};
+                BOOST_TEST(collect(shiv::split(line, ',', empty)) ==
+                           reference_split(line, ",", false, empty));
+                BOOST_TEST(collect(shiv::split(line, ",;", empty)) ==
+                           reference_split(line, ",;", false, empty));
+                BOOST_TEST(collect(shiv::split(line, shiv::CharSet{",;"}, empty)) ==
+                           reference_split(line, ",;", true, empty));
+            }
+        }
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+#include <ShivLib/dataStructures/string_pool.hpp>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(string_pool_test)
+BOOST_AUTO_TEST_CASE(intern_test) {
+    shiv::StringPool pool{};
+    BOOST_TEST(pool.size() == 1U);
+    BOOST_TEST(pool.view(shiv::Symbol{}).empty());
+    BOOST_TEST((pool.intern("") == shiv::Symbol{}));
+
+    const shiv::Symbol vod{pool.intern("VOD.L")};
+    const shiv::Symbol barc{pool.intern("BARC.L")};
+    BOOST_TEST((vod != barc));
+    BOOST_TEST((pool.intern(std::string{"VOD.L"}) == vod));
+    BOOST_TEST((pool[vod] == "VOD.L"));
+    BOOST_TEST(pool.size() == 3U);
+    BOOST_TEST((pool.find("BARC.L") == barc));
+    BOOST_TEST(!pool.find("HSBA.L").has_value());
+    BOOST_TEST(pool.size() == 3U);
+
+    std::unordered_map<shiv::Symbol, int> positions{};
+    positions[vod] = 100;
+    positions[pool.intern("VOD.L")] += 20;
+    BOOST_TEST(positions.at(vod) == 120);
+}
+
+BOOST_AUTO_TEST_CASE(growth_test) {
+    // enough strings to grow the table and entries several times and fill many arena blocks,
+    // the views handed out first must still read the same afterwards
+    shiv::StringPool pool{};
+    const std::string long_string(30'000, 'z');
+    const shiv::Symbol first{pool.intern("first")};
+    const shiv::StringView<char> first_view{pool[first]};
+    const shiv::Symbol long_symbol{pool.intern(long_string)};
+    std::vector<shiv::Symbol> symbols{};
+    for (int i{0}; i < 50'000; ++i) {
+        symbols.push_back(pool.intern("symbol_" + std::to_string(i)));
+    }
+    BOOST_TEST(pool.size() == 50'003U);
+    BOOST_TEST((first_view == "first"));
+    BOOST_TEST(first_view.data() == pool[first].data());
+    BOOST_TEST((pool[long_symbol] == shiv::StringView<char>{long_string}));
+    for (int i{0}; i < 50'000; i += 997) {
+        BOOST_REQUIRE((pool[symbols[static_cast<size_t>(i)]] == "symbol_" + std::to_string(i)));
+        BOOST_REQUIRE((pool.intern("symbol_" + std::to_string(i)) ==
+                       symbols[static_cast<size_t>(i)]));
+    }
+    BOOST_TEST(pool.memory_usage() > 50'000U * 12);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test) {
+    // threads interning overlapping ranges must agree on one symbol per string
+    shiv::StringPool pool{};
+    constexpr int threads{4};
+    constexpr int count{20'000};
+    std::vector<std::vector<shiv::Symbol>> results(threads);
+    std::vector<std::thread> workers{};
+    for (int t{0}; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i{0}; i < count; ++i) {
+                const int key{(i + t * count / 2) % (2 * count)};
+                results[static_cast<size_t>(t)].push_back(
+                    pool.intern("key_" + std::to_string(key)));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    BOOST_TEST(pool.size() == 2U * count + 1);
+    for (int t{0}; t < threads; ++t) {
+        for (int i{0}; i < count; i += 101) {
+            const int key{(i + t * count / 2) % (2 * count)};
+            const shiv::Symbol symbol{results[static_cast<size_t>(t)][static_cast<size_t>(i)]};
+            BOOST_REQUIRE((pool[symbol] == "key_" + std::to_string(key)));
+            BOOST_REQUIRE((pool.find("key_" + std::to_string(key)) == symbol));
+        }
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+#include <ShivLib/dataStructures/string.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace {
+size_t allocations{0};
+
+// std::allocator that counts the buffers it hands out
+template <typename T>
+struct CountingAllocator : std::allocator<T> {
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U>;
+    };
+
+    CountingAllocator() noexcept = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {
+    }
+
+    T* allocate(size_t count) {
+        ++allocations;
+        return std::allocator<T>::allocate(count);
+    }
+};
+using CountedString = shiv::String<char, CountingAllocator<char>>;
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(string_test)
+BOOST_AUTO_TEST_CASE(short_string_test) {
+    static_assert(sizeof(shiv::string) == 24);
+    static_assert(shiv::string::short_capacity == 23);
+    static_assert(shiv::String<char16_t>::short_capacity == 11);
+    static_assert(sizeof(CountedString) == 24);
+
+    allocations = 0;
+    const CountedString empty{};
+    BOOST_TEST(empty.empty());
+    BOOST_TEST(*empty.c_str() == '\0');
+    const CountedString key{"EURUSD.SPOT.LDN"};
+    BOOST_TEST(key.size() == 15U);
+    BOOST_TEST((key == "EURUSD.SPOT.LDN"));
+    // 23 characters, the terminator is the byte that counts the room left
+    CountedString full{"abcdefghijklmnopqrstuvw"};
+    BOOST_TEST(full.size() == 23U);
+    BOOST_TEST(full.capacity() == 23U);
+    BOOST_TEST(full.c_str()[23] == '\0');
+    const CountedString copied{full};
+    CountedString moved{std::move(full)};
+    BOOST_TEST(allocations == 0U);
+    BOOST_TEST((copied == moved));
+    BOOST_TEST(full.empty());
+
+    const shiv::String<char16_t> wide{u"short key"};
+    BOOST_TEST(wide.size() == 9U);
+    BOOST_TEST((wide == u"short key"));
+}
+
+BOOST_AUTO_TEST_CASE(long_string_test) {
+    allocations = 0;
+    CountedString text{"abcdefghijklmnopqrstuvw"};
+    text.push_back('x');
+    BOOST_TEST(allocations == 1U);
+    BOOST_TEST(text.size() == 24U);
+    BOOST_TEST(text.capacity() == 46U);
+    BOOST_TEST((text == "abcdefghijklmnopqrstuvwx"));
+    BOOST_TEST(text.c_str()[24] == '\0');
+    // growth doubles, so a run of appends allocates a handful of times
+    for (size_t i{0}; i < 1000; ++i) {
+        text += 'y';
+    }
+    BOOST_TEST(text.size() == 1024U);
+    BOOST_TEST(allocations <= 7U);
+
+    // appending a string to itself reads from the buffer that is being replaced
+    CountedString twice{"0123456789"};
+    twice.append(twice);
+    twice.append(twice);
+    twice.append(twice.view().substr(5, 10));
+    BOOST_TEST((twice == "01234567890123456789012345678901234567895678901234"));
+
+    text.shrink_to_fit();
+    BOOST_TEST(text.capacity() == 1024U);
+    text.resize(20);
+    text.shrink_to_fit();
+    BOOST_TEST(text.capacity() == 23U);
+    BOOST_TEST((text == "abcdefghijklmnopqrst"));
+
+    CountedString assigned{};
+    assigned = twice;
+    BOOST_TEST((assigned == twice));
+    assigned = CountedString{"short"};
+    BOOST_TEST((assigned == "short"));
+    assigned = std::move(twice);
+    BOOST_TEST(assigned.size() == 50U);
+    BOOST_TEST(twice.empty());
+}
+
+BOOST_AUTO_TEST_CASE(resize_test) {
+    shiv::string text{"key"};
+    text.resize(6, '-');
+    BOOST_TEST((text == "key---"));
+    text.resize(2);
+    BOOST_TEST((text == "ke"));
+    text.append(3, 'y');
+    BOOST_TEST((text == "keyyy"));
+    text.pop_back();
+    BOOST_TEST(text.back() == 'y');
+    BOOST_TEST(text.at(1) == 'e');
+    BOOST_CHECK_THROW((void)text.at(4), std::out_of_range);
+
+    // room for a formatter to write into directly
+    shiv::string number{"id="};
+    number.resize_for_overwrite(3 + 40);
+    for (size_t i{3}; i < number.size(); ++i) {
+        number[i] = static_cast<char>('0' + i % 10);
+    }
+    BOOST_TEST(number.size() == 43U);
+    BOOST_TEST(number.c_str()[43] == '\0');
+    BOOST_TEST(number.view().starts_with("id=3456"));
+
+    shiv::string reserved{"abc"};
+    reserved.reserve(100);
+    BOOST_TEST(reserved.capacity() == 100U);
+    BOOST_TEST((reserved == "abc"));
+    reserved.clear();
+    BOOST_TEST(reserved.empty());
+}
+
+BOOST_AUTO_TEST_CASE(view_test) {
+    const shiv::string text{"35=D|49=ABC|56=XYZ"};
+    const shiv::StringView<char> view{text};
+    BOOST_TEST(view.data() == text.data());
+    BOOST_TEST(text.view().find('|') == 4U);
+    BOOST_TEST(text.compare("35=D") > 0);
+    BOOST_TEST((std::string{text.begin(), text.end()} == "35=D|49=ABC|56=XYZ"));
+
+    shiv::string first{"first"};
+    shiv::string second{"a much longer second string"};
+    first.swap(second);
+    BOOST_TEST((first == "a much longer second string"));
+    BOOST_TEST((second == "first"));
+}
+BOOST_AUTO_TEST_SUITE_END()
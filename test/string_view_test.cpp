@@ -1,8 +1,22 @@
 #include <ShivLib/dataStructures/string_view.hpp>
 #include <boost/test/unit_test.hpp>
+#include <random>
 #include <string>
 #include <string_view>
 
+namespace {
+// text from a small alphabet so short needles match often and long ones rarely
+std::string random_text(size_t length, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<int> distribution{'a', 'e'};
+    std::string result(length, ' ');
+    for (auto& c : result) {
+        c = static_cast<char>(distribution(generator));
+    }
+    return result;
+}
+} // namespace
+
 BOOST_AUTO_TEST_SUITE(string_view_test)
 BOOST_AUTO_TEST_CASE(trim_test) {
     std::string test_string{"    Hello, world  "};
@@ -34,10 +48,118 @@ BOOST_AUTO_TEST_CASE(comparison_test) {
     shiv::StringView shiv_view2{"zzzzzzzzz"};
     std::string_view std_view{"hello, world"};
     std::string_view std_view2{"zzzzzzzzz"};
-    BOOST_TEST(shiv_view.compare(shiv_view2) == std_view.compare(std_view2));
+    BOOST_TEST((shiv_view.compare(shiv_view2) < 0) == (std_view.compare(std_view2) < 0));
+    BOOST_TEST(shiv_view.compare(shiv_view2) == -1);
     BOOST_TEST(shiv_view2.compare("zzzzzzzzz") == 0);
-    BOOST_TEST(shiv_view2.compare("zzzzzzzzzzzz") == -3);
+    BOOST_TEST(shiv_view2.compare("zzzzzzzzzzzz") == -1);
+    BOOST_TEST(shiv::StringView{"zzzzzzzzzzzz"}.compare(shiv_view2) == 1);
+    // lengths differing by a multiple of 2^32 still order, only the first byte is read
+    const shiv::StringView<char> one{"z", 1};
+    const shiv::StringView<char> huge{"z", (size_t{1} << 32) + 1};
+    BOOST_TEST(one.compare(huge) == -1);
+    BOOST_TEST(huge.compare(one) == 1);
     BOOST_TEST(shiv_view.compare(7, 5, shiv::StringView{"world"}) == 0);
     BOOST_TEST(shiv_view.compare(7, 5, shiv::StringView{"zzzworld"}, 3, 5) == 0);
+
+    // the length is checked before the characters
+    BOOST_TEST(!(shiv::StringView{"hello"} == shiv::StringView{"hello, world"}));
+    BOOST_TEST(!(shiv::StringView{"hello, world"} == shiv::StringView{"hello"}));
+    // bytes past 127 order after ascii, as in std::string_view
+    BOOST_TEST(shiv::StringView{"\xE9"}.compare("e") > 0);
+    static_assert(shiv::StringView{"abc"}.compare("abd") < 0);
+    // memcmp at run time gives the same -1 or 1 as the loop at compile time
+    constexpr int at_compile_time{shiv::StringView{"abc"}.compare("azc")};
+    static_assert(at_compile_time == -1);
+    BOOST_TEST(shiv::StringView{"abc"}.compare("azc") == at_compile_time);
+    BOOST_TEST(shiv::StringView{"\xE9"}.compare("e") == 1);
+    static_assert(shiv::StringView{"abc"} == shiv::StringView{"abc"});
+    static_assert(!(shiv::StringView{"abc"} == shiv::StringView{"abcd"}));
+
+    const std::string long_string{random_text(1000, 1)};
+    std::string other{long_string};
+    other[900] = 'z';
+    const shiv::StringView long_view{long_string};
+    BOOST_TEST((long_view == shiv::StringView{other}) == false);
+    BOOST_TEST(long_view.compare(other) < 0);
+    BOOST_TEST(long_view.substr(0, 900) == shiv::StringView{other}.substr(0, 900));
+}
+
+BOOST_AUTO_TEST_CASE(find_test) {
+    constexpr shiv::StringView view{"Hello, world"};
+    static_assert(view.find('o') == 4);
+    static_assert(view.find('o', 5) == 8);
+    static_assert(view.find("world") == 7);
+    static_assert(view.rfind('o') == 8);
+    static_assert(view.rfind("l", 9) == 3);
+    static_assert(view.find('z') == shiv::StringView<>::npos);
+    static_assert(view.contains("lo, w"));
+    BOOST_TEST(shiv::StringView{"Hello, world"}.find('o', 5) == 8U);
+    BOOST_TEST(shiv::StringView{"Hello, world"}.find("") == 0U);
+    BOOST_TEST(shiv::StringView{"Hello, world"}.find("", 12) == 12U);
+    BOOST_TEST(shiv::StringView{"Hello, world"}.rfind("") == 12U);
+    BOOST_TEST(shiv::StringView{"Hello, world"}.find("world!") == shiv::StringView<>::npos);
+    BOOST_TEST(!shiv::StringView{"Hello, world"}.contains('z'));
+    BOOST_TEST(shiv::StringView{""}.rfind('a') == shiv::StringView<>::npos);
+
+    // every length of needle and start position through both the vector and scalar loops
+    const std::string text{random_text(300, 2)};
+    const shiv::StringView shiv_view{text};
+    const std::string_view std_view{text};
+    for (size_t length{1}; length < 40; length += 3) {
+        for (size_t start{0}; start + length <= text.size(); start += 23) {
+            const std::string needle{text.substr(start, length)};
+            for (size_t pos : {size_t{0}, size_t{17}, size_t{150}, size_t{299}}) {
+                BOOST_TEST(shiv_view.find(needle.c_str(), pos) == std_view.find(needle, pos));
+                BOOST_TEST(shiv_view.rfind(needle.c_str(), pos) == std_view.rfind(needle, pos));
+            }
+        }
+    }
+    for (char c{'a'}; c <= 'f'; ++c) {
+        for (size_t pos{0}; pos <= text.size(); pos += 7) {
+            BOOST_TEST(shiv_view.find(c, pos) == std_view.find(c, pos));
+            BOOST_TEST(shiv_view.rfind(c, pos) == std_view.rfind(c, pos));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(find_first_of_test) {
+    constexpr shiv::CharSet delimiters{",;|"};
+    static_assert(delimiters.contains(';'));
+    static_assert(!delimiters.contains('a'));
+    constexpr shiv::StringView view{"35=D|49=ABC;56=XYZ"};
+    static_assert(view.find_first_of(delimiters) == 4);
+    static_assert(view.find_first_of(delimiters, 5) == 11);
+    static_assert(view.find_first_not_of("0123456789") == 2);
+    BOOST_TEST(shiv::StringView{"35=D|49=ABC"}.find_first_of(delimiters) == 4U);
+    BOOST_TEST(shiv::StringView{"   x"}.find_first_not_of(' ') == 3U);
+
+    // every byte value, so both halves of the table and the high bit are covered
+    const shiv::CharSet high{"\x80\xFF\x7F\x01 "};
+    std::string bytes(256, ' ');
+    for (size_t i{0}; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>(i);
+    }
+    const shiv::StringView all{bytes.data(), bytes.size()};
+    BOOST_TEST(all.find_first_of(high) == 1U);
+    BOOST_TEST(all.find_first_of(high, 2) == 32U);
+    BOOST_TEST(all.find_first_of(high, 33) == 127U);
+    BOOST_TEST(all.find_first_of(high, 129) == 255U);
+
+    const std::string text{random_text(500, 3)};
+    const shiv::StringView shiv_view{text};
+    const std::string_view std_view{text};
+    for (const char* chars : {"e", "de", "xyz", "abcd", "abcde", "c\xFF"}) {
+        for (size_t pos{0}; pos <= text.size(); pos += 13) {
+            BOOST_TEST(shiv_view.find_first_of(chars, pos) == std_view.find_first_of(chars, pos));
+            BOOST_TEST(shiv_view.find_first_not_of(chars, pos) ==
+                       std_view.find_first_not_of(chars, pos));
+        }
+    }
+
+    // wider characters take the scalar loops
+    const shiv::StringView<char16_t> wide{u"key=value;"};
+    BOOST_TEST(wide.find_first_of(u";=") == 3U);
+    BOOST_TEST(wide.find(u"value") == 4U);
+    BOOST_TEST(wide.rfind(u'e') == 8U);
 }
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,79 @@
+#include <ShivLib/multithreading/thread_pool.hpp>
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(thread_pool_test)
+BOOST_AUTO_TEST_CASE(parallel_for_test) {
+    shiv::ThreadPool pool{4};
+    BOOST_TEST(pool.size() == 4U);
+    for (size_t count : {0U, 1U, 3U, 1000U}) {
+        std::vector<std::atomic<int>> hits(count);
+        pool.parallel_for(count, [&](size_t index) { ++hits[index]; });
+        for (auto&& hit : hits) {
+            BOOST_TEST(hit.load() == 1);
+        }
+    }
+    BOOST_TEST(shiv::ThreadPool{0}.size() == 1U);
+}
+
+BOOST_AUTO_TEST_CASE(nested_test) {
+    shiv::ThreadPool pool{3};
+    std::atomic<size_t> total{0};
+    pool.parallel_for(8, [&](size_t) {
+        pool.parallel_for(8, [&](size_t index) { total += index; });
+    });
+    BOOST_TEST(total.load() == 8U * 28U);
+
+    // a loop on another pool inside this one still spreads over that pool's workers
+    shiv::ThreadPool inner{3};
+    std::mutex mutex{};
+    std::set<std::thread::id> inner_threads{};
+    pool.parallel_for(2, [&](size_t) {
+        inner.parallel_for(6, [&](size_t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+            const std::lock_guard lock{mutex};
+            inner_threads.insert(std::this_thread::get_id());
+        });
+    });
+    BOOST_TEST(inner_threads.size() > 1U);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test) {
+    // loops started from several threads at once all finish, a busy pool runs the others inline
+    shiv::ThreadPool pool{3};
+    std::atomic<size_t> total{0};
+    std::vector<std::thread> callers{};
+    for (size_t caller{0}; caller < 4; ++caller) {
+        callers.emplace_back([&] {
+            for (size_t loop{0}; loop < 50; ++loop) {
+                pool.parallel_for(16, [&](size_t index) { total += index; });
+            }
+        });
+    }
+    for (auto&& caller : callers) {
+        caller.join();
+    }
+    BOOST_TEST(total.load() == 4U * 50U * 120U);
+}
+
+BOOST_AUTO_TEST_CASE(exception_test) {
+    shiv::ThreadPool pool{3};
+    BOOST_CHECK_THROW(pool.parallel_for(100,
+                                        [](size_t index) {
+                                            if (index == 42) {
+                                                throw std::runtime_error{"failed"};
+                                            }
+                                        }),
+                      std::runtime_error);
+    // the pool is still usable afterwards
+    std::atomic<size_t> count{0};
+    pool.parallel_for(10, [&](size_t) { ++count; });
+    BOOST_TEST(count.load() == 10U);
+}
+BOOST_AUTO_TEST_SUITE_END()
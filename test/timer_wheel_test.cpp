@@ -0,0 +1,122 @@
+#include <ShivLib/dataStructures/timer_wheel.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace {
+struct Session : shiv::TimerNode {
+    int fired{0};
+    uint64_t fired_at{0};
+
+    Session()
+    : shiv::TimerNode{[](shiv::TimerNode& node) {
+        auto& session{static_cast<Session&>(node)};
+        ++session.fired;
+        session.fired_at = node.expiry();
+    }} {
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(timer_wheel_test)
+BOOST_AUTO_TEST_CASE(schedule_test) {
+    shiv::TimerWheel wheel{};
+    Session near{};
+    Session far{};
+    Session very_far{};
+    wheel.schedule(near, 10);
+    wheel.schedule(far, 70000);
+    wheel.schedule(very_far, (uint64_t{1} << 33) + 5);
+    BOOST_TEST(wheel.size() == 3U);
+    BOOST_TEST(wheel.advance_to(9) == 0U);
+    BOOST_TEST(*wheel.next_expiry() == 10U);
+    BOOST_TEST(wheel.advance_to(10) == 1U);
+    BOOST_TEST(near.fired == 1);
+    BOOST_TEST(near.fired_at == 10U);
+    BOOST_TEST(!near.is_scheduled());
+
+    BOOST_TEST(wheel.advance_to(69999) == 0U);
+    BOOST_TEST(wheel.advance_to(70000) == 1U);
+    BOOST_TEST(far.fired_at == 70000U);
+
+    BOOST_TEST(wheel.advance_to(uint64_t{1} << 33) == 0U);
+    BOOST_TEST(wheel.now() == (uint64_t{1} << 33) + 1);
+    BOOST_TEST(wheel.advance_to((uint64_t{1} << 33) + 5) == 1U);
+    BOOST_TEST(very_far.fired == 1);
+    BOOST_TEST(wheel.empty());
+}
+
+BOOST_AUTO_TEST_CASE(cancel_test) {
+    shiv::TimerWheel wheel{};
+    Session session{};
+    BOOST_TEST(!wheel.cancel(session));
+    wheel.schedule_after(session, 300);
+    BOOST_TEST(wheel.cancel(session));
+    BOOST_TEST(wheel.empty());
+    wheel.schedule_after(session, 300);
+    wheel.schedule_after(session, 5); // rescheduling moves it
+    BOOST_TEST(wheel.size() == 1U);
+    wheel.advance_to(1000);
+    BOOST_TEST(session.fired == 1);
+    BOOST_TEST(session.fired_at == 5U);
+}
+
+BOOST_AUTO_TEST_CASE(reschedule_from_callback_test) {
+    struct Periodic : shiv::TimerNode {
+        shiv::TimerWheel* wheel;
+        int fired{0};
+        explicit Periodic(shiv::TimerWheel& owner)
+        : shiv::TimerNode{[](shiv::TimerNode& node) {
+            auto& periodic{static_cast<Periodic&>(node)};
+            if (++periodic.fired < 4) {
+                periodic.wheel->schedule(node, node.expiry());
+            }
+        }}
+        , wheel{&owner} {
+        }
+    };
+    shiv::TimerWheel wheel{};
+    Periodic periodic{wheel};
+    wheel.schedule(periodic, 3);
+    // a callback asking for a time that has passed runs on the following tick
+    BOOST_TEST(wheel.advance_to(5) == 3U);
+    BOOST_TEST(wheel.advance_to(6) == 1U);
+    BOOST_TEST(periodic.fired == 4);
+}
+
+BOOST_AUTO_TEST_CASE(random_expiry_test) {
+    shiv::TimerWheel wheel{};
+    std::vector<Session> sessions(2000);
+    std::mt19937_64 rng{42};
+    std::vector<uint64_t> expiries{};
+    for (auto&& session : sessions) {
+        expiries.push_back(rng() % 200000);
+        wheel.schedule(session, expiries.back());
+    }
+    for (size_t i{0}; i < sessions.size(); i += 3) {
+        wheel.cancel(sessions[i]);
+    }
+    wheel.advance_to(200000);
+    for (size_t i{0}; i < sessions.size(); ++i) {
+        if (i % 3 == 0) {
+            BOOST_TEST(sessions[i].fired == 0);
+        } else {
+            BOOST_TEST(sessions[i].fired == 1);
+            BOOST_TEST(sessions[i].fired_at == expiries[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(driver_test) {
+    using namespace std::chrono_literals;
+    const auto start{std::chrono::steady_clock::now()};
+    shiv::TimerDriver<> driver{1ms, start};
+    Session session{};
+    BOOST_TEST(!driver.timeout(start).has_value());
+    driver.schedule_at(session, start + 5ms + 1us);
+    BOOST_TEST((*driver.timeout(start) == 6ms));
+    BOOST_TEST(driver.poll(start + 5ms) == 0U);
+    BOOST_TEST(driver.poll(start + 6ms) == 1U);
+}
+BOOST_AUTO_TEST_SUITE_END()
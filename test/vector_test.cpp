@@ -54,6 +54,26 @@ BOOST_AUTO_TEST_CASE(adding_elements_test) {
     BOOST_TEST(vector1.capacity() == 100U);
 }
 
+BOOST_AUTO_TEST_CASE(growth_test) {
+    // a default constructed vector has no capacity to double
+    shiv::Vector<int> vector1{};
+    for (int i{0}; i < 100; ++i) {
+        vector1.push_back(i);
+    }
+    BOOST_TEST(vector1.size() == 100U);
+    BOOST_TEST(vector1[99] == 99);
+    BOOST_TEST(vector1.capacity() == 128U);
+
+    // more than double the capacity at once
+    shiv::Vector<int> vector2{1, 2};
+    vector2.insert(vector2.end(), 10, 7);
+    BOOST_TEST(vector2.size() == 12U);
+    BOOST_TEST(vector2[11] == 7);
+    vector2.insert(vector2.begin(), {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+    BOOST_TEST(vector2.size() == 32U);
+    BOOST_TEST(vector2[20] == 1);
+}
+
 BOOST_AUTO_TEST_CASE(removing_elements_test) {
     shiv::Vector<int> vector1{1, 2, 3};
     shiv::Vector<int> vector1_expected{1, 2};
@@ -124,5 +144,8 @@ BOOST_AUTO_TEST_CASE(comparison_test) {
     BOOST_TEST(vector1 <= shiv::Vector({0, 1, 2, 3, 4}));
     BOOST_TEST(vector1 > vector_lt);
     BOOST_TEST(!(vector1 > vector2));
+    // a prefix is not equal, whichever side it is on
+    BOOST_TEST(vector1 != shiv::Vector({0, 1, 2}));
+    BOOST_TEST(shiv::Vector({0, 1, 2}) != vector1);
 }
 BOOST_AUTO_TEST_SUITE_END()